@@ -8,9 +8,12 @@ COMMON_CFLAGS += -Iapps/include
 
 # App makefiles ################################################################
 
+include apps/echo/echo.mk
 include apps/gnss_world/gnss_world.mk
 include apps/hello_world/hello_world.mk
+include apps/load_gen/load_gen.mk
 include apps/message_world/message_world.mk
+include apps/sensor_latency/sensor_latency.mk
 include apps/sensor_world/sensor_world.mk
 include apps/spammer/spammer.mk
 include apps/timer_world/timer_world.mk
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chre.h>
+#include <cinttypes>
+#include <cstring>
+
+#include "chre/apps/echo/echo_messages.h"
+#include "chre/util/nanoapp/log.h"
+
+#define LOG_TAG "[Echo]"
+
+/**
+ * @file
+ * A nanoapp that returns every EchoRequest message it receives to the host
+ * endpoint that sent it, for measuring host link round-trip latency and
+ * throughput. See chre_link_benchmark_client for the host side.
+ */
+
+#ifdef CHRE_NANOAPP_INTERNAL
+namespace chre {
+namespace {
+#endif  // CHRE_NANOAPP_INTERNAL
+
+using chre::echo::kMessageTypeEchoRequest;
+using chre::echo::kMessageTypeEchoResponse;
+
+namespace {
+
+//! The number of requests that could not be echoed, logged when the nanoapp
+//! stops
+uint32_t gDroppedCount = 0;
+
+void messageFreeCallback(void *message, size_t /* messageSize */) {
+  chreHeapFree(message);
+}
+
+void handleEchoRequest(const chreMessageFromHostData *msg) {
+  void *payload = nullptr;
+  bool success = true;
+  if (msg->messageSize > CHRE_MESSAGE_TO_HOST_MAX_SIZE) {
+    success = false;
+  } else if (msg->messageSize > 0) {
+    payload = chreHeapAlloc(msg->messageSize);
+    if (payload == nullptr) {
+      success = false;
+    } else {
+      memcpy(payload, msg->message, msg->messageSize);
+    }
+  }
+
+  // chreSendMessageToHostEndpoint() invokes the free callback on failure too
+  if (success) {
+    success = chreSendMessageToHostEndpoint(
+        payload, msg->messageSize, kMessageTypeEchoResponse, msg->hostEndpoint,
+        (payload != nullptr) ? messageFreeCallback : nullptr);
+  }
+
+  if (!success && gDroppedCount++ == 0) {
+    LOGW("Failed to echo %" PRIu32 " byte message to endpoint 0x%" PRIx16,
+         msg->messageSize, msg->hostEndpoint);
+  }
+}
+
+}  // anonymous namespace
+
+bool nanoappStart() {
+  LOGI("App started as instance %" PRIu32, chreGetInstanceId());
+  return true;
+}
+
+void nanoappHandleEvent(uint32_t /* senderInstanceId */,
+                        uint16_t eventType,
+                        const void *eventData) {
+  if (eventType == CHRE_EVENT_MESSAGE_FROM_HOST) {
+    auto *msg = static_cast<const chreMessageFromHostData *>(eventData);
+    if (msg->messageType == kMessageTypeEchoRequest) {
+      handleEchoRequest(msg);
+    } else {
+      LOGW("Got unexpected message type %" PRIu32, msg->messageType);
+    }
+  }
+}
+
+void nanoappEnd() {
+  LOGI("Stopped after dropping %" PRIu32 " messages", gDroppedCount);
+}
+
+#ifdef CHRE_NANOAPP_INTERNAL
+}  // anonymous namespace
+}  // namespace chre
+
+#include "chre/util/nanoapp/app_id.h"
+#include "chre/platform/static_nanoapp_init.h"
+
+CHRE_STATIC_NANOAPP_INIT(Echo, chre::kEchoAppId, 0);
+#endif  // CHRE_NANOAPP_INTERNAL
@@ -0,0 +1,12 @@
+#
+# Echo Makefile
+#
+
+# Common Compiler Flags ########################################################
+
+# Include paths.
+COMMON_CFLAGS += -Iapps/echo/include
+
+# Common Source Files ##########################################################
+
+COMMON_SRCS += apps/echo/echo.cc
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_APPS_ECHO_ECHO_MESSAGES_H_
+#define CHRE_APPS_ECHO_ECHO_MESSAGES_H_
+
+/**
+ * @file
+ * Definitions of the messages exchanged between the Echo nanoapp and host-side
+ * benchmark clients. The nanoapp does not interpret payloads, so clients are
+ * free to embed whatever they need (e.g. a sequence number) to match responses
+ * to requests.
+ */
+
+#include <stdint.h>
+
+namespace chre {
+namespace echo {
+
+//! Message types used with the Echo nanoapp
+enum MessageType : uint32_t {
+  //! Host to nanoapp: a payload of up to CHRE_MESSAGE_TO_HOST_MAX_SIZE bytes
+  //! to be returned to the sending host endpoint
+  kMessageTypeEchoRequest = 1,
+
+  //! Nanoapp to host: an unmodified copy of the request payload
+  kMessageTypeEchoResponse = 2,
+};
+
+}  // namespace echo
+}  // namespace chre
+
+#endif  // CHRE_APPS_ECHO_ECHO_MESSAGES_H_
@@ -52,6 +52,22 @@ constexpr uint64_t kDefaultStandByLatency = Seconds(1).toRawNanoseconds();
 // Tracks the ON/OFF state of the gyro.
 bool gGyroEnabled = false;
 
+// The maximum time spent on calibration work per event. Work beyond this is
+// continued in later events so that the nanoapp doesn't monopolize the CHRE
+// event loop. May be overridden at build time, or set to zero to disable.
+#ifndef IMU_CAL_WORK_BUDGET_USEC
+#define IMU_CAL_WORK_BUDGET_USEC 2000
+#endif  // IMU_CAL_WORK_BUDGET_USEC
+
+constexpr uint64_t kWorkBudget =
+    Microseconds(IMU_CAL_WORK_BUDGET_USEC).toRawNanoseconds();
+
+// Event posted to self to continue deferred calibration work.
+constexpr uint16_t kContinueWorkEvent = CHRE_EVENT_FIRST_USER_VALUE;
+
+// True while a kContinueWorkEvent is in flight.
+bool gContinueWorkPosted = false;
+
 // Defines the indices for the following sensor array definition.
 enum SensorIndex {
   SENSOR_INDEX_TEMP = 0,
@@ -124,6 +140,19 @@ void nanoappDynamicConfigure(bool highPerformance) {
     }
   }
 }
+
+// Posts an event to this nanoapp to continue any deferred calibration work,
+// allowing other events to be delivered in between work slices.
+void scheduleContinueWork() {
+  if (!gContinueWorkPosted && nanoCal.has_pending_work()) {
+    gContinueWorkPosted = chreSendEvent(kContinueWorkEvent, nullptr, nullptr,
+                                        chreGetInstanceId());
+    if (!gContinueWorkPosted) {
+      // Nothing is lost: the work is resumed on the next sensor event.
+      LOGW("Failed to post continuation event");
+    }
+  }
+}
 }  // namespace
 
 bool nanoappStart() {
@@ -164,6 +193,7 @@ bool nanoappStart() {
   //  - MagCal:   magnetometer
   if (accelIsInitialized || magIsInitialized) {
     nanoCal.Initialize();
+    nanoCal.set_work_budget_nanos(kWorkBudget);
   } else {
     LOGE(
         "None of the required sensors to enable a runtime calibration were "
@@ -205,14 +235,23 @@ void nanoappHandleEvent(uint32_t senderInstanceId, uint16_t eventType,
       break;
     }
 
+    case kContinueWorkEvent: {
+      gContinueWorkPosted = false;
+      nanoCal.ProcessPendingWork();
+      break;
+    }
+
     default:
       LOGW("Unhandled event %d", eventType);
       break;
   }
+
+  scheduleContinueWork();
 }
 
 void nanoappEnd() {
   // TODO: Unsubscribe to sensors
+  nanoCal.Deinitialize();
   LOGI("Stopped");
 }
 
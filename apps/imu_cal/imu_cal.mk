@@ -25,6 +25,9 @@ COMMON_CFLAGS += -DDIVERSITY_CHECK_ENABLED
 #COMMON_CFLAGS += -DSPHERE_FIT_ENABLED
 #COMMON_CFLAGS += -DGYRO_OTC_FACTORY_CAL_ENABLED
 
+# Maximum calibration work per event [microseconds]; 0 disables time slicing.
+#COMMON_CFLAGS += -DIMU_CAL_WORK_BUDGET_USEC=2000
+
 # Debug testing flags.
 #COMMON_CFLAGS += -DMAG_CAL_DEBUG_ENABLE
 #COMMON_CFLAGS += -DDIVERSE_DEBUG_ENABLE
@@ -15,6 +15,7 @@
  */
 #include "nano_calibration.h"
 
+#include <cinttypes>
 #include <cmath>
 #include <cstring>
 
@@ -427,17 +428,68 @@ void NanoSensorCal::Initialize() {
   nanosensorcal_initialized_ = true;
 }
 
+void NanoSensorCal::Deinitialize() {
+  // Deferred samples and ASH updates are dropped, as the nanoapp is stopping.
+  while (num_pending_batches_ > 0) {
+    PopPendingBatch();
+  }
+  if (num_dropped_readings_ > 0) {
+    NANO_CAL_LOGW("[NanoSensorCal]", "Dropped %zu readings in total",
+                  num_dropped_readings_);
+    num_dropped_readings_ = 0;
+  }
+  pending_notify_accel_ = false;
+  pending_notify_gyro_ = false;
+  pending_notify_mag_ = 0;
+  mag_batch_update_flags_ = 0;
+
+  nanosensorcal_initialized_ = false;
+}
+
 // TODO: Evaluate the impact of sensor batching on the performance of the
 // calibration algorithms (versus processing on a per-sample basis). For
 // example, some of the internal algorithms rely on the temperature signal to
 // determine when temperature variation is too high to perform calibrations.
 void NanoSensorCal::HandleSensorSamples(
     uint16_t event_type, const chreSensorThreeAxisData *event_data) {
-  if (nanosensorcal_initialized_) {
-    HandleSensorSamplesAccelCal(event_type, event_data);
-    HandleSensorSamplesGyroCal(event_type, event_data);
-    HandleSensorSamplesMagCal(event_type, event_data);
+  if (!nanosensorcal_initialized_ || event_data->header.readingCount == 0 ||
+      !IsCalibratedSensorEventType(event_type))
+      return;
+
+  const auto &header = event_data->header;
+  const uint64_t deadline_nanos = GetWorkDeadline();
+  if (num_pending_batches_ == kMaxPendingBatches) {
+    // Makes room by spending this slice on the backlog.
+    ProcessPendingBatches(deadline_nanos);
+  }
+
+  if (num_pending_batches_ > 0) {
+    // Samples must reach the algorithms in time order, so a new batch can't
+    // be processed ahead of the ones that are still pending.
+    if (!QueueBatch(event_type, event_data->readings, header.readingCount,
+                    header.baseTimestamp)) {
+      DropBatch(event_type, header.readingCount);
+    }
+    return;
   }
+
+  uint64_t timestamp_nanos = header.baseTimestamp;
+  size_t next_reading = ProcessReadings(
+      event_type, event_data->readings, header.readingCount, 0 /* first */,
+      &timestamp_nanos, deadline_nanos);
+  if (next_reading < header.readingCount &&
+      QueueBatch(event_type, &event_data->readings[next_reading],
+                 header.readingCount - next_reading, timestamp_nanos)) {
+    // The remainder of the batch is processed by ProcessPendingWork().
+    return;
+  }
+
+  if (next_reading < header.readingCount) {
+    // Out of memory to defer the remainder. Finishing it here would exceed the
+    // work budget, so the algorithms only see the readings processed so far.
+    DropBatch(event_type, header.readingCount - next_reading);
+  }
+  FinishBatch(event_type, timestamp_nanos);
 }
 
 void NanoSensorCal::HandleTemperatureSamples(
@@ -459,208 +511,407 @@ void NanoSensorCal::HandleTemperatureSamples(
       mean_temperature_celsius += data[i].value;
     }
     mean_temperature_celsius /= header.readingCount;
-    temperature_celsius_ = mean_temperature_celsius;
+
+    // Pending samples predate this temperature update, so it is queued behind
+    // them to keep the temperature associated with the right samples.
+    if (num_pending_batches_ == kMaxPendingBatches) {
+      ProcessPendingBatches(GetWorkDeadline());
+    }
+
+    if (num_pending_batches_ == 0) {
+      SetTemperature(mean_temperature_celsius, timestamp_nanos);
+    } else if (num_pending_batches_ < kMaxPendingBatches) {
+      PendingBatch &batch = pending_batches_[num_pending_batches_++];
+      batch.event_type = event_type;
+      batch.readings = nullptr;
+      batch.reading_count = 0;
+      batch.next_reading = 0;
+      batch.timestamp_nanos = timestamp_nanos;
+      batch.temperature_celsius = mean_temperature_celsius;
+    } else {
+      // The next temperature update supersedes this one.
+      DropBatch(event_type, header.readingCount);
+    }
+  }
+}
+
+void NanoSensorCal::SetTemperature(float temperature_celsius,
+                                   uint64_t timestamp_nanos) {
+  temperature_celsius_ = temperature_celsius;
 
 #ifdef GYRO_CAL_ENABLED
 #ifdef OVERTEMPCAL_GYRO_ENABLED
-      // Updates the OTC gyro temperature.
-      overTempCalSetTemperature(&over_temp_gyro_cal_, timestamp_nanos,
-                                temperature_celsius_);
+  // Updates the OTC gyro temperature.
+  overTempCalSetTemperature(&over_temp_gyro_cal_, timestamp_nanos,
+                            temperature_celsius_);
 #endif  // OVERTEMPCAL_GYRO_ENABLED
 #endif  // GYRO_CAL_ENABLED
+}
+
+bool NanoSensorCal::has_pending_work() const {
+  bool pending = (num_pending_batches_ > 0 || pending_notify_accel_ ||
+                  pending_notify_gyro_);
+#ifdef MAG_CAL_ENABLED
+  pending |= (pending_notify_mag_ != MagUpdate::NO_UPDATE);
+#endif  // MAG_CAL_ENABLED
+  return pending;
+}
+
+void NanoSensorCal::ProcessPendingWork() {
+  // Performs a single unit of deferred work per call. ASH notifications are
+  // cheap relative to a batch, and are handled first so that a steady stream
+  // of sensor data can't delay a calibration update indefinitely.
+  if (pending_notify_accel_) {
+    pending_notify_accel_ = false;
+    NotifyAshAccelCal();
+  } else if (pending_notify_gyro_) {
+    pending_notify_gyro_ = false;
+    NotifyAshGyroCal();
+#ifdef MAG_CAL_ENABLED
+  } else if (pending_notify_mag_ != MagUpdate::NO_UPDATE) {
+    MagUpdateFlags new_update = pending_notify_mag_;
+    pending_notify_mag_ = MagUpdate::NO_UPDATE;
+    NotifyAshMagCal(new_update);
+#endif  // MAG_CAL_ENABLED
+  } else if (num_pending_batches_ > 0) {
+    ProcessPendingBatches(GetWorkDeadline());
   }
 }
 
-void NanoSensorCal::HandleSensorSamplesAccelCal(
-    uint16_t event_type, const chreSensorThreeAxisData *event_data) {
-#ifdef ACCEL_CAL_ENABLED
-  if (event_type == CHRE_EVENT_SENSOR_UNCALIBRATED_ACCELEROMETER_DATA) {
-    const auto header = event_data->header;
-    const auto *data = event_data->readings;
-    uint64_t timestamp_nanos = header.baseTimestamp;
-    for (size_t i = 0; i < header.readingCount; i++) {
-      timestamp_nanos += data[i].timestampDelta;
-      accelCalRun(&accel_cal_, timestamp_nanos,
-                  data[i].v[0],  // x-axis data [m/sec^2]
-                  data[i].v[1],  // y-axis data [m/sec^2]
-                  data[i].v[2],  // z-axis data [m/sec^2]
-                  temperature_celsius_);
-    }
-    // Checks for an accelerometer bias calibration change.
-    float offset[3] = {0.0f, 0.0f, 0.0f};
-    if (accelCalUpdateBias(&accel_cal_, &offset[0], &offset[1], &offset[2])) {
-      // Provides a new accelerometer calibration update.
-      accel_calibration_ready_ = true;
-      NotifyAshAccelCal();
+bool NanoSensorCal::IsCalibratedSensorEventType(uint16_t event_type) {
+  return (event_type == CHRE_EVENT_SENSOR_UNCALIBRATED_ACCELEROMETER_DATA ||
+          event_type == CHRE_EVENT_SENSOR_UNCALIBRATED_GYROSCOPE_DATA ||
+          event_type == CHRE_EVENT_SENSOR_UNCALIBRATED_GEOMAGNETIC_FIELD_DATA);
+}
+
+uint64_t NanoSensorCal::GetWorkDeadline() const {
+  return (work_budget_nanos_ == 0)
+      ? UINT64_MAX : chreGetTime() + work_budget_nanos_;
+}
+
+size_t NanoSensorCal::ProcessReadings(
+    uint16_t event_type, const ThreeAxisSample *readings,
+    size_t reading_count, size_t first, uint64_t *timestamp_nanos,
+    uint64_t deadline_nanos) {
+  size_t next_reading = first;
+  while (next_reading < reading_count) {
+    // The clock is only consulted every few samples, as reading it costs more
+    // than delivering a sample to the algorithms.
+    size_t end = reading_count - next_reading > kReadingsPerBudgetCheck
+        ? next_reading + kReadingsPerBudgetCheck : reading_count;
+    switch (event_type) {
+      case CHRE_EVENT_SENSOR_UNCALIBRATED_ACCELEROMETER_DATA:
+        ProcessAccelReadings(readings, next_reading, end, timestamp_nanos);
+        break;
+
+      case CHRE_EVENT_SENSOR_UNCALIBRATED_GYROSCOPE_DATA:
+        ProcessGyroReadings(readings, next_reading, end, timestamp_nanos);
+        break;
+
+      case CHRE_EVENT_SENSOR_UNCALIBRATED_GEOMAGNETIC_FIELD_DATA:
+        ProcessMagReadings(readings, next_reading, end, timestamp_nanos);
+        break;
+
+      default:
+        break;
     }
+    next_reading = end;
 
-#ifdef ACCEL_CAL_DBG_ENABLED
-    // Prints debug data report.
-    accelCalDebPrint(&accel_cal_, temperature_celsius_);
-#endif
+    if (deadline_nanos != UINT64_MAX && chreGetTime() >= deadline_nanos) {
+      break;
+    }
   }
+
+  return next_reading;
+}
+
+void NanoSensorCal::ProcessAccelReadings(
+    const ThreeAxisSample *readings, size_t begin, size_t end,
+    uint64_t *timestamp_nanos) {
+#ifdef GYRO_CAL_ENABLED
+  // GyroCal is only updated when the measured temperature is valid.
+  const bool update_gyro_cal = IsTemperatureValid();
+#endif  // GYRO_CAL_ENABLED
+
+  for (size_t i = begin; i < end; i++) {
+    *timestamp_nanos += readings[i].timestampDelta;
+    const float x = readings[i].v[0];  // x-axis data [m/sec^2]
+    const float y = readings[i].v[1];  // y-axis data [m/sec^2]
+    const float z = readings[i].v[2];  // z-axis data [m/sec^2]
+
+#ifdef ACCEL_CAL_ENABLED
+    accelCalRun(&accel_cal_, *timestamp_nanos, x, y, z, temperature_celsius_);
 #endif  // ACCEL_CAL_ENABLED
+
+#ifdef GYRO_CAL_ENABLED
+    if (update_gyro_cal) {
+      gyroCalUpdateAccel(&gyro_cal_, *timestamp_nanos, x, y, z);
+    }
+#endif  // GYRO_CAL_ENABLED
+  }
 }
 
-// TODO: Factor common code to shorten function and improve readability.
-void NanoSensorCal::HandleSensorSamplesGyroCal(
-    uint16_t event_type, const chreSensorThreeAxisData *event_data) {
-    uint64_t timestamp_nanos = 0;
+void NanoSensorCal::ProcessGyroReadings(
+    const ThreeAxisSample *readings, size_t begin, size_t end,
+    uint64_t *timestamp_nanos) {
 #ifdef GYRO_CAL_ENABLED
-    // Only updates the gyroscope calibration algorithm when measured
-    // temperature is valid.
-    if (temperature_celsius_ <= kInvalidTemperatureCelsius) {
-        return;
+  // Only updates the gyroscope calibration algorithm when measured
+  // temperature is valid.
+  const bool update_gyro_cal = IsTemperatureValid();
+#endif  // GYRO_CAL_ENABLED
+
+  for (size_t i = begin; i < end; i++) {
+    *timestamp_nanos += readings[i].timestampDelta;
+#ifdef GYRO_CAL_ENABLED
+    if (update_gyro_cal) {
+      gyroCalUpdateGyro(&gyro_cal_, *timestamp_nanos,
+                        readings[i].v[0],  // x-axis data [rad/sec]
+                        readings[i].v[1],  // y-axis data [rad/sec]
+                        readings[i].v[2],  // z-axis data [rad/sec]
+                        temperature_celsius_);
     }
+#endif  // GYRO_CAL_ENABLED
+  }
+}
 
-    switch (event_type) {
-      case CHRE_EVENT_SENSOR_UNCALIBRATED_ACCELEROMETER_DATA: {
-        const auto header = event_data->header;
-        const auto *data = event_data->readings;
-        timestamp_nanos = header.baseTimestamp;
-        for (size_t i = 0; i < header.readingCount; i++) {
-          timestamp_nanos += data[i].timestampDelta;
-          gyroCalUpdateAccel(&gyro_cal_, timestamp_nanos,
-                             data[i].v[0],   // x-axis data [m/sec^2]
-                             data[i].v[1],   // y-axis data [m/sec^2]
-                             data[i].v[2]);  // z-axis data [m/sec^2]
-        }
-        break;
-      }
+void NanoSensorCal::ProcessMagReadings(
+    const ThreeAxisSample *readings, size_t begin, size_t end,
+    uint64_t *timestamp_nanos) {
+#ifdef GYRO_CAL_ENABLED
+  // GyroCal is only updated when the measured temperature is valid.
+  const bool update_gyro_cal = IsTemperatureValid();
+#endif  // GYRO_CAL_ENABLED
 
-      case CHRE_EVENT_SENSOR_UNCALIBRATED_GYROSCOPE_DATA: {
-        const auto header = event_data->header;
-        const auto *data = event_data->readings;
-        timestamp_nanos = header.baseTimestamp;
-        for (size_t i = 0; i < header.readingCount; i++) {
-          timestamp_nanos += data[i].timestampDelta;
-          gyroCalUpdateGyro(&gyro_cal_, timestamp_nanos,
-                            data[i].v[0],  // x-axis data [rad/sec]
-                            data[i].v[1],  // y-axis data [rad/sec]
-                            data[i].v[2],  // z-axis data [rad/sec]
-                            temperature_celsius_);
-        }
+  for (size_t i = begin; i < end; i++) {
+    *timestamp_nanos += readings[i].timestampDelta;
+    const float x = readings[i].v[0];  // x-axis data [uT]
+    const float y = readings[i].v[1];  // y-axis data [uT]
+    const float z = readings[i].v[2];  // z-axis data [uT]
 
-        if (gyroCalNewBiasAvailable(&gyro_cal_)) {
-#ifdef OVERTEMPCAL_GYRO_ENABLED
-        // Sends new GyroCal offset estimate to the OTC-Gyro.
-        float offset[3] = {0.0f, 0.0f, 0.0f};
-        float offset_temperature_celsius = 0.0f;
-        gyroCalGetBias(&gyro_cal_, &offset[0], &offset[1], &offset[2],
-                       &offset_temperature_celsius);
-        overTempCalUpdateSensorEstimate(&over_temp_gyro_cal_, timestamp_nanos,
-                                        offset, offset_temperature_celsius);
-#else
-        // Provides a new gyroscope calibration update.
-        gyro_calibration_ready_ = true;
-        NotifyAshGyroCal();
-#endif  // OVERTEMPCAL_GYRO_ENABLED
-      }
+#ifdef GYRO_CAL_ENABLED
+    if (update_gyro_cal) {
+      gyroCalUpdateMag(&gyro_cal_, *timestamp_nanos, x, y, z);
+    }
+#endif  // GYRO_CAL_ENABLED
 
-#ifdef OVERTEMPCAL_GYRO_ENABLED
-      // Checks OTC for new calibration model update.
-      bool new_otc_model_update =
-          overTempCalNewModelUpdateAvailable(&over_temp_gyro_cal_);
-
-      // Checks for a change in the OTC-Gyro temperature compensated offset
-      // estimate.
-      bool new_otc_offset = overTempCalNewOffsetAvailable(&over_temp_gyro_cal_);
-
-      if (new_otc_model_update || new_otc_offset) {
-        // Provides a temperature compensated gyroscope calibration update.
-        gyro_calibration_ready_ = true;
-        NotifyAshGyroCal();
+#ifdef MAG_CAL_ENABLED
+    const uint64_t timestamp_micros =
+        static_cast<uint64_t>(*timestamp_nanos * kNanoToMicroseconds);
+
+    // Accumulates the calibration update flags until the batch completes.
+    mag_batch_update_flags_ |=
+        magCalUpdate(&mag_cal_, timestamp_micros, x, y, z);
+
+#ifdef SPHERE_FIT_ENABLED
+    // Sphere Fit Algo Part.
+
+    // getting ODR.
+    if (mag_sample_rate_data_.num_samples <
+         kSamplesToAverageForOdrEstimateMag) {
+      SamplingRateEstimate(&mag_sample_rate_data_, nullptr, *timestamp_nanos,
+                           false);
+    } else {
+      SamplingRateEstimate(&mag_sample_rate_data_, &mag_odr_estimate_hz_,
+                           0, true);
+
+      // Sphere fit ODR update.
+      magCalSphereOdrUpdate(&mag_cal_sphere_, mag_odr_estimate_hz_);
+    }
+
+    // Running Sphere fit, and getting trigger.
+    mag_batch_update_flags_ |=
+        magCalSphereUpdate(&mag_cal_sphere_, timestamp_micros, x, y, z);
+#endif  // SPHERE_FIT_ENABLED
+#endif  // MAG_CAL_ENABLED
+  }
+}
+
+void NanoSensorCal::FinishBatch(uint16_t event_type,
+                                uint64_t timestamp_nanos) {
+  switch (event_type) {
+    case CHRE_EVENT_SENSOR_UNCALIBRATED_ACCELEROMETER_DATA: {
+#ifdef ACCEL_CAL_ENABLED
+      // Checks for an accelerometer bias calibration change.
+      float offset[3] = {0.0f, 0.0f, 0.0f};
+      if (accelCalUpdateBias(&accel_cal_, &offset[0], &offset[1],
+                             &offset[2])) {
+        // Provides a new accelerometer calibration update.
+        accel_calibration_ready_ = true;
+        if (work_budget_nanos_ == 0) {
+          NotifyAshAccelCal();
+        } else {
+          pending_notify_accel_ = true;
+        }
       }
-#endif  // OVERTEMPCAL_GYRO_ENABLED
+
+#ifdef ACCEL_CAL_DBG_ENABLED
+      // Prints debug data report.
+      accelCalDebPrint(&accel_cal_, temperature_celsius_);
+#endif
+#endif  // ACCEL_CAL_ENABLED
       break;
     }
 
-    case CHRE_EVENT_SENSOR_UNCALIBRATED_GEOMAGNETIC_FIELD_DATA: {
-      const auto header = event_data->header;
-      const auto *data = event_data->readings;
-      timestamp_nanos = header.baseTimestamp;
-      for (size_t i = 0; i < header.readingCount; i++) {
-        timestamp_nanos += data[i].timestampDelta;
-        gyroCalUpdateMag(&gyro_cal_, timestamp_nanos,
-                         data[i].v[0],   // x-axis data [uT]
-                         data[i].v[1],   // y-axis data [uT]
-                         data[i].v[2]);  // z-axis data [uT]
+    case CHRE_EVENT_SENSOR_UNCALIBRATED_GYROSCOPE_DATA:
+#ifdef GYRO_CAL_ENABLED
+      if (IsTemperatureValid()) {
+        FinishGyroBatch(timestamp_nanos);
       }
+#endif  // GYRO_CAL_ENABLED
+      break;
+
+    case CHRE_EVENT_SENSOR_UNCALIBRATED_GEOMAGNETIC_FIELD_DATA:
+#ifdef MAG_CAL_ENABLED
+      if ((MagUpdate::UPDATE_BIAS & mag_batch_update_flags_) ||
+          (MagUpdate::UPDATE_SPHERE_FIT & mag_batch_update_flags_)) {
+        // Sets the flag to indicate a new calibration update is pending.
+        mag_calibration_ready_ = true;
+        if (work_budget_nanos_ == 0) {
+          NotifyAshMagCal(mag_batch_update_flags_);
+        } else {
+          pending_notify_mag_ |= mag_batch_update_flags_;
+        }
+      }
+      mag_batch_update_flags_ = MagUpdate::NO_UPDATE;
+#endif  // MAG_CAL_ENABLED
       break;
-    }
 
     default:
       break;
   }
 
-  if (timestamp_nanos > 0) {
-#ifdef GYRO_CAL_DBG_ENABLED
-    // Prints debug data report.
-    gyroCalDebugPrint(&gyro_cal_, timestamp_nanos);
-#endif  // GYRO_CAL_DBG_ENABLED
+  if (IsTemperatureValid()) {
+    PrintGyroCalDebug(timestamp_nanos);
+  }
+}
 
-#if defined(OVERTEMPCAL_GYRO_ENABLED) && defined(OVERTEMPCAL_DBG_ENABLED)
-    // Prints debug data report.
-    overTempCalDebugPrint(&over_temp_gyro_cal_, timestamp_nanos);
-#endif  // OVERTEMPCAL_GYRO_ENABLED && OVERTEMPCAL_DBG_ENABLED
+void NanoSensorCal::FinishGyroBatch(uint64_t timestamp_nanos) {
+#ifdef GYRO_CAL_ENABLED
+  bool notify = false;
+  if (gyroCalNewBiasAvailable(&gyro_cal_)) {
+#ifdef OVERTEMPCAL_GYRO_ENABLED
+    // Sends new GyroCal offset estimate to the OTC-Gyro.
+    float offset[3] = {0.0f, 0.0f, 0.0f};
+    float offset_temperature_celsius = 0.0f;
+    gyroCalGetBias(&gyro_cal_, &offset[0], &offset[1], &offset[2],
+                   &offset_temperature_celsius);
+    overTempCalUpdateSensorEstimate(&over_temp_gyro_cal_, timestamp_nanos,
+                                    offset, offset_temperature_celsius);
+#else
+    // Provides a new gyroscope calibration update.
+    notify = true;
+#endif  // OVERTEMPCAL_GYRO_ENABLED
+  }
+
+#ifdef OVERTEMPCAL_GYRO_ENABLED
+  // Checks OTC for new calibration model update.
+  bool new_otc_model_update =
+      overTempCalNewModelUpdateAvailable(&over_temp_gyro_cal_);
+
+  // Checks for a change in the OTC-Gyro temperature compensated offset
+  // estimate.
+  bool new_otc_offset = overTempCalNewOffsetAvailable(&over_temp_gyro_cal_);
+
+  // Provides a temperature compensated gyroscope calibration update.
+  notify |= (new_otc_model_update || new_otc_offset);
+#endif  // OVERTEMPCAL_GYRO_ENABLED
+
+  if (notify) {
+    gyro_calibration_ready_ = true;
+    if (work_budget_nanos_ == 0) {
+      NotifyAshGyroCal();
+    } else {
+      pending_notify_gyro_ = true;
+    }
   }
 #endif  // GYRO_CAL_ENABLED
 }
 
-void NanoSensorCal::HandleSensorSamplesMagCal(
-    uint16_t event_type, const chreSensorThreeAxisData *event_data) {
-#ifdef MAG_CAL_ENABLED
-  if (event_type == CHRE_EVENT_SENSOR_UNCALIBRATED_GEOMAGNETIC_FIELD_DATA) {
-    const auto header = event_data->header;
-    const auto *data = event_data->readings;
-    uint64_t timestamp_nanos = header.baseTimestamp;
-    MagUpdateFlags new_calibration_update_mag_cal = MagUpdate::NO_UPDATE;
+bool NanoSensorCal::QueueBatch(
+    uint16_t event_type, const ThreeAxisSample *readings,
+    size_t reading_count, uint64_t timestamp_nanos) {
+  bool success = false;
+  if (num_pending_batches_ < kMaxPendingBatches) {
+    // Event data is only valid for the duration of the event callback, so the
+    // unprocessed readings are copied.
+    size_t size = reading_count * sizeof(ThreeAxisSample);
+    auto *copy = static_cast<ThreeAxisSample *>(
+        chreHeapAlloc(static_cast<uint32_t>(size)));
+    if (copy == nullptr) {
+      NANO_CAL_LOGW("[NanoSensorCal]", "Failed to defer %zu readings",
+                    reading_count);
+    } else {
+      memcpy(copy, readings, size);
+
+      PendingBatch &batch = pending_batches_[num_pending_batches_++];
+      batch.event_type = event_type;
+      batch.readings = copy;
+      batch.reading_count = reading_count;
+      batch.next_reading = 0;
+      batch.timestamp_nanos = timestamp_nanos;
+      success = true;
+    }
+  }
 
-    for (size_t i = 0; i < header.readingCount; i++) {
-      timestamp_nanos += data[i].timestampDelta;
+  return success;
+}
 
-      // Sets the flag to indicate a new calibration update.
-      new_calibration_update_mag_cal |= magCalUpdate(
-          &mag_cal_,
-          static_cast<uint64_t>(timestamp_nanos * kNanoToMicroseconds),
-          data[i].v[0],   // x-axis data [uT]
-          data[i].v[1],   // y-axis data [uT]
-          data[i].v[2]);  // z-axis data [uT]
+void NanoSensorCal::PopPendingBatch() {
+  if (pending_batches_[0].readings != nullptr) {
+    chreHeapFree(pending_batches_[0].readings);
+  }
+  num_pending_batches_--;
+  for (size_t i = 0; i < num_pending_batches_; i++) {
+    pending_batches_[i] = pending_batches_[i + 1];
+  }
+}
 
-#ifdef SPHERE_FIT_ENABLED
-      // Sphere Fit Algo Part.
-
-      // getting ODR.
-      if (mag_sample_rate_data_.num_samples <
-           kSamplesToAverageForOdrEstimateMag) {
-        SamplingRateEstimate(&mag_sample_rate_data_, nullptr, timestamp_nanos,
-                             false);
-      } else {
-        SamplingRateEstimate(&mag_sample_rate_data_, &mag_odr_estimate_hz_,
-                             0, true);
-
-        // Sphere fit ODR update.
-        magCalSphereOdrUpdate(&mag_cal_sphere_, mag_odr_estimate_hz_);
+void NanoSensorCal::ProcessPendingBatches(uint64_t deadline_nanos) {
+  while (num_pending_batches_ > 0) {
+    PendingBatch &batch = pending_batches_[0];
+    if (batch.event_type == CHRE_EVENT_SENSOR_ACCELEROMETER_TEMPERATURE_DATA) {
+      SetTemperature(batch.temperature_celsius, batch.timestamp_nanos);
+      PopPendingBatch();
+    } else {
+      batch.next_reading = ProcessReadings(
+          batch.event_type, batch.readings, batch.reading_count,
+          batch.next_reading, &batch.timestamp_nanos, deadline_nanos);
+      if (batch.next_reading < batch.reading_count) {
+        break;
       }
-
-      // Running Sphere fit, and getting trigger.
-      new_calibration_update_mag_cal |= magCalSphereUpdate(
-          &mag_cal_sphere_,
-          static_cast<uint64_t>(timestamp_nanos * kNanoToMicroseconds),
-          data[i].v[0],   // x-axis data [uT]
-          data[i].v[1],   // y-axis data [uT]
-          data[i].v[2]);  // z-axis data [uT]
-#endif  // SPHERE_FIT_ENABLED
+      FinishBatch(batch.event_type, batch.timestamp_nanos);
+      PopPendingBatch();
     }
 
-    if ((MagUpdate::UPDATE_BIAS & new_calibration_update_mag_cal) ||
-        (MagUpdate::UPDATE_SPHERE_FIT & new_calibration_update_mag_cal)) {
-      // Sets the flag to indicate a new calibration update is pending.
-      mag_calibration_ready_ = true;
-      NotifyAshMagCal(new_calibration_update_mag_cal);
+    if (deadline_nanos != UINT64_MAX && chreGetTime() >= deadline_nanos) {
+      break;
     }
   }
-#endif  // MAG_CAL_ENABLED
+}
+
+void NanoSensorCal::DropBatch(uint16_t event_type, size_t reading_count) {
+  // Only the first drop is logged, as they come in bursts when the nanoapp
+  // can't keep up, and the total is logged by Deinitialize().
+  if (num_dropped_readings_ == 0) {
+    NANO_CAL_LOGW("[NanoSensorCal]", "Dropping %zu readings of event type %"
+                  PRIu16 " to stay within the work budget", reading_count,
+                  event_type);
+  }
+  num_dropped_readings_ += reading_count;
+}
+
+void NanoSensorCal::PrintGyroCalDebug(uint64_t timestamp_nanos) {
+#ifdef GYRO_CAL_ENABLED
+#ifdef GYRO_CAL_DBG_ENABLED
+  // Prints debug data report.
+  gyroCalDebugPrint(&gyro_cal_, timestamp_nanos);
+#endif  // GYRO_CAL_DBG_ENABLED
+
+#if defined(OVERTEMPCAL_GYRO_ENABLED) && defined(OVERTEMPCAL_DBG_ENABLED)
+  // Prints debug data report.
+  overTempCalDebugPrint(&over_temp_gyro_cal_, timestamp_nanos);
+#endif  // OVERTEMPCAL_GYRO_ENABLED && OVERTEMPCAL_DBG_ENABLED
+#endif  // GYRO_CAL_ENABLED
 }
 
 void NanoSensorCal::GetAccelerometerCalibration(
@@ -75,6 +75,9 @@ struct SampleRateData {
   size_t num_samples;
 };
 
+// A single three-axis sensor reading, as delivered in chreSensorThreeAxisData.
+typedef chreSensorThreeAxisData::chreSensorThreeAxisSampleData ThreeAxisSample;
+
 // TODO: move typedef to mag_cal.h.
 typedef uint32_t MagUpdateFlags;
 
@@ -92,6 +95,11 @@ class NanoSensorCal {
   // Initializes the sensor calibration algorithms.
   void Initialize();
 
+  // Releases any deferred sensor samples without processing them. Must be
+  // called from nanoappEnd(), as the CHRE heap can't be used once the nanoapp
+  // has stopped (e.g. during static destruction).
+  void Deinitialize();
+
   // Sends new sensor samples to the calibration algorithms.
   void HandleSensorSamples(uint16_t event_type,
                            const chreSensorThreeAxisData *event_data);
@@ -100,6 +108,24 @@ class NanoSensorCal {
   void HandleTemperatureSamples(uint16_t event_type,
                                 const chreSensorFloatData *event_data);
 
+  // Sets the time budget [nanoseconds] for a single call to
+  // HandleSensorSamples() or ProcessPendingWork(). Samples that can't be
+  // processed within the budget are deferred, along with the resulting ASH
+  // updates, or dropped if the backlog is full. Deferred work must be
+  // completed by calling ProcessPendingWork() until has_pending_work()
+  // returns false. A budget of zero (default) processes all
+  // work immediately.
+  void set_work_budget_nanos(uint64_t budget_nanos) {
+    work_budget_nanos_ = budget_nanos;
+  }
+
+  // Returns true if there is deferred work awaiting ProcessPendingWork().
+  bool has_pending_work() const;
+
+  // Performs one bounded unit of deferred work: a single ASH update, or up to
+  // the work budget's worth of deferred samples.
+  void ProcessPendingWork();
+
   // Returns the availability of new calibration data (useful for polling).
   bool is_accel_calibration_ready() { return accel_calibration_ready_; }
   bool is_gyro_calibration_ready()  { return gyro_calibration_ready_; }
@@ -117,18 +143,86 @@ class NanoSensorCal {
   void GetMagnetometerCalibration(struct ashCalParams *mag_cal_params) const ;
 
  private:
-  // Sends new sensor samples to the AccelCal.
-  void HandleSensorSamplesAccelCal(uint16_t event_type,
-                                   const chreSensorThreeAxisData *event_data);
-
-  // Sends new sensor samples to the GyroCal/OTC. GyroCal utilizes multiple
-  // sensor types (i.e., accel/gyro/mag).
-  void HandleSensorSamplesGyroCal(uint16_t event_type,
-                                  const chreSensorThreeAxisData *event_data);
-
-  // Sends new sensor samples to the MagCal.
-  void HandleSensorSamplesMagCal(uint16_t event_type,
-                                 const chreSensorThreeAxisData *event_data);
+  // The maximum number of partially processed sensor batches and temperature
+  // updates that can be deferred at once. When the queue is full, the backlog
+  // is processed within the work budget, and anything that still doesn't fit
+  // is dropped.
+  static constexpr size_t kMaxPendingBatches = 4;
+
+  // The number of samples processed between checks of the work budget.
+  static constexpr size_t kReadingsPerBudgetCheck = 16;
+
+  // A sensor batch whose processing has been deferred to a later work slice.
+  // The readings are a heap-allocated copy of the unprocessed samples. A
+  // temperature update queued behind earlier batches has no readings, and
+  // carries its mean temperature instead.
+  struct PendingBatch {
+    ThreeAxisSample *readings;
+    size_t reading_count;
+    size_t next_reading;
+    uint64_t timestamp_nanos;  // Timestamp of the last processed sample.
+    float temperature_celsius;
+    uint16_t event_type;
+  };
+
+  // Returns true for the sensor event types consumed by HandleSensorSamples().
+  static bool IsCalibratedSensorEventType(uint16_t event_type);
+
+  // Returns the time at which the current work slice must yield.
+  uint64_t GetWorkDeadline() const;
+
+  // Delivers readings [first, reading_count) to the algorithms, stopping early
+  // once the deadline has passed. Advances timestamp_nanos to the last
+  // processed sample and returns the index of the next unprocessed reading.
+  size_t ProcessReadings(uint16_t event_type,
+                         const ThreeAxisSample *readings,
+                         size_t reading_count, size_t first,
+                         uint64_t *timestamp_nanos, uint64_t deadline_nanos);
+
+  // Per-sensor sample loops. Each makes a single pass over the readings,
+  // delivering every sample to all of the algorithms that consume that sensor
+  // (e.g., accelerometer data feeds both AccelCal and GyroCal's stillness
+  // detection).
+  void ProcessAccelReadings(const ThreeAxisSample *readings,
+                            size_t begin, size_t end,
+                            uint64_t *timestamp_nanos);
+  void ProcessGyroReadings(const ThreeAxisSample *readings,
+                           size_t begin, size_t end,
+                           uint64_t *timestamp_nanos);
+  void ProcessMagReadings(const ThreeAxisSample *readings,
+                          size_t begin, size_t end,
+                          uint64_t *timestamp_nanos);
+
+  // Checks once per completed batch for new calibrations.
+  void FinishBatch(uint16_t event_type, uint64_t timestamp_nanos);
+  void FinishGyroBatch(uint64_t timestamp_nanos);
+
+  // Copies the given readings to the back of the pending batch queue. Returns
+  // false if the queue is full or memory could not be allocated.
+  bool QueueBatch(uint16_t event_type,
+                  const ThreeAxisSample *readings,
+                  size_t reading_count, uint64_t timestamp_nanos);
+
+  // Releases the batch at the front of the pending queue.
+  void PopPendingBatch();
+
+  // Processes pending batches and temperature updates in order until the
+  // queue is empty or the deadline has passed.
+  void ProcessPendingBatches(uint64_t deadline_nanos);
+
+  // Records readings that were discarded to stay within the work budget.
+  void DropBatch(uint16_t event_type, size_t reading_count);
+
+  // Delivers a temperature update to the calibration algorithms.
+  void SetTemperature(float temperature_celsius, uint64_t timestamp_nanos);
+
+  // Prints the GyroCal/OTC debug reports, if enabled.
+  void PrintGyroCalDebug(uint64_t timestamp_nanos);
+
+  // Returns true if a valid sensor temperature has been received.
+  bool IsTemperatureValid() const {
+    return temperature_celsius_ > kInvalidTemperatureCelsius;
+  }
 
   // Updates the local calibration parameters containers.
   void UpdateAccelCalParams();
@@ -171,6 +265,24 @@ class NanoSensorCal {
 #endif  // SPHERE_FIT_ENABLED
 #endif  // MAG_CAL_ENABLED
 
+  // Deferred sensor batches, in the order they were received.
+  PendingBatch pending_batches_[kMaxPendingBatches];
+  size_t num_pending_batches_ = 0;
+
+  // The number of readings discarded because they couldn't be deferred.
+  size_t num_dropped_readings_ = 0;
+
+  // Time budget for a single work slice [nanoseconds], zero if unlimited.
+  uint64_t work_budget_nanos_ = 0;
+
+  // ASH notifications deferred to a later work slice.
+  bool pending_notify_accel_ = false;
+  bool pending_notify_gyro_ = false;
+  MagUpdateFlags pending_notify_mag_ = 0;
+
+  // Calibration updates accumulated over the magnetometer batch in progress.
+  MagUpdateFlags mag_batch_update_flags_ = 0;
+
   // Used to limit the rate of gyro debug notification messages.
   uint64_t gyro_notification_time_check_ = 0;
 
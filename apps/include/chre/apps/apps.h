@@ -23,10 +23,13 @@
 namespace chre {
 
 UniquePtr<Nanoapp> initializeStaticNanoappAshWorld();
+UniquePtr<Nanoapp> initializeStaticNanoappEcho();
 UniquePtr<Nanoapp> initializeStaticNanoappGnssWorld();
 UniquePtr<Nanoapp> initializeStaticNanoappHelloWorld();
 UniquePtr<Nanoapp> initializeStaticNanoappImuCal();
+UniquePtr<Nanoapp> initializeStaticNanoappLoadGen();
 UniquePtr<Nanoapp> initializeStaticNanoappMessageWorld();
+UniquePtr<Nanoapp> initializeStaticNanoappSensorLatency();
 UniquePtr<Nanoapp> initializeStaticNanoappSensorWorld();
 UniquePtr<Nanoapp> initializeStaticNanoappSpammer();
 UniquePtr<Nanoapp> initializeStaticNanoappTimerWorld();
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_APPS_LOAD_GEN_LOAD_GEN_MESSAGES_H_
+#define CHRE_APPS_LOAD_GEN_LOAD_GEN_MESSAGES_H_
+
+/**
+ * @file
+ * Definitions of the messages exchanged between the LoadGen nanoapp and its
+ * host-side driver. The payloads are plain structs composed of 32-bit fields
+ * only, so their layout is identical on both sides without padding; both the
+ * host and CHRE are assumed to be little-endian.
+ */
+
+#include <stdint.h>
+
+namespace chre {
+namespace load_gen {
+
+//! Message types used with the LoadGen nanoapp
+enum MessageType : uint32_t {
+  //! Host to nanoapp: begin a run, with a LoadGenConfig payload. Ignored if a
+  //! run is already in progress.
+  kMessageTypeStart = 1,
+
+  //! Host to nanoapp: end the current run early, with no payload
+  kMessageTypeStop = 2,
+
+  //! Nanoapp to host: a LoadGenResult payload, sent when a run ends
+  kMessageTypeResult = 3,
+
+  //! Nanoapp to host: filler messages sent to generate load. The payload
+  //! begins with the 32-bit CHRE timestamp (in microseconds) at which the
+  //! message was sent.
+  kMessageTypeLoad = 4,
+};
+
+/**
+ * Describes the mix of load to generate. Each rate is a target that the
+ * nanoapp attempts to meet; a rate of zero disables that kind of load.
+ */
+struct LoadGenConfig {
+  //! How long to run before reporting results
+  uint32_t durationMillis;
+
+  //! Rate of events posted by the nanoapp to itself
+  uint32_t selfEventsPerSec;
+
+  //! Rate of events posted to all nanoapps, including this one
+  uint32_t broadcastEventsPerSec;
+
+  //! Number of cyclic timers to run concurrently, and their period
+  uint32_t timerCount;
+  uint32_t timerPeriodMicros;
+
+  //! Rate and size of messages sent to the host endpoint that started the run
+  uint32_t hostMessagesPerSec;
+  uint32_t hostMessageSize;
+
+  //! Rate and size of heap allocations. Up to heapMaxOutstanding allocations
+  //! are held at a time, with the oldest released to make room for the next.
+  uint32_t heapAllocsPerSec;
+  uint32_t heapAllocSize;
+  uint32_t heapMaxOutstanding;
+};
+
+/**
+ * Summary of a latency measurement, in microseconds.
+ */
+struct LoadGenLatency {
+  uint32_t count;
+  uint32_t minMicros;
+  uint32_t meanMicros;
+  uint32_t maxMicros;
+};
+
+/**
+ * Results of a run. Achieved rates are derived from the counts and
+ * elapsedMillis.
+ */
+struct LoadGenResult {
+  //! Time actually spent generating load
+  uint32_t elapsedMillis;
+
+  //! Total number of events delivered to the nanoapp during the run
+  uint32_t eventsHandled;
+
+  //! Self events posted and failed to post, and the latency from posting to
+  //! delivery
+  uint32_t selfEventsSent;
+  uint32_t selfEventsFailed;
+  struct LoadGenLatency selfEventLatency;
+
+  //! Broadcast events, as above
+  uint32_t broadcastEventsSent;
+  uint32_t broadcastEventsFailed;
+  struct LoadGenLatency broadcastEventLatency;
+
+  //! Number of timers successfully started, and how late each expiration was
+  //! delivered relative to the previous one plus the timer period
+  uint32_t timersStarted;
+  struct LoadGenLatency timerLateness;
+
+  //! Host messages sent, failed, and skipped because too many were in flight,
+  //! and the latency from sending to the message being released by CHRE
+  uint32_t hostMessagesSent;
+  uint32_t hostMessagesFailed;
+  uint32_t hostMessagesThrottled;
+  struct LoadGenLatency hostMessageLatency;
+
+  //! Heap allocations performed and failed, and the mean time per allocation
+  uint32_t heapAllocs;
+  uint32_t heapAllocFailures;
+  uint32_t heapMeanAllocNanos;
+};
+
+static_assert(sizeof(LoadGenConfig) == 10 * sizeof(uint32_t),
+              "LoadGenConfig must not contain padding");
+static_assert(sizeof(LoadGenResult) == 29 * sizeof(uint32_t),
+              "LoadGenResult must not contain padding");
+
+}  // namespace load_gen
+}  // namespace chre
+
+#endif  // CHRE_APPS_LOAD_GEN_LOAD_GEN_MESSAGES_H_
@@ -0,0 +1,477 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chre.h>
+#include <cinttypes>
+#include <cstring>
+
+#include "chre/apps/load_gen/load_gen_messages.h"
+#include "chre/util/macros.h"
+#include "chre/util/nanoapp/log.h"
+#include "chre/util/time.h"
+
+#define LOG_TAG "[LoadGen]"
+
+/**
+ * @file
+ * A nanoapp that generates a configurable mix of load on CHRE - self events,
+ * broadcast events, timers, host messages and heap churn - at target rates,
+ * then reports the achieved throughput and latency to the host. Runs are
+ * driven by the host via the messages in load_gen_messages.h, for example
+ * using chre_load_gen_client.
+ */
+
+#ifdef CHRE_NANOAPP_INTERNAL
+namespace chre {
+namespace {
+#endif  // CHRE_NANOAPP_INTERNAL
+
+using chre::load_gen::LoadGenConfig;
+using chre::load_gen::LoadGenLatency;
+using chre::load_gen::LoadGenResult;
+
+namespace {
+
+//! Period of the timer that paces load generation. Every tick, each kind of
+//! load catches up to its target rate.
+constexpr uint64_t kTickPeriod =
+    chre::Milliseconds(1).toRawNanoseconds();
+
+//! Upper bound on the operations of each kind issued per tick, which bounds
+//! the time spent in a single tick when the target rate can't be met
+constexpr uint32_t kMaxOpsPerTick = 64;
+
+//! Limits on the resources a run may hold at once
+constexpr uint32_t kMaxTimers = 8;
+constexpr uint32_t kMaxHostMessagesInFlight = 16;
+constexpr uint32_t kMaxHeapOutstanding = 64;
+
+//! Target instance ID that CHRE delivers to every nanoapp. Note that other
+//! nanoapps receive (and may log) the broadcast events generated by a run.
+constexpr uint32_t kBroadcastTarget = UINT32_MAX;
+
+constexpr uint16_t kSelfEvent = CHRE_EVENT_FIRST_USER_VALUE;
+constexpr uint16_t kBroadcastEvent = kSelfEvent + 1;
+
+//! Accumulates latency samples, in microseconds
+struct LatencyStats {
+  uint32_t count;
+  uint32_t minMicros;
+  uint32_t maxMicros;
+  uint64_t totalMicros;
+
+  void add(uint32_t micros) {
+    if (count == 0 || micros < minMicros) {
+      minMicros = micros;
+    }
+    if (micros > maxMicros) {
+      maxMicros = micros;
+    }
+    totalMicros += micros;
+    count++;
+  }
+
+  void exportTo(LoadGenLatency *latency) const {
+    latency->count = count;
+    latency->minMicros = minMicros;
+    latency->maxMicros = maxMicros;
+    latency->meanMicros = (count == 0)
+        ? 0 : static_cast<uint32_t>(totalMicros / count);
+  }
+};
+
+struct LoadTimer {
+  uint32_t handle;
+  uint64_t lastFireTime;
+};
+
+//! State for the run in progress; zeroed at the start of each run
+struct Run {
+  LoadGenConfig config;
+  LoadGenResult result;
+  uint16_t hostEndpoint;
+  uint64_t startTime;
+  uint32_t tickTimerHandle;
+
+  LatencyStats selfEventLatency;
+  LatencyStats broadcastEventLatency;
+  LatencyStats timerLateness;
+  LatencyStats hostMessageLatency;
+
+  LoadTimer timers[kMaxTimers];
+
+  void *heapBlocks[kMaxHeapOutstanding];
+  uint32_t heapHead;
+  uint32_t heapCount;
+  uint64_t heapAllocNanos;
+};
+
+Run gRun;
+bool gRunning = false;
+
+//! Host messages not yet released by CHRE; these may outlive the run that
+//! sent them
+uint32_t gHostMessagesInFlight = 0;
+
+//! Set while a host message send is in progress, as a send that fails
+//! releases the message before returning
+bool gSendingHostMessage = false;
+
+uint32_t getTimeMicros() {
+  // Truncated to 32 bits: the latencies measured are differences between two
+  // timestamps, which remain correct across wrap-around
+  return static_cast<uint32_t>(chreGetTime() / chre::kOneMicrosecondInNanoseconds);
+}
+
+void *encodeTimestamp(uint32_t micros) {
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(micros));
+}
+
+uint32_t decodeTimestamp(const void *eventData) {
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(eventData));
+}
+
+/**
+ * @return The number of operations to issue this tick for a given target
+ *         rate, given the number issued so far in this run
+ */
+uint32_t getOpsDue(uint32_t ratePerSec, uint64_t elapsedNanos,
+                   uint32_t issued) {
+  uint64_t due = static_cast<uint64_t>(ratePerSec) * elapsedNanos
+      / chre::kOneSecondInNanoseconds;
+  uint64_t pending = (due > issued) ? due - issued : 0;
+  return static_cast<uint32_t>(
+      (pending > kMaxOpsPerTick) ? kMaxOpsPerTick : pending);
+}
+
+void hostMessageFreeCallback(void *message, size_t messageSize) {
+  if (!gSendingHostMessage && gRunning) {
+    uint32_t sentMicros;
+    memcpy(&sentMicros, message, sizeof(sentMicros));
+    gRun.hostMessageLatency.add(getTimeMicros() - sentMicros);
+  }
+  gHostMessagesInFlight--;
+  chreHeapFree(message);
+}
+
+void resultFreeCallback(void *message, size_t messageSize) {
+  chreHeapFree(message);
+}
+
+void generateEvents(uint16_t eventType, uint32_t targetInstanceId,
+                    uint32_t count, uint32_t *sent, uint32_t *failed) {
+  for (uint32_t i = 0; i < count; i++) {
+    if (chreSendEvent(eventType, encodeTimestamp(getTimeMicros()),
+                      nullptr /* freeCallback */, targetInstanceId)) {
+      (*sent)++;
+    } else {
+      (*failed)++;
+    }
+  }
+}
+
+void generateHostMessages(uint32_t count) {
+  uint32_t size = gRun.config.hostMessageSize;
+  if (size < sizeof(uint32_t)) {
+    size = sizeof(uint32_t);
+  } else if (size > CHRE_MESSAGE_TO_HOST_MAX_SIZE) {
+    size = CHRE_MESSAGE_TO_HOST_MAX_SIZE;
+  }
+
+  LoadGenResult& result = gRun.result;
+  for (uint32_t i = 0; i < count; i++) {
+    void *message = nullptr;
+    if (gHostMessagesInFlight >= kMaxHostMessagesInFlight) {
+      result.hostMessagesThrottled++;
+    } else if ((message = chreHeapAlloc(size)) == nullptr) {
+      result.hostMessagesFailed++;
+    } else {
+      uint32_t sentMicros = getTimeMicros();
+      memset(message, 0, size);
+      memcpy(message, &sentMicros, sizeof(sentMicros));
+
+      gHostMessagesInFlight++;
+      gSendingHostMessage = true;
+      bool sent = chreSendMessageToHostEndpoint(
+          message, size, chre::load_gen::kMessageTypeLoad, gRun.hostEndpoint,
+          hostMessageFreeCallback);
+      gSendingHostMessage = false;
+
+      if (sent) {
+        result.hostMessagesSent++;
+      } else {
+        result.hostMessagesFailed++;
+      }
+    }
+  }
+}
+
+void generateHeapChurn(uint32_t count) {
+  uint32_t maxOutstanding = gRun.config.heapMaxOutstanding;
+  if (maxOutstanding == 0) {
+    maxOutstanding = 1;
+  } else if (maxOutstanding > kMaxHeapOutstanding) {
+    maxOutstanding = kMaxHeapOutstanding;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (gRun.heapCount == maxOutstanding) {
+      chreHeapFree(gRun.heapBlocks[gRun.heapHead]);
+      gRun.heapHead = (gRun.heapHead + 1) % kMaxHeapOutstanding;
+      gRun.heapCount--;
+    }
+
+    uint64_t allocStart = chreGetTime();
+    void *block = chreHeapAlloc(gRun.config.heapAllocSize);
+    gRun.heapAllocNanos += chreGetTime() - allocStart;
+    gRun.result.heapAllocs++;
+
+    if (block == nullptr) {
+      gRun.result.heapAllocFailures++;
+    } else {
+      // Touch the block so the allocation is backed by real memory traffic
+      memset(block, 0xa5, gRun.config.heapAllocSize);
+      uint32_t tail = (gRun.heapHead + gRun.heapCount) % kMaxHeapOutstanding;
+      gRun.heapBlocks[tail] = block;
+      gRun.heapCount++;
+    }
+  }
+}
+
+void releaseRunResources() {
+  chreTimerCancel(gRun.tickTimerHandle);
+  for (uint32_t i = 0; i < kMaxTimers; i++) {
+    if (gRun.timers[i].handle != CHRE_TIMER_INVALID) {
+      chreTimerCancel(gRun.timers[i].handle);
+    }
+  }
+
+  while (gRun.heapCount > 0) {
+    chreHeapFree(gRun.heapBlocks[gRun.heapHead]);
+    gRun.heapHead = (gRun.heapHead + 1) % kMaxHeapOutstanding;
+    gRun.heapCount--;
+  }
+}
+
+void endRun() {
+  releaseRunResources();
+  gRunning = false;
+
+  LoadGenResult& result = gRun.result;
+  result.elapsedMillis = static_cast<uint32_t>(
+      (chreGetTime() - gRun.startTime) / chre::kOneMillisecondInNanoseconds);
+  gRun.selfEventLatency.exportTo(&result.selfEventLatency);
+  gRun.broadcastEventLatency.exportTo(&result.broadcastEventLatency);
+  gRun.timerLateness.exportTo(&result.timerLateness);
+  gRun.hostMessageLatency.exportTo(&result.hostMessageLatency);
+  result.heapMeanAllocNanos = (result.heapAllocs == 0) ? 0
+      : static_cast<uint32_t>(gRun.heapAllocNanos / result.heapAllocs);
+
+  LOGI("Run complete after %" PRIu32 " ms: handled %" PRIu32 " events",
+       result.elapsedMillis, result.eventsHandled);
+
+  auto *message = static_cast<LoadGenResult *>(
+      chreHeapAlloc(sizeof(LoadGenResult)));
+  if (message == nullptr) {
+    LOGE("Couldn't allocate result message");
+  } else {
+    *message = result;
+    if (!chreSendMessageToHostEndpoint(
+            message, sizeof(LoadGenResult),
+            chre::load_gen::kMessageTypeResult, gRun.hostEndpoint,
+            resultFreeCallback)) {
+      LOGE("Couldn't send result message");
+    }
+  }
+}
+
+void startRun(const chreMessageFromHostData *message) {
+  if (gRunning) {
+    LOGW("Ignoring start request: run already in progress");
+  } else if (message->messageSize != sizeof(LoadGenConfig)) {
+    LOGE("Ignoring start request with invalid size %" PRIu32,
+         message->messageSize);
+  } else {
+    memset(&gRun, 0, sizeof(gRun));
+    memcpy(&gRun.config, message->message, sizeof(LoadGenConfig));
+    gRun.hostEndpoint = message->hostEndpoint;
+    gRun.startTime = chreGetTime();
+
+    const LoadGenConfig& config = gRun.config;
+    LOGI("Starting %" PRIu32 " ms run: %" PRIu32 " self/s, %" PRIu32
+         " broadcast/s, %" PRIu32 " timers @ %" PRIu32 " us, %" PRIu32
+         " msg/s x %" PRIu32 " B, %" PRIu32 " alloc/s x %" PRIu32 " B",
+         config.durationMillis, config.selfEventsPerSec,
+         config.broadcastEventsPerSec, config.timerCount,
+         config.timerPeriodMicros, config.hostMessagesPerSec,
+         config.hostMessageSize, config.heapAllocsPerSec,
+         config.heapAllocSize);
+
+    for (uint32_t i = 0; i < kMaxTimers; i++) {
+      LoadTimer& timer = gRun.timers[i];
+      timer.handle = CHRE_TIMER_INVALID;
+      timer.lastFireTime = gRun.startTime;
+      if (i < config.timerCount && config.timerPeriodMicros > 0) {
+        timer.handle = chreTimerSet(
+            config.timerPeriodMicros * chre::kOneMicrosecondInNanoseconds,
+            &timer, false /* oneShot */);
+        if (timer.handle != CHRE_TIMER_INVALID) {
+          gRun.result.timersStarted++;
+        }
+      }
+    }
+
+    gRun.tickTimerHandle = chreTimerSet(kTickPeriod, &gRun.tickTimerHandle,
+                                        false /* oneShot */);
+    if (gRun.tickTimerHandle == CHRE_TIMER_INVALID) {
+      LOGE("Couldn't start tick timer");
+      releaseRunResources();
+    } else {
+      gRunning = true;
+    }
+  }
+}
+
+void handleTick() {
+  uint64_t elapsedNanos = chreGetTime() - gRun.startTime;
+  const LoadGenConfig& config = gRun.config;
+  LoadGenResult& result = gRun.result;
+
+  if (elapsedNanos >= config.durationMillis
+          * chre::kOneMillisecondInNanoseconds) {
+    endRun();
+  } else {
+    generateEvents(kSelfEvent, chreGetInstanceId(),
+                   getOpsDue(config.selfEventsPerSec, elapsedNanos,
+                             result.selfEventsSent + result.selfEventsFailed),
+                   &result.selfEventsSent, &result.selfEventsFailed);
+    generateEvents(kBroadcastEvent, kBroadcastTarget,
+                   getOpsDue(config.broadcastEventsPerSec, elapsedNanos,
+                             result.broadcastEventsSent
+                                 + result.broadcastEventsFailed),
+                   &result.broadcastEventsSent, &result.broadcastEventsFailed);
+    generateHostMessages(getOpsDue(
+        config.hostMessagesPerSec, elapsedNanos,
+        result.hostMessagesSent + result.hostMessagesFailed
+            + result.hostMessagesThrottled));
+    generateHeapChurn(getOpsDue(config.heapAllocsPerSec, elapsedNanos,
+                                result.heapAllocs));
+  }
+}
+
+void handleLoadTimer(LoadTimer *timer) {
+  uint64_t now = chreGetTime();
+  uint64_t expected = timer->lastFireTime
+      + gRun.config.timerPeriodMicros * chre::kOneMicrosecondInNanoseconds;
+  uint64_t lateness = (now > expected) ? now - expected : 0;
+  gRun.timerLateness.add(static_cast<uint32_t>(
+      lateness / chre::kOneMicrosecondInNanoseconds));
+  timer->lastFireTime = now;
+}
+
+void handleTimerEvent(const void *cookie) {
+  if (cookie == &gRun.tickTimerHandle) {
+    handleTick();
+  } else {
+    for (uint32_t i = 0; i < kMaxTimers; i++) {
+      if (cookie == &gRun.timers[i]) {
+        handleLoadTimer(&gRun.timers[i]);
+        break;
+      }
+    }
+  }
+}
+
+void handleMessageFromHost(const chreMessageFromHostData *message) {
+  switch (message->messageType) {
+    case chre::load_gen::kMessageTypeStart:
+      startRun(message);
+      break;
+
+    case chre::load_gen::kMessageTypeStop:
+      if (gRunning) {
+        endRun();
+      }
+      break;
+
+    default:
+      LOGW("Unexpected message type %" PRIu32, message->messageType);
+      break;
+  }
+}
+
+}  // anonymous namespace
+
+bool nanoappStart() {
+  LOGI("App started as instance %" PRIu32, chreGetInstanceId());
+  return true;
+}
+
+void nanoappHandleEvent(uint32_t senderInstanceId, uint16_t eventType,
+                        const void *eventData) {
+  if (gRunning) {
+    gRun.result.eventsHandled++;
+  }
+
+  switch (eventType) {
+    case CHRE_EVENT_MESSAGE_FROM_HOST:
+      handleMessageFromHost(
+          static_cast<const chreMessageFromHostData *>(eventData));
+      break;
+
+    case CHRE_EVENT_TIMER:
+      if (gRunning) {
+        handleTimerEvent(eventData);
+      }
+      break;
+
+    case kSelfEvent:
+      if (gRunning && senderInstanceId == chreGetInstanceId()) {
+        gRun.selfEventLatency.add(
+            getTimeMicros() - decodeTimestamp(eventData));
+      }
+      break;
+
+    case kBroadcastEvent:
+      if (gRunning && senderInstanceId == chreGetInstanceId()) {
+        gRun.broadcastEventLatency.add(
+            getTimeMicros() - decodeTimestamp(eventData));
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void nanoappEnd() {
+  if (gRunning) {
+    releaseRunResources();
+    gRunning = false;
+  }
+  LOGI("Stopped");
+}
+
+#ifdef CHRE_NANOAPP_INTERNAL
+}  // anonymous namespace
+}  // namespace chre
+
+#include "chre/platform/static_nanoapp_init.h"
+#include "chre/util/nanoapp/app_id.h"
+
+CHRE_STATIC_NANOAPP_INIT(LoadGen, chre::kLoadGenAppId, 0);
+#endif  // CHRE_NANOAPP_INTERNAL
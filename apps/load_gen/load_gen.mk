@@ -0,0 +1,12 @@
+#
+# Load Generator Makefile
+#
+
+# Common Compiler Flags ########################################################
+
+# Include paths.
+COMMON_CFLAGS += -Iapps/load_gen/include
+
+# Common Source Files ##########################################################
+
+COMMON_SRCS += apps/load_gen/load_gen.cc
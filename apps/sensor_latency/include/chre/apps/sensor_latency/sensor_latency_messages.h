@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_APPS_SENSOR_LATENCY_SENSOR_LATENCY_MESSAGES_H_
+#define CHRE_APPS_SENSOR_LATENCY_SENSOR_LATENCY_MESSAGES_H_
+
+/**
+ * @file
+ * Definitions of the messages exchanged between the SensorLatency nanoapp and
+ * the host. As with the LoadGen messages, the payloads are composed of 32-bit
+ * fields only, and both sides are assumed to be little-endian.
+ */
+
+#include <stdint.h>
+
+namespace chre {
+namespace sensor_latency {
+
+//! Message types used with the SensorLatency nanoapp
+enum MessageType : uint32_t {
+  //! Host to nanoapp: replace the set of sensors being measured, with a
+  //! SensorLatencyConfig payload. Reports are then sent to the host endpoint
+  //! that sent this message. Nothing is measured until the first of these is
+  //! received, and one with no sensors stops all measurement.
+  kMessageTypeConfigure = 1,
+
+  //! Nanoapp to host: a SensorLatencyReport payload, sent periodically for
+  //! each sensor that delivered data in the reporting period
+  kMessageTypeReport = 2,
+};
+
+//! The maximum number of sensors that can be measured at once
+constexpr uint32_t kMaxSensors = 4;
+
+//! The shortest report interval the nanoapp accepts. Shorter intervals are
+//! raised to this.
+constexpr uint32_t kMinReportIntervalMillis = 1000;
+
+//! Latencies are recorded in a histogram of power-of-two buckets. Bucket 0
+//! covers [0, kFirstBucketLimitMicros), bucket i covers
+//! [kFirstBucketLimitMicros << (i - 1), kFirstBucketLimitMicros << i), and the
+//! last bucket is unbounded.
+constexpr uint32_t kHistogramBucketCount = 16;
+constexpr uint32_t kFirstBucketLimitMicros = 128;
+
+struct SensorLatencyRequest {
+  //! One of CHRE_SENSOR_TYPE_*
+  uint32_t sensorType;
+
+  //! Sampling interval and batching latency passed to chreSensorConfigure().
+  //! The interval must be no shorter than the sensor's minimum interval.
+  uint32_t intervalMicros;
+  uint32_t latencyMicros;
+};
+
+struct SensorLatencyConfig {
+  //! How often to send a report for each sensor, at least
+  //! kMinReportIntervalMillis
+  uint32_t reportIntervalMillis;
+
+  //! The number of valid entries in sensors. Each must be for a different
+  //! sensor type.
+  uint32_t sensorCount;
+  struct SensorLatencyRequest sensors[kMaxSensors];
+};
+
+/**
+ * Latency statistics for one sensor over one reporting period. The latency of
+ * an event is the time between the timestamp of its newest sample and the
+ * nanoapp receiving it, as measured by chreGetTime() on entry to
+ * nanoappHandleEvent().
+ */
+struct SensorLatencyReport {
+  uint32_t sensorType;
+
+  //! The length of the period covered by this report
+  uint32_t periodMillis;
+
+  //! Events and samples received during the period
+  uint32_t eventCount;
+  uint32_t sampleCount;
+
+  //! Summary of the event latencies
+  uint32_t minMicros;
+  uint32_t meanMicros;
+  uint32_t maxMicros;
+
+  //! The largest age of the oldest sample in an event, which includes the
+  //! time spent batching
+  uint32_t maxBatchAgeMicros;
+
+  //! Events whose newest sample was timestamped after it was received, which
+  //! indicates skew between the sensor and CHRE time bases. These are
+  //! recorded as zero latency.
+  uint32_t futureSampleCount;
+
+  uint32_t histogram[kHistogramBucketCount];
+};
+
+static_assert(sizeof(SensorLatencyConfig)
+                  == (2 + 3 * kMaxSensors) * sizeof(uint32_t),
+              "SensorLatencyConfig must not contain padding");
+static_assert(sizeof(SensorLatencyReport)
+                  == (9 + kHistogramBucketCount) * sizeof(uint32_t),
+              "SensorLatencyReport must not contain padding");
+
+}  // namespace sensor_latency
+}  // namespace chre
+
+#endif  // CHRE_APPS_SENSOR_LATENCY_SENSOR_LATENCY_MESSAGES_H_
@@ -0,0 +1,405 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chre.h>
+#include <cinttypes>
+#include <cstring>
+
+#include "chre/apps/sensor_latency/sensor_latency_messages.h"
+#include "chre/util/macros.h"
+#include "chre/util/nanoapp/log.h"
+#include "chre/util/time.h"
+
+#define LOG_TAG "[SensorLatency]"
+
+/**
+ * @file
+ * A benchmarking nanoapp that measures the end-to-end latency of sensor data:
+ * for each sensor event, the time between the timestamp of its samples and
+ * the event reaching the nanoapp. Latencies are collected into histograms
+ * that are reported to the host periodically. The sensors to measure are
+ * configured by the host, and the nanoapp stays idle until it receives a
+ * configuration, so that it doesn't load the system when it isn't in use.
+ */
+
+#ifdef CHRE_NANOAPP_INTERNAL
+namespace chre {
+namespace {
+#endif  // CHRE_NANOAPP_INTERNAL
+
+using chre::sensor_latency::SensorLatencyConfig;
+using chre::sensor_latency::SensorLatencyReport;
+using chre::sensor_latency::SensorLatencyRequest;
+using chre::sensor_latency::kFirstBucketLimitMicros;
+using chre::sensor_latency::kHistogramBucketCount;
+using chre::sensor_latency::kMaxSensors;
+using chre::sensor_latency::kMinReportIntervalMillis;
+
+namespace {
+
+//! The state of one sensor being measured
+struct SensorProbe {
+  uint32_t handle;
+  uint8_t sensorType;
+  uint64_t totalMicros;
+  SensorLatencyReport report;
+};
+
+SensorProbe gProbes[kMaxSensors];
+uint32_t gProbeCount = 0;
+
+uint32_t gReportTimerHandle = CHRE_TIMER_INVALID;
+uint64_t gPeriodStartTime;
+uint16_t gHostEndpoint = CHRE_HOST_ENDPOINT_BROADCAST;
+
+uint32_t toMicros(uint64_t nanos) {
+  uint64_t micros = nanos / chre::kOneMicrosecondInNanoseconds;
+  return (micros > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(micros);
+}
+
+uint32_t getHistogramBucket(uint32_t latencyMicros) {
+  uint32_t bucket = 0;
+  uint32_t limit = kFirstBucketLimitMicros;
+  while (bucket < kHistogramBucketCount - 1 && latencyMicros >= limit) {
+    bucket++;
+    limit <<= 1;
+  }
+  return bucket;
+}
+
+void resetReport(SensorProbe *probe) {
+  memset(&probe->report, 0, sizeof(probe->report));
+  probe->report.sensorType = probe->sensorType;
+  probe->totalMicros = 0;
+}
+
+//! The layouts of sensor data events that latency can be measured from
+enum class SampleFormat {
+  Unknown,
+  ThreeAxis,
+  Float,
+  Byte,
+  Occurrence,
+};
+
+SampleFormat getSampleFormat(uint32_t sensorType) {
+  switch (sensorType) {
+    case CHRE_SENSOR_TYPE_ACCELEROMETER:
+    case CHRE_SENSOR_TYPE_GYROSCOPE:
+    case CHRE_SENSOR_TYPE_GEOMAGNETIC_FIELD:
+    case CHRE_SENSOR_TYPE_UNCALIBRATED_ACCELEROMETER:
+    case CHRE_SENSOR_TYPE_UNCALIBRATED_GYROSCOPE:
+    case CHRE_SENSOR_TYPE_UNCALIBRATED_GEOMAGNETIC_FIELD:
+      return SampleFormat::ThreeAxis;
+
+    case CHRE_SENSOR_TYPE_PRESSURE:
+    case CHRE_SENSOR_TYPE_LIGHT:
+    case CHRE_SENSOR_TYPE_ACCELEROMETER_TEMPERATURE:
+    case CHRE_SENSOR_TYPE_GYROSCOPE_TEMPERATURE:
+    case CHRE_SENSOR_TYPE_GEOMAGNETIC_FIELD_TEMPERATURE:
+      return SampleFormat::Float;
+
+    case CHRE_SENSOR_TYPE_PROXIMITY:
+      return SampleFormat::Byte;
+
+    case CHRE_SENSOR_TYPE_INSTANT_MOTION_DETECT:
+    case CHRE_SENSOR_TYPE_STATIONARY_DETECT:
+      return SampleFormat::Occurrence;
+
+    default:
+      return SampleFormat::Unknown;
+  }
+}
+
+/**
+ * Computes the timestamp of the newest sample in a batch. The sample structs
+ * of every sensor data type begin with a timestampDelta, but differ in size.
+ */
+template<typename SensorDataType>
+uint64_t getNewestSampleTime(const void *eventData) {
+  const auto *data = static_cast<const SensorDataType *>(eventData);
+  uint64_t timestamp = data->header.baseTimestamp;
+  for (uint16_t i = 0; i < data->header.readingCount; i++) {
+    timestamp += data->readings[i].timestampDelta;
+  }
+  return timestamp;
+}
+
+/**
+ * @return false if the sensor type's data format isn't known
+ */
+bool getNewestSampleTime(uint8_t sensorType, const void *eventData,
+                         uint64_t *timestamp) {
+  bool success = true;
+  switch (getSampleFormat(sensorType)) {
+    case SampleFormat::ThreeAxis:
+      *timestamp = getNewestSampleTime<chreSensorThreeAxisData>(eventData);
+      break;
+
+    case SampleFormat::Float:
+      *timestamp = getNewestSampleTime<chreSensorFloatData>(eventData);
+      break;
+
+    case SampleFormat::Byte:
+      *timestamp = getNewestSampleTime<chreSensorByteData>(eventData);
+      break;
+
+    case SampleFormat::Occurrence:
+      *timestamp = getNewestSampleTime<chreSensorOccurrenceData>(eventData);
+      break;
+
+    default:
+      success = false;
+      break;
+  }
+
+  return success;
+}
+
+void recordSensorEvent(SensorProbe *probe, uint64_t receiveTime,
+                       const void *eventData) {
+  const auto *header = static_cast<const chreSensorDataHeader *>(eventData);
+  uint64_t newestSampleTime;
+  if (header->readingCount > 0
+      && getNewestSampleTime(probe->sensorType, eventData,
+                             &newestSampleTime)) {
+    SensorLatencyReport& report = probe->report;
+    uint32_t latencyMicros = 0;
+    if (newestSampleTime > receiveTime) {
+      report.futureSampleCount++;
+    } else {
+      latencyMicros = toMicros(receiveTime - newestSampleTime);
+    }
+
+    if (report.eventCount == 0 || latencyMicros < report.minMicros) {
+      report.minMicros = latencyMicros;
+    }
+    if (latencyMicros > report.maxMicros) {
+      report.maxMicros = latencyMicros;
+    }
+    if (receiveTime > header->baseTimestamp) {
+      uint32_t batchAgeMicros = toMicros(receiveTime - header->baseTimestamp);
+      if (batchAgeMicros > report.maxBatchAgeMicros) {
+        report.maxBatchAgeMicros = batchAgeMicros;
+      }
+    }
+
+    report.histogram[getHistogramBucket(latencyMicros)]++;
+    report.eventCount++;
+    report.sampleCount += header->readingCount;
+    probe->totalMicros += latencyMicros;
+  }
+}
+
+void reportFreeCallback(void *message, size_t messageSize) {
+  chreHeapFree(message);
+}
+
+void sendReports() {
+  uint64_t now = chreGetTime();
+  uint32_t periodMillis = static_cast<uint32_t>(
+      (now - gPeriodStartTime) / chre::kOneMillisecondInNanoseconds);
+  gPeriodStartTime = now;
+
+  for (uint32_t i = 0; i < gProbeCount; i++) {
+    SensorProbe& probe = gProbes[i];
+    SensorLatencyReport& report = probe.report;
+    if (report.eventCount > 0) {
+      report.periodMillis = periodMillis;
+      report.meanMicros = static_cast<uint32_t>(
+          probe.totalMicros / report.eventCount);
+      LOGI("Sensor %" PRIu8 ": %" PRIu32 " events, latency (us) min %" PRIu32
+           " mean %" PRIu32 " max %" PRIu32 ", max batch age %" PRIu32 " us",
+           probe.sensorType, report.eventCount, report.minMicros,
+           report.meanMicros, report.maxMicros, report.maxBatchAgeMicros);
+
+      auto *message = static_cast<SensorLatencyReport *>(
+          chreHeapAlloc(sizeof(SensorLatencyReport)));
+      if (message == nullptr) {
+        LOGE("Couldn't allocate report");
+      } else {
+        *message = report;
+        if (!chreSendMessageToHostEndpoint(
+                message, sizeof(SensorLatencyReport),
+                chre::sensor_latency::kMessageTypeReport, gHostEndpoint,
+                reportFreeCallback)) {
+          LOGE("Couldn't send report");
+        }
+      }
+    }
+
+    resetReport(&probe);
+  }
+}
+
+void stopProbes() {
+  for (uint32_t i = 0; i < gProbeCount; i++) {
+    chreSensorConfigureModeOnly(gProbes[i].handle,
+                                CHRE_SENSOR_CONFIGURE_MODE_DONE);
+  }
+  gProbeCount = 0;
+
+  if (gReportTimerHandle != CHRE_TIMER_INVALID) {
+    chreTimerCancel(gReportTimerHandle);
+    gReportTimerHandle = CHRE_TIMER_INVALID;
+  }
+}
+
+bool isSensorTypeMeasured(uint32_t sensorType) {
+  bool measured = false;
+  for (uint32_t i = 0; i < gProbeCount && !measured; i++) {
+    measured = (gProbes[i].sensorType == sensorType);
+  }
+  return measured;
+}
+
+void applyConfig(const SensorLatencyConfig& config) {
+  stopProbes();
+
+  uint32_t sensorCount = (config.sensorCount > kMaxSensors)
+      ? kMaxSensors : config.sensorCount;
+  for (uint32_t i = 0; i < sensorCount; i++) {
+    const SensorLatencyRequest& request = config.sensors[i];
+    SensorProbe& probe = gProbes[gProbeCount];
+    probe.sensorType = static_cast<uint8_t>(request.sensorType);
+    uint64_t intervalNanos = static_cast<uint64_t>(request.intervalMicros)
+        * chre::kOneMicrosecondInNanoseconds;
+    struct chreSensorInfo info;
+
+    if (getSampleFormat(request.sensorType) == SampleFormat::Unknown) {
+      LOGW("Sensor type %" PRIu32 " not supported", request.sensorType);
+    } else if (isSensorTypeMeasured(request.sensorType)) {
+      LOGW("Ignoring duplicate sensor type %" PRIu32, request.sensorType);
+    } else if (!chreSensorFindDefault(probe.sensorType, &probe.handle)) {
+      LOGW("Sensor type %" PRIu32 " not found", request.sensorType);
+    } else if (!chreGetSensorInfo(probe.handle, &info)) {
+      LOGW("Couldn't get info for sensor type %" PRIu32, request.sensorType);
+    } else if (intervalNanos == 0 || intervalNanos < info.minInterval) {
+      LOGW("Interval %" PRIu32 " us is too short for sensor type %" PRIu32,
+           request.intervalMicros, request.sensorType);
+    } else if (!chreSensorConfigure(
+                   probe.handle, CHRE_SENSOR_CONFIGURE_MODE_CONTINUOUS,
+                   intervalNanos,
+                   request.latencyMicros * chre::kOneMicrosecondInNanoseconds)) {
+      LOGW("Couldn't configure sensor type %" PRIu32, request.sensorType);
+    } else {
+      LOGI("Measuring sensor type %" PRIu32 " at %" PRIu32 " us interval, %"
+           PRIu32 " us latency", request.sensorType, request.intervalMicros,
+           request.latencyMicros);
+      resetReport(&probe);
+      gProbeCount++;
+    }
+  }
+
+  // A cyclic timer with a tiny interval would flood the event loop
+  uint32_t reportIntervalMillis = config.reportIntervalMillis;
+  if (reportIntervalMillis < kMinReportIntervalMillis) {
+    LOGW("Raising report interval of %" PRIu32 " ms to %" PRIu32 " ms",
+         reportIntervalMillis, kMinReportIntervalMillis);
+    reportIntervalMillis = kMinReportIntervalMillis;
+  }
+
+  gPeriodStartTime = chreGetTime();
+  if (gProbeCount > 0) {
+    gReportTimerHandle = chreTimerSet(
+        reportIntervalMillis * chre::kOneMillisecondInNanoseconds,
+        &gReportTimerHandle, false /* oneShot */);
+    if (gReportTimerHandle == CHRE_TIMER_INVALID) {
+      LOGE("Couldn't start report timer");
+    }
+  }
+}
+
+void handleMessageFromHost(const chreMessageFromHostData *message) {
+  if (message->messageType != chre::sensor_latency::kMessageTypeConfigure) {
+    LOGW("Unexpected message type %" PRIu32, message->messageType);
+  } else if (message->messageSize != sizeof(SensorLatencyConfig)) {
+    LOGE("Ignoring config with invalid size %" PRIu32, message->messageSize);
+  } else {
+    SensorLatencyConfig config;
+    memcpy(&config, message->message, sizeof(config));
+    gHostEndpoint = message->hostEndpoint;
+    applyConfig(config);
+  }
+}
+
+SensorProbe *findProbeForEventType(uint16_t eventType) {
+  SensorProbe *probe = nullptr;
+  for (uint32_t i = 0; i < gProbeCount; i++) {
+    if (eventType == CHRE_EVENT_SENSOR_DATA_EVENT_BASE
+            + gProbes[i].sensorType) {
+      probe = &gProbes[i];
+      break;
+    }
+  }
+  return probe;
+}
+
+}  // anonymous namespace
+
+bool nanoappStart() {
+  LOGI("App started as instance %" PRIu32, chreGetInstanceId());
+  return true;
+}
+
+void nanoappHandleEvent(uint32_t senderInstanceId, uint16_t eventType,
+                        const void *eventData) {
+  // Sampled first, so that the measurement includes as little of this
+  // nanoapp's own processing as possible
+  uint64_t receiveTime = chreGetTime();
+
+  switch (eventType) {
+    case CHRE_EVENT_MESSAGE_FROM_HOST:
+      handleMessageFromHost(
+          static_cast<const chreMessageFromHostData *>(eventData));
+      break;
+
+    case CHRE_EVENT_TIMER:
+      if (eventData == &gReportTimerHandle) {
+        sendReports();
+      }
+      break;
+
+    case CHRE_EVENT_SENSOR_SAMPLING_CHANGE:
+      break;
+
+    default: {
+      // Events for a sensor that is no longer measured, e.g. ones already
+      // queued when a new configuration was applied, are ignored
+      SensorProbe *probe = findProbeForEventType(eventType);
+      if (probe != nullptr) {
+        recordSensorEvent(probe, receiveTime, eventData);
+      }
+      break;
+    }
+  }
+}
+
+void nanoappEnd() {
+  stopProbes();
+  LOGI("Stopped");
+}
+
+#ifdef CHRE_NANOAPP_INTERNAL
+}  // anonymous namespace
+}  // namespace chre
+
+#include "chre/platform/static_nanoapp_init.h"
+#include "chre/util/nanoapp/app_id.h"
+
+CHRE_STATIC_NANOAPP_INIT(SensorLatency, chre::kSensorLatencyAppId, 0);
+#endif  // CHRE_NANOAPP_INTERNAL
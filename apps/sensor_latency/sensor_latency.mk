@@ -0,0 +1,12 @@
+#
+# Sensor Latency Makefile
+#
+
+# Common Compiler Flags ########################################################
+
+# Include paths.
+COMMON_CFLAGS += -Iapps/sensor_latency/include
+
+# Common Source Files ##########################################################
+
+COMMON_SRCS += apps/sensor_latency/sensor_latency.cc
@@ -6,11 +6,23 @@
 
 # Include paths.
 COMMON_CFLAGS += -Iash/include
+COMMON_CFLAGS += -Iash/platform/shared/include
 
 # Hexagon-specific Source Files ################################################
 
 HEXAGON_SRCS += ash/platform/slpi/ash.cc
 
+# x86-specific Compiler Flags ##################################################
+
+X86_CFLAGS += -Iash/platform/linux/include
+
 # x86-specific Source Files ####################################################
 
 X86_SRCS += ash/platform/linux/ash.cc
+X86_SRCS += ash/platform/linux/file_cal_params_storage.cc
+X86_SRCS += ash/platform/shared/cal_params_debouncer.cc
+
+# GoogleTest Source Files ######################################################
+
+GOOGLETEST_SRCS += ash/platform/linux/tests/file_cal_params_storage_test.cc
+GOOGLETEST_SRCS += ash/platform/shared/tests/cal_params_debouncer_test.cc
@@ -14,8 +14,81 @@
  * limitations under the License.
  */
 
+
 #include "ash_api/ash.h"
 
+#include "ash/platform/linux/ash.h"
+#include "ash/platform/linux/file_cal_params_storage.h"
+#include "ash/platform/shared/cal_params_debouncer.h"
+#include "chre/core/event_loop_manager.h"
+#include "chre/platform/log.h"
+#include "chre/platform/system_time.h"
+#include "chre/platform/system_timer.h"
+
+//! The directory that calibration parameters are persisted to. Override at
+//! build time to keep them elsewhere.
+#ifndef ASH_CAL_STORAGE_DIR
+#define ASH_CAL_STORAGE_DIR "/tmp"
+#endif  // ASH_CAL_STORAGE_DIR
+
+using chre::CalParamsDebouncer;
+using chre::EventLoopManagerSingleton;
+using chre::FileCalParamsStorage;
+using chre::Microseconds;
+using chre::Nanoseconds;
+using chre::Seconds;
+using chre::SystemCallbackType;
+using chre::SystemTime;
+using chre::SystemTimer;
+
+namespace {
+
+//! How long a sensor's cal params must go unchanged before they're persisted
+constexpr Nanoseconds kQuietPeriod = Nanoseconds(Seconds(30));
+
+//! The longest that changed cal params may go without being persisted
+constexpr Nanoseconds kMaxDelay =
+    Nanoseconds(Microseconds(ASH_CAL_SAVE_INTERVAL_USEC));
+
+FileCalParamsStorage gStorage(ASH_CAL_STORAGE_DIR);
+CalParamsDebouncer gDebouncer(gStorage, kQuietPeriod, kMaxDelay);
+
+//! Fires when pending cal params become due
+SystemTimer gFlushTimer;
+bool gFlushTimerInitialized = false;
+
+void scheduleFlush(Nanoseconds delay);
+
+void flushCallback(uint16_t /* eventType */, void * /* data */) {
+  scheduleFlush(gDebouncer.flushDue(SystemTime::getMonotonicTime()));
+}
+
+void flushTimerCallback(void * /* data */) {
+  // The debouncer is only accessed from the CHRE thread, which nanoapps call
+  // into ASH from
+  EventLoopManagerSingleton::get()->deferCallback(
+      SystemCallbackType::AshCalParamsFlush, nullptr, flushCallback);
+}
+
+/**
+ * Arms the flush timer to fire after the given delay, or leaves it idle if the
+ * delay is zero.
+ */
+void scheduleFlush(Nanoseconds delay) {
+  if (delay != Nanoseconds(0)) {
+    if (!gFlushTimerInitialized) {
+      gFlushTimerInitialized = gFlushTimer.init();
+    }
+
+    if (!gFlushTimerInitialized
+        || !gFlushTimer.set(flushTimerCallback, nullptr, delay)) {
+      LOGE("Couldn't schedule cal params flush");
+    }
+  }
+}
+
+}  // anonymous namespace
+
 bool ashSetCalibration(uint8_t sensorType, const struct ashCalInfo *calInfo) {
   // TODO: Implement this.
   return false;
@@ -23,12 +96,33 @@ bool ashSetCalibration(uint8_t sensorType, const struct ashCalInfo *calInfo) {
 
 bool ashLoadCalibrationParams(uint8_t sensorType, uint8_t storage,
                               struct ashCalParams *params) {
-  // TODO: Implement this.
-  return false;
+  // There is no sensor registry on Linux, so both storage areas are served
+  // from ASH storage.
+  return (params != nullptr && gDebouncer.load(sensorType, params));
 }
 
 bool ashSaveCalibrationParams(uint8_t sensorType,
                               const struct ashCalParams *params) {
-  // TODO: Implement this.
-  return false;
+  bool success = false;
+  if (params != nullptr) {
+    Nanoseconds now = SystemTime::getMonotonicTime();
+    success = gDebouncer.save(sensorType, *params, now);
+    if (success) {
+      scheduleFlush(gDebouncer.flushDue(now));
+    }
+  }
+
+  return success;
 }
+
+namespace chre {
+
+void ashDeinit() {
+  if (gFlushTimerInitialized) {
+    gFlushTimer.cancel();
+  }
+
+  gDebouncer.flushAll();
+}
+
+}  // namespace chre
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ash/platform/linux/file_cal_params_storage.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "chre/platform/log.h"
+
+namespace chre {
+
+namespace {
+
+//! Identifies a calibration file and the version of its layout
+constexpr uint32_t kFileMagic = 0x43414c31;  // "CAL1"
+
+struct CalFile {
+  uint32_t magic;
+  ashCalParams params;
+};
+
+}  // anonymous namespace
+
+bool FileCalParamsStorage::read(uint8_t sensorType, ashCalParams *params) {
+  char path[kMaxPathLen];
+  bool success = false;
+  FILE *file = nullptr;
+  if (getPath(sensorType, "", path)
+      && (file = fopen(path, "rb")) != nullptr) {
+    CalFile contents;
+    if (fread(&contents, sizeof(contents), 1, file) != 1
+        || contents.magic != kFileMagic) {
+      LOGE("Ignoring invalid cal file %s", path);
+    } else {
+      *params = contents.params;
+      success = true;
+    }
+    fclose(file);
+  }
+
+  return success;
+}
+
+bool FileCalParamsStorage::write(uint8_t sensorType,
+                                 const ashCalParams& params) {
+  char path[kMaxPathLen];
+  char tempPath[kMaxPathLen];
+  bool success = false;
+  if (getPath(sensorType, "", path) && getPath(sensorType, ".tmp", tempPath)) {
+    CalFile contents;
+    contents.magic = kFileMagic;
+    contents.params = params;
+
+    FILE *file = fopen(tempPath, "wb");
+    if (file == nullptr) {
+      LOGE("Couldn't open %s for writing", tempPath);
+    } else {
+      bool written = (fwrite(&contents, sizeof(contents), 1, file) == 1);
+      written = (fclose(file) == 0) && written;
+      if (!written || rename(tempPath, path) != 0) {
+        LOGE("Couldn't write %s", path);
+        remove(tempPath);
+      } else {
+        mWriteCount++;
+        success = true;
+      }
+    }
+  }
+
+  return success;
+}
+
+bool FileCalParamsStorage::getPath(uint8_t sensorType, const char *suffix,
+                                   char *path) const {
+  int len = snprintf(path, kMaxPathLen, "%s/ash_cal_%" PRIu8 ".bin%s",
+                     mDirectory, sensorType, suffix);
+  return (len > 0 && static_cast<size_t>(len) < kMaxPathLen);
+}
+
+}  // namespace chre
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ASH_PLATFORM_LINUX_ASH_H_
+#define ASH_PLATFORM_LINUX_ASH_H_
+
+namespace chre {
+
+/**
+ * Commits any calibration parameters that ASH is still holding back from
+ * storage, and stops committing them in the background. Must be called after
+ * the event loop has exited, before it is deinitialized.
+ */
+void ashDeinit();
+
+}  // namespace chre
+
+#endif  // ASH_PLATFORM_LINUX_ASH_H_
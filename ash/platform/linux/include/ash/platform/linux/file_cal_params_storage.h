@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ASH_PLATFORM_LINUX_FILE_CAL_PARAMS_STORAGE_H_
+#define ASH_PLATFORM_LINUX_FILE_CAL_PARAMS_STORAGE_H_
+
+#include "ash/platform/shared/cal_params_debouncer.h"
+
+namespace chre {
+
+/**
+ * Persists calibration parameters as one file per sensor type in a given
+ * directory. Each write replaces the file atomically, so an interrupted write
+ * leaves the previous parameters intact.
+ */
+class FileCalParamsStorage : public CalParamsStorage {
+ public:
+  /**
+   * @param directory The directory to store files in, which must exist and
+   *        outlive this object
+   */
+  explicit FileCalParamsStorage(const char *directory)
+      : mDirectory(directory) {}
+
+  bool read(uint8_t sensorType, ashCalParams *params) override;
+
+  bool write(uint8_t sensorType, const ashCalParams& params) override;
+
+  /**
+   * @return The number of successful writes, for testing
+   */
+  size_t getWriteCount() const {
+    return mWriteCount;
+  }
+
+ private:
+  //! The maximum length of a path to a file, including the terminator
+  static constexpr size_t kMaxPathLen = 256;
+
+  const char *mDirectory;
+  size_t mWriteCount = 0;
+
+  /**
+   * @return true if the path fit in the buffer
+   */
+  bool getPath(uint8_t sensorType, const char *suffix, char *path) const;
+};
+
+}  // namespace chre
+
+#endif  // ASH_PLATFORM_LINUX_FILE_CAL_PARAMS_STORAGE_H_
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "ash/platform/linux/file_cal_params_storage.h"
+#include "chre_api/chre/sensor.h"
+
+using chre::FileCalParamsStorage;
+
+namespace {
+
+class FileCalParamsStorageTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    strcpy(mDirectory, "/tmp/ash_cal_test_XXXXXX");
+    ASSERT_NE(mkdtemp(mDirectory), nullptr);
+  }
+
+  void TearDown() override {
+    DIR *dir = opendir(mDirectory);
+    ASSERT_NE(dir, nullptr);
+
+    char path[PATH_MAX];
+    for (dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+      if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+        snprintf(path, sizeof(path), "%s/%s", mDirectory, entry->d_name);
+        EXPECT_EQ(unlink(path), 0);
+      }
+    }
+    closedir(dir);
+    EXPECT_EQ(rmdir(mDirectory), 0);
+  }
+
+  char mDirectory[32];
+};
+
+ashCalParams makeParams(float offsetX) {
+  ashCalParams params;
+  memset(&params, 0, sizeof(params));
+  params.offset[0] = offsetX;
+  params.offsetSource = ASH_CAL_PARAMS_SOURCE_RUNTIME;
+  return params;
+}
+
+}  // anonymous namespace
+
+TEST_F(FileCalParamsStorageTest, ReadMissingFileFails) {
+  FileCalParamsStorage storage(mDirectory);
+  ashCalParams params;
+  EXPECT_FALSE(storage.read(CHRE_SENSOR_TYPE_ACCELEROMETER, &params));
+}
+
+TEST_F(FileCalParamsStorageTest, WriteThenReadFromNewInstance) {
+  {
+    FileCalParamsStorage storage(mDirectory);
+    EXPECT_TRUE(storage.write(CHRE_SENSOR_TYPE_ACCELEROMETER,
+                              makeParams(1.5f)));
+    EXPECT_TRUE(storage.write(CHRE_SENSOR_TYPE_GYROSCOPE, makeParams(0.25f)));
+    EXPECT_TRUE(storage.write(CHRE_SENSOR_TYPE_ACCELEROMETER,
+                              makeParams(2.5f)));
+    EXPECT_EQ(storage.getWriteCount(), 3);
+  }
+
+  FileCalParamsStorage storage(mDirectory);
+  ashCalParams params;
+  ASSERT_TRUE(storage.read(CHRE_SENSOR_TYPE_ACCELEROMETER, &params));
+  EXPECT_EQ(params.offset[0], 2.5f);
+  EXPECT_EQ(params.offsetSource, ASH_CAL_PARAMS_SOURCE_RUNTIME);
+  ASSERT_TRUE(storage.read(CHRE_SENSOR_TYPE_GYROSCOPE, &params));
+  EXPECT_EQ(params.offset[0], 0.25f);
+  EXPECT_FALSE(storage.read(CHRE_SENSOR_TYPE_GEOMAGNETIC_FIELD, &params));
+}
+
+TEST_F(FileCalParamsStorageTest, WriteToMissingDirectoryFails) {
+  FileCalParamsStorage storage("/nonexistent/ash_cal");
+  EXPECT_FALSE(storage.write(CHRE_SENSOR_TYPE_ACCELEROMETER, makeParams(1.0f)));
+  EXPECT_EQ(storage.getWriteCount(), 0);
+}
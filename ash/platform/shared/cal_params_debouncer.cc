@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ash/platform/shared/cal_params_debouncer.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+
+#include "chre/platform/log.h"
+#include "chre_api/chre/sensor.h"
+
+namespace chre {
+
+namespace {
+
+/**
+ * @return The change in offset, in the sensor's units, beyond which updated
+ *         parameters are committed without waiting for the quiet period. Zero
+ *         for sensors without a tuned threshold, which commits every change.
+ */
+float getOffsetThreshold(uint8_t sensorType) {
+  switch (sensorType) {
+    case CHRE_SENSOR_TYPE_ACCELEROMETER:
+    case CHRE_SENSOR_TYPE_UNCALIBRATED_ACCELEROMETER:
+      return 0.01f;  // m/s^2, roughly 1 mg
+    case CHRE_SENSOR_TYPE_GYROSCOPE:
+    case CHRE_SENSOR_TYPE_UNCALIBRATED_GYROSCOPE:
+      return 0.0005f;  // rad/s, roughly 0.03 deg/s
+    case CHRE_SENSOR_TYPE_GEOMAGNETIC_FIELD:
+    case CHRE_SENSOR_TYPE_UNCALIBRATED_GEOMAGNETIC_FIELD:
+      return 0.5f;  // uT
+    default:
+      return 0.0f;
+  }
+}
+
+/**
+ * @return true if both sets of parameters hold the same values, ignoring any
+ *         trailing padding
+ */
+bool paramsEqual(const ashCalParams& a, const ashCalParams& b) {
+  constexpr size_t kSize = offsetof(ashCalParams, crossAxisSource)
+      + sizeof(a.crossAxisSource);
+  return (memcmp(&a, &b, kSize) == 0);
+}
+
+}  // anonymous namespace
+
+bool CalParamsDebouncer::save(uint8_t sensorType, const ashCalParams& params,
+                              Nanoseconds now) {
+  Entry *entry = findEntry(sensorType);
+  if (entry == nullptr && !mEntries.full()) {
+    mEntries.emplace_back();
+    entry = &mEntries.back();
+    entry->sensorType = sensorType;
+    entry->pending = false;
+
+    // Seed the comparison baseline from storage, so that a restart doesn't
+    // force a write of parameters that haven't changed
+    entry->hasCommitted = mStorage.read(sensorType, &entry->committed);
+  }
+
+  bool success = (entry != nullptr);
+  if (!success) {
+    LOGE("Can't cache cal params for sensor %" PRIu8 ": too many sensors",
+         sensorType);
+  } else if (entry->hasCommitted && paramsEqual(entry->committed, params)) {
+    // Nothing needs to be written, including any pending change that these
+    // parameters have since reverted
+    entry->pending = false;
+  } else if (!entry->pending || !paramsEqual(entry->latest, params)) {
+    if (!entry->pending) {
+      entry->firstPendingTime = now;
+    }
+    entry->latest = params;
+    entry->lastUpdateTime = now;
+    entry->pending = true;
+
+    if (!entry->hasCommitted
+        || isSignificantChange(sensorType, entry->committed, params)) {
+      commit(*entry, now);
+    }
+  }
+
+  return success;
+}
+
+bool CalParamsDebouncer::load(uint8_t sensorType, ashCalParams *params) {
+  Entry *entry = findEntry(sensorType);
+  bool success = true;
+  if (entry != nullptr && entry->pending) {
+    *params = entry->latest;
+  } else if (entry != nullptr && entry->hasCommitted) {
+    *params = entry->committed;
+  } else {
+    success = mStorage.read(sensorType, params);
+  }
+
+  return success;
+}
+
+Nanoseconds CalParamsDebouncer::flushDue(Nanoseconds now) {
+  Nanoseconds nextDelay(0);
+  for (Entry& entry : mEntries) {
+    if (entry.pending && now >= getDueTime(entry)) {
+      commit(entry, now);
+    }
+
+    // Checked again, as a failed commit leaves the entry pending
+    if (entry.pending) {
+      Nanoseconds delay = getDueTime(entry) - now;
+      if (nextDelay == Nanoseconds(0) || delay < nextDelay) {
+        nextDelay = delay;
+      }
+    }
+  }
+
+  return nextDelay;
+}
+
+void CalParamsDebouncer::flushAll() {
+  for (Entry& entry : mEntries) {
+    if (entry.pending) {
+      commit(entry, entry.lastUpdateTime);
+    }
+  }
+}
+
+size_t CalParamsDebouncer::getPendingCount() const {
+  size_t count = 0;
+  for (const Entry& entry : mEntries) {
+    if (entry.pending) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+bool CalParamsDebouncer::isSignificantChange(uint8_t sensorType,
+                                             const ashCalParams& committed,
+                                             const ashCalParams& updated) {
+  bool significant = (committed.offsetSource != updated.offsetSource
+      || committed.offsetTempCelsiusSource != updated.offsetTempCelsiusSource
+      || committed.tempSensitivitySource != updated.tempSensitivitySource
+      || committed.tempInterceptSource != updated.tempInterceptSource
+      || committed.scaleFactorSource != updated.scaleFactorSource
+      || committed.crossAxisSource != updated.crossAxisSource);
+
+  float threshold = getOffsetThreshold(sensorType);
+  for (size_t i = 0; i < 3 && !significant; i++) {
+    float delta = std::fabs(updated.offset[i] - committed.offset[i]);
+    significant = (threshold == 0.0f) ? (delta > 0.0f) : (delta > threshold);
+  }
+
+  return significant;
+}
+
+CalParamsDebouncer::Entry *CalParamsDebouncer::findEntry(uint8_t sensorType) {
+  Entry *entry = nullptr;
+  for (Entry& candidate : mEntries) {
+    if (candidate.sensorType == sensorType) {
+      entry = &candidate;
+      break;
+    }
+  }
+
+  return entry;
+}
+
+void CalParamsDebouncer::commit(Entry& entry, Nanoseconds now) {
+  if (mStorage.write(entry.sensorType, entry.latest)) {
+    entry.committed = entry.latest;
+    entry.hasCommitted = true;
+    entry.pending = false;
+  } else {
+    LOGE("Failed to commit cal params for sensor %" PRIu8, entry.sensorType);
+    entry.firstPendingTime = now;
+    entry.lastUpdateTime = now;
+  }
+}
+
+Nanoseconds CalParamsDebouncer::getDueTime(const Entry& entry) const {
+  Nanoseconds quietDue = entry.lastUpdateTime + mQuietPeriod;
+  Nanoseconds maxDue = entry.firstPendingTime + mMaxDelay;
+  return (quietDue < maxDue) ? quietDue : maxDue;
+}
+
+}  // namespace chre
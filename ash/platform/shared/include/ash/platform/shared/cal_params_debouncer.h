@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ASH_PLATFORM_SHARED_CAL_PARAMS_DEBOUNCER_H_
+#define ASH_PLATFORM_SHARED_CAL_PARAMS_DEBOUNCER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ash_api/ash.h"
+#include "chre/util/fixed_size_vector.h"
+#include "chre/util/non_copyable.h"
+#include "chre/util/time.h"
+
+namespace chre {
+
+/**
+ * The persistent store that calibration parameters are committed to, supplied
+ * by each platform's ASH implementation.
+ */
+class CalParamsStorage {
+ public:
+  virtual ~CalParamsStorage() {}
+
+  /**
+   * Reads the calibration parameters last written for a sensor.
+   *
+   * @return true if parameters for the sensor were found
+   */
+  virtual bool read(uint8_t sensorType, ashCalParams *params) = 0;
+
+  /**
+   * Writes the calibration parameters for a sensor to persistent storage.
+   *
+   * @return true on success
+   */
+  virtual bool write(uint8_t sensorType, const ashCalParams& params) = 0;
+};
+
+/**
+ * Coalesces calibration parameter updates before they are committed to
+ * persistent storage. Runtime calibration algorithms can produce a new
+ * estimate every few seconds, most of which differ negligibly from the last
+ * one, so rather than writing each of them, the latest parameters for each
+ * sensor are cached and committed only when:
+ *  - they differ significantly from the committed parameters (an offset moved
+ *    by more than a per-sensor threshold, or a parameter's source changed),
+ *  - no further update has arrived for the quiet period, or
+ *  - they have been pending for the maximum delay, so that a sensor that
+ *    updates continuously is still persisted.
+ *
+ * Time is supplied by the caller, who is also responsible for calling
+ * flushDue() when the delay it returns has elapsed.
+ *
+ * This class is not thread-safe.
+ */
+class CalParamsDebouncer : public NonCopyable {
+ public:
+  //! The maximum number of sensors whose parameters can be cached
+  static constexpr size_t kMaxSensors = 8;
+
+  /**
+   * @param storage The persistent store to commit parameters to, which must
+   *        outlive this object
+   * @param quietPeriod How long a sensor's parameters must go without
+   *        updates before pending changes are committed
+   * @param maxDelay The longest a change may be pending before it is
+   *        committed, regardless of further updates
+   */
+  CalParamsDebouncer(CalParamsStorage& storage, Nanoseconds quietPeriod,
+                     Nanoseconds maxDelay)
+      : mStorage(storage), mQuietPeriod(quietPeriod), mMaxDelay(maxDelay) {}
+
+  /**
+   * Caches new parameters for a sensor, committing them immediately if they
+   * differ significantly from those last committed. Parameters identical to
+   * the cached ones are ignored.
+   *
+   * @param sensorType One of the CHRE_SENSOR_TYPE_* constants
+   * @param params The new parameters
+   * @param now The current time
+   *
+   * @return false if the parameters could not be cached
+   */
+  bool save(uint8_t sensorType, const ashCalParams& params, Nanoseconds now);
+
+  /**
+   * Provides the most recently saved parameters for a sensor, whether or not
+   * they have been committed, falling back to persistent storage.
+   *
+   * @return true if parameters were found
+   */
+  bool load(uint8_t sensorType, ashCalParams *params);
+
+  /**
+   * Commits the pending parameters of each sensor whose quiet period or
+   * maximum delay has elapsed.
+   *
+   * @param now The current time
+   *
+   * @return The delay until the next pending parameters become due, or
+   *         Nanoseconds(0) if none are pending
+   */
+  Nanoseconds flushDue(Nanoseconds now);
+
+  /**
+   * Commits all pending parameters immediately.
+   */
+  void flushAll();
+
+  /**
+   * @return The number of sensors with parameters awaiting commit
+   */
+  size_t getPendingCount() const;
+
+  /**
+   * @return true if updated parameters should be committed without waiting
+   *         for the quiet period
+   */
+  static bool isSignificantChange(uint8_t sensorType,
+                                  const ashCalParams& committed,
+                                  const ashCalParams& updated);
+
+ private:
+  struct Entry {
+    uint8_t sensorType;
+
+    //! Whether committed holds the parameters in persistent storage
+    bool hasCommitted;
+
+    //! Whether latest differs from what has been committed
+    bool pending;
+
+    ashCalParams committed;
+    ashCalParams latest;
+
+    //! The time of the oldest uncommitted update, and of the newest update
+    Nanoseconds firstPendingTime;
+    Nanoseconds lastUpdateTime;
+  };
+
+  CalParamsStorage& mStorage;
+  const Nanoseconds mQuietPeriod;
+  const Nanoseconds mMaxDelay;
+  FixedSizeVector<Entry, kMaxSensors> mEntries;
+
+  /**
+   * @return The entry for the sensor, or nullptr if there is none
+   */
+  Entry *findEntry(uint8_t sensorType);
+
+  /**
+   * Writes an entry's latest parameters to storage. On failure, the entry
+   * remains pending and is retried after another quiet period.
+   */
+  void commit(Entry& entry, Nanoseconds now);
+
+  /**
+   * @return The time at which an entry's pending parameters become due
+   */
+  Nanoseconds getDueTime(const Entry& entry) const;
+};
+
+}  // namespace chre
+
+#endif  // ASH_PLATFORM_SHARED_CAL_PARAMS_DEBOUNCER_H_
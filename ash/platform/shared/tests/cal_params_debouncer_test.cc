@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "ash/platform/shared/cal_params_debouncer.h"
+#include "chre_api/chre/sensor.h"
+
+using chre::CalParamsDebouncer;
+using chre::CalParamsStorage;
+using chre::Nanoseconds;
+using chre::Seconds;
+
+namespace {
+
+constexpr uint8_t kSensorType = CHRE_SENSOR_TYPE_ACCELEROMETER;
+constexpr Nanoseconds kQuietPeriod = Nanoseconds(Seconds(10));
+constexpr Nanoseconds kMaxDelay = Nanoseconds(Seconds(60));
+
+//! Keeps the parameters for a single sensor in memory
+class FakeStorage : public CalParamsStorage {
+ public:
+  bool read(uint8_t /* sensorType */, ashCalParams *params) override {
+    if (hasParams) {
+      *params = stored;
+    }
+    return hasParams;
+  }
+
+  bool write(uint8_t /* sensorType */, const ashCalParams& params) override {
+    if (writeSucceeds) {
+      stored = params;
+      hasParams = true;
+      writeCount++;
+    }
+    return writeSucceeds;
+  }
+
+  ashCalParams stored;
+  bool hasParams = false;
+  bool writeSucceeds = true;
+  size_t writeCount = 0;
+};
+
+ashCalParams makeParams(float offsetX) {
+  ashCalParams params;
+  memset(&params, 0, sizeof(params));
+  params.offset[0] = offsetX;
+  params.offsetSource = ASH_CAL_PARAMS_SOURCE_RUNTIME;
+  return params;
+}
+
+Nanoseconds at(uint64_t seconds) {
+  return Nanoseconds(Seconds(seconds));
+}
+
+}  // anonymous namespace
+
+TEST(CalParamsDebouncer, FirstSaveCommitsImmediately) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+
+  EXPECT_TRUE(debouncer.save(kSensorType, makeParams(1.0f), at(0)));
+  EXPECT_EQ(storage.writeCount, 1);
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+  EXPECT_EQ(debouncer.flushDue(at(0)), Nanoseconds(0));
+}
+
+TEST(CalParamsDebouncer, UnchangedParamsFromStorageNotRewritten) {
+  FakeStorage storage;
+  storage.stored = makeParams(1.0f);
+  storage.hasParams = true;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+
+  EXPECT_TRUE(debouncer.save(kSensorType, makeParams(1.0f), at(0)));
+  EXPECT_EQ(storage.writeCount, 0);
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+}
+
+TEST(CalParamsDebouncer, RevertedChangeNotWritten) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+
+  debouncer.save(kSensorType, makeParams(1.001f), at(1));
+  EXPECT_EQ(debouncer.getPendingCount(), 1);
+  debouncer.save(kSensorType, makeParams(1.0f), at(2));
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+
+  debouncer.flushAll();
+  EXPECT_EQ(storage.writeCount, 1);
+}
+
+TEST(CalParamsDebouncer, RepeatedParamsDontRestartQuietPeriod) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+
+  debouncer.save(kSensorType, makeParams(1.001f), at(1));
+  debouncer.save(kSensorType, makeParams(1.001f), at(5));
+  EXPECT_EQ(debouncer.flushDue(at(11)), Nanoseconds(0));
+  EXPECT_EQ(storage.writeCount, 2);
+}
+
+TEST(CalParamsDebouncer, SmallChangeWaitsForQuietPeriod) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+
+  debouncer.save(kSensorType, makeParams(1.001f), at(1));
+  EXPECT_EQ(storage.writeCount, 1);
+  EXPECT_EQ(debouncer.getPendingCount(), 1);
+
+  // Each update restarts the quiet period
+  debouncer.save(kSensorType, makeParams(1.002f), at(5));
+  EXPECT_EQ(debouncer.flushDue(at(11)), Nanoseconds(Seconds(4)));
+  EXPECT_EQ(storage.writeCount, 1);
+
+  EXPECT_EQ(debouncer.flushDue(at(15)), Nanoseconds(0));
+  EXPECT_EQ(storage.writeCount, 2);
+  EXPECT_EQ(storage.stored.offset[0], 1.002f);
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+}
+
+TEST(CalParamsDebouncer, SignificantChangeCommitsImmediately) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+
+  debouncer.save(kSensorType, makeParams(1.1f), at(1));
+  EXPECT_EQ(storage.writeCount, 2);
+  EXPECT_EQ(storage.stored.offset[0], 1.1f);
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+}
+
+TEST(CalParamsDebouncer, SourceChangeIsSignificant) {
+  ashCalParams committed = makeParams(1.0f);
+  ashCalParams updated = committed;
+  EXPECT_FALSE(CalParamsDebouncer::isSignificantChange(
+      kSensorType, committed, updated));
+
+  updated.offsetSource = ASH_CAL_PARAMS_SOURCE_FACTORY;
+  EXPECT_TRUE(CalParamsDebouncer::isSignificantChange(
+      kSensorType, committed, updated));
+}
+
+TEST(CalParamsDebouncer, MaxDelayBoundsContinuousUpdates) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+
+  // Updates arrive more often than the quiet period, so only the max delay
+  // (measured from the first uncommitted update at t=1) forces a commit
+  float offset = 1.0f;
+  for (uint64_t t = 1; t < 61; t += 5) {
+    offset += 0.0001f;
+    debouncer.save(kSensorType, makeParams(offset), at(t));
+    debouncer.flushDue(at(t));
+  }
+  EXPECT_EQ(storage.writeCount, 1);
+
+  EXPECT_EQ(debouncer.flushDue(at(61)), Nanoseconds(0));
+  EXPECT_EQ(storage.writeCount, 2);
+  EXPECT_EQ(storage.stored.offset[0], offset);
+}
+
+TEST(CalParamsDebouncer, LoadReturnsPendingParams) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  ashCalParams params;
+  EXPECT_FALSE(debouncer.load(kSensorType, &params));
+
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+  debouncer.save(kSensorType, makeParams(1.001f), at(1));
+  EXPECT_TRUE(debouncer.load(kSensorType, &params));
+  EXPECT_EQ(params.offset[0], 1.001f);
+
+  storage.stored = makeParams(2.0f);
+  storage.hasParams = true;
+  EXPECT_TRUE(debouncer.load(CHRE_SENSOR_TYPE_GYROSCOPE, &params));
+  EXPECT_EQ(params.offset[0], 2.0f);
+}
+
+TEST(CalParamsDebouncer, FailedCommitIsRetried) {
+  FakeStorage storage;
+  storage.writeSucceeds = false;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+
+  EXPECT_TRUE(debouncer.save(kSensorType, makeParams(1.0f), at(0)));
+  EXPECT_EQ(debouncer.getPendingCount(), 1);
+  EXPECT_EQ(debouncer.flushDue(at(0)), kQuietPeriod);
+
+  storage.writeSucceeds = true;
+  EXPECT_EQ(debouncer.flushDue(at(10)), Nanoseconds(0));
+  EXPECT_EQ(storage.writeCount, 1);
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+}
+
+TEST(CalParamsDebouncer, FlushAllCommitsPending) {
+  FakeStorage storage;
+  CalParamsDebouncer debouncer(storage, kQuietPeriod, kMaxDelay);
+  debouncer.save(kSensorType, makeParams(1.0f), at(0));
+  debouncer.save(kSensorType, makeParams(1.001f), at(1));
+
+  debouncer.flushAll();
+  EXPECT_EQ(storage.writeCount, 2);
+  EXPECT_EQ(debouncer.getPendingCount(), 0);
+}
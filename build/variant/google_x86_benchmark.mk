@@ -0,0 +1,33 @@
+#
+# CHRE Microbenchmark Build Variant
+#
+
+include $(CHRE_PREFIX)/build/clean_build_template_args.mk
+
+TARGET_NAME = google_x86_benchmark
+TARGET_CFLAGS = -DCHRE_MESSAGE_TO_HOST_MAX_SIZE=2048
+TARGET_VARIANT_SRCS = $(BENCHMARK_SRCS)
+
+ifneq ($(filter $(TARGET_NAME)% all, $(MAKECMDGOALS)),)
+include $(CHRE_PREFIX)/build/arch/x86.mk
+
+TARGET_CFLAGS += $(BENCHMARK_CFLAGS)
+
+# Benchmark results are only meaningful for optimized code, so override the
+# optimization level supplied by the arch Makefile.
+TARGET_CFLAGS += -O2
+
+# Instruct the build to link a final executable.
+TARGET_BUILD_BIN = true
+
+# Link in libraries for the final executable.
+TARGET_BIN_LDFLAGS += -lrt
+TARGET_BIN_LDFLAGS += -lpthread
+TARGET_BIN_LDFLAGS += -ldl
+
+# Export the CHRE API from the executable so that dynamically loaded nanoapps
+# can resolve it.
+TARGET_BIN_LDFLAGS += -rdynamic
+
+include $(CHRE_PREFIX)/build/build_template.mk
+endif
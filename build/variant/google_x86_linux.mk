@@ -28,6 +28,11 @@ TARGET_BUILD_BIN = true
 
 # Link in libraries for the final executable.
 TARGET_BIN_LDFLAGS += -lrt
+TARGET_BIN_LDFLAGS += -ldl
+
+# Export the CHRE API from the executable so that dynamically loaded nanoapps
+# can resolve it.
+TARGET_BIN_LDFLAGS += -rdynamic
 endif
 
 include $(CHRE_PREFIX)/build/arch/x86.mk
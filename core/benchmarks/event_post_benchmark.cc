@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+
+#include <thread>
+#include <vector>
+
+#include "chre/core/event.h"
+#include "chre/platform/memory.h"
+#include "chre/util/fixed_size_blocking_queue.h"
+#include "chre/util/synchronized_memory_pool.h"
+#include "chre_api/chre/common.h"
+
+using chre::Event;
+using chre::FixedSizeBlockingQueue;
+using chre::MemoryPool;
+using chre::SynchronizedMemoryPool;
+using chre::benchmark::State;
+
+namespace {
+
+//! Matches the sizes of the EventLoop event pool and inbound queue.
+constexpr size_t kMaxEventCount = 256;
+
+//! The number of events each producer posts per iteration.
+constexpr size_t kEventsPerProducer = 5000;
+
+/**
+ * Stresses the locks on the event post path the same way EventLoop does:
+ * getArg() producer threads allocate events from a synchronized pool and push
+ * them into the blocking inbound queue, while a single consumer pops and frees
+ * them. Build with and without CHRE_USE_FUTEX_MUTEX=true to compare the Mutex
+ * implementations under realistic contention.
+ */
+void EventPostStress(State& state) {
+  SynchronizedMemoryPool<Event, kMaxEventCount> eventPool;
+  FixedSizeBlockingQueue<Event *, kMaxEventCount> events;
+
+  while (state.keepRunning()) {
+    size_t producerCount = state.getArg();
+    size_t totalEvents = producerCount * kEventsPerProducer;
+
+    std::thread consumer([&]() {
+      for (size_t i = 0; i < totalEvents; i++) {
+        eventPool.deallocate(events.pop());
+      }
+    });
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producerCount; i++) {
+      producers.emplace_back([&]() {
+        size_t posted = 0;
+        while (posted < kEventsPerProducer) {
+          Event *event = eventPool.allocate(1, nullptr, nullptr);
+          if (event == nullptr) {
+            // The pool is exhausted, give the consumer a chance to catch up
+            std::this_thread::yield();
+          } else if (!events.push(event)) {
+            eventPool.deallocate(event);
+            std::this_thread::yield();
+          } else {
+            posted++;
+          }
+        }
+      });
+    }
+
+    for (std::thread& producer : producers) {
+      producer.join();
+    }
+    consumer.join();
+  }
+}
+
+void freePayloadCallback(uint16_t /* eventType */, void *eventData) {
+  chre::memoryFree(eventData);
+}
+
+/**
+ * Posts and releases getArg() events carrying a chreAsyncResult payload the
+ * way the system did before payloads could be stored in the Event: allocated
+ * separately and released through the free callback.
+ */
+void EventPayloadHeap(State& state) {
+  SynchronizedMemoryPool<Event, kMaxEventCount> eventPool;
+  FixedSizeBlockingQueue<Event *, kMaxEventCount> events;
+
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < state.getArg(); i++) {
+      auto *result = chre::memoryAlloc<chreAsyncResult>();
+      result->success = true;
+      events.push(eventPool.allocate(1, result, freePayloadCallback));
+      Event *event = events.pop();
+      event->freeCallback(event->eventType, event->eventData);
+      eventPool.deallocate(event);
+    }
+  }
+}
+
+/**
+ * As EventPayloadHeap, but with the payload copied into the Event.
+ */
+void EventPayloadInline(State& state) {
+  SynchronizedMemoryPool<Event, kMaxEventCount> eventPool;
+  FixedSizeBlockingQueue<Event *, kMaxEventCount> events;
+
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < state.getArg(); i++) {
+      chreAsyncResult result = {};
+      result.success = true;
+      events.push(eventPool.allocate(1, &result, sizeof(result), nullptr,
+                                     chre::kSystemInstanceId,
+                                     chre::kBroadcastInstanceId));
+      eventPool.deallocate(events.pop());
+    }
+  }
+}
+
+/**
+ * Posts and releases 1024 events in batches of getArg(), taking the pool and
+ * queue locks once per batch as EventLoop::postEvents() does. A batch size of
+ * 1 uses the single-event path, as EventLoop::postEvent() does.
+ */
+void EventPostBatch(State& state) {
+  constexpr size_t kEventsPerIteration = 1024;
+  constexpr size_t kMaxBatchSize = 32;
+  SynchronizedMemoryPool<Event, kMaxEventCount> eventPool;
+  FixedSizeBlockingQueue<Event *, kMaxEventCount> events;
+  Event *batch[kMaxBatchSize];
+
+  auto allocateEvent = [](MemoryPool<Event, kMaxEventCount>& pool,
+                          size_t /* index */) {
+    return pool.allocate(1, nullptr, nullptr);
+  };
+
+  while (state.keepRunning()) {
+    size_t batchSize = state.getArg();
+    for (size_t posted = 0; posted < kEventsPerIteration;
+         posted += batchSize) {
+      if (batchSize == 1) {
+        events.push(eventPool.allocate(1, nullptr, nullptr));
+      } else {
+        eventPool.allocateMultiple(batch, batchSize, allocateEvent);
+        events.pushAll(batch, batchSize);
+      }
+
+      for (size_t i = 0; i < batchSize; i++) {
+        eventPool.deallocate(events.pop());
+      }
+    }
+  }
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK(EventPostStress, 1, 2, 4);
+CHRE_BENCHMARK(EventPostBatch, 1, 8, 32);
+CHRE_BENCHMARK(EventPayloadHeap, 1000);
+CHRE_BENCHMARK(EventPayloadInline, 1000);
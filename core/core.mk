@@ -29,7 +29,15 @@ COMMON_SRCS += core/wwan_request_manager.cc
 
 # GoogleTest Source Files ######################################################
 
+GOOGLETEST_SRCS += core/tests/event_loop_test.cc
+GOOGLETEST_SRCS += core/tests/event_test.cc
 GOOGLETEST_SRCS += core/tests/memory_manager_test.cc
 GOOGLETEST_SRCS += core/tests/request_multiplexer_test.cc
+GOOGLETEST_SRCS += core/tests/sensor_request_manager_test.cc
 GOOGLETEST_SRCS += core/tests/sensor_request_test.cc
+GOOGLETEST_SRCS += core/tests/sensor_test.cc
 GOOGLETEST_SRCS += core/tests/wifi_scan_request_test.cc
+
+# Benchmark Source Files #######################################################
+
+BENCHMARK_SRCS += core/benchmarks/event_post_benchmark.cc
@@ -16,9 +16,12 @@
 
 #include "chre/core/event.h"
 
+#include <cstring>
 
 namespace chre {
 
+constexpr size_t Event::kInlineDataSize;
+
 Event::Event(uint16_t eventType_, void *eventData_,
              chreEventCompleteFunction *freeCallback_,
              uint32_t senderInstanceId_, uint32_t targetInstanceId_)
@@ -26,4 +29,18 @@ Event::Event(uint16_t eventType_, void *eventData_,
       senderInstanceId(senderInstanceId_),
       targetInstanceId(targetInstanceId_) {}
 
+Event::Event(uint16_t eventType_, const void *eventData_,
+             size_t eventDataSize, chreEventCompleteFunction *freeCallback_,
+             uint32_t senderInstanceId_, uint32_t targetInstanceId_)
+    : eventType(eventType_), eventData(&mInlineData),
+      freeCallback(freeCallback_),
+      senderInstanceId(senderInstanceId_),
+      targetInstanceId(targetInstanceId_) {
+  CHRE_ASSERT(eventDataSize <= kInlineDataSize);
+  if (eventDataSize > kInlineDataSize) {
+    eventDataSize = kInlineDataSize;
+  }
+  memcpy(&mInlineData, eventData_, eventDataSize);
+}
+
 }  // namespace chre
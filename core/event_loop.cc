@@ -55,6 +55,8 @@ bool populateNanoappInfo(const Nanoapp *app, struct chreNanoappInfo *info) {
 
 }  // anonymous namespace
 
+constexpr size_t EventLoop::kMaxEventBatchSize;
+
 EventLoop::EventLoop()
     : mTimerPool(*this) {}
 
@@ -101,7 +103,7 @@ void EventLoop::run() {
   LOGI("EventLoop start");
 
   bool havePendingEvents = false;
-  while (mRunning) {
+  while (mRunning.load(MemoryOrder::Acquire)) {
     // Events are delivered in two stages: first they arrive in the inbound
     // event queue mEvents (potentially posted from another thread), then within
     // this context these events are distributed to smaller event queues
@@ -243,13 +245,47 @@ bool EventLoop::postEvent(uint16_t eventType, void *eventData,
     uint32_t targetInstanceId) {
   bool success = false;
 
-  if (mRunning) {
-    Event *event = mEventPool.allocate(eventType, eventData, freeCallback,
-        senderInstanceId, targetInstanceId);
-    if (event != nullptr) {
-      success = mEvents.push(event);
+  if (mRunning.load(MemoryOrder::Acquire)) {
+    success = enqueueEvent(mEventPool.allocate(
+        eventType, eventData, freeCallback, senderInstanceId,
+        targetInstanceId));
+  }
+
+  return success;
+}
+
+bool EventLoop::postEvents(const chreEventBatchEntry *events,
+                           size_t eventCount, uint32_t senderInstanceId,
+                           uint32_t targetInstanceId) {
+  bool success = false;
+
+  if (eventCount > kMaxEventBatchSize) {
+    LOGE("Event batch of %zu exceeds max %zu", eventCount, kMaxEventBatchSize);
+  } else if (mRunning.load(MemoryOrder::Acquire)) {
+    Event *batch[kMaxEventBatchSize];
+    auto allocateEvent = [&](MemoryPool<Event, kMaxEventCount>& pool,
+                             size_t i) {
+      return pool.allocate(events[i].eventType, events[i].eventData,
+                           events[i].freeCallback, senderInstanceId,
+                           targetInstanceId);
+    };
+
+    if (!mEventPool.allocateMultiple(batch, eventCount, allocateEvent)) {
+      LOGE("Failed to allocate batch of %zu events", eventCount);
+    } else if (!mEvents.pushAll(batch, eventCount)) {
+      LOGE("Inbound event queue can't hold batch of %zu events", eventCount);
+      mEventPool.deallocateMultiple(batch, eventCount);
+    } else {
+      success = true;
+    }
+
+    // Statistics only, so no ordering with respect to the events is needed
+    if (success) {
+      mPostedEventCount.fetchAdd(static_cast<uint32_t>(eventCount),
+                                 MemoryOrder::Relaxed);
     } else {
-      LOGE("Failed to allocate event");
+      mFailedEventPostCount.fetchAdd(static_cast<uint32_t>(eventCount),
+                                     MemoryOrder::Relaxed);
     }
   }
 
@@ -259,7 +295,7 @@ bool EventLoop::postEvent(uint16_t eventType, void *eventData,
 void EventLoop::stop() {
   postEvent(0, nullptr, nullptr, kSystemInstanceId, kSystemInstanceId);
   // Stop accepting new events and tell the main loop to finish
-  mRunning = false;
+  mRunning.store(false, MemoryOrder::Release);
 }
 
 Nanoapp *EventLoop::findNanoappByInstanceId(uint32_t instanceId) const {
@@ -282,18 +318,61 @@ bool EventLoop::populateNanoappInfoForInstanceId(
 }
 
 bool EventLoop::currentNanoappIsStopping() const {
-  return (mCurrentApp == mStoppingNanoapp || !mRunning);
+  return (mCurrentApp == mStoppingNanoapp
+          || !mRunning.load(MemoryOrder::Acquire));
 }
 
 bool EventLoop::logStateToBuffer(char *buffer, size_t *bufferPos,
                                  size_t bufferSize) const {
-  bool success = debugDumpPrint(buffer, bufferPos, bufferSize, "\nNanoapps:\n");
+  bool success = debugDumpPrint(
+      buffer, bufferPos, bufferSize,
+      "\nEvent loop: %" PRIu32 " events posted, %" PRIu32 " failed\n",
+      mPostedEventCount.load(MemoryOrder::Relaxed),
+      mFailedEventPostCount.load(MemoryOrder::Relaxed));
+  success &= debugDumpPrint(buffer, bufferPos, bufferSize, "\nNanoapps:\n");
   for (const UniquePtr<Nanoapp>& app : mNanoapps) {
     success &= app->logStateToBuffer(buffer, bufferPos, bufferSize);
   }
   return success;
 }
 
+bool EventLoop::postInlineEventData(
+    uint16_t eventType, const void *eventData, size_t eventDataSize,
+    chreEventCompleteFunction *freeCallback, uint32_t senderInstanceId,
+    uint32_t targetInstanceId) {
+  bool success = false;
+
+  if (mRunning.load(MemoryOrder::Acquire)) {
+    success = enqueueEvent(mEventPool.allocate(
+        eventType, eventData, eventDataSize, freeCallback, senderInstanceId,
+        targetInstanceId));
+  }
+
+  return success;
+}
+
+bool EventLoop::enqueueEvent(Event *event) {
+  bool success = false;
+
+  if (event == nullptr) {
+    LOGE("Failed to allocate event");
+  } else if (!mEvents.push(event)) {
+    LOGE("Inbound event queue full");
+    mEventPool.deallocate(event);
+  } else {
+    success = true;
+  }
+
+  // Statistics only, so no ordering with respect to the event is needed
+  if (success) {
+    mPostedEventCount.fetchAdd(1, MemoryOrder::Relaxed);
+  } else {
+    mFailedEventPostCount.fetchAdd(1, MemoryOrder::Relaxed);
+  }
+
+  return success;
+}
+
 bool EventLoop::deliverEvents() {
   bool havePendingEvents = false;
 
@@ -388,19 +467,18 @@ Nanoapp *EventLoop::lookupAppByInstanceId(uint32_t instanceId) const {
 
 void EventLoop::notifyAppStatusChange(uint16_t eventType,
                                       const Nanoapp& nanoapp) {
-  auto *info = memoryAlloc<chreNanoappInfo>();
-  if (info == nullptr) {
-    LOGE("Couldn't alloc app status change event");
-  } else {
-    info->appId      = nanoapp.getAppId();
-    info->version    = nanoapp.getAppVersion();
-    info->instanceId = nanoapp.getInstanceId();
+  chreNanoappInfo info;
+  info.appId      = nanoapp.getAppId();
+  info.version    = nanoapp.getAppVersion();
+  info.instanceId = nanoapp.getInstanceId();
 
-    if (!postEvent(eventType, info, freeEventDataCallback)) {
-      LOGE("Couldn't post app status change event");
-      memoryFree(info);
-    }
+  if (!postInlineEvent(eventType, info, nullptr /* freeCallback */)) {
+    LOGE("Couldn't post app status change event");
   }
+
+  EventLoopManagerSingleton::get()->getHostCommsManager()
+      .sendNanoappStatusChange(nanoapp,
+                               (eventType == CHRE_EVENT_NANOAPP_STARTED));
 }
 
 void EventLoop::unloadNanoappAtIndex(size_t index) {
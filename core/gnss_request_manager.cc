@@ -62,26 +62,21 @@ void GnssRequestManager::handleLocationSessionStatusChange(bool enabled,
     uint8_t errorCode;
   };
 
-  auto *cbState = memoryAlloc<CallbackState>();
-  if (cbState == nullptr) {
-    LOGE("Failed to allocate callback state for location session state change");
-  } else {
-    cbState->enabled = enabled;
-    cbState->errorCode = errorCode;
-
-    auto callback = [](uint16_t /* eventType */, void *eventData) {
-      auto *state = static_cast<CallbackState *>(eventData);
-      EventLoopManagerSingleton::get()->getGnssRequestManager()
-          .handleLocationSessionStatusChangeSync(state->enabled,
-                                                 state->errorCode);
-      memoryFree(state);
-    };
-
-    bool callbackDeferred = EventLoopManagerSingleton::get()->deferCallback(
-        SystemCallbackType::GnssLocationSessionStatusChange, cbState, callback);
-    if (!callbackDeferred) {
-      memoryFree(cbState);
-    }
+  CallbackState cbState;
+  cbState.enabled = enabled;
+  cbState.errorCode = errorCode;
+
+  auto callback = [](uint16_t /* eventType */, void *eventData) {
+    auto *state = static_cast<CallbackState *>(eventData);
+    EventLoopManagerSingleton::get()->getGnssRequestManager()
+        .handleLocationSessionStatusChangeSync(state->enabled,
+                                               state->errorCode);
+  };
+
+  if (!EventLoopManagerSingleton::get()->deferCallbackWithInlineData(
+          SystemCallbackType::GnssLocationSessionStatusChange, cbState,
+          callback)) {
+    LOGE("Failed to defer location session state change");
   }
 }
 
@@ -308,29 +303,21 @@ bool GnssRequestManager::postLocationSessionAsyncResultEvent(
   bool eventPosted = false;
   if (!success || updateLocationSessionRequests(enable, minInterval,
                                                 instanceId)) {
-    chreAsyncResult *event = memoryAlloc<chreAsyncResult>();
-    if (event == nullptr) {
-      LOGE("Failed to allocate location session async result event");
+    chreAsyncResult event;
+    if (enable) {
+      event.requestType = CHRE_GNSS_REQUEST_TYPE_LOCATION_SESSION_START;
     } else {
-      if (enable) {
-        event->requestType = CHRE_GNSS_REQUEST_TYPE_LOCATION_SESSION_START;
-      } else {
-        event->requestType = CHRE_GNSS_REQUEST_TYPE_LOCATION_SESSION_STOP;
-      }
-
-      event->success = success;
-      event->errorCode = errorCode;
-      event->reserved = 0;
-      event->cookie = cookie;
+      event.requestType = CHRE_GNSS_REQUEST_TYPE_LOCATION_SESSION_STOP;
+    }
 
-      eventPosted = EventLoopManagerSingleton::get()->getEventLoop()
-          .postEvent(CHRE_EVENT_GNSS_ASYNC_RESULT, event, freeEventDataCallback,
-                     kSystemInstanceId, instanceId);
+    event.success = success;
+    event.errorCode = errorCode;
+    event.reserved = 0;
+    event.cookie = cookie;
 
-      if (!eventPosted) {
-        memoryFree(event);
-      }
-    }
+    eventPosted = EventLoopManagerSingleton::get()->getEventLoop()
+        .postInlineEvent(CHRE_EVENT_GNSS_ASYNC_RESULT, event, nullptr,
+                         kSystemInstanceId, instanceId);
   }
 
   return eventPosted;
@@ -30,6 +30,13 @@ void HostCommsManager::flushMessagesSentByNanoapp(uint64_t appId) {
   mHostLink.flushMessagesSentByNanoapp(appId);
 }
 
+void HostCommsManager::sendNanoappStatusChange(const Nanoapp& nanoapp,
+                                               bool started) {
+  mHostLink.sendNanoappStatusChange(nanoapp.getAppId(),
+                                    nanoapp.getAppVersion(),
+                                    nanoapp.getInstanceId(), started);
+}
+
 bool HostCommsManager::sendMessageToHostFromNanoapp(
     Nanoapp *nanoapp, void *messageData, size_t messageSize,
     uint32_t messageType, uint16_t hostEndpoint,
@@ -21,7 +21,18 @@
 #include "chre/platform/assert.h"
 #include "chre/util/non_copyable.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+
+//! The size, in bytes, of the payload area inside each Event. Payloads up to
+//! this size can be copied into the Event when posted rather than being
+//! allocated separately. The default fits the chreAsyncResult and
+//! chreNanoappInfo payloads posted by the system; each byte added here is
+//! multiplied by the size of the event pool.
+#ifndef CHRE_EVENT_INLINE_DATA_SIZE
+#define CHRE_EVENT_INLINE_DATA_SIZE 16
+#endif  // CHRE_EVENT_INLINE_DATA_SIZE
 
 namespace chre {
 
@@ -38,11 +49,27 @@ constexpr uint32_t kInvalidInstanceId = kBroadcastInstanceId;
 
 class Event : public NonCopyable {
  public:
+  //! The maximum size of a payload stored inside the Event
+  static constexpr size_t kInlineDataSize = CHRE_EVENT_INLINE_DATA_SIZE;
+
   Event(uint16_t eventType, void *eventData,
         chreEventCompleteFunction *freeCallback,
         uint32_t senderInstanceId = kSystemInstanceId,
         uint32_t targetInstanceId = kBroadcastInstanceId);
 
+  /**
+   * Constructs an Event whose eventData points to a copy of the given payload
+   * stored inside the Event itself. The copy is released along with the Event,
+   * so the free callback, if any, must not free it.
+   *
+   * @param eventData The payload to copy
+   * @param eventDataSize The size of the payload, which must be no larger than
+   *        kInlineDataSize
+   */
+  Event(uint16_t eventType, const void *eventData, size_t eventDataSize,
+        chreEventCompleteFunction *freeCallback, uint32_t senderInstanceId,
+        uint32_t targetInstanceId);
+
   void incrementRefCount() {
     mRefCount++;
     CHRE_ASSERT(mRefCount != 0);
@@ -64,7 +91,12 @@ class Event : public NonCopyable {
   const uint32_t targetInstanceId;
 
  private:
+  static_assert(kInlineDataSize > 0, "Inline event data size must be nonzero");
+
   size_t mRefCount = 0;
+
+  //! Holds the payload when constructed with one to copy
+  typename std::aligned_storage<kInlineDataSize>::type mInlineData;
 };
 
 }
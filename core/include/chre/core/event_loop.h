@@ -20,8 +20,10 @@
 #include "chre/core/event.h"
 #include "chre/core/nanoapp.h"
 #include "chre/core/timer_pool.h"
+#include "chre/platform/atomic.h"
 #include "chre/platform/mutex.h"
 #include "chre/platform/platform_nanoapp.h"
+#include "chre/platform/shared/event_batch.h"
 #include "chre/util/dynamic_vector.h"
 #include "chre/util/fixed_size_blocking_queue.h"
 #include "chre/util/non_copyable.h"
@@ -129,6 +131,14 @@ class EventLoop : public NonCopyable {
    */
   void stop();
 
+  /**
+   * @return true if the event loop has not been asked to stop, and so will
+   *         accept and deliver new events. This function is thread-safe.
+   */
+  bool isRunning() const {
+    return mRunning.load(MemoryOrder::Acquire);
+  }
+
   /**
    * Posts an event to a nanoapp that is currently running (or all nanoapps if
    * the target instance ID is kBroadcastInstanceId).
@@ -153,6 +163,68 @@ class EventLoop : public NonCopyable {
                  uint32_t senderInstanceId = kSystemInstanceId,
                  uint32_t targetInstanceId = kBroadcastInstanceId);
 
+  /**
+   * Posts a batch of events to a nanoapp that is currently running (or all
+   * nanoapps if the target instance ID is kBroadcastInstanceId). Either all of
+   * the events are added to the queue, in order and without any other events
+   * between them, or none are. The event pool and the queue are each locked
+   * once for the whole batch.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @param events The events to post.
+   * @param eventCount The number of events to post, which must be no greater
+   *        than kMaxEventBatchSize.
+   * @param senderInstanceId The instance ID of the sender of these events.
+   * @param targetInstanceId The instance ID of the destination of these
+   *        events.
+   *
+   * @return true if the events were added to the queue. As with postEvent(),
+   *         the free callbacks are *not* invoked if posting failed.
+   *
+   * @see chreSendEvents
+   */
+  bool postEvents(const chreEventBatchEntry *events, size_t eventCount,
+                  uint32_t senderInstanceId = kSystemInstanceId,
+                  uint32_t targetInstanceId = kBroadcastInstanceId);
+
+  //! The maximum number of events that can be posted by one call to
+  //! postEvents().
+  static constexpr size_t kMaxEventBatchSize = CHRE_SEND_EVENTS_MAX_COUNT;
+
+  /**
+   * Posts an event whose data is copied into the Event itself, so it needn't
+   * be allocated and freed separately. Recipients may only access the data
+   * while handling the event, as with any other event.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @param eventType The type of data being posted.
+   * @param eventData The data to copy into the event. Must be no larger than
+   *        Event::kInlineDataSize.
+   * @param freeCallback The callback to invoke with the event's copy of the
+   *        data when the event is no longer needed, or nullptr. The copy must
+   *        not be freed by the callback.
+   * @param senderInstanceId The instance ID of the sender of this event.
+   * @param targetInstanceId The instance ID of the destination of this event.
+   *
+   * @return true if the event was successfully added to the queue
+   *
+   * @see postEvent
+   */
+  template<typename EventDataType>
+  bool postInlineEvent(uint16_t eventType, const EventDataType& eventData,
+                       chreEventCompleteFunction *freeCallback,
+                       uint32_t senderInstanceId = kSystemInstanceId,
+                       uint32_t targetInstanceId = kBroadcastInstanceId) {
+    static_assert(sizeof(EventDataType) <= Event::kInlineDataSize,
+                  "Event data is too large to be stored in the Event; "
+                  "allocate it or raise CHRE_EVENT_INLINE_DATA_SIZE");
+    return postInlineEventData(eventType, &eventData, sizeof(eventData),
+                               freeCallback, senderInstanceId,
+                               targetInstanceId);
+  }
+
   /**
    * Returns a pointer to the currently executing Nanoapp, or nullptr if none is
    * currently executing. Must only be called from within the thread context
@@ -260,8 +332,17 @@ class EventLoop : public NonCopyable {
   //! distributed out to apps yet.
   FixedSizeBlockingQueue<Event *, kMaxUnscheduledEventCount> mEvents;
 
-  // TODO: should probably be atomic to be fully correct
-  volatile bool mRunning = true;
+  //! Cleared by stop() (from any thread) to make run() exit and to stop
+  //! accepting new events.
+  AtomicBool mRunning{true};
+
+  //! The number of events successfully posted to the inbound queue. Updated
+  //! from any thread that posts events.
+  AtomicUint32 mPostedEventCount;
+
+  //! The number of events that could not be posted because the event pool or
+  //! inbound queue was exhausted.
+  AtomicUint32 mFailedEventPostCount;
 
   //! The nanoapp that is currently executing - must be set any time we call
   //! into the nanoapp's entry points or callbacks
@@ -278,6 +359,26 @@ class EventLoop : public NonCopyable {
    */
   bool deliverEvents();
 
+  /**
+   * Implements postInlineEvent() once the size of the data has been checked.
+   */
+  bool postInlineEventData(uint16_t eventType, const void *eventData,
+                           size_t eventDataSize,
+                           chreEventCompleteFunction *freeCallback,
+                           uint32_t senderInstanceId,
+                           uint32_t targetInstanceId);
+
+  /**
+   * Adds an event allocated from mEventPool to the inbound queue, or releases
+   * it (without invoking its free callback) if the queue is full, and updates
+   * the post statistics.
+   *
+   * @param event The event to enqueue, or nullptr if allocation failed
+   *
+   * @return true if the event was added to the queue
+   */
+  bool enqueueEvent(Event *event);
+
   /**
    * Delivers the next event pending in the Nanoapp's queue, and takes care of
    * freeing events once they have been delivered to all nanoapps. Must only be
@@ -50,6 +50,8 @@ enum class SystemCallbackType : uint16_t {
   GnssLocationSessionStatusChange,
   SensorStatusUpdate,
   PerformDebugDump,
+  AshCalParamsFlush,
+  SensorConfigResult,
 };
 
 //! The function signature of a system callback mirrors the CHRE event free
@@ -113,6 +115,28 @@ class EventLoopManager : public NonCopyable {
   bool deferCallback(SystemCallbackType type, void *data,
                      SystemCallbackFunction *callback);
 
+  /**
+   * Like deferCallback(), but passes the callback a pointer to a copy of the
+   * given data stored inside the event, so small callback state needn't be
+   * allocated and freed. The callback must not free the data.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @param type An identifier for the callback, which is passed through to the
+   *        callback as a uint16_t, and can also be useful for debugging
+   * @param data Data to copy for the callback; no larger than
+   *        Event::kInlineDataSize
+   * @param callback Function to invoke from within the main CHRE thread
+   */
+  template<typename DataType>
+  bool deferCallbackWithInlineData(SystemCallbackType type,
+                                   const DataType& data,
+                                   SystemCallbackFunction *callback) {
+    return mEventLoop.postInlineEvent(static_cast<uint16_t>(type), data,
+                                      callback, kSystemInstanceId,
+                                      kSystemInstanceId);
+  }
+
   /**
    * Returns a guaranteed unique instance identifier to associate with a newly
    * constructed nanoapp.
@@ -140,6 +140,14 @@ class HostCommsManager : public NonCopyable {
    */
   void onMessageToHostComplete(const MessageToHost *msgToHost);
 
+  /**
+   * Informs the host that a nanoapp started or stopped. Must be called from
+   * the context of the CHRE thread.
+   *
+   * @see HostLink::sendNanoappStatusChange
+   */
+  void sendNanoappStatusChange(const Nanoapp& nanoapp, bool started);
+
  private:
   //! The maximum number of messages we can have outstanding at any given time
   static constexpr size_t kMaxOutstandingMessages = 32;
@@ -20,6 +20,7 @@
 #include "chre/platform/platform_sensor.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/optional.h"
+#include "chre/util/time.h"
 
 namespace chre {
 
@@ -59,18 +60,119 @@ class Sensor : public PlatformSensor {
 
   /**
    * Sets the current request of this sensor. If this request is a change from
-   * the previous request, it is sent to the underlying platform. If isValid()
-   * returns false this function will also return false and do nothing.
+   * the previous request, it is submitted to the underlying platform without
+   * waiting for it to be applied; getRequest() is updated once the platform
+   * reports completion through handleConfigComplete(). While a configuration
+   * is in flight, further requests are collapsed so that only the most recent
+   * one is submitted when it completes. Once the event loop is stopping, the
+   * request is applied synchronously via setRequestSync() instead.
+   *
+   * @param request The new request for this sensor.
+   * @return true if there was no change required or the request has been
+   *         submitted or queued successfully.
+   */
+  bool setRequest(const SensorRequest& request);
+
+  /**
+   * Sets the current request of this sensor, blocking until the platform has
+   * applied it. Any queued request is discarded, and the result of any
+   * in-flight request is ignored when it arrives. This is only intended for
+   * use when the event loop is not running to deliver completions, e.g. at
+   * shutdown.
    *
    * @param request The new request for this sensor.
    * @return true if there was no change required or the platform has set the
    *         request successfully.
    */
-  bool setRequest(const SensorRequest& request);
+  bool setRequestSync(const SensorRequest& request);
+
+  /**
+   * Handles the completion of the request most recently submitted to the
+   * platform, and submits the next queued request, if any. Must only be called
+   * from the context of the main CHRE thread.
+   *
+   * @param success Whether the platform applied the request.
+   */
+  void handleConfigComplete(bool success);
+
+  /**
+   * @return true if a request has been submitted to the platform and has not
+   *         yet completed.
+   */
+  bool isConfigInFlight() const {
+    return mConfigInFlight;
+  }
+
+  /**
+   * @return true if a request is waiting to be submitted once the in-flight
+   *         request completes.
+   */
+  bool hasQueuedRequest() const {
+    return mHasQueuedRequest;
+  }
+
+  /**
+   * @return The ID of the request most recently submitted to the platform.
+   *         IDs start at 1 and increase by one with each submission, so a
+   *         queued request will be submitted with the next ID.
+   */
+  uint32_t getLastSubmissionId() const {
+    return mLastSubmissionId;
+  }
+
+  /**
+   * Statistics on the time taken by the platform to apply requests.
+   */
+  struct ConfigLatencyStats {
+    //! The number of requests completed, and how many of those failed.
+    uint32_t completedCount = 0;
+    uint32_t failedCount = 0;
+
+    //! The number of requests that were superseded while queued, and so never
+    //! submitted to the platform.
+    uint32_t collapsedCount = 0;
+
+    Nanoseconds lastLatency;
+    Nanoseconds maxLatency;
+    Nanoseconds totalLatency;
+  };
+
+  /**
+   * @return Configuration latency statistics for this sensor.
+   */
+  const ConfigLatencyStats& getConfigLatencyStats() const {
+    return mConfigLatencyStats;
+  }
 
  private:
   //! The most recent sensor request accepted by the platform.
   SensorRequest mSensorRequest;
+
+  //! The request submitted to the platform that has yet to complete. Only
+  //! valid if mConfigInFlight is true.
+  SensorRequest mInFlightRequest;
+
+  //! The most recent request made while another was in flight. Only valid if
+  //! mHasQueuedRequest is true.
+  SensorRequest mQueuedRequest;
+  bool mHasQueuedRequest = false;
+
+  //! Whether mInFlightRequest is awaiting completion, and the time at which it
+  //! was submitted.
+  bool mConfigInFlight = false;
+  Nanoseconds mConfigStartTime;
+
+  //! @see getLastSubmissionId()
+  uint32_t mLastSubmissionId = 0;
+
+  ConfigLatencyStats mConfigLatencyStats;
+
+  /**
+   * Submits a request to the platform.
+   *
+   * @return true if the platform accepted the request for processing.
+   */
+  bool submitRequest(const SensorRequest& request);
 };
 
 }  // namespace chre
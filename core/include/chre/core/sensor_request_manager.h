@@ -20,6 +20,7 @@
 #include "chre/core/request_multiplexer.h"
 #include "chre/core/sensor.h"
 #include "chre/core/sensor_request.h"
+#include "chre/util/dynamic_vector.h"
 #include "chre/util/fixed_size_vector.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/optional.h"
@@ -61,12 +62,24 @@ class SensorRequestManager : public NonCopyable {
    *        directed at.
    * @param request The new sensor request for this nanoapp.
    * @return true if the request was set successfully. If the sensorHandle is
-   *         out of range or the platform sensor fails to update to the new
-   *         request false will be returned.
+   *         out of range or the platform sensor rejects the new request false
+   *         will be returned. The platform applies the request asynchronously,
+   *         so a later failure is only logged and leaves the sensor with its
+   *         previous configuration.
    */
   bool setSensorRequest(Nanoapp *nanoapp, uint32_t sensorHandle,
                         const SensorRequest& sensorRequest);
 
+  /**
+   * Handles the completion of a sensor request submitted to the platform via
+   * PlatformSensor::applyRequestAsync(). Must only be called from the context
+   * of the main CHRE thread.
+   *
+   * @param sensorType The type of the sensor that was configured.
+   * @param success Whether the platform applied the request.
+   */
+  void handleSensorConfigResult(SensorType sensorType, bool success);
+
   /**
    * Populates the supplied info struct if the sensor handle exists.
    *
@@ -142,6 +155,27 @@ class SensorRequestManager : public NonCopyable {
     //! The request multiplexer for this sensor.
     RequestMultiplexer<SensorRequest> multiplexer;
 
+    /**
+     * A change made to the multiplexer on behalf of a nanoapp whose resulting
+     * sensor configuration has not completed yet.
+     */
+    struct PendingChange {
+      Nanoapp *nanoapp;
+
+      //! The nanoapp's request before the change. Only valid if
+      //! hasPreviousRequest is true, otherwise the change added the request.
+      SensorRequest previousRequest;
+      bool hasPreviousRequest;
+
+      //! The ID of the sensor submission that applies this change.
+      //! @see Sensor::getLastSubmissionId()
+      uint32_t submissionId;
+    };
+
+    //! The changes that the sensor has not applied yet, oldest first, so that
+    //! they can be rolled back if the platform rejects the configuration.
+    DynamicVector<PendingChange> pendingChanges;
+
     /**
      * Searches through the list of sensor requests for a request owned by the
      * given nanoapp. The provided non-null index pointer is populated with the
@@ -200,6 +234,35 @@ class SensorRequestManager : public NonCopyable {
      *         configuration successfully updated.
      */
     bool removeAll();
+
+    /**
+     * Handles the completion of a configuration of this sensor. If it
+     * succeeded, the pending changes it covered are discarded. Once no more
+     * configurations are in flight, any pending changes that the platform did
+     * not apply are rolled back so that the multiplexer matches the sensor.
+     *
+     * @param success Whether the platform applied the configuration.
+     * @param submissionId The ID of the completed submission.
+     */
+    void handleConfigComplete(bool success, uint32_t submissionId);
+
+   private:
+    /**
+     * Records a change to the multiplexer that has been submitted to the
+     * sensor, or discards all pending changes if the sensor has already
+     * applied it.
+     *
+     * @param nanoapp The nanoapp whose request was changed.
+     * @param previousRequest The nanoapp's request before the change, or
+     *        nullptr if the request was added.
+     */
+    void trackChange(Nanoapp *nanoapp, const SensorRequest *previousRequest);
+
+    /**
+     * Undoes the pending changes, newest first, and configures the sensor
+     * with the resulting maximal request if it differs from the sensor's.
+     */
+    void rollBackPendingChanges();
   };
 
   //! The list of sensor requests
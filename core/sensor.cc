@@ -16,20 +16,98 @@
 
 #include "chre/core/sensor.h"
 
+#include "chre/core/event_loop_manager.h"
+#include "chre/platform/log.h"
+#include "chre/platform/system_time.h"
+
 namespace chre {
 
 bool Sensor::setRequest(const SensorRequest& request) {
+  bool success = true;
+
+  if (!EventLoopManagerSingleton::get()->getEventLoop().isRunning()) {
+    // Completions can't be delivered once the event loop is stopping, e.g.
+    // when nanoapps release their sensors from nanoappEnd at shutdown.
+    success = setRequestSync(request);
+  } else if (mConfigInFlight) {
+    // Only the most recent request matters once the platform is free, so
+    // replace any request that has been waiting behind the in-flight one.
+    if (mHasQueuedRequest) {
+      mConfigLatencyStats.collapsedCount++;
+    }
+    mQueuedRequest = request;
+    mHasQueuedRequest = true;
+  } else if (!request.isEquivalentTo(mSensorRequest)) {
+    success = submitRequest(request);
+  }
+
+  return success;
+}
+
+bool Sensor::setRequestSync(const SensorRequest& request) {
   bool success = false;
 
-  if (request.isEquivalentTo(mSensorRequest)) {
-    success = true;
-  } else if (applyRequest(request)) {
-    // Update mSensorRequest only if platform has accepted the request.
-    mSensorRequest = request;
+  mHasQueuedRequest = false;
+  if (!mConfigInFlight && request.isEquivalentTo(mSensorRequest)) {
     success = true;
+  } else {
+    // Any result still to arrive for an in-flight request is now stale, and
+    // is ignored by handleConfigComplete().
+    mConfigInFlight = false;
+    if (applyRequest(request)) {
+      // Update mSensorRequest only if platform has accepted the request.
+      mSensorRequest = request;
+      success = true;
+    }
   }
 
   return success;
 }
 
+void Sensor::handleConfigComplete(bool success) {
+  if (!mConfigInFlight) {
+    LOGW("Ignoring config completion for sensor %s with none in flight",
+         getSensorTypeName(getSensorType()));
+  } else {
+    mConfigInFlight = false;
+
+    Nanoseconds latency = SystemTime::getMonotonicTime() - mConfigStartTime;
+    ConfigLatencyStats& stats = mConfigLatencyStats;
+    stats.completedCount++;
+    stats.lastLatency = latency;
+    stats.totalLatency = stats.totalLatency + latency;
+    if (latency > stats.maxLatency) {
+      stats.maxLatency = latency;
+    }
+
+    if (success) {
+      // Update mSensorRequest only if platform has accepted the request.
+      mSensorRequest = mInFlightRequest;
+    } else {
+      // The platform is expected to maintain the existing request on failure
+      stats.failedCount++;
+      LOGE("Failed to configure sensor %s after %" PRIu64 " us",
+           getSensorTypeName(getSensorType()),
+           Microseconds(latency).getMicroseconds());
+    }
+
+    if (mHasQueuedRequest) {
+      mHasQueuedRequest = false;
+      if (!mQueuedRequest.isEquivalentTo(mSensorRequest)
+          && !submitRequest(mQueuedRequest)) {
+        LOGE("Failed to submit queued request for sensor %s",
+             getSensorTypeName(getSensorType()));
+      }
+    }
+  }
+}
+
+bool Sensor::submitRequest(const SensorRequest& request) {
+  mLastSubmissionId++;
+  mInFlightRequest = request;
+  mConfigStartTime = SystemTime::getMonotonicTime();
+  mConfigInFlight = applyRequestAsync(request);
+  return mConfigInFlight;
+}
+
 }  // namespace chre
@@ -78,7 +78,7 @@ SensorRequestManager::~SensorRequestManager() {
   for (size_t i = 0; i < mSensorRequests.size(); i++) {
     // Disable sensors that have been enabled previously.
     if (mSensorRequests[i].sensor.has_value()) {
-      mSensorRequests[i].sensor->setRequest(nullRequest);
+      mSensorRequests[i].sensor->setRequestSync(nullRequest);
     }
   }
 }
@@ -178,6 +178,22 @@ bool SensorRequestManager::setSensorRequest(Nanoapp *nanoapp,
   return success;
 }
 
+void SensorRequestManager::handleSensorConfigResult(SensorType sensorType,
+                                                    bool success) {
+  Sensor *sensor = getSensor(sensorType);
+  if (sensor == nullptr) {
+    LOGE("Config result for unsupported sensor type %d",
+         static_cast<int>(sensorType));
+  } else {
+    // The completion is for the most recent submission, and completing it may
+    // submit the next one
+    uint32_t submissionId = sensor->getLastSubmissionId();
+    sensor->handleConfigComplete(success);
+    mSensorRequests[getSensorTypeArrayIndex(sensorType)]
+        .handleConfigComplete(success, submissionId);
+  }
+}
+
 bool SensorRequestManager::getSensorInfo(uint32_t sensorHandle,
                                          const Nanoapp& nanoapp,
                                          struct chreSensorInfo *info) const {
@@ -303,6 +319,31 @@ bool SensorRequestManager::logStateToBuffer(char *buffer, size_t *bufferPos,
     }
   }
 
+  success &= debugDumpPrint(buffer, bufferPos, bufferSize,
+                            "\nSensor config latency:\n");
+  for (const SensorRequests& requests : mSensorRequests) {
+    if (requests.sensor.has_value()) {
+      const Sensor& sensor = requests.sensor.value();
+      const Sensor::ConfigLatencyStats& stats = sensor.getConfigLatencyStats();
+      if (stats.completedCount > 0) {
+        uint64_t avgLatencyUs = Microseconds(stats.totalLatency)
+            .getMicroseconds() / stats.completedCount;
+        success &= debugDumpPrint(buffer, bufferPos, bufferSize,
+                                  " %s: count=%" PRIu32 " failed=%" PRIu32
+                                  " collapsed=%" PRIu32 " last(us)=%" PRIu64
+                                  " avg(us)=%" PRIu64 " max(us)=%" PRIu64 "\n",
+                                  getSensorTypeName(sensor.getSensorType()),
+                                  stats.completedCount, stats.failedCount,
+                                  stats.collapsedCount,
+                                  Microseconds(stats.lastLatency)
+                                      .getMicroseconds(),
+                                  avgLatencyUs,
+                                  Microseconds(stats.maxLatency)
+                                      .getMicroseconds());
+      }
+    }
+  }
+
   return success;
 }
 
@@ -344,6 +385,8 @@ bool SensorRequestManager::SensorRequests::add(const SensorRequest& request,
       // This is a roll-back operation so the maximal change in the multiplexer
       // must not have changed. The request changed state is forced to false.
       *requestChanged = false;
+    } else {
+      trackChange(request.getNanoapp(), nullptr);
     }
   }
 
@@ -355,6 +398,14 @@ bool SensorRequestManager::SensorRequests::remove(size_t removeIndex,
   CHRE_ASSERT(requestChanged != nullptr);
   CHRE_ASSERT(sensor.has_value());
 
+  // A removed request is never restored, so drop any changes to roll back
+  Nanoapp *nanoapp = multiplexer.getRequests()[removeIndex].getNanoapp();
+  for (size_t i = pendingChanges.size(); i > 0; i--) {
+    if (pendingChanges[i - 1].nanoapp == nanoapp) {
+      pendingChanges.erase(i - 1);
+    }
+  }
+
   bool success = true;
   multiplexer.removeRequest(removeIndex, requestChanged);
   if (*requestChanged) {
@@ -398,6 +449,8 @@ bool SensorRequestManager::SensorRequests::update(size_t updateIndex,
       // This is a roll-back operation so the maximal change in the multiplexer
       // must not have changed. The request changed state is forced to false.
       *requestChanged = false;
+    } else {
+      trackChange(previousRequest.getNanoapp(), &previousRequest);
     }
   }
 
@@ -409,6 +462,7 @@ bool SensorRequestManager::SensorRequests::removeAll() {
 
   bool requestChanged;
   multiplexer.removeAllRequests(&requestChanged);
+  pendingChanges.clear();
 
   bool success = true;
   if (requestChanged) {
@@ -427,4 +481,86 @@ bool SensorRequestManager::SensorRequests::removeAll() {
   return success;
 }
 
+void SensorRequestManager::SensorRequests::handleConfigComplete(
+    bool success, uint32_t submissionId) {
+  CHRE_ASSERT(sensor.has_value());
+
+  if (success) {
+    // Changes covered by the completed submission were applied, so only the
+    // changes recorded after it may still need to be rolled back
+    size_t appliedCount = 0;
+    while (appliedCount < pendingChanges.size()
+           && pendingChanges[appliedCount].submissionId <= submissionId) {
+      appliedCount++;
+    }
+    for (size_t i = appliedCount; i > 0; i--) {
+      pendingChanges.erase(i - 1);
+    }
+  }
+
+  if (!sensor->isConfigInFlight()) {
+    if (!pendingChanges.empty() && !sensor->getRequest().isEquivalentTo(
+        multiplexer.getCurrentMaximalRequest())) {
+      rollBackPendingChanges();
+    } else {
+      pendingChanges.clear();
+    }
+  }
+}
+
+void SensorRequestManager::SensorRequests::trackChange(
+    Nanoapp *nanoapp, const SensorRequest *previousRequest) {
+  if (!sensor->isConfigInFlight()) {
+    // The sensor configuration already matches the multiplexer.
+    pendingChanges.clear();
+  } else {
+    PendingChange change;
+    change.nanoapp = nanoapp;
+    change.submissionId = sensor->getLastSubmissionId();
+    if (sensor->hasQueuedRequest()) {
+      change.submissionId++;
+    }
+    change.hasPreviousRequest = (previousRequest != nullptr);
+    if (change.hasPreviousRequest) {
+      change.previousRequest = *previousRequest;
+    }
+
+    if (!pendingChanges.push_back(change)) {
+      LOG_OOM();
+    }
+  }
+}
+
+void SensorRequestManager::SensorRequests::rollBackPendingChanges() {
+  SensorType sensorType = sensor->getSensorType();
+  uint16_t eventType = getSampleEventTypeForSensorType(sensorType);
+
+  bool requestChanged;
+  for (size_t i = pendingChanges.size(); i > 0; i--) {
+    const PendingChange& change = pendingChanges[i - 1];
+    size_t index;
+    if (find(change.nanoapp, &index) != nullptr) {
+      LOGW("Rolling back request for sensor %s from app ID 0x%016" PRIx64,
+           getSensorTypeName(sensorType), change.nanoapp->getAppId());
+      if (change.hasPreviousRequest) {
+        multiplexer.updateRequest(index, change.previousRequest,
+                                  &requestChanged);
+      } else {
+        multiplexer.removeRequest(index, &requestChanged);
+        change.nanoapp->unregisterForBroadcastEvent(eventType);
+      }
+    }
+  }
+  pendingChanges.clear();
+
+  // Requests removed while the changes were pending are not rolled back, so
+  // the multiplexer may now ask for less than the sensor is configured with.
+  const SensorRequest& maximalRequest = multiplexer.getCurrentMaximalRequest();
+  if (!sensor->getRequest().isEquivalentTo(maximalRequest)
+      && !sensor->setRequest(maximalRequest)) {
+    LOGE("Failed to reconfigure sensor %s after roll back",
+         getSensorTypeName(sensorType));
+  }
+}
+
 }  // namespace chre
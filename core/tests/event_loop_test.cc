@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/core/init.h"
+
+using chre::EventLoop;
+using chre::EventLoopManagerSingleton;
+
+namespace {
+
+constexpr uint16_t kFillerEventType = 0x1000;
+constexpr uint16_t kBatchEventType = 0x1001;
+
+size_t gFillerFreeCount;
+size_t gBatchFreeCount;
+
+void fillerFreeCallback(uint16_t eventType, void *eventData) {
+  gFillerFreeCount++;
+}
+
+void batchFreeCallback(uint16_t eventType, void *eventData) {
+  gBatchFreeCount++;
+}
+
+/**
+ * Posts events to an event loop that is never run while a test executes, so
+ * the inbound queue fills up. Events are addressed to the system instance,
+ * which no nanoapp receives.
+ */
+class EventLoopTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    gFillerFreeCount = 0;
+    gBatchFreeCount = 0;
+    chre::init();
+    mEventLoop = &EventLoopManagerSingleton::get()->getEventLoop();
+  }
+
+  void TearDown() override {
+    // Running a stopped event loop frees everything left in the queue
+    mEventLoop->stop();
+    mEventLoop->run();
+    chre::deinit();
+  }
+
+  bool postFillerEvent() {
+    return mEventLoop->postEvent(kFillerEventType, nullptr, fillerFreeCallback,
+                                 chre::kSystemInstanceId,
+                                 chre::kSystemInstanceId);
+  }
+
+  bool postBatch(size_t eventCount) {
+    chreEventBatchEntry batch[EventLoop::kMaxEventBatchSize];
+    for (size_t i = 0; i < eventCount; i++) {
+      batch[i].eventType = kBatchEventType;
+      batch[i].eventData = nullptr;
+      batch[i].freeCallback = batchFreeCallback;
+    }
+
+    return mEventLoop->postEvents(batch, eventCount, chre::kSystemInstanceId,
+                                  chre::kSystemInstanceId);
+  }
+
+  EventLoop *mEventLoop;
+};
+
+}  // anonymous namespace
+
+TEST_F(EventLoopTest, BatchRejectedWhenQueueFull) {
+  size_t fillerCount = 0;
+  while (postFillerEvent()) {
+    fillerCount++;
+  }
+  ASSERT_GT(fillerCount, 0u);
+
+  EXPECT_FALSE(postBatch(2));
+  // A failed post does not invoke the free callbacks
+  EXPECT_EQ(gBatchFreeCount, 0u);
+
+  mEventLoop->stop();
+  mEventLoop->run();
+  EXPECT_EQ(gFillerFreeCount, fillerCount);
+  EXPECT_EQ(gBatchFreeCount, 0u);
+}
+
+TEST_F(EventLoopTest, BatchNotPartiallyQueuedWhenItDoesNotFit) {
+  constexpr size_t kBatchSize = 5;
+
+  size_t batchCount = 0;
+  while (postBatch(kBatchSize)) {
+    batchCount++;
+  }
+  ASSERT_GT(batchCount, 0u);
+
+  // The batch that failed left behind whatever space it could not fill
+  size_t fillerCount = 0;
+  while (postFillerEvent()) {
+    fillerCount++;
+  }
+  EXPECT_LT(fillerCount, kBatchSize);
+
+  mEventLoop->stop();
+  mEventLoop->run();
+  EXPECT_EQ(gBatchFreeCount, batchCount * kBatchSize);
+  EXPECT_EQ(gFillerFreeCount, fillerCount);
+}
+
+TEST_F(EventLoopTest, OversizedBatchRejected) {
+  chreEventBatchEntry batch[EventLoop::kMaxEventBatchSize + 1];
+  for (chreEventBatchEntry& entry : batch) {
+    entry.eventType = kBatchEventType;
+    entry.eventData = nullptr;
+    entry.freeCallback = batchFreeCallback;
+  }
+
+  EXPECT_FALSE(mEventLoop->postEvents(batch, EventLoop::kMaxEventBatchSize + 1,
+                                      chre::kSystemInstanceId,
+                                      chre::kSystemInstanceId));
+  EXPECT_TRUE(postBatch(EventLoop::kMaxEventBatchSize));
+
+  mEventLoop->stop();
+  mEventLoop->run();
+  EXPECT_EQ(gBatchFreeCount, EventLoop::kMaxEventBatchSize);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "chre/core/event.h"
+
+using chre::Event;
+using chre::kBroadcastInstanceId;
+using chre::kSystemInstanceId;
+
+namespace {
+
+struct SmallPayload {
+  uint32_t a;
+  uint32_t b;
+};
+
+void noOpFreeCallback(uint16_t /* eventType */, void * /* eventData */) {}
+
+}  // anonymous namespace
+
+TEST(Event, ExternalDataIsReferenced) {
+  SmallPayload payload = {1, 2};
+  Event event(1, &payload, noOpFreeCallback);
+
+  EXPECT_EQ(event.eventData, &payload);
+  EXPECT_EQ(event.freeCallback, noOpFreeCallback);
+}
+
+TEST(Event, InlineDataIsCopiedIntoEvent) {
+  SmallPayload payload = {1, 2};
+  Event event(2, &payload, sizeof(payload), nullptr, kSystemInstanceId,
+              kBroadcastInstanceId);
+
+  // Changes to the original must not be visible through the event
+  payload.a = 3;
+  auto *eventPayload = static_cast<const SmallPayload *>(event.eventData);
+  EXPECT_NE(event.eventData, &payload);
+  EXPECT_EQ(eventPayload->a, 1u);
+  EXPECT_EQ(eventPayload->b, 2u);
+  EXPECT_EQ(event.freeCallback, nullptr);
+  EXPECT_EQ(event.eventType, 2);
+}
+
+TEST(Event, InlineDataIsSuitablyAligned) {
+  uint64_t value = UINT64_MAX;
+  Event event(3, &value, sizeof(value), noOpFreeCallback, kSystemInstanceId,
+              kSystemInstanceId);
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(event.eventData) % alignof(uint64_t),
+            0u);
+  EXPECT_EQ(*static_cast<const uint64_t *>(event.eventData), UINT64_MAX);
+  EXPECT_EQ(event.freeCallback, noOpFreeCallback);
+}
+
+TEST(Event, InlineDataFillsPayloadArea) {
+  uint8_t data[Event::kInlineDataSize];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<uint8_t>(i + 1);
+  }
+
+  Event event(4, data, sizeof(data), nullptr, kSystemInstanceId,
+              kBroadcastInstanceId);
+  EXPECT_EQ(memcmp(event.eventData, data, sizeof(data)), 0);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/core/init.h"
+#include "chre/core/nanoapp.h"
+#include "chre/core/sensor_request_manager.h"
+#include "chre/platform/platform_sensor.h"
+
+using chre::EventLoopManagerSingleton;
+using chre::Nanoapp;
+using chre::Nanoseconds;
+using chre::PlatformSensor;
+using chre::Sensor;
+using chre::SensorMode;
+using chre::SensorRequest;
+using chre::SensorRequestManager;
+using chre::SensorType;
+
+namespace {
+
+constexpr SensorType kSensorType = SensorType::Accelerometer;
+const SensorType kFakeSensorTypes[] = {kSensorType};
+
+const Nanoseconds kSlowInterval(100000000);
+const Nanoseconds kFastInterval(10000000);
+
+/**
+ * Drives a SensorRequestManager backed by a fake Linux sensor. The Linux
+ * PlatformSensor posts its results to the event loop, which is never run while
+ * a test executes, so completions are delivered by calling
+ * handleSensorConfigResult() as the platform would.
+ */
+class SensorRequestManagerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    chre::init();
+    PlatformSensor::setFakeSensorTypes(kFakeSensorTypes, 1);
+    mManager.reset(new SensorRequestManager());
+    ASSERT_TRUE(mManager->getSensorHandle(kSensorType, &mHandle));
+  }
+
+  void TearDown() override {
+    mManager.reset();
+    PlatformSensor::setFakeSensorTypes(nullptr, 0);
+
+    // Running a stopped event loop frees the results deferred by the platform
+    chre::EventLoop& eventLoop = EventLoopManagerSingleton::get()
+        ->getEventLoop();
+    eventLoop.stop();
+    eventLoop.run();
+    chre::deinit();
+  }
+
+  bool request(Nanoapp *nanoapp, SensorMode mode, Nanoseconds interval) {
+    SensorRequest request(nanoapp, mode, interval, Nanoseconds(0));
+    return mManager->setSensorRequest(nanoapp, mHandle, request);
+  }
+
+  void complete(bool success) {
+    mManager->handleSensorConfigResult(kSensorType, success);
+  }
+
+  const Sensor& sensor() {
+    return *mManager->getSensor(kSensorType);
+  }
+
+  const chre::DynamicVector<SensorRequest>& requests() {
+    return mManager->getRequests(kSensorType);
+  }
+
+  std::unique_ptr<SensorRequestManager> mManager;
+  uint32_t mHandle;
+  Nanoapp mApp1;
+  Nanoapp mApp2;
+};
+
+}  // anonymous namespace
+
+TEST_F(SensorRequestManagerTest, FailedUpdateRollsBackToAppliedRequest) {
+  ASSERT_TRUE(request(&mApp1, SensorMode::ActiveContinuous, kSlowInterval));
+  complete(true);
+  ASSERT_TRUE(sensor().getRequest().getInterval() == kSlowInterval);
+
+  ASSERT_TRUE(request(&mApp1, SensorMode::ActiveContinuous, kFastInterval));
+  complete(false);
+  EXPECT_FALSE(sensor().isConfigInFlight());
+  ASSERT_EQ(requests().size(), 1);
+  EXPECT_EQ(requests()[0].getNanoapp(), &mApp1);
+  EXPECT_TRUE(requests()[0].getInterval() == kSlowInterval);
+  EXPECT_TRUE(sensor().getRequest().getInterval() == kSlowInterval);
+}
+
+TEST_F(SensorRequestManagerTest, FailedQueuedRequestKeepsEarlierChanges) {
+  ASSERT_TRUE(request(&mApp1, SensorMode::ActiveContinuous, kSlowInterval));
+  ASSERT_TRUE(request(&mApp2, SensorMode::ActiveContinuous, kFastInterval));
+
+  // The first submission succeeds, and the queued one is submitted
+  complete(true);
+  EXPECT_TRUE(sensor().isConfigInFlight());
+  EXPECT_TRUE(sensor().getRequest().getInterval() == kSlowInterval);
+
+  // Only the change covered by the failed submission is rolled back
+  complete(false);
+  EXPECT_FALSE(sensor().isConfigInFlight());
+  ASSERT_EQ(requests().size(), 1);
+  EXPECT_EQ(requests()[0].getNanoapp(), &mApp1);
+  EXPECT_TRUE(sensor().getRequest().getInterval() == kSlowInterval);
+
+  uint16_t eventType = chre::getSampleEventTypeForSensorType(kSensorType);
+  EXPECT_TRUE(mApp1.isRegisteredForBroadcastEvent(eventType));
+  EXPECT_FALSE(mApp2.isRegisteredForBroadcastEvent(eventType));
+}
+
+TEST_F(SensorRequestManagerTest, SuccessfulQueuedRequestAppliesAllChanges) {
+  ASSERT_TRUE(request(&mApp1, SensorMode::ActiveContinuous, kSlowInterval));
+  ASSERT_TRUE(request(&mApp2, SensorMode::ActiveContinuous, kFastInterval));
+
+  // The queued request includes the first change, so it applies both
+  complete(false);
+  EXPECT_TRUE(sensor().isConfigInFlight());
+  complete(true);
+  EXPECT_FALSE(sensor().isConfigInFlight());
+  EXPECT_EQ(requests().size(), 2);
+  EXPECT_TRUE(sensor().getRequest().getInterval() == kFastInterval);
+}
+
+TEST_F(SensorRequestManagerTest, RequestRemovedInFlightIsNotRestored) {
+  ASSERT_TRUE(request(&mApp1, SensorMode::ActiveContinuous, kSlowInterval));
+  ASSERT_TRUE(request(&mApp2, SensorMode::ActiveContinuous, kFastInterval));
+  ASSERT_TRUE(request(&mApp1, SensorMode::Off, kSlowInterval));
+
+  complete(true);
+  EXPECT_TRUE(sensor().isConfigInFlight());
+
+  // Rolling back the second app's request leaves no requests, so the sensor
+  // is turned off again rather than restoring the removed request
+  complete(false);
+  EXPECT_TRUE(requests().empty());
+  EXPECT_TRUE(sensor().isConfigInFlight());
+  complete(true);
+  EXPECT_FALSE(sensor().isConfigInFlight());
+  EXPECT_EQ(sensor().getRequest().getMode(), SensorMode::Off);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/core/init.h"
+#include "chre/core/sensor.h"
+
+using chre::EventLoopManagerSingleton;
+using chre::Nanoseconds;
+using chre::Sensor;
+using chre::SensorMode;
+using chre::SensorRequest;
+
+namespace {
+
+const SensorRequest kSlowRequest(SensorMode::ActiveContinuous,
+                                 Nanoseconds(100000000), Nanoseconds(0));
+const SensorRequest kMediumRequest(SensorMode::ActiveContinuous,
+                                   Nanoseconds(50000000), Nanoseconds(0));
+const SensorRequest kFastRequest(SensorMode::ActiveContinuous,
+                                 Nanoseconds(10000000), Nanoseconds(0));
+
+/**
+ * Drives the Sensor configuration state machine directly. The Linux
+ * PlatformSensor posts its results to the event loop, which is never run
+ * while a test executes, so completions are delivered by calling
+ * handleConfigComplete() as SensorRequestManager would.
+ */
+class SensorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    chre::init();
+  }
+
+  void TearDown() override {
+    // Running a stopped event loop frees the results deferred by the platform
+    chre::EventLoop& eventLoop = EventLoopManagerSingleton::get()
+        ->getEventLoop();
+    eventLoop.stop();
+    eventLoop.run();
+    chre::deinit();
+  }
+
+  Sensor mSensor;
+};
+
+}  // anonymous namespace
+
+TEST_F(SensorTest, RequestIsAppliedOnCompletion) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  EXPECT_TRUE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(SensorRequest()));
+
+  mSensor.handleConfigComplete(true);
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(kSlowRequest));
+  EXPECT_EQ(mSensor.getConfigLatencyStats().completedCount, 1);
+  EXPECT_EQ(mSensor.getConfigLatencyStats().failedCount, 0);
+}
+
+TEST_F(SensorTest, EquivalentRequestIsNotSubmitted) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  mSensor.handleConfigComplete(true);
+
+  EXPECT_TRUE(mSensor.setRequest(kSlowRequest));
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+}
+
+TEST_F(SensorTest, FailedRequestKeepsPreviousRequest) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  mSensor.handleConfigComplete(true);
+
+  ASSERT_TRUE(mSensor.setRequest(kFastRequest));
+  mSensor.handleConfigComplete(false);
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(kSlowRequest));
+  EXPECT_EQ(mSensor.getConfigLatencyStats().completedCount, 2);
+  EXPECT_EQ(mSensor.getConfigLatencyStats().failedCount, 1);
+}
+
+TEST_F(SensorTest, RequestsInFlightCollapseToLatest) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  EXPECT_TRUE(mSensor.setRequest(kMediumRequest));
+  EXPECT_TRUE(mSensor.setRequest(kFastRequest));
+  EXPECT_EQ(mSensor.getConfigLatencyStats().collapsedCount, 1);
+
+  // Completing the first request submits only the most recent one
+  mSensor.handleConfigComplete(true);
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(kSlowRequest));
+  EXPECT_TRUE(mSensor.isConfigInFlight());
+
+  mSensor.handleConfigComplete(true);
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(kFastRequest));
+  EXPECT_EQ(mSensor.getConfigLatencyStats().completedCount, 2);
+}
+
+TEST_F(SensorTest, QueuedRequestIsSubmittedAfterFailure) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  EXPECT_TRUE(mSensor.setRequest(kFastRequest));
+
+  mSensor.handleConfigComplete(false);
+  EXPECT_TRUE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(SensorRequest()));
+
+  mSensor.handleConfigComplete(true);
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(kFastRequest));
+}
+
+TEST_F(SensorTest, QueuedRequestMatchingResultIsNotSubmitted) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  EXPECT_TRUE(mSensor.setRequest(kFastRequest));
+  EXPECT_TRUE(mSensor.setRequest(kSlowRequest));
+
+  mSensor.handleConfigComplete(true);
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(kSlowRequest));
+}
+
+TEST_F(SensorTest, StopWhilePendingIgnoresLateCompletion) {
+  ASSERT_TRUE(mSensor.setRequest(kSlowRequest));
+  EXPECT_TRUE(mSensor.setRequest(kFastRequest));
+  EventLoopManagerSingleton::get()->getEventLoop().stop();
+
+  // Requests are applied synchronously once the event loop is stopping. The
+  // Linux platform has no sensors to accept it, but either way the in-flight
+  // request and the queued one are abandoned.
+  EXPECT_FALSE(mSensor.setRequest(SensorRequest()));
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+
+  mSensor.handleConfigComplete(true);
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+  EXPECT_TRUE(mSensor.getRequest().isEquivalentTo(SensorRequest()));
+}
+
+TEST_F(SensorTest, EquivalentRequestSucceedsWhileStopping) {
+  EventLoopManagerSingleton::get()->getEventLoop().stop();
+  EXPECT_TRUE(mSensor.setRequest(SensorRequest()));
+  EXPECT_FALSE(mSensor.isConfigInFlight());
+}
@@ -101,25 +101,19 @@ void WifiRequestManager::handleScanMonitorStateChange(bool enabled,
     uint8_t errorCode;
   };
 
-  auto *cbState = memoryAlloc<CallbackState>();
-  if (cbState == nullptr) {
-    LOGE("Failed to allocate callback state for scan monitor state change");
-  } else {
-    cbState->enabled = enabled;
-    cbState->errorCode = errorCode;
-
-    auto callback = [](uint16_t /* eventType */, void *eventData) {
-      auto *state = static_cast<CallbackState *>(eventData);
-      EventLoopManagerSingleton::get()->getWifiRequestManager()
-          .handleScanMonitorStateChangeSync(state->enabled, state->errorCode);
-      memoryFree(state);
-    };
-
-    bool callbackDeferred = EventLoopManagerSingleton::get()->deferCallback(
-        SystemCallbackType::WifiScanMonitorStateChange, cbState, callback);
-    if (!callbackDeferred) {
-      memoryFree(cbState);
-    }
+  CallbackState cbState;
+  cbState.enabled = enabled;
+  cbState.errorCode = errorCode;
+
+  auto callback = [](uint16_t /* eventType */, void *eventData) {
+    auto *state = static_cast<CallbackState *>(eventData);
+    EventLoopManagerSingleton::get()->getWifiRequestManager()
+        .handleScanMonitorStateChangeSync(state->enabled, state->errorCode);
+  };
+
+  if (!EventLoopManagerSingleton::get()->deferCallbackWithInlineData(
+          SystemCallbackType::WifiScanMonitorStateChange, cbState, callback)) {
+    LOGE("Failed to defer scan monitor state change");
   }
 }
 
@@ -130,22 +124,19 @@ void WifiRequestManager::handleScanResponse(bool pending,
     uint8_t errorCode;
   };
 
-  auto *cbState = memoryAlloc<CallbackState>();
-  if (cbState == nullptr) {
-    LOGE("Failed to allocate callback state for wifi scan response");
-  } else {
-    cbState->pending = pending;
-    cbState->errorCode = errorCode;
-
-    auto callback = [](uint16_t /* eventType */, void *eventData) {
-      auto *state = static_cast<CallbackState *>(eventData);
-      EventLoopManagerSingleton::get()->getWifiRequestManager()
-          .handleScanResponseSync(state->pending, state->errorCode);
-      memoryFree(state);
-    };
-
-    EventLoopManagerSingleton::get()->deferCallback(
-        SystemCallbackType::WifiRequestScanResponse, cbState, callback);
+  CallbackState cbState;
+  cbState.pending = pending;
+  cbState.errorCode = errorCode;
+
+  auto callback = [](uint16_t /* eventType */, void *eventData) {
+    auto *state = static_cast<CallbackState *>(eventData);
+    EventLoopManagerSingleton::get()->getWifiRequestManager()
+        .handleScanResponseSync(state->pending, state->errorCode);
+  };
+
+  if (!EventLoopManagerSingleton::get()->deferCallbackWithInlineData(
+          SystemCallbackType::WifiRequestScanResponse, cbState, callback)) {
+    LOGE("Failed to defer wifi scan response");
   }
 }
 
@@ -284,27 +275,19 @@ bool WifiRequestManager::updateNanoappScanMonitoringList(bool enable,
 bool WifiRequestManager::postScanMonitorAsyncResultEvent(
     uint32_t nanoappInstanceId, bool success, bool enable, uint8_t errorCode,
     const void *cookie) {
-  // Allocate and post an event to the nanoapp requesting wifi.
+  // Post an event to the nanoapp requesting wifi.
   bool eventPosted = false;
   if (!success || updateNanoappScanMonitoringList(enable, nanoappInstanceId)) {
-    chreAsyncResult *event = memoryAlloc<chreAsyncResult>();
-    if (event == nullptr) {
-      LOGE("Failed to allocate wifi scan monitor async result event");
-    } else {
-      event->requestType = CHRE_WIFI_REQUEST_TYPE_CONFIGURE_SCAN_MONITOR;
-      event->success = success;
-      event->errorCode = errorCode;
-      event->reserved = 0;
-      event->cookie = cookie;
-
-      // Post the event.
-      eventPosted = EventLoopManagerSingleton::get()->getEventLoop()
-          .postEvent(CHRE_EVENT_WIFI_ASYNC_RESULT, event, freeEventDataCallback,
-                     kSystemInstanceId, nanoappInstanceId);
-      if (!eventPosted) {
-        memoryFree(event);
-      }
-    }
+    chreAsyncResult event;
+    event.requestType = CHRE_WIFI_REQUEST_TYPE_CONFIGURE_SCAN_MONITOR;
+    event.success = success;
+    event.errorCode = errorCode;
+    event.reserved = 0;
+    event.cookie = cookie;
+
+    eventPosted = EventLoopManagerSingleton::get()->getEventLoop()
+        .postInlineEvent(CHRE_EVENT_WIFI_ASYNC_RESULT, event, nullptr,
+                         kSystemInstanceId, nanoappInstanceId);
   }
 
   return eventPosted;
@@ -322,24 +305,16 @@ void WifiRequestManager::postScanMonitorAsyncResultEventFatal(
 bool WifiRequestManager::postScanRequestAsyncResultEvent(
     uint32_t nanoappInstanceId, bool success, uint8_t errorCode,
     const void *cookie) {
-  bool eventPosted = false;
-  chreAsyncResult *event = memoryAlloc<chreAsyncResult>();
-  if (event == nullptr) {
-    LOGE("Failed to allocate wifi scan request async result event");
-  } else {
-    event->requestType = CHRE_WIFI_REQUEST_TYPE_REQUEST_SCAN;
-    event->success = success;
-    event->errorCode = errorCode;
-    event->reserved = 0;
-    event->cookie = cookie;
-
-    // Post the event.
-    eventPosted = EventLoopManagerSingleton::get()->getEventLoop()
-        .postEvent(CHRE_EVENT_WIFI_ASYNC_RESULT, event, freeEventDataCallback,
-                   kSystemInstanceId, nanoappInstanceId);
-  }
-
-  return eventPosted;
+  chreAsyncResult event;
+  event.requestType = CHRE_WIFI_REQUEST_TYPE_REQUEST_SCAN;
+  event.success = success;
+  event.errorCode = errorCode;
+  event.reserved = 0;
+  event.cookie = cookie;
+
+  return EventLoopManagerSingleton::get()->getEventLoop()
+      .postInlineEvent(CHRE_EVENT_WIFI_ASYNC_RESULT, event, nullptr,
+                       kSystemInstanceId, nanoappInstanceId);
 }
 
 void WifiRequestManager::postScanRequestAsyncResultEventFatal(
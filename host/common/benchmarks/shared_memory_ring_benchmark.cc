@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/benchmark/benchmark.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+#include "chre_host/shared_memory_ring.h"
+
+using android::chre::SharedMemoryRing;
+using chre::benchmark::State;
+using chre::benchmark::doNotOptimize;
+
+namespace {
+
+//! The number of messages passed from the producer thread to the consumer per
+//! iteration. Each benchmark takes the message size from getArg().
+constexpr size_t kMessagesPerIteration = 1000;
+
+//! Matches the maximum message size accepted by the SocketServer.
+constexpr size_t kMaxMessageSize = 64 * 1024;
+
+//! Ring capacity used by the benchmark, large enough to hold bursts of the
+//! largest message size without the producer having to wait.
+constexpr size_t kRingCapacity = 1024 * 1024;
+
+/**
+ * Passes messages from a producer thread through a SharedMemoryRing, with the
+ * consumer blocking on the eventfd whenever the ring is empty, as
+ * SocketClient's receive thread does.
+ */
+void RingTransfer(State& state) {
+  SharedMemoryRing consumer;
+  SharedMemoryRing producer;
+  if (!consumer.create(kRingCapacity)
+      || !producer.attach(dup(consumer.getMemFd()),
+                          dup(consumer.getEventFd()))) {
+    return;
+  }
+
+  std::vector<uint8_t> message(state.getArg());
+  size_t bytesReceived = 0;
+  while (state.keepRunning()) {
+    std::thread producerThread([&]() {
+      for (size_t i = 0; i < kMessagesPerIteration; i++) {
+        while (!producer.write(message.data(), message.size())) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    size_t received = 0;
+    while (received < kMessagesPerIteration) {
+      received += consumer.drain([&](const void *data, size_t length) {
+        bytesReceived += length;
+      });
+      if (received < kMessagesPerIteration && consumer.prepareToWait()) {
+        struct pollfd pollFd = {};
+        pollFd.fd = consumer.getEventFd();
+        pollFd.events = POLLIN;
+        if (poll(&pollFd, 1, -1 /* timeout */) > 0) {
+          consumer.clearWakeup();
+        }
+      }
+    }
+    producerThread.join();
+  }
+  doNotOptimize(bytesReceived);
+}
+
+/**
+ * Passes messages from a producer thread over a SOCK_SEQPACKET socket pair, as
+ * SocketServer does by default.
+ */
+void SocketTransfer(State& state) {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+    return;
+  }
+
+  std::vector<uint8_t> message(state.getArg());
+  std::vector<uint8_t> buffer(kMaxMessageSize);
+  size_t bytesReceived = 0;
+  while (state.keepRunning()) {
+    std::thread producerThread([&]() {
+      for (size_t i = 0; i < kMessagesPerIteration; i++) {
+        send(fds[0], message.data(), message.size(), 0);
+      }
+    });
+
+    for (size_t i = 0; i < kMessagesPerIteration; i++) {
+      ssize_t length = recv(fds[1], buffer.data(), buffer.size(), 0);
+      if (length > 0) {
+        bytesReceived += static_cast<size_t>(length);
+      }
+    }
+    producerThread.join();
+  }
+  doNotOptimize(bytesReceived);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK(RingTransfer, 64, 512, 4096);
+CHRE_BENCHMARK(SocketTransfer, 64, 512, 4096);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre_host/broadcast_subscriptions.h"
+
+#include <algorithm>
+
+namespace android {
+namespace chre {
+
+bool BroadcastSubscriptions::Subscription::operator==(
+    const Subscription& other) const {
+  return (matchAnyAppId == other.matchAnyAppId
+          && (matchAnyAppId || appId == other.appId)
+          && matchAnyMessageType == other.matchAnyMessageType
+          && (matchAnyMessageType || messageType == other.messageType));
+}
+
+bool BroadcastSubscriptions::Subscription::matches(
+    uint64_t messageAppId, uint32_t messageMessageType) const {
+  return ((matchAnyAppId || appId == messageAppId)
+          && (matchAnyMessageType || messageType == messageMessageType));
+}
+
+void BroadcastSubscriptions::addSubscription(uint16_t clientId,
+                                             const Subscription& subscription) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  ClientState& client = mClients[clientId];
+  client.subscribed = true;
+
+  std::vector<Subscription>& subscriptions = client.subscriptions;
+  if (std::find(subscriptions.begin(), subscriptions.end(), subscription)
+        == subscriptions.end()) {
+    subscriptions.push_back(subscription);
+  }
+}
+
+bool BroadcastSubscriptions::removeSubscription(
+    uint16_t clientId, const Subscription& subscription) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  bool removed = false;
+  auto client = mClients.find(clientId);
+  if (client != mClients.end()) {
+    std::vector<Subscription>& subscriptions = client->second.subscriptions;
+    auto it = std::find(subscriptions.begin(), subscriptions.end(),
+                        subscription);
+    if (it != subscriptions.end()) {
+      subscriptions.erase(it);
+      removed = true;
+    }
+  }
+
+  return removed;
+}
+
+BroadcastSubscriptions::ClientStats BroadcastSubscriptions::removeClient(
+    uint16_t clientId) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  ClientStats stats;
+  auto client = mClients.find(clientId);
+  if (client != mClients.end()) {
+    stats = client->second.stats;
+    mClients.erase(client);
+  }
+
+  return stats;
+}
+
+bool BroadcastSubscriptions::shouldDeliver(uint16_t clientId, uint64_t appId,
+                                           uint32_t messageType) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  ClientState& client = mClients[clientId];
+
+  bool deliver = !client.subscribed;
+  for (const Subscription& subscription : client.subscriptions) {
+    if (subscription.matches(appId, messageType)) {
+      deliver = true;
+      break;
+    }
+  }
+
+  if (deliver) {
+    client.stats.deliveredCount++;
+  } else {
+    client.stats.filteredCount++;
+    mTotalFilteredCount++;
+  }
+
+  return deliver;
+}
+
+uint64_t BroadcastSubscriptions::getTotalFilteredCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mTotalFilteredCount;
+}
+
+}  // namespace chre
+}  // namespace android
@@ -19,6 +19,9 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <algorithm>
+
+#include "chre/util/system/crc32.h"
 #include "chre_host/log.h"
 
 using flatbuffers::FlatBufferBuilder;
@@ -87,7 +90,8 @@ bool HostProtocolHost::decodeMessageFromChre(
             name, vendor, toolchain, resp->platform_version(),
             resp->toolchain_version(), resp->peak_mips(), resp->stopped_power(),
             resp->sleep_power(), resp->peak_power(), resp->max_msg_len(),
-            resp->platform_id(), resp->chre_platform_version());
+            resp->platform_id(), resp->chre_platform_version(),
+            resp->supports_cached_load());
         break;
       }
 
@@ -161,6 +165,76 @@ void HostProtocolHost::encodeLoadNanoappRequest(
   finalize(builder, fbs::ChreMessage::LoadNanoappRequest, request.Union());
 }
 
+void HostProtocolHost::encodeLoadNanoappBeginRequest(
+    FlatBufferBuilder& builder, uint32_t transactionId, uint64_t appId,
+    uint32_t appVersion, uint32_t targetApiVersion, uint32_t totalAppSize) {
+  auto request = fbs::CreateLoadNanoappBeginRequest(
+      builder, transactionId, appId, appVersion, targetApiVersion,
+      totalAppSize);
+  finalize(builder, fbs::ChreMessage::LoadNanoappBeginRequest,
+           request.Union());
+}
+
+void HostProtocolHost::encodeLoadNanoappFragment(
+    FlatBufferBuilder& builder, uint32_t transactionId, uint32_t offset,
+    const uint8_t *fragment, size_t fragmentLen) {
+  auto data = builder.CreateVector(fragment, fragmentLen);
+  auto message = fbs::CreateLoadNanoappFragment(
+      builder, transactionId, offset, data);
+  finalize(builder, fbs::ChreMessage::LoadNanoappFragment, message.Union());
+}
+
+void HostProtocolHost::encodeLoadNanoappCommitRequest(
+    FlatBufferBuilder& builder, uint32_t transactionId, uint32_t crc32) {
+  auto request = fbs::CreateLoadNanoappCommitRequest(
+      builder, transactionId, crc32);
+  finalize(builder, fbs::ChreMessage::LoadNanoappCommitRequest,
+           request.Union());
+}
+
+void HostProtocolHost::encodeLoadCachedNanoappRequest(
+    FlatBufferBuilder& builder, uint32_t transactionId, uint64_t appId,
+    uint32_t appVersion, uint32_t targetApiVersion, uint32_t crc32) {
+  auto request = fbs::CreateLoadCachedNanoappRequest(
+      builder, transactionId, appId, appVersion, targetApiVersion, crc32);
+  finalize(builder, fbs::ChreMessage::LoadCachedNanoappRequest,
+           request.Union());
+}
+
+bool HostProtocolHost::encodeFragmentedLoadNanoapp(
+    uint32_t transactionId, uint64_t appId, uint32_t appVersion,
+    uint32_t targetApiVersion, const uint8_t *appBinary, size_t appBinarySize,
+    size_t fragmentSize,
+    const std::function<bool(const uint8_t *, size_t)>& sendFunc) {
+  constexpr size_t kFragmentOverhead = 128;
+
+  // Reuse the same builder for every message so the binary is never copied
+  // into a buffer larger than a single fragment
+  FlatBufferBuilder builder(fragmentSize + kFragmentOverhead);
+  encodeLoadNanoappBeginRequest(builder, transactionId, appId, appVersion,
+                                targetApiVersion,
+                                static_cast<uint32_t>(appBinarySize));
+  bool success = sendFunc(builder.GetBufferPointer(), builder.GetSize());
+
+  for (size_t offset = 0; success && offset < appBinarySize;
+       offset += fragmentSize) {
+    builder.Clear();
+    encodeLoadNanoappFragment(
+        builder, transactionId, static_cast<uint32_t>(offset),
+        appBinary + offset, std::min(fragmentSize, appBinarySize - offset));
+    success = sendFunc(builder.GetBufferPointer(), builder.GetSize());
+  }
+
+  if (success) {
+    builder.Clear();
+    encodeLoadNanoappCommitRequest(builder, transactionId,
+                                   ::chre::crc32(appBinary, appBinarySize));
+    success = sendFunc(builder.GetBufferPointer(), builder.GetSize());
+  }
+
+  return success;
+}
+
 void HostProtocolHost::encodeNanoappListRequest(FlatBufferBuilder& builder) {
   auto request = fbs::CreateNanoappListRequest(builder);
   finalize(builder, fbs::ChreMessage::NanoappListRequest, request.Union());
@@ -174,12 +248,30 @@ void HostProtocolHost::encodeUnloadNanoappRequest(
   finalize(builder, fbs::ChreMessage::UnloadNanoappRequest, request.Union());
 }
 
+void HostProtocolHost::encodeMessageSubscriptionRequest(
+    FlatBufferBuilder& builder, bool subscribe, uint64_t appId,
+    bool matchAnyAppId, uint32_t messageType, bool matchAnyMessageType) {
+  auto request = fbs::CreateMessageSubscriptionRequest(
+      builder, subscribe, appId, matchAnyAppId, messageType,
+      matchAnyMessageType);
+  finalize(builder, fbs::ChreMessage::MessageSubscriptionRequest,
+           request.Union());
+}
+
 void HostProtocolHost::encodeTimeSyncMessage(FlatBufferBuilder& builder,
-                                             int64_t offset) {
-  auto request = fbs::CreateTimeSyncMessage(builder, offset);
+                                             int64_t offset,
+                                             int64_t uncertainty) {
+  auto request = fbs::CreateTimeSyncMessage(builder, offset, uncertainty);
   finalize(builder, fbs::ChreMessage::TimeSyncMessage, request.Union());
 }
 
+void HostProtocolHost::encodeTimeSyncProbe(FlatBufferBuilder& builder,
+                                           uint32_t sequence,
+                                           int64_t hostSendTime) {
+  auto probe = fbs::CreateTimeSyncProbe(builder, sequence, hostSendTime);
+  finalize(builder, fbs::ChreMessage::TimeSyncProbe, probe.Union());
+}
+
 void HostProtocolHost::encodeDebugDumpRequest(FlatBufferBuilder& builder) {
   auto request = fbs::CreateDebugDumpRequest(builder);
   finalize(builder, fbs::ChreMessage::DebugDumpRequest, request.Union());
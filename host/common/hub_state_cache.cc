@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre_host/hub_state_cache.h"
+
+#include "chre_host/host_protocol_host.h"
+
+// Aliased for consistency with the way these symbols are referenced in
+// CHRE-side code
+namespace fbs = ::chre::fbs;
+
+namespace android {
+namespace chre {
+
+bool HubStateCache::getCachedResponse(fbs::ChreMessage requestType,
+                                      uint16_t clientId,
+                                      std::vector<uint8_t> *response) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  const std::vector<uint8_t> *cached = nullptr;
+  if (requestType == fbs::ChreMessage::HubInfoRequest) {
+    cached = &mHubInfoResponse;
+  } else if (requestType == fbs::ChreMessage::NanoappListRequest) {
+    cached = &mNanoappListResponse;
+  }
+
+  bool hit = false;
+  if (cached != nullptr) {
+    if (cached->empty()) {
+      mStats.missCount++;
+    } else {
+      *response = *cached;
+      hit = HostProtocolHost::mutateHostClientId(
+          response->data(), response->size(), clientId);
+      if (hit) {
+        mStats.hitCount++;
+      }
+    }
+  }
+
+  return hit;
+}
+
+void HubStateCache::onMessageFromChre(fbs::ChreMessage messageType,
+                                      const void *message, size_t messageLen) {
+  const auto *bytes = static_cast<const uint8_t *>(message);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  switch (messageType) {
+    case fbs::ChreMessage::HubInfoResponse:
+      mHubInfoResponse.assign(bytes, bytes + messageLen);
+      break;
+
+    case fbs::ChreMessage::NanoappListResponse:
+      mNanoappListResponse.assign(bytes, bytes + messageLen);
+      break;
+
+    case fbs::ChreMessage::LoadNanoappResponse:
+    case fbs::ChreMessage::UnloadNanoappResponse:
+    case fbs::ChreMessage::NanoappStatusChange:
+      if (!mNanoappListResponse.empty()) {
+        mNanoappListResponse.clear();
+        mStats.invalidationCount++;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+HubStateCache::Stats HubStateCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStats;
+}
+
+}  // namespace chre
+}  // namespace android
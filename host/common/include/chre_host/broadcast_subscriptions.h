@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_HOST_BROADCAST_SUBSCRIPTIONS_H_
+#define CHRE_HOST_BROADCAST_SUBSCRIPTIONS_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace android {
+namespace chre {
+
+/**
+ * Tracks which broadcast nanoapp messages each host client has subscribed to,
+ * so that the daemon only delivers a broadcast to the clients interested in
+ * it. A client that has never subscribed receives all broadcasts, which
+ * keeps clients that predate subscriptions working unmodified. Once a client
+ * subscribes, it only receives the broadcasts matching its subscriptions,
+ * even after it removes them all.
+ *
+ * This class is thread-safe.
+ */
+class BroadcastSubscriptions {
+ public:
+  struct Subscription {
+    uint64_t appId;
+    uint32_t messageType;
+    bool matchAnyAppId;
+    bool matchAnyMessageType;
+
+    bool operator==(const Subscription& other) const;
+
+    /**
+     * @return true if a message of the given type from the given nanoapp
+     *         matches this subscription
+     */
+    bool matches(uint64_t messageAppId, uint32_t messageMessageType) const;
+  };
+
+  /**
+   * Counts of the broadcasts considered for delivery to a client.
+   */
+  struct ClientStats {
+    uint64_t deliveredCount = 0;
+    uint64_t filteredCount = 0;
+  };
+
+  /**
+   * Adds a subscription for a client, opting it in to filtering. Adding a
+   * subscription identical to one the client already holds has no effect.
+   */
+  void addSubscription(uint16_t clientId, const Subscription& subscription);
+
+  /**
+   * Removes a subscription previously added for a client. The client remains
+   * subscribed, so it receives no broadcasts once its last subscription is
+   * removed.
+   *
+   * @return true if a matching subscription was found
+   */
+  bool removeSubscription(uint16_t clientId, const Subscription& subscription);
+
+  /**
+   * Discards all state for a client, e.g. when it disconnects.
+   *
+   * @return The client's final delivery counts
+   */
+  ClientStats removeClient(uint16_t clientId);
+
+  /**
+   * Determines whether a broadcast message should be delivered to a client,
+   * and updates the client's counters accordingly.
+   *
+   * @return true if the client has never subscribed, or one of its
+   *         subscriptions matches
+   */
+  bool shouldDeliver(uint16_t clientId, uint64_t appId, uint32_t messageType);
+
+  /**
+   * @return The total number of broadcasts withheld from clients
+   */
+  uint64_t getTotalFilteredCount() const;
+
+ private:
+  struct ClientState {
+    std::vector<Subscription> subscriptions;
+    ClientStats stats;
+
+    //! Set once the client adds a subscription, after which broadcasts are
+    //! filtered by its subscriptions
+    bool subscribed = false;
+  };
+
+  mutable std::mutex mMutex;
+  std::map<uint16_t, ClientState> mClients;
+  uint64_t mTotalFilteredCount = 0;
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_BROADCAST_SUBSCRIPTIONS_H_
@@ -57,6 +57,30 @@ struct DebugDumpResponseT;
 struct TimeSyncRequest;
 struct TimeSyncRequestT;
 
+struct LoadNanoappBeginRequest;
+struct LoadNanoappBeginRequestT;
+
+struct LoadNanoappFragment;
+struct LoadNanoappFragmentT;
+
+struct LoadNanoappCommitRequest;
+struct LoadNanoappCommitRequestT;
+
+struct LoadCachedNanoappRequest;
+struct LoadCachedNanoappRequestT;
+
+struct MessageSubscriptionRequest;
+struct MessageSubscriptionRequestT;
+
+struct NanoappStatusChange;
+struct NanoappStatusChangeT;
+
+struct TimeSyncProbe;
+struct TimeSyncProbeT;
+
+struct TimeSyncProbeResponse;
+struct TimeSyncProbeResponseT;
+
 struct HostAddress;
 
 struct MessageContainer;
@@ -81,8 +105,16 @@ enum class ChreMessage : uint8_t {
   DebugDumpData = 13,
   DebugDumpResponse = 14,
   TimeSyncRequest = 15,
+  LoadNanoappBeginRequest = 16,
+  LoadNanoappFragment = 17,
+  LoadNanoappCommitRequest = 18,
+  LoadCachedNanoappRequest = 19,
+  MessageSubscriptionRequest = 20,
+  NanoappStatusChange = 21,
+  TimeSyncProbe = 22,
+  TimeSyncProbeResponse = 23,
   MIN = NONE,
-  MAX = TimeSyncRequest
+  MAX = TimeSyncProbeResponse
 };
 
 inline const char **EnumNamesChreMessage() {
@@ -103,6 +135,14 @@ inline const char **EnumNamesChreMessage() {
     "DebugDumpData",
     "DebugDumpResponse",
     "TimeSyncRequest",
+    "LoadNanoappBeginRequest",
+    "LoadNanoappFragment",
+    "LoadNanoappCommitRequest",
+    "LoadCachedNanoappRequest",
+    "MessageSubscriptionRequest",
+    "NanoappStatusChange",
+    "TimeSyncProbe",
+    "TimeSyncProbeResponse",
     nullptr
   };
   return names;
@@ -177,6 +217,38 @@ template<> struct ChreMessageTraits<TimeSyncRequest> {
   static const ChreMessage enum_value = ChreMessage::TimeSyncRequest;
 };
 
+template<> struct ChreMessageTraits<LoadNanoappBeginRequest> {
+  static const ChreMessage enum_value = ChreMessage::LoadNanoappBeginRequest;
+};
+
+template<> struct ChreMessageTraits<LoadNanoappFragment> {
+  static const ChreMessage enum_value = ChreMessage::LoadNanoappFragment;
+};
+
+template<> struct ChreMessageTraits<LoadNanoappCommitRequest> {
+  static const ChreMessage enum_value = ChreMessage::LoadNanoappCommitRequest;
+};
+
+template<> struct ChreMessageTraits<LoadCachedNanoappRequest> {
+  static const ChreMessage enum_value = ChreMessage::LoadCachedNanoappRequest;
+};
+
+template<> struct ChreMessageTraits<MessageSubscriptionRequest> {
+  static const ChreMessage enum_value = ChreMessage::MessageSubscriptionRequest;
+};
+
+template<> struct ChreMessageTraits<NanoappStatusChange> {
+  static const ChreMessage enum_value = ChreMessage::NanoappStatusChange;
+};
+
+template<> struct ChreMessageTraits<TimeSyncProbe> {
+  static const ChreMessage enum_value = ChreMessage::TimeSyncProbe;
+};
+
+template<> struct ChreMessageTraits<TimeSyncProbeResponse> {
+  static const ChreMessage enum_value = ChreMessage::TimeSyncProbeResponse;
+};
+
 struct ChreMessageUnion {
   ChreMessage type;
   flatbuffers::NativeTable *table;
@@ -262,6 +334,38 @@ struct ChreMessageUnion {
     return type == ChreMessage::TimeSyncRequest ?
       reinterpret_cast<TimeSyncRequestT *>(table) : nullptr;
   }
+  LoadNanoappBeginRequestT *AsLoadNanoappBeginRequest() {
+    return type == ChreMessage::LoadNanoappBeginRequest ?
+      reinterpret_cast<LoadNanoappBeginRequestT *>(table) : nullptr;
+  }
+  LoadNanoappFragmentT *AsLoadNanoappFragment() {
+    return type == ChreMessage::LoadNanoappFragment ?
+      reinterpret_cast<LoadNanoappFragmentT *>(table) : nullptr;
+  }
+  LoadNanoappCommitRequestT *AsLoadNanoappCommitRequest() {
+    return type == ChreMessage::LoadNanoappCommitRequest ?
+      reinterpret_cast<LoadNanoappCommitRequestT *>(table) : nullptr;
+  }
+  LoadCachedNanoappRequestT *AsLoadCachedNanoappRequest() {
+    return type == ChreMessage::LoadCachedNanoappRequest ?
+      reinterpret_cast<LoadCachedNanoappRequestT *>(table) : nullptr;
+  }
+  MessageSubscriptionRequestT *AsMessageSubscriptionRequest() {
+    return type == ChreMessage::MessageSubscriptionRequest ?
+      reinterpret_cast<MessageSubscriptionRequestT *>(table) : nullptr;
+  }
+  NanoappStatusChangeT *AsNanoappStatusChange() {
+    return type == ChreMessage::NanoappStatusChange ?
+      reinterpret_cast<NanoappStatusChangeT *>(table) : nullptr;
+  }
+  TimeSyncProbeT *AsTimeSyncProbe() {
+    return type == ChreMessage::TimeSyncProbe ?
+      reinterpret_cast<TimeSyncProbeT *>(table) : nullptr;
+  }
+  TimeSyncProbeResponseT *AsTimeSyncProbeResponse() {
+    return type == ChreMessage::TimeSyncProbeResponse ?
+      reinterpret_cast<TimeSyncProbeResponseT *>(table) : nullptr;
+  }
 };
 
 bool VerifyChreMessage(flatbuffers::Verifier &verifier, const void *obj, ChreMessage type);
@@ -466,6 +570,7 @@ struct HubInfoResponseT : public flatbuffers::NativeTable {
   uint32_t max_msg_len;
   uint64_t platform_id;
   uint32_t chre_platform_version;
+  bool supports_cached_load;
   HubInfoResponseT()
       : platform_version(0),
         toolchain_version(0),
@@ -475,7 +580,8 @@ struct HubInfoResponseT : public flatbuffers::NativeTable {
         peak_power(0.0f),
         max_msg_len(0),
         platform_id(0),
-        chre_platform_version(0) {
+        chre_platform_version(0),
+        supports_cached_load(false) {
   }
 };
 
@@ -493,7 +599,8 @@ struct HubInfoResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_PEAK_POWER = 20,
     VT_MAX_MSG_LEN = 22,
     VT_PLATFORM_ID = 24,
-    VT_CHRE_PLATFORM_VERSION = 26
+    VT_CHRE_PLATFORM_VERSION = 26,
+    VT_SUPPORTS_CACHED_LOAD = 28
   };
   /// The name of the hub. Nominally a UTF-8 string, but note that we're not
   /// using the built-in "string" data type from FlatBuffers here, because the
@@ -577,6 +684,14 @@ struct HubInfoResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   bool mutate_chre_platform_version(uint32_t _chre_platform_version) {
     return SetField(VT_CHRE_PLATFORM_VERSION, _chre_platform_version);
   }
+  /// Whether CHRE handles LoadCachedNanoappRequest. Hosts must not send that
+  /// request unless this is set, as older implementations drop it silently.
+  bool supports_cached_load() const {
+    return GetField<uint8_t>(VT_SUPPORTS_CACHED_LOAD, 0) != 0;
+  }
+  bool mutate_supports_cached_load(bool _supports_cached_load) {
+    return SetField(VT_SUPPORTS_CACHED_LOAD, static_cast<uint8_t>(_supports_cached_load));
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<flatbuffers::uoffset_t>(verifier, VT_NAME) &&
@@ -594,6 +709,7 @@ struct HubInfoResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint32_t>(verifier, VT_MAX_MSG_LEN) &&
            VerifyField<uint64_t>(verifier, VT_PLATFORM_ID) &&
            VerifyField<uint32_t>(verifier, VT_CHRE_PLATFORM_VERSION) &&
+           VerifyField<uint8_t>(verifier, VT_SUPPORTS_CACHED_LOAD) &&
            verifier.EndTable();
   }
   HubInfoResponseT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -640,13 +756,16 @@ struct HubInfoResponseBuilder {
   void add_chre_platform_version(uint32_t chre_platform_version) {
     fbb_.AddElement<uint32_t>(HubInfoResponse::VT_CHRE_PLATFORM_VERSION, chre_platform_version, 0);
   }
+  void add_supports_cached_load(bool supports_cached_load) {
+    fbb_.AddElement<uint8_t>(HubInfoResponse::VT_SUPPORTS_CACHED_LOAD, static_cast<uint8_t>(supports_cached_load), 0);
+  }
   HubInfoResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   HubInfoResponseBuilder &operator=(const HubInfoResponseBuilder &);
   flatbuffers::Offset<HubInfoResponse> Finish() {
-    const auto end = fbb_.EndTable(start_, 12);
+    const auto end = fbb_.EndTable(start_, 13);
     auto o = flatbuffers::Offset<HubInfoResponse>(end);
     return o;
   }
@@ -665,7 +784,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(
     float peak_power = 0.0f,
     uint32_t max_msg_len = 0,
     uint64_t platform_id = 0,
-    uint32_t chre_platform_version = 0) {
+    uint32_t chre_platform_version = 0,
+    bool supports_cached_load = false) {
   HubInfoResponseBuilder builder_(_fbb);
   builder_.add_platform_id(platform_id);
   builder_.add_chre_platform_version(chre_platform_version);
@@ -679,6 +799,7 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(
   builder_.add_toolchain(toolchain);
   builder_.add_vendor(vendor);
   builder_.add_name(name);
+  builder_.add_supports_cached_load(supports_cached_load);
   return builder_.Finish();
 }
 
@@ -695,7 +816,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponseDirect(
     float peak_power = 0.0f,
     uint32_t max_msg_len = 0,
     uint64_t platform_id = 0,
-    uint32_t chre_platform_version = 0) {
+    uint32_t chre_platform_version = 0,
+    bool supports_cached_load = false) {
   return chre::fbs::CreateHubInfoResponse(
       _fbb,
       name ? _fbb.CreateVector<int8_t>(*name) : 0,
@@ -709,7 +831,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponseDirect(
       peak_power,
       max_msg_len,
       platform_id,
-      chre_platform_version);
+      chre_platform_version,
+      supports_cached_load);
 }
 
 flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(flatbuffers::FlatBufferBuilder &_fbb, const HubInfoResponseT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -1065,9 +1188,11 @@ struct LoadNanoappResponseT : public flatbuffers::NativeTable {
   typedef LoadNanoappResponse TableType;
   uint32_t transaction_id;
   bool success;
+  bool cache_miss;
   LoadNanoappResponseT()
       : transaction_id(0),
-        success(false) {
+        success(false),
+        cache_miss(false) {
   }
 };
 
@@ -1075,7 +1200,8 @@ struct LoadNanoappResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   typedef LoadNanoappResponseT NativeTableType;
   enum {
     VT_TRANSACTION_ID = 4,
-    VT_SUCCESS = 6
+    VT_SUCCESS = 6,
+    VT_CACHE_MISS = 8
   };
   uint32_t transaction_id() const {
     return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
@@ -1089,10 +1215,20 @@ struct LoadNanoappResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   bool mutate_success(bool _success) {
     return SetField(VT_SUCCESS, static_cast<uint8_t>(_success));
   }
+  /// Set to true if the request was a LoadCachedNanoappRequest and CHRE does
+  /// not hold a matching binary in its cache; the host should retry by
+  /// transferring the binary
+  bool cache_miss() const {
+    return GetField<uint8_t>(VT_CACHE_MISS, 0) != 0;
+  }
+  bool mutate_cache_miss(bool _cache_miss) {
+    return SetField(VT_CACHE_MISS, static_cast<uint8_t>(_cache_miss));
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
            VerifyField<uint8_t>(verifier, VT_SUCCESS) &&
+           VerifyField<uint8_t>(verifier, VT_CACHE_MISS) &&
            verifier.EndTable();
   }
   LoadNanoappResponseT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1109,13 +1245,16 @@ struct LoadNanoappResponseBuilder {
   void add_success(bool success) {
     fbb_.AddElement<uint8_t>(LoadNanoappResponse::VT_SUCCESS, static_cast<uint8_t>(success), 0);
   }
+  void add_cache_miss(bool cache_miss) {
+    fbb_.AddElement<uint8_t>(LoadNanoappResponse::VT_CACHE_MISS, static_cast<uint8_t>(cache_miss), 0);
+  }
   LoadNanoappResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   LoadNanoappResponseBuilder &operator=(const LoadNanoappResponseBuilder &);
   flatbuffers::Offset<LoadNanoappResponse> Finish() {
-    const auto end = fbb_.EndTable(start_, 2);
+    const auto end = fbb_.EndTable(start_, 3);
     auto o = flatbuffers::Offset<LoadNanoappResponse>(end);
     return o;
   }
@@ -1124,9 +1263,11 @@ struct LoadNanoappResponseBuilder {
 inline flatbuffers::Offset<LoadNanoappResponse> CreateLoadNanoappResponse(
     flatbuffers::FlatBufferBuilder &_fbb,
     uint32_t transaction_id = 0,
-    bool success = false) {
+    bool success = false,
+    bool cache_miss = false) {
   LoadNanoappResponseBuilder builder_(_fbb);
   builder_.add_transaction_id(transaction_id);
+  builder_.add_cache_miss(cache_miss);
   builder_.add_success(success);
   return builder_.Finish();
 }
@@ -1376,8 +1517,10 @@ flatbuffers::Offset<LogMessage> CreateLogMessage(flatbuffers::FlatBufferBuilder
 struct TimeSyncMessageT : public flatbuffers::NativeTable {
   typedef TimeSyncMessage TableType;
   int64_t offset;
+  int64_t uncertainty;
   TimeSyncMessageT()
-      : offset(0) {
+      : offset(0),
+        uncertainty(0) {
   }
 };
 
@@ -1385,7 +1528,8 @@ struct TimeSyncMessageT : public flatbuffers::NativeTable {
 struct TimeSyncMessage FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef TimeSyncMessageT NativeTableType;
   enum {
-    VT_OFFSET = 4
+    VT_OFFSET = 4,
+    VT_UNCERTAINTY = 6
   };
   /// Offset between AP and CHRE timestamp
   int64_t offset() const {
@@ -1394,9 +1538,17 @@ struct TimeSyncMessage FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   bool mutate_offset(int64_t _offset) {
     return SetField(VT_OFFSET, _offset);
   }
+  /// Maximum error of the offset in nanoseconds, or 0 if unknown
+  int64_t uncertainty() const {
+    return GetField<int64_t>(VT_UNCERTAINTY, 0);
+  }
+  bool mutate_uncertainty(int64_t _uncertainty) {
+    return SetField(VT_UNCERTAINTY, _uncertainty);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int64_t>(verifier, VT_OFFSET) &&
+           VerifyField<int64_t>(verifier, VT_UNCERTAINTY) &&
            verifier.EndTable();
   }
   TimeSyncMessageT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1410,13 +1562,16 @@ struct TimeSyncMessageBuilder {
   void add_offset(int64_t offset) {
     fbb_.AddElement<int64_t>(TimeSyncMessage::VT_OFFSET, offset, 0);
   }
+  void add_uncertainty(int64_t uncertainty) {
+    fbb_.AddElement<int64_t>(TimeSyncMessage::VT_UNCERTAINTY, uncertainty, 0);
+  }
   TimeSyncMessageBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   TimeSyncMessageBuilder &operator=(const TimeSyncMessageBuilder &);
   flatbuffers::Offset<TimeSyncMessage> Finish() {
-    const auto end = fbb_.EndTable(start_, 1);
+    const auto end = fbb_.EndTable(start_, 2);
     auto o = flatbuffers::Offset<TimeSyncMessage>(end);
     return o;
   }
@@ -1424,8 +1579,10 @@ struct TimeSyncMessageBuilder {
 
 inline flatbuffers::Offset<TimeSyncMessage> CreateTimeSyncMessage(
     flatbuffers::FlatBufferBuilder &_fbb,
-    int64_t offset = 0) {
+    int64_t offset = 0,
+    int64_t uncertainty = 0) {
   TimeSyncMessageBuilder builder_(_fbb);
+  builder_.add_uncertainty(uncertainty);
   builder_.add_offset(offset);
   return builder_.Finish();
 }
@@ -1658,156 +1815,994 @@ inline flatbuffers::Offset<TimeSyncRequest> CreateTimeSyncRequest(
 
 flatbuffers::Offset<TimeSyncRequest> CreateTimeSyncRequest(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
-struct MessageContainerT : public flatbuffers::NativeTable {
-  typedef MessageContainer TableType;
-  ChreMessageUnion message;
-  std::unique_ptr<HostAddress> host_addr;
-  MessageContainerT() {
+struct LoadNanoappBeginRequestT : public flatbuffers::NativeTable {
+  typedef LoadNanoappBeginRequest TableType;
+  uint32_t transaction_id;
+  uint64_t app_id;
+  uint32_t app_version;
+  uint32_t target_api_version;
+  uint32_t total_app_size;
+  LoadNanoappBeginRequestT()
+      : transaction_id(0),
+        app_id(0),
+        app_version(0),
+        target_api_version(0),
+        total_app_size(0) {
   }
 };
 
-/// The top-level container that encapsulates all possible messages. Note that
-/// per FlatBuffers requirements, we can't use a union as the top-level
-/// structure (root type), so we must wrap it in a table.
-struct MessageContainer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
-  typedef MessageContainerT NativeTableType;
+/// Starts a fragmented nanoapp load transaction. The binary is delivered in
+/// one or more LoadNanoappFragment messages, followed by a
+/// LoadNanoappCommitRequest. Other messages may be interleaved with the
+/// transfer. The result is reported via LoadNanoappResponse, which may be sent
+/// early if the transaction fails before it is committed.
+struct LoadNanoappBeginRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LoadNanoappBeginRequestT NativeTableType;
   enum {
-    VT_MESSAGE_TYPE = 4,
-    VT_MESSAGE = 6,
-    VT_HOST_ADDR = 8
+    VT_TRANSACTION_ID = 4,
+    VT_APP_ID = 6,
+    VT_APP_VERSION = 8,
+    VT_TARGET_API_VERSION = 10,
+    VT_TOTAL_APP_SIZE = 12
   };
-  ChreMessage message_type() const {
-    return static_cast<ChreMessage>(GetField<uint8_t>(VT_MESSAGE_TYPE, 0));
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
   }
-  bool mutate_message_type(ChreMessage _message_type) {
-    return SetField(VT_MESSAGE_TYPE, static_cast<uint8_t>(_message_type));
+  bool mutate_transaction_id(uint32_t _transaction_id) {
+    return SetField(VT_TRANSACTION_ID, _transaction_id);
   }
-  const void *message() const {
-    return GetPointer<const void *>(VT_MESSAGE);
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
   }
-  void *mutable_message() {
-    return GetPointer<void *>(VT_MESSAGE);
+  bool mutate_app_id(uint64_t _app_id) {
+    return SetField(VT_APP_ID, _app_id);
   }
-  /// The originating or destination client ID on the host side, used to direct
-  /// responses only to the client that sent the request. Although initially
-  /// populated by the requesting client, this is enforced to be the correct
-  /// value by the entity guarding access to CHRE.
-  /// This is wrapped in a struct to ensure that it is always included when
-  /// encoding the message, so it can be mutated by the host daemon.
-  const HostAddress *host_addr() const {
-    return GetStruct<const HostAddress *>(VT_HOST_ADDR);
+  uint32_t app_version() const {
+    return GetField<uint32_t>(VT_APP_VERSION, 0);
   }
-  HostAddress *mutable_host_addr() {
-    return GetStruct<HostAddress *>(VT_HOST_ADDR);
+  bool mutate_app_version(uint32_t _app_version) {
+    return SetField(VT_APP_VERSION, _app_version);
+  }
+  uint32_t target_api_version() const {
+    return GetField<uint32_t>(VT_TARGET_API_VERSION, 0);
+  }
+  bool mutate_target_api_version(uint32_t _target_api_version) {
+    return SetField(VT_TARGET_API_VERSION, _target_api_version);
+  }
+  /// Total size of the app binary, in bytes
+  uint32_t total_app_size() const {
+    return GetField<uint32_t>(VT_TOTAL_APP_SIZE, 0);
+  }
+  bool mutate_total_app_size(uint32_t _total_app_size) {
+    return SetField(VT_TOTAL_APP_SIZE, _total_app_size);
   }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
-           VerifyField<uint8_t>(verifier, VT_MESSAGE_TYPE) &&
-           VerifyFieldRequired<flatbuffers::uoffset_t>(verifier, VT_MESSAGE) &&
-           VerifyChreMessage(verifier, message(), message_type()) &&
-           VerifyFieldRequired<HostAddress>(verifier, VT_HOST_ADDR) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_APP_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_TARGET_API_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_TOTAL_APP_SIZE) &&
            verifier.EndTable();
   }
-  MessageContainerT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
-  void UnPackTo(MessageContainerT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
-  static flatbuffers::Offset<MessageContainer> Pack(flatbuffers::FlatBufferBuilder &_fbb, const MessageContainerT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  LoadNanoappBeginRequestT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LoadNanoappBeginRequestT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<LoadNanoappBeginRequest> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappBeginRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 };
 
-struct MessageContainerBuilder {
+struct LoadNanoappBeginRequestBuilder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
-  void add_message_type(ChreMessage message_type) {
-    fbb_.AddElement<uint8_t>(MessageContainer::VT_MESSAGE_TYPE, static_cast<uint8_t>(message_type), 0);
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_TRANSACTION_ID, transaction_id, 0);
   }
-  void add_message(flatbuffers::Offset<void> message) {
-    fbb_.AddOffset(MessageContainer::VT_MESSAGE, message);
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(LoadNanoappBeginRequest::VT_APP_ID, app_id, 0);
   }
-  void add_host_addr(const HostAddress *host_addr) {
-    fbb_.AddStruct(MessageContainer::VT_HOST_ADDR, host_addr);
+  void add_app_version(uint32_t app_version) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_APP_VERSION, app_version, 0);
   }
-  MessageContainerBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+  void add_target_api_version(uint32_t target_api_version) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_TARGET_API_VERSION, target_api_version, 0);
+  }
+  void add_total_app_size(uint32_t total_app_size) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_TOTAL_APP_SIZE, total_app_size, 0);
+  }
+  LoadNanoappBeginRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
-  MessageContainerBuilder &operator=(const MessageContainerBuilder &);
-  flatbuffers::Offset<MessageContainer> Finish() {
-    const auto end = fbb_.EndTable(start_, 3);
-    auto o = flatbuffers::Offset<MessageContainer>(end);
-    fbb_.Required(o, MessageContainer::VT_MESSAGE);
-    fbb_.Required(o, MessageContainer::VT_HOST_ADDR);
+  LoadNanoappBeginRequestBuilder &operator=(const LoadNanoappBeginRequestBuilder &);
+  flatbuffers::Offset<LoadNanoappBeginRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 5);
+    auto o = flatbuffers::Offset<LoadNanoappBeginRequest>(end);
     return o;
   }
 };
 
-inline flatbuffers::Offset<MessageContainer> CreateMessageContainer(
+inline flatbuffers::Offset<LoadNanoappBeginRequest> CreateLoadNanoappBeginRequest(
     flatbuffers::FlatBufferBuilder &_fbb,
-    ChreMessage message_type = ChreMessage::NONE,
-    flatbuffers::Offset<void> message = 0,
-    const HostAddress *host_addr = 0) {
-  MessageContainerBuilder builder_(_fbb);
-  builder_.add_host_addr(host_addr);
-  builder_.add_message(message);
-  builder_.add_message_type(message_type);
+    uint32_t transaction_id = 0,
+    uint64_t app_id = 0,
+    uint32_t app_version = 0,
+    uint32_t target_api_version = 0,
+    uint32_t total_app_size = 0) {
+  LoadNanoappBeginRequestBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_total_app_size(total_app_size);
+  builder_.add_target_api_version(target_api_version);
+  builder_.add_app_version(app_version);
+  builder_.add_transaction_id(transaction_id);
   return builder_.Finish();
 }
 
-flatbuffers::Offset<MessageContainer> CreateMessageContainer(flatbuffers::FlatBufferBuilder &_fbb, const MessageContainerT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+flatbuffers::Offset<LoadNanoappBeginRequest> CreateLoadNanoappBeginRequest(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappBeginRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
-inline NanoappMessageT *NanoappMessage::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
-  auto _o = new NanoappMessageT();
-  UnPackTo(_o, _resolver);
-  return _o;
-}
+struct LoadNanoappFragmentT : public flatbuffers::NativeTable {
+  typedef LoadNanoappFragment TableType;
+  uint32_t transaction_id;
+  uint32_t offset;
+  std::vector<uint8_t> data;
+  LoadNanoappFragmentT()
+      : transaction_id(0),
+        offset(0) {
+  }
+};
 
-inline void NanoappMessage::UnPackTo(NanoappMessageT *_o, const flatbuffers::resolver_function_t *_resolver) const {
-  (void)_o;
-  (void)_resolver;
-  { auto _e = app_id(); _o->app_id = _e; };
-  { auto _e = message_type(); _o->message_type = _e; };
-  { auto _e = host_endpoint(); _o->host_endpoint = _e; };
-  { auto _e = message(); if (_e) for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->message.push_back(_e->Get(_i)); } };
-}
+struct LoadNanoappFragment FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LoadNanoappFragmentT NativeTableType;
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_OFFSET = 6,
+    VT_DATA = 8
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  bool mutate_transaction_id(uint32_t _transaction_id) {
+    return SetField(VT_TRANSACTION_ID, _transaction_id);
+  }
+  /// Byte offset of this fragment within the app binary. Fragments must be
+  /// sent in order, so this is always equal to the sum of the sizes of all
+  /// previous fragments in the transaction.
+  uint32_t offset() const {
+    return GetField<uint32_t>(VT_OFFSET, 0);
+  }
+  bool mutate_offset(uint32_t _offset) {
+    return SetField(VT_OFFSET, _offset);
+  }
+  const flatbuffers::Vector<uint8_t> *data() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DATA);
+  }
+  flatbuffers::Vector<uint8_t> *mutable_data() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint32_t>(verifier, VT_OFFSET) &&
+           VerifyFieldRequired<flatbuffers::uoffset_t>(verifier, VT_DATA) &&
+           verifier.Verify(data()) &&
+           verifier.EndTable();
+  }
+  LoadNanoappFragmentT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LoadNanoappFragmentT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<LoadNanoappFragment> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappFragmentT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
 
-inline flatbuffers::Offset<NanoappMessage> NanoappMessage::Pack(flatbuffers::FlatBufferBuilder &_fbb, const NanoappMessageT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
-  return CreateNanoappMessage(_fbb, _o, _rehasher);
-}
+struct LoadNanoappFragmentBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadNanoappFragment::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_offset(uint32_t offset) {
+    fbb_.AddElement<uint32_t>(LoadNanoappFragment::VT_OFFSET, offset, 0);
+  }
+  void add_data(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data) {
+    fbb_.AddOffset(LoadNanoappFragment::VT_DATA, data);
+  }
+  LoadNanoappFragmentBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadNanoappFragmentBuilder &operator=(const LoadNanoappFragmentBuilder &);
+  flatbuffers::Offset<LoadNanoappFragment> Finish() {
+    const auto end = fbb_.EndTable(start_, 3);
+    auto o = flatbuffers::Offset<LoadNanoappFragment>(end);
+    fbb_.Required(o, LoadNanoappFragment::VT_DATA);
+    return o;
+  }
+};
 
-inline flatbuffers::Offset<NanoappMessage> CreateNanoappMessage(flatbuffers::FlatBufferBuilder &_fbb, const NanoappMessageT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
-  (void)_rehasher;
-  (void)_o;
-  auto _app_id = _o->app_id;
-  auto _message_type = _o->message_type;
-  auto _host_endpoint = _o->host_endpoint;
-  auto _message = _fbb.CreateVector(_o->message);
-  return chre::fbs::CreateNanoappMessage(
-      _fbb,
-      _app_id,
-      _message_type,
-      _host_endpoint,
-      _message);
+inline flatbuffers::Offset<LoadNanoappFragment> CreateLoadNanoappFragment(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint32_t offset = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0) {
+  LoadNanoappFragmentBuilder builder_(_fbb);
+  builder_.add_data(data);
+  builder_.add_offset(offset);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
 }
 
-inline HubInfoRequestT *HubInfoRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
-  auto _o = new HubInfoRequestT();
-  UnPackTo(_o, _resolver);
-  return _o;
+inline flatbuffers::Offset<LoadNanoappFragment> CreateLoadNanoappFragmentDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint32_t offset = 0,
+    const std::vector<uint8_t> *data = nullptr) {
+  return chre::fbs::CreateLoadNanoappFragment(
+      _fbb,
+      transaction_id,
+      offset,
+      data ? _fbb.CreateVector<uint8_t>(*data) : 0);
 }
 
-inline void HubInfoRequest::UnPackTo(HubInfoRequestT *_o, const flatbuffers::resolver_function_t *_resolver) const {
-  (void)_o;
-  (void)_resolver;
-}
+flatbuffers::Offset<LoadNanoappFragment> CreateLoadNanoappFragment(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappFragmentT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
-inline flatbuffers::Offset<HubInfoRequest> HubInfoRequest::Pack(flatbuffers::FlatBufferBuilder &_fbb, const HubInfoRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
-  return CreateHubInfoRequest(_fbb, _o, _rehasher);
-}
+struct LoadNanoappCommitRequestT : public flatbuffers::NativeTable {
+  typedef LoadNanoappCommitRequest TableType;
+  uint32_t transaction_id;
+  uint32_t crc32;
+  LoadNanoappCommitRequestT()
+      : transaction_id(0),
+        crc32(0) {
+  }
+};
 
-inline flatbuffers::Offset<HubInfoRequest> CreateHubInfoRequest(flatbuffers::FlatBufferBuilder &_fbb, const HubInfoRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
-  (void)_rehasher;
-  (void)_o;
-  return chre::fbs::CreateHubInfoRequest(
-      _fbb);
-}
+struct LoadNanoappCommitRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LoadNanoappCommitRequestT NativeTableType;
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_CRC32 = 6
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  bool mutate_transaction_id(uint32_t _transaction_id) {
+    return SetField(VT_TRANSACTION_ID, _transaction_id);
+  }
+  /// CRC-32 (as used by IEEE 802.3) of the complete app binary
+  uint32_t crc32() const {
+    return GetField<uint32_t>(VT_CRC32, 0);
+  }
+  bool mutate_crc32(uint32_t _crc32) {
+    return SetField(VT_CRC32, _crc32);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint32_t>(verifier, VT_CRC32) &&
+           verifier.EndTable();
+  }
+  LoadNanoappCommitRequestT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LoadNanoappCommitRequestT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<LoadNanoappCommitRequest> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappCommitRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct LoadNanoappCommitRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadNanoappCommitRequest::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_crc32(uint32_t crc32) {
+    fbb_.AddElement<uint32_t>(LoadNanoappCommitRequest::VT_CRC32, crc32, 0);
+  }
+  LoadNanoappCommitRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadNanoappCommitRequestBuilder &operator=(const LoadNanoappCommitRequestBuilder &);
+  flatbuffers::Offset<LoadNanoappCommitRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 2);
+    auto o = flatbuffers::Offset<LoadNanoappCommitRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LoadNanoappCommitRequest> CreateLoadNanoappCommitRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint32_t crc32 = 0) {
+  LoadNanoappCommitRequestBuilder builder_(_fbb);
+  builder_.add_crc32(crc32);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<LoadNanoappCommitRequest> CreateLoadNanoappCommitRequest(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappCommitRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct LoadCachedNanoappRequestT : public flatbuffers::NativeTable {
+  typedef LoadCachedNanoappRequest TableType;
+  uint32_t transaction_id;
+  uint64_t app_id;
+  uint32_t app_version;
+  uint32_t target_api_version;
+  uint32_t crc32;
+  LoadCachedNanoappRequestT()
+      : transaction_id(0),
+        app_id(0),
+        app_version(0),
+        target_api_version(0),
+        crc32(0) {
+  }
+};
+
+/// Requests that CHRE load a nanoapp from a binary it has cached from a previous
+/// load, avoiding the need to transfer it again. The binary is identified by
+/// its app ID, version and CRC-32, as supplied when it was originally loaded
+/// via LoadNanoappCommitRequest. The result is reported via
+/// LoadNanoappResponse.
+struct LoadCachedNanoappRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LoadCachedNanoappRequestT NativeTableType;
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_APP_ID = 6,
+    VT_APP_VERSION = 8,
+    VT_TARGET_API_VERSION = 10,
+    VT_CRC32 = 12
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  bool mutate_transaction_id(uint32_t _transaction_id) {
+    return SetField(VT_TRANSACTION_ID, _transaction_id);
+  }
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  bool mutate_app_id(uint64_t _app_id) {
+    return SetField(VT_APP_ID, _app_id);
+  }
+  uint32_t app_version() const {
+    return GetField<uint32_t>(VT_APP_VERSION, 0);
+  }
+  bool mutate_app_version(uint32_t _app_version) {
+    return SetField(VT_APP_VERSION, _app_version);
+  }
+  uint32_t target_api_version() const {
+    return GetField<uint32_t>(VT_TARGET_API_VERSION, 0);
+  }
+  bool mutate_target_api_version(uint32_t _target_api_version) {
+    return SetField(VT_TARGET_API_VERSION, _target_api_version);
+  }
+  /// CRC-32 (as used by IEEE 802.3) of the complete app binary
+  uint32_t crc32() const {
+    return GetField<uint32_t>(VT_CRC32, 0);
+  }
+  bool mutate_crc32(uint32_t _crc32) {
+    return SetField(VT_CRC32, _crc32);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_APP_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_TARGET_API_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_CRC32) &&
+           verifier.EndTable();
+  }
+  LoadCachedNanoappRequestT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LoadCachedNanoappRequestT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<LoadCachedNanoappRequest> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadCachedNanoappRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct LoadCachedNanoappRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(LoadCachedNanoappRequest::VT_APP_ID, app_id, 0);
+  }
+  void add_app_version(uint32_t app_version) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_APP_VERSION, app_version, 0);
+  }
+  void add_target_api_version(uint32_t target_api_version) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_TARGET_API_VERSION, target_api_version, 0);
+  }
+  void add_crc32(uint32_t crc32) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_CRC32, crc32, 0);
+  }
+  LoadCachedNanoappRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadCachedNanoappRequestBuilder &operator=(const LoadCachedNanoappRequestBuilder &);
+  flatbuffers::Offset<LoadCachedNanoappRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 5);
+    auto o = flatbuffers::Offset<LoadCachedNanoappRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LoadCachedNanoappRequest> CreateLoadCachedNanoappRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint64_t app_id = 0,
+    uint32_t app_version = 0,
+    uint32_t target_api_version = 0,
+    uint32_t crc32 = 0) {
+  LoadCachedNanoappRequestBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_crc32(crc32);
+  builder_.add_target_api_version(target_api_version);
+  builder_.add_app_version(app_version);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<LoadCachedNanoappRequest> CreateLoadCachedNanoappRequest(flatbuffers::FlatBufferBuilder &_fbb, const LoadCachedNanoappRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct MessageSubscriptionRequestT : public flatbuffers::NativeTable {
+  typedef MessageSubscriptionRequest TableType;
+  bool subscribe;
+  uint64_t app_id;
+  bool match_any_app_id;
+  uint32_t message_type;
+  bool match_any_message_type;
+  MessageSubscriptionRequestT()
+      : subscribe(true),
+        app_id(0),
+        match_any_app_id(false),
+        message_type(0),
+        match_any_message_type(false) {
+  }
+};
+
+/// Sent by a host client to select which broadcast NanoappMessages (those with
+/// an unspecified host endpoint) it receives. This message is handled by the
+/// host daemon and is not delivered to CHRE. A client that holds no
+/// subscriptions receives all broadcasts; once it has added a subscription, it
+/// only receives broadcasts that match at least one of its subscriptions.
+/// Messages addressed to a specific client are always delivered.
+struct MessageSubscriptionRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef MessageSubscriptionRequestT NativeTableType;
+  enum {
+    VT_SUBSCRIBE = 4,
+    VT_APP_ID = 6,
+    VT_MATCH_ANY_APP_ID = 8,
+    VT_MESSAGE_TYPE = 10,
+    VT_MATCH_ANY_MESSAGE_TYPE = 12
+  };
+  /// true to add this subscription, false to remove a previously added one
+  /// with identical fields
+  bool subscribe() const {
+    return GetField<uint8_t>(VT_SUBSCRIBE, 1) != 0;
+  }
+  bool mutate_subscribe(bool _subscribe) {
+    return SetField(VT_SUBSCRIBE, static_cast<uint8_t>(_subscribe));
+  }
+  /// The app ID of the nanoapp whose messages are wanted. Ignored if
+  /// match_any_app_id is set.
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  bool mutate_app_id(uint64_t _app_id) {
+    return SetField(VT_APP_ID, _app_id);
+  }
+  bool match_any_app_id() const {
+    return GetField<uint8_t>(VT_MATCH_ANY_APP_ID, 0) != 0;
+  }
+  bool mutate_match_any_app_id(bool _match_any_app_id) {
+    return SetField(VT_MATCH_ANY_APP_ID, static_cast<uint8_t>(_match_any_app_id));
+  }
+  /// The message type wanted. Ignored if match_any_message_type is set.
+  uint32_t message_type() const {
+    return GetField<uint32_t>(VT_MESSAGE_TYPE, 0);
+  }
+  bool mutate_message_type(uint32_t _message_type) {
+    return SetField(VT_MESSAGE_TYPE, _message_type);
+  }
+  bool match_any_message_type() const {
+    return GetField<uint8_t>(VT_MATCH_ANY_MESSAGE_TYPE, 0) != 0;
+  }
+  bool mutate_match_any_message_type(bool _match_any_message_type) {
+    return SetField(VT_MATCH_ANY_MESSAGE_TYPE, static_cast<uint8_t>(_match_any_message_type));
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_SUBSCRIBE) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint8_t>(verifier, VT_MATCH_ANY_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_MESSAGE_TYPE) &&
+           VerifyField<uint8_t>(verifier, VT_MATCH_ANY_MESSAGE_TYPE) &&
+           verifier.EndTable();
+  }
+  MessageSubscriptionRequestT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(MessageSubscriptionRequestT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<MessageSubscriptionRequest> Pack(flatbuffers::FlatBufferBuilder &_fbb, const MessageSubscriptionRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct MessageSubscriptionRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_subscribe(bool subscribe) {
+    fbb_.AddElement<uint8_t>(MessageSubscriptionRequest::VT_SUBSCRIBE, static_cast<uint8_t>(subscribe), 1);
+  }
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(MessageSubscriptionRequest::VT_APP_ID, app_id, 0);
+  }
+  void add_match_any_app_id(bool match_any_app_id) {
+    fbb_.AddElement<uint8_t>(MessageSubscriptionRequest::VT_MATCH_ANY_APP_ID, static_cast<uint8_t>(match_any_app_id), 0);
+  }
+  void add_message_type(uint32_t message_type) {
+    fbb_.AddElement<uint32_t>(MessageSubscriptionRequest::VT_MESSAGE_TYPE, message_type, 0);
+  }
+  void add_match_any_message_type(bool match_any_message_type) {
+    fbb_.AddElement<uint8_t>(MessageSubscriptionRequest::VT_MATCH_ANY_MESSAGE_TYPE, static_cast<uint8_t>(match_any_message_type), 0);
+  }
+  MessageSubscriptionRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MessageSubscriptionRequestBuilder &operator=(const MessageSubscriptionRequestBuilder &);
+  flatbuffers::Offset<MessageSubscriptionRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 5);
+    auto o = flatbuffers::Offset<MessageSubscriptionRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MessageSubscriptionRequest> CreateMessageSubscriptionRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    bool subscribe = true,
+    uint64_t app_id = 0,
+    bool match_any_app_id = false,
+    uint32_t message_type = 0,
+    bool match_any_message_type = false) {
+  MessageSubscriptionRequestBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_message_type(message_type);
+  builder_.add_match_any_message_type(match_any_message_type);
+  builder_.add_match_any_app_id(match_any_app_id);
+  builder_.add_subscribe(subscribe);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<MessageSubscriptionRequest> CreateMessageSubscriptionRequest(flatbuffers::FlatBufferBuilder &_fbb, const MessageSubscriptionRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct NanoappStatusChangeT : public flatbuffers::NativeTable {
+  typedef NanoappStatusChange TableType;
+  uint64_t app_id;
+  uint32_t app_version;
+  uint32_t instance_id;
+  bool started;
+  NanoappStatusChangeT()
+      : app_id(0),
+        app_version(0),
+        instance_id(0),
+        started(false) {
+  }
+};
+
+/// Sent by CHRE whenever a nanoapp starts or stops, including loads and unloads
+/// not requested by the host. Consumed by the host daemon to keep its cached
+/// NanoappListResponse up to date; not delivered to clients.
+struct NanoappStatusChange FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef NanoappStatusChangeT NativeTableType;
+  enum {
+    VT_APP_ID = 4,
+    VT_APP_VERSION = 6,
+    VT_INSTANCE_ID = 8,
+    VT_STARTED = 10
+  };
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  bool mutate_app_id(uint64_t _app_id) {
+    return SetField(VT_APP_ID, _app_id);
+  }
+  uint32_t app_version() const {
+    return GetField<uint32_t>(VT_APP_VERSION, 0);
+  }
+  bool mutate_app_version(uint32_t _app_version) {
+    return SetField(VT_APP_VERSION, _app_version);
+  }
+  uint32_t instance_id() const {
+    return GetField<uint32_t>(VT_INSTANCE_ID, 0);
+  }
+  bool mutate_instance_id(uint32_t _instance_id) {
+    return SetField(VT_INSTANCE_ID, _instance_id);
+  }
+  /// true if the nanoapp started, false if it stopped
+  bool started() const {
+    return GetField<uint8_t>(VT_STARTED, 0) != 0;
+  }
+  bool mutate_started(bool _started) {
+    return SetField(VT_STARTED, static_cast<uint8_t>(_started));
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_APP_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_INSTANCE_ID) &&
+           VerifyField<uint8_t>(verifier, VT_STARTED) &&
+           verifier.EndTable();
+  }
+  NanoappStatusChangeT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(NanoappStatusChangeT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<NanoappStatusChange> Pack(flatbuffers::FlatBufferBuilder &_fbb, const NanoappStatusChangeT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct NanoappStatusChangeBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(NanoappStatusChange::VT_APP_ID, app_id, 0);
+  }
+  void add_app_version(uint32_t app_version) {
+    fbb_.AddElement<uint32_t>(NanoappStatusChange::VT_APP_VERSION, app_version, 0);
+  }
+  void add_instance_id(uint32_t instance_id) {
+    fbb_.AddElement<uint32_t>(NanoappStatusChange::VT_INSTANCE_ID, instance_id, 0);
+  }
+  void add_started(bool started) {
+    fbb_.AddElement<uint8_t>(NanoappStatusChange::VT_STARTED, static_cast<uint8_t>(started), 0);
+  }
+  NanoappStatusChangeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  NanoappStatusChangeBuilder &operator=(const NanoappStatusChangeBuilder &);
+  flatbuffers::Offset<NanoappStatusChange> Finish() {
+    const auto end = fbb_.EndTable(start_, 4);
+    auto o = flatbuffers::Offset<NanoappStatusChange>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<NanoappStatusChange> CreateNanoappStatusChange(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t app_id = 0,
+    uint32_t app_version = 0,
+    uint32_t instance_id = 0,
+    bool started = false) {
+  NanoappStatusChangeBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_instance_id(instance_id);
+  builder_.add_app_version(app_version);
+  builder_.add_started(started);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<NanoappStatusChange> CreateNanoappStatusChange(flatbuffers::FlatBufferBuilder &_fbb, const NanoappStatusChangeT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct TimeSyncProbeT : public flatbuffers::NativeTable {
+  typedef TimeSyncProbe TableType;
+  uint32_t sequence;
+  int64_t host_send_time;
+  TimeSyncProbeT()
+      : sequence(0),
+        host_send_time(0) {
+  }
+};
+
+/// Sent by the host daemon to measure the offset between the AP and CHRE
+/// clocks. CHRE replies with a TimeSyncProbeResponse, and the daemon sends a
+/// TimeSyncMessage once it has collected enough probes.
+struct TimeSyncProbe FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef TimeSyncProbeT NativeTableType;
+  enum {
+    VT_SEQUENCE = 4,
+    VT_HOST_SEND_TIME = 6
+  };
+  /// Identifies the probe within the current exchange
+  uint32_t sequence() const {
+    return GetField<uint32_t>(VT_SEQUENCE, 0);
+  }
+  bool mutate_sequence(uint32_t _sequence) {
+    return SetField(VT_SEQUENCE, _sequence);
+  }
+  /// AP time the probe was sent, in nanoseconds
+  int64_t host_send_time() const {
+    return GetField<int64_t>(VT_HOST_SEND_TIME, 0);
+  }
+  bool mutate_host_send_time(int64_t _host_send_time) {
+    return SetField(VT_HOST_SEND_TIME, _host_send_time);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_SEQUENCE) &&
+           VerifyField<int64_t>(verifier, VT_HOST_SEND_TIME) &&
+           verifier.EndTable();
+  }
+  TimeSyncProbeT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(TimeSyncProbeT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<TimeSyncProbe> Pack(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct TimeSyncProbeBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_sequence(uint32_t sequence) {
+    fbb_.AddElement<uint32_t>(TimeSyncProbe::VT_SEQUENCE, sequence, 0);
+  }
+  void add_host_send_time(int64_t host_send_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbe::VT_HOST_SEND_TIME, host_send_time, 0);
+  }
+  TimeSyncProbeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  TimeSyncProbeBuilder &operator=(const TimeSyncProbeBuilder &);
+  flatbuffers::Offset<TimeSyncProbe> Finish() {
+    const auto end = fbb_.EndTable(start_, 2);
+    auto o = flatbuffers::Offset<TimeSyncProbe>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<TimeSyncProbe> CreateTimeSyncProbe(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t sequence = 0,
+    int64_t host_send_time = 0) {
+  TimeSyncProbeBuilder builder_(_fbb);
+  builder_.add_host_send_time(host_send_time);
+  builder_.add_sequence(sequence);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<TimeSyncProbe> CreateTimeSyncProbe(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct TimeSyncProbeResponseT : public flatbuffers::NativeTable {
+  typedef TimeSyncProbeResponse TableType;
+  uint32_t sequence;
+  int64_t host_send_time;
+  int64_t chre_receive_time;
+  int64_t chre_send_time;
+  TimeSyncProbeResponseT()
+      : sequence(0),
+        host_send_time(0),
+        chre_receive_time(0),
+        chre_send_time(0) {
+  }
+};
+
+struct TimeSyncProbeResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef TimeSyncProbeResponseT NativeTableType;
+  enum {
+    VT_SEQUENCE = 4,
+    VT_HOST_SEND_TIME = 6,
+    VT_CHRE_RECEIVE_TIME = 8,
+    VT_CHRE_SEND_TIME = 10
+  };
+  /// Copied from the TimeSyncProbe
+  uint32_t sequence() const {
+    return GetField<uint32_t>(VT_SEQUENCE, 0);
+  }
+  bool mutate_sequence(uint32_t _sequence) {
+    return SetField(VT_SEQUENCE, _sequence);
+  }
+  int64_t host_send_time() const {
+    return GetField<int64_t>(VT_HOST_SEND_TIME, 0);
+  }
+  bool mutate_host_send_time(int64_t _host_send_time) {
+    return SetField(VT_HOST_SEND_TIME, _host_send_time);
+  }
+  /// CHRE time the probe was received and the response was sent, in
+  /// nanoseconds
+  int64_t chre_receive_time() const {
+    return GetField<int64_t>(VT_CHRE_RECEIVE_TIME, 0);
+  }
+  bool mutate_chre_receive_time(int64_t _chre_receive_time) {
+    return SetField(VT_CHRE_RECEIVE_TIME, _chre_receive_time);
+  }
+  int64_t chre_send_time() const {
+    return GetField<int64_t>(VT_CHRE_SEND_TIME, 0);
+  }
+  bool mutate_chre_send_time(int64_t _chre_send_time) {
+    return SetField(VT_CHRE_SEND_TIME, _chre_send_time);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_SEQUENCE) &&
+           VerifyField<int64_t>(verifier, VT_HOST_SEND_TIME) &&
+           VerifyField<int64_t>(verifier, VT_CHRE_RECEIVE_TIME) &&
+           VerifyField<int64_t>(verifier, VT_CHRE_SEND_TIME) &&
+           verifier.EndTable();
+  }
+  TimeSyncProbeResponseT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(TimeSyncProbeResponseT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<TimeSyncProbeResponse> Pack(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeResponseT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct TimeSyncProbeResponseBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_sequence(uint32_t sequence) {
+    fbb_.AddElement<uint32_t>(TimeSyncProbeResponse::VT_SEQUENCE, sequence, 0);
+  }
+  void add_host_send_time(int64_t host_send_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbeResponse::VT_HOST_SEND_TIME, host_send_time, 0);
+  }
+  void add_chre_receive_time(int64_t chre_receive_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbeResponse::VT_CHRE_RECEIVE_TIME, chre_receive_time, 0);
+  }
+  void add_chre_send_time(int64_t chre_send_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbeResponse::VT_CHRE_SEND_TIME, chre_send_time, 0);
+  }
+  TimeSyncProbeResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  TimeSyncProbeResponseBuilder &operator=(const TimeSyncProbeResponseBuilder &);
+  flatbuffers::Offset<TimeSyncProbeResponse> Finish() {
+    const auto end = fbb_.EndTable(start_, 4);
+    auto o = flatbuffers::Offset<TimeSyncProbeResponse>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<TimeSyncProbeResponse> CreateTimeSyncProbeResponse(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t sequence = 0,
+    int64_t host_send_time = 0,
+    int64_t chre_receive_time = 0,
+    int64_t chre_send_time = 0) {
+  TimeSyncProbeResponseBuilder builder_(_fbb);
+  builder_.add_chre_send_time(chre_send_time);
+  builder_.add_chre_receive_time(chre_receive_time);
+  builder_.add_host_send_time(host_send_time);
+  builder_.add_sequence(sequence);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<TimeSyncProbeResponse> CreateTimeSyncProbeResponse(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeResponseT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct MessageContainerT : public flatbuffers::NativeTable {
+  typedef MessageContainer TableType;
+  ChreMessageUnion message;
+  std::unique_ptr<HostAddress> host_addr;
+  MessageContainerT() {
+  }
+};
+
+/// The top-level container that encapsulates all possible messages. Note that
+/// per FlatBuffers requirements, we can't use a union as the top-level
+/// structure (root type), so we must wrap it in a table.
+struct MessageContainer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef MessageContainerT NativeTableType;
+  enum {
+    VT_MESSAGE_TYPE = 4,
+    VT_MESSAGE = 6,
+    VT_HOST_ADDR = 8
+  };
+  ChreMessage message_type() const {
+    return static_cast<ChreMessage>(GetField<uint8_t>(VT_MESSAGE_TYPE, 0));
+  }
+  bool mutate_message_type(ChreMessage _message_type) {
+    return SetField(VT_MESSAGE_TYPE, static_cast<uint8_t>(_message_type));
+  }
+  const void *message() const {
+    return GetPointer<const void *>(VT_MESSAGE);
+  }
+  void *mutable_message() {
+    return GetPointer<void *>(VT_MESSAGE);
+  }
+  /// The originating or destination client ID on the host side, used to direct
+  /// responses only to the client that sent the request. Although initially
+  /// populated by the requesting client, this is enforced to be the correct
+  /// value by the entity guarding access to CHRE.
+  /// This is wrapped in a struct to ensure that it is always included when
+  /// encoding the message, so it can be mutated by the host daemon.
+  const HostAddress *host_addr() const {
+    return GetStruct<const HostAddress *>(VT_HOST_ADDR);
+  }
+  HostAddress *mutable_host_addr() {
+    return GetStruct<HostAddress *>(VT_HOST_ADDR);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_MESSAGE_TYPE) &&
+           VerifyFieldRequired<flatbuffers::uoffset_t>(verifier, VT_MESSAGE) &&
+           VerifyChreMessage(verifier, message(), message_type()) &&
+           VerifyFieldRequired<HostAddress>(verifier, VT_HOST_ADDR) &&
+           verifier.EndTable();
+  }
+  MessageContainerT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(MessageContainerT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<MessageContainer> Pack(flatbuffers::FlatBufferBuilder &_fbb, const MessageContainerT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct MessageContainerBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_message_type(ChreMessage message_type) {
+    fbb_.AddElement<uint8_t>(MessageContainer::VT_MESSAGE_TYPE, static_cast<uint8_t>(message_type), 0);
+  }
+  void add_message(flatbuffers::Offset<void> message) {
+    fbb_.AddOffset(MessageContainer::VT_MESSAGE, message);
+  }
+  void add_host_addr(const HostAddress *host_addr) {
+    fbb_.AddStruct(MessageContainer::VT_HOST_ADDR, host_addr);
+  }
+  MessageContainerBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MessageContainerBuilder &operator=(const MessageContainerBuilder &);
+  flatbuffers::Offset<MessageContainer> Finish() {
+    const auto end = fbb_.EndTable(start_, 3);
+    auto o = flatbuffers::Offset<MessageContainer>(end);
+    fbb_.Required(o, MessageContainer::VT_MESSAGE);
+    fbb_.Required(o, MessageContainer::VT_HOST_ADDR);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MessageContainer> CreateMessageContainer(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    ChreMessage message_type = ChreMessage::NONE,
+    flatbuffers::Offset<void> message = 0,
+    const HostAddress *host_addr = 0) {
+  MessageContainerBuilder builder_(_fbb);
+  builder_.add_host_addr(host_addr);
+  builder_.add_message(message);
+  builder_.add_message_type(message_type);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<MessageContainer> CreateMessageContainer(flatbuffers::FlatBufferBuilder &_fbb, const MessageContainerT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+inline NanoappMessageT *NanoappMessage::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new NanoappMessageT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void NanoappMessage::UnPackTo(NanoappMessageT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = app_id(); _o->app_id = _e; };
+  { auto _e = message_type(); _o->message_type = _e; };
+  { auto _e = host_endpoint(); _o->host_endpoint = _e; };
+  { auto _e = message(); if (_e) for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->message.push_back(_e->Get(_i)); } };
+}
+
+inline flatbuffers::Offset<NanoappMessage> NanoappMessage::Pack(flatbuffers::FlatBufferBuilder &_fbb, const NanoappMessageT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateNanoappMessage(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<NanoappMessage> CreateNanoappMessage(flatbuffers::FlatBufferBuilder &_fbb, const NanoappMessageT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _app_id = _o->app_id;
+  auto _message_type = _o->message_type;
+  auto _host_endpoint = _o->host_endpoint;
+  auto _message = _fbb.CreateVector(_o->message);
+  return chre::fbs::CreateNanoappMessage(
+      _fbb,
+      _app_id,
+      _message_type,
+      _host_endpoint,
+      _message);
+}
+
+inline HubInfoRequestT *HubInfoRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new HubInfoRequestT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void HubInfoRequest::UnPackTo(HubInfoRequestT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+}
+
+inline flatbuffers::Offset<HubInfoRequest> HubInfoRequest::Pack(flatbuffers::FlatBufferBuilder &_fbb, const HubInfoRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateHubInfoRequest(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<HubInfoRequest> CreateHubInfoRequest(flatbuffers::FlatBufferBuilder &_fbb, const HubInfoRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  return chre::fbs::CreateHubInfoRequest(
+      _fbb);
+}
 
 inline HubInfoResponseT *HubInfoResponse::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new HubInfoResponseT();
@@ -1830,6 +2825,7 @@ inline void HubInfoResponse::UnPackTo(HubInfoResponseT *_o, const flatbuffers::r
   { auto _e = max_msg_len(); _o->max_msg_len = _e; };
   { auto _e = platform_id(); _o->platform_id = _e; };
   { auto _e = chre_platform_version(); _o->chre_platform_version = _e; };
+  { auto _e = supports_cached_load(); _o->supports_cached_load = _e; };
 }
 
 inline flatbuffers::Offset<HubInfoResponse> HubInfoResponse::Pack(flatbuffers::FlatBufferBuilder &_fbb, const HubInfoResponseT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -1851,6 +2847,7 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(flatbuffers::F
   auto _max_msg_len = _o->max_msg_len;
   auto _platform_id = _o->platform_id;
   auto _chre_platform_version = _o->chre_platform_version;
+  auto _supports_cached_load = _o->supports_cached_load;
   return chre::fbs::CreateHubInfoResponse(
       _fbb,
       _name,
@@ -1864,7 +2861,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(flatbuffers::F
       _peak_power,
       _max_msg_len,
       _platform_id,
-      _chre_platform_version);
+      _chre_platform_version,
+      _supports_cached_load);
 }
 
 inline NanoappListRequestT *NanoappListRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -1996,6 +2994,7 @@ inline void LoadNanoappResponse::UnPackTo(LoadNanoappResponseT *_o, const flatbu
   (void)_resolver;
   { auto _e = transaction_id(); _o->transaction_id = _e; };
   { auto _e = success(); _o->success = _e; };
+  { auto _e = cache_miss(); _o->cache_miss = _e; };
 }
 
 inline flatbuffers::Offset<LoadNanoappResponse> LoadNanoappResponse::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappResponseT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -2007,10 +3006,12 @@ inline flatbuffers::Offset<LoadNanoappResponse> CreateLoadNanoappResponse(flatbu
   (void)_o;
   auto _transaction_id = _o->transaction_id;
   auto _success = _o->success;
+  auto _cache_miss = _o->cache_miss;
   return chre::fbs::CreateLoadNanoappResponse(
       _fbb,
       _transaction_id,
-      _success);
+      _success,
+      _cache_miss);
 }
 
 inline UnloadNanoappRequestT *UnloadNanoappRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -2107,6 +3108,7 @@ inline void TimeSyncMessage::UnPackTo(TimeSyncMessageT *_o, const flatbuffers::r
   (void)_o;
   (void)_resolver;
   { auto _e = offset(); _o->offset = _e; };
+  { auto _e = uncertainty(); _o->uncertainty = _e; };
 }
 
 inline flatbuffers::Offset<TimeSyncMessage> TimeSyncMessage::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncMessageT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -2117,9 +3119,11 @@ inline flatbuffers::Offset<TimeSyncMessage> CreateTimeSyncMessage(flatbuffers::F
   (void)_rehasher;
   (void)_o;
   auto _offset = _o->offset;
+  auto _uncertainty = _o->uncertainty;
   return chre::fbs::CreateTimeSyncMessage(
       _fbb,
-      _offset);
+      _offset,
+      _uncertainty);
 }
 
 inline DebugDumpRequestT *DebugDumpRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -2219,6 +3223,272 @@ inline flatbuffers::Offset<TimeSyncRequest> CreateTimeSyncRequest(flatbuffers::F
       _fbb);
 }
 
+inline LoadNanoappBeginRequestT *LoadNanoappBeginRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new LoadNanoappBeginRequestT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void LoadNanoappBeginRequest::UnPackTo(LoadNanoappBeginRequestT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = transaction_id(); _o->transaction_id = _e; };
+  { auto _e = app_id(); _o->app_id = _e; };
+  { auto _e = app_version(); _o->app_version = _e; };
+  { auto _e = target_api_version(); _o->target_api_version = _e; };
+  { auto _e = total_app_size(); _o->total_app_size = _e; };
+}
+
+inline flatbuffers::Offset<LoadNanoappBeginRequest> LoadNanoappBeginRequest::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappBeginRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLoadNanoappBeginRequest(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<LoadNanoappBeginRequest> CreateLoadNanoappBeginRequest(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappBeginRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _transaction_id = _o->transaction_id;
+  auto _app_id = _o->app_id;
+  auto _app_version = _o->app_version;
+  auto _target_api_version = _o->target_api_version;
+  auto _total_app_size = _o->total_app_size;
+  return chre::fbs::CreateLoadNanoappBeginRequest(
+      _fbb,
+      _transaction_id,
+      _app_id,
+      _app_version,
+      _target_api_version,
+      _total_app_size);
+}
+
+inline LoadNanoappFragmentT *LoadNanoappFragment::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new LoadNanoappFragmentT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void LoadNanoappFragment::UnPackTo(LoadNanoappFragmentT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = transaction_id(); _o->transaction_id = _e; };
+  { auto _e = offset(); _o->offset = _e; };
+  { auto _e = data(); if (_e) for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->data.push_back(_e->Get(_i)); } };
+}
+
+inline flatbuffers::Offset<LoadNanoappFragment> LoadNanoappFragment::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappFragmentT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLoadNanoappFragment(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<LoadNanoappFragment> CreateLoadNanoappFragment(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappFragmentT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _transaction_id = _o->transaction_id;
+  auto _offset = _o->offset;
+  auto _data = _fbb.CreateVector(_o->data);
+  return chre::fbs::CreateLoadNanoappFragment(
+      _fbb,
+      _transaction_id,
+      _offset,
+      _data);
+}
+
+inline LoadNanoappCommitRequestT *LoadNanoappCommitRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new LoadNanoappCommitRequestT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void LoadNanoappCommitRequest::UnPackTo(LoadNanoappCommitRequestT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = transaction_id(); _o->transaction_id = _e; };
+  { auto _e = crc32(); _o->crc32 = _e; };
+}
+
+inline flatbuffers::Offset<LoadNanoappCommitRequest> LoadNanoappCommitRequest::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappCommitRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLoadNanoappCommitRequest(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<LoadNanoappCommitRequest> CreateLoadNanoappCommitRequest(flatbuffers::FlatBufferBuilder &_fbb, const LoadNanoappCommitRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _transaction_id = _o->transaction_id;
+  auto _crc32 = _o->crc32;
+  return chre::fbs::CreateLoadNanoappCommitRequest(
+      _fbb,
+      _transaction_id,
+      _crc32);
+}
+
+inline LoadCachedNanoappRequestT *LoadCachedNanoappRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new LoadCachedNanoappRequestT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void LoadCachedNanoappRequest::UnPackTo(LoadCachedNanoappRequestT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = transaction_id(); _o->transaction_id = _e; };
+  { auto _e = app_id(); _o->app_id = _e; };
+  { auto _e = app_version(); _o->app_version = _e; };
+  { auto _e = target_api_version(); _o->target_api_version = _e; };
+  { auto _e = crc32(); _o->crc32 = _e; };
+}
+
+inline flatbuffers::Offset<LoadCachedNanoappRequest> LoadCachedNanoappRequest::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoadCachedNanoappRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLoadCachedNanoappRequest(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<LoadCachedNanoappRequest> CreateLoadCachedNanoappRequest(flatbuffers::FlatBufferBuilder &_fbb, const LoadCachedNanoappRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _transaction_id = _o->transaction_id;
+  auto _app_id = _o->app_id;
+  auto _app_version = _o->app_version;
+  auto _target_api_version = _o->target_api_version;
+  auto _crc32 = _o->crc32;
+  return chre::fbs::CreateLoadCachedNanoappRequest(
+      _fbb,
+      _transaction_id,
+      _app_id,
+      _app_version,
+      _target_api_version,
+      _crc32);
+}
+
+inline MessageSubscriptionRequestT *MessageSubscriptionRequest::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new MessageSubscriptionRequestT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void MessageSubscriptionRequest::UnPackTo(MessageSubscriptionRequestT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = subscribe(); _o->subscribe = _e; };
+  { auto _e = app_id(); _o->app_id = _e; };
+  { auto _e = match_any_app_id(); _o->match_any_app_id = _e; };
+  { auto _e = message_type(); _o->message_type = _e; };
+  { auto _e = match_any_message_type(); _o->match_any_message_type = _e; };
+}
+
+inline flatbuffers::Offset<MessageSubscriptionRequest> MessageSubscriptionRequest::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MessageSubscriptionRequestT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateMessageSubscriptionRequest(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<MessageSubscriptionRequest> CreateMessageSubscriptionRequest(flatbuffers::FlatBufferBuilder &_fbb, const MessageSubscriptionRequestT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _subscribe = _o->subscribe;
+  auto _app_id = _o->app_id;
+  auto _match_any_app_id = _o->match_any_app_id;
+  auto _message_type = _o->message_type;
+  auto _match_any_message_type = _o->match_any_message_type;
+  return chre::fbs::CreateMessageSubscriptionRequest(
+      _fbb,
+      _subscribe,
+      _app_id,
+      _match_any_app_id,
+      _message_type,
+      _match_any_message_type);
+}
+
+inline NanoappStatusChangeT *NanoappStatusChange::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new NanoappStatusChangeT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void NanoappStatusChange::UnPackTo(NanoappStatusChangeT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = app_id(); _o->app_id = _e; };
+  { auto _e = app_version(); _o->app_version = _e; };
+  { auto _e = instance_id(); _o->instance_id = _e; };
+  { auto _e = started(); _o->started = _e; };
+}
+
+inline flatbuffers::Offset<NanoappStatusChange> NanoappStatusChange::Pack(flatbuffers::FlatBufferBuilder &_fbb, const NanoappStatusChangeT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateNanoappStatusChange(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<NanoappStatusChange> CreateNanoappStatusChange(flatbuffers::FlatBufferBuilder &_fbb, const NanoappStatusChangeT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _app_id = _o->app_id;
+  auto _app_version = _o->app_version;
+  auto _instance_id = _o->instance_id;
+  auto _started = _o->started;
+  return chre::fbs::CreateNanoappStatusChange(
+      _fbb,
+      _app_id,
+      _app_version,
+      _instance_id,
+      _started);
+}
+
+inline TimeSyncProbeT *TimeSyncProbe::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new TimeSyncProbeT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void TimeSyncProbe::UnPackTo(TimeSyncProbeT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = sequence(); _o->sequence = _e; };
+  { auto _e = host_send_time(); _o->host_send_time = _e; };
+}
+
+inline flatbuffers::Offset<TimeSyncProbe> TimeSyncProbe::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateTimeSyncProbe(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<TimeSyncProbe> CreateTimeSyncProbe(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _sequence = _o->sequence;
+  auto _host_send_time = _o->host_send_time;
+  return chre::fbs::CreateTimeSyncProbe(
+      _fbb,
+      _sequence,
+      _host_send_time);
+}
+
+inline TimeSyncProbeResponseT *TimeSyncProbeResponse::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new TimeSyncProbeResponseT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void TimeSyncProbeResponse::UnPackTo(TimeSyncProbeResponseT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = sequence(); _o->sequence = _e; };
+  { auto _e = host_send_time(); _o->host_send_time = _e; };
+  { auto _e = chre_receive_time(); _o->chre_receive_time = _e; };
+  { auto _e = chre_send_time(); _o->chre_send_time = _e; };
+}
+
+inline flatbuffers::Offset<TimeSyncProbeResponse> TimeSyncProbeResponse::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeResponseT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateTimeSyncProbeResponse(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<TimeSyncProbeResponse> CreateTimeSyncProbeResponse(flatbuffers::FlatBufferBuilder &_fbb, const TimeSyncProbeResponseT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _sequence = _o->sequence;
+  auto _host_send_time = _o->host_send_time;
+  auto _chre_receive_time = _o->chre_receive_time;
+  auto _chre_send_time = _o->chre_send_time;
+  return chre::fbs::CreateTimeSyncProbeResponse(
+      _fbb,
+      _sequence,
+      _host_send_time,
+      _chre_receive_time,
+      _chre_send_time);
+}
+
 inline MessageContainerT *MessageContainer::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new MessageContainerT();
   UnPackTo(_o, _resolver);
@@ -2315,6 +3585,38 @@ inline bool VerifyChreMessage(flatbuffers::Verifier &verifier, const void *obj,
       auto ptr = reinterpret_cast<const TimeSyncRequest *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case ChreMessage::LoadNanoappBeginRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappBeginRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::LoadNanoappFragment: {
+      auto ptr = reinterpret_cast<const LoadNanoappFragment *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::LoadNanoappCommitRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappCommitRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::LoadCachedNanoappRequest: {
+      auto ptr = reinterpret_cast<const LoadCachedNanoappRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::MessageSubscriptionRequest: {
+      auto ptr = reinterpret_cast<const MessageSubscriptionRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::NanoappStatusChange: {
+      auto ptr = reinterpret_cast<const NanoappStatusChange *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::TimeSyncProbe: {
+      auto ptr = reinterpret_cast<const TimeSyncProbe *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::TimeSyncProbeResponse: {
+      auto ptr = reinterpret_cast<const TimeSyncProbeResponse *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return false;
   }
 }
@@ -2392,6 +3694,38 @@ inline flatbuffers::NativeTable *ChreMessageUnion::UnPack(const void *obj, ChreM
       auto ptr = reinterpret_cast<const TimeSyncRequest *>(obj);
       return ptr->UnPack(resolver);
     }
+    case ChreMessage::LoadNanoappBeginRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappBeginRequest *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::LoadNanoappFragment: {
+      auto ptr = reinterpret_cast<const LoadNanoappFragment *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::LoadNanoappCommitRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappCommitRequest *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::LoadCachedNanoappRequest: {
+      auto ptr = reinterpret_cast<const LoadCachedNanoappRequest *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::MessageSubscriptionRequest: {
+      auto ptr = reinterpret_cast<const MessageSubscriptionRequest *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::NanoappStatusChange: {
+      auto ptr = reinterpret_cast<const NanoappStatusChange *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::TimeSyncProbe: {
+      auto ptr = reinterpret_cast<const TimeSyncProbe *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case ChreMessage::TimeSyncProbeResponse: {
+      auto ptr = reinterpret_cast<const TimeSyncProbeResponse *>(obj);
+      return ptr->UnPack(resolver);
+    }
     default: return nullptr;
   }
 }
@@ -2458,6 +3792,38 @@ inline flatbuffers::Offset<void> ChreMessageUnion::Pack(flatbuffers::FlatBufferB
       auto ptr = reinterpret_cast<const TimeSyncRequestT *>(table);
       return CreateTimeSyncRequest(_fbb, ptr, _rehasher).Union();
     }
+    case ChreMessage::LoadNanoappBeginRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappBeginRequestT *>(table);
+      return CreateLoadNanoappBeginRequest(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::LoadNanoappFragment: {
+      auto ptr = reinterpret_cast<const LoadNanoappFragmentT *>(table);
+      return CreateLoadNanoappFragment(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::LoadNanoappCommitRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappCommitRequestT *>(table);
+      return CreateLoadNanoappCommitRequest(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::LoadCachedNanoappRequest: {
+      auto ptr = reinterpret_cast<const LoadCachedNanoappRequestT *>(table);
+      return CreateLoadCachedNanoappRequest(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::MessageSubscriptionRequest: {
+      auto ptr = reinterpret_cast<const MessageSubscriptionRequestT *>(table);
+      return CreateMessageSubscriptionRequest(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::NanoappStatusChange: {
+      auto ptr = reinterpret_cast<const NanoappStatusChangeT *>(table);
+      return CreateNanoappStatusChange(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::TimeSyncProbe: {
+      auto ptr = reinterpret_cast<const TimeSyncProbeT *>(table);
+      return CreateTimeSyncProbe(_fbb, ptr, _rehasher).Union();
+    }
+    case ChreMessage::TimeSyncProbeResponse: {
+      auto ptr = reinterpret_cast<const TimeSyncProbeResponseT *>(table);
+      return CreateTimeSyncProbeResponse(_fbb, ptr, _rehasher).Union();
+    }
     default: return 0;
   }
 }
@@ -2539,6 +3905,46 @@ inline void ChreMessageUnion::Reset() {
       delete ptr;
       break;
     }
+    case ChreMessage::LoadNanoappBeginRequest: {
+      auto ptr = reinterpret_cast<LoadNanoappBeginRequestT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::LoadNanoappFragment: {
+      auto ptr = reinterpret_cast<LoadNanoappFragmentT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::LoadNanoappCommitRequest: {
+      auto ptr = reinterpret_cast<LoadNanoappCommitRequestT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::LoadCachedNanoappRequest: {
+      auto ptr = reinterpret_cast<LoadCachedNanoappRequestT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::MessageSubscriptionRequest: {
+      auto ptr = reinterpret_cast<MessageSubscriptionRequestT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::NanoappStatusChange: {
+      auto ptr = reinterpret_cast<NanoappStatusChangeT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::TimeSyncProbe: {
+      auto ptr = reinterpret_cast<TimeSyncProbeT *>(table);
+      delete ptr;
+      break;
+    }
+    case ChreMessage::TimeSyncProbeResponse: {
+      auto ptr = reinterpret_cast<TimeSyncProbeResponseT *>(table);
+      delete ptr;
+      break;
+    }
     default: break;
   }
   table = nullptr;
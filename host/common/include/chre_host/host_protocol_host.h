@@ -20,6 +20,8 @@
 
 #include <stdint.h>
 
+#include <functional>
+
 #include "chre/platform/shared/host_protocol_common.h"
 #include "chre_host/host_messages_generated.h"
 #include "flatbuffers/flatbuffers.h"
@@ -44,7 +46,7 @@ class IChreMessageHandlers {
       const char *toolchain, uint32_t legacyPlatformVersion,
       uint32_t legacyToolchainVersion, float peakMips, float stoppedPower,
       float sleepPower, float peakPower, uint32_t maxMessageLen,
-      uint64_t platformId, uint32_t version) = 0;
+      uint64_t platformId, uint32_t version, bool supportsCachedLoad) = 0;
 
   virtual void handleNanoappListResponse(
       const ::chre::fbs::NanoappListResponseT& response) = 0;
@@ -104,6 +106,79 @@ class HostProtocolHost : public ::chre::HostProtocolCommon {
       uint64_t appId, uint32_t appVersion, uint32_t targetApiVersion,
       const std::vector<uint8_t>& nanoappBinary);
 
+  /**
+   * Encodes a message starting a fragmented nanoapp load transaction. The
+   * binary itself is sent via one or more subsequent LoadNanoappFragment
+   * messages, followed by a LoadNanoappCommitRequest.
+   *
+   * @param builder A newly constructed FlatBufferBuilder that will be used to
+   *        construct the message
+   * @param totalAppSize Size of the complete app binary, in bytes
+   */
+  static void encodeLoadNanoappBeginRequest(
+      flatbuffers::FlatBufferBuilder& builder, uint32_t transactionId,
+      uint64_t appId, uint32_t appVersion, uint32_t targetApiVersion,
+      uint32_t totalAppSize);
+
+  /**
+   * Encodes one fragment of the app binary for a fragmented nanoapp load
+   * transaction.
+   *
+   * @param builder A newly constructed (or cleared) FlatBufferBuilder that will
+   *        be used to construct the message
+   * @param offset Byte offset of the fragment within the app binary
+   * @param fragment Pointer to the fragment data
+   * @param fragmentLen Size of the fragment, in bytes
+   */
+  static void encodeLoadNanoappFragment(
+      flatbuffers::FlatBufferBuilder& builder, uint32_t transactionId,
+      uint32_t offset, const uint8_t *fragment, size_t fragmentLen);
+
+  /**
+   * Encodes a message completing a fragmented nanoapp load transaction.
+   *
+   * @param builder A newly constructed FlatBufferBuilder that will be used to
+   *        construct the message
+   * @param crc32 CRC-32 of the complete app binary, computed via chre::crc32()
+   */
+  static void encodeLoadNanoappCommitRequest(
+      flatbuffers::FlatBufferBuilder& builder, uint32_t transactionId,
+      uint32_t crc32);
+
+  /**
+   * Encodes a request to load a nanoapp from a binary that CHRE retained from a
+   * previous load. If CHRE does not hold a matching binary, it responds with
+   * cache_miss set in LoadNanoappResponse, and the binary must be transferred
+   * via encodeFragmentedLoadNanoapp().
+   *
+   * @param builder A newly constructed FlatBufferBuilder that will be used to
+   *        construct the message
+   * @param crc32 CRC-32 of the complete app binary, computed via chre::crc32()
+   */
+  static void encodeLoadCachedNanoappRequest(
+      flatbuffers::FlatBufferBuilder& builder, uint32_t transactionId,
+      uint64_t appId, uint32_t appVersion, uint32_t targetApiVersion,
+      uint32_t crc32);
+
+  /**
+   * Encodes the complete sequence of messages for a fragmented nanoapp load
+   * transaction (begin request, fragments and commit request, including the
+   * CRC of the binary), passing each encoded message to sendFunc in order.
+   * Messages for multiple transactions can be freely interleaved.
+   *
+   * @param fragmentSize Maximum number of bytes of the app binary to include in
+   *        each LoadNanoappFragment message
+   * @param sendFunc Invoked synchronously with each encoded message; returning
+   *        false stops the sequence
+   *
+   * @return true if all messages were encoded and sent successfully
+   */
+  static bool encodeFragmentedLoadNanoapp(
+      uint32_t transactionId, uint64_t appId, uint32_t appVersion,
+      uint32_t targetApiVersion, const uint8_t *appBinary,
+      size_t appBinarySize, size_t fragmentSize,
+      const std::function<bool(const uint8_t *, size_t)>& sendFunc);
+
   /**
    * Encodes a message requesting the list of loaded nanoapps from CHRE
    *
@@ -135,9 +210,22 @@ class HostProtocolHost : public ::chre::HostProtocolCommon {
    * @param builder A newly constructed FlatBufferBuilder that will be used to
    *        construct the message
    * @param offset The AP to SLPI offset in nanoseconds
+   * @param uncertainty The maximum error of offset in nanoseconds, or 0 if
+   *        unknown
    */
   static void encodeTimeSyncMessage(flatbuffers::FlatBufferBuilder& builder,
-                                    int64_t offset);
+                                    int64_t offset, int64_t uncertainty = 0);
+
+  /**
+   * Encodes a probe used to measure the AP to SLPI offset
+   *
+   * @param builder A newly constructed FlatBufferBuilder that will be used to
+   *        construct the message
+   * @param sequence Identifies the probe in the TimeSyncProbeResponse
+   * @param hostSendTime The AP time the probe is sent, in nanoseconds
+   */
+  static void encodeTimeSyncProbe(flatbuffers::FlatBufferBuilder& builder,
+                                  uint32_t sequence, int64_t hostSendTime);
 
   /**
    * Encodes a message requesting debugging information from CHRE
@@ -147,6 +235,24 @@ class HostProtocolHost : public ::chre::HostProtocolCommon {
    */
   static void encodeDebugDumpRequest(flatbuffers::FlatBufferBuilder& builder);
 
+  /**
+   * Encodes a message to the host daemon adding or removing a subscription to
+   * broadcast nanoapp messages. See MessageSubscriptionRequest in
+   * host_messages.fbs for details.
+   *
+   * @param builder A newly constructed FlatBufferBuilder that will be used to
+   *        construct the message
+   * @param subscribe true to add the subscription, false to remove it
+   * @param matchAnyAppId If true, match messages from all nanoapps rather than
+   *        only appId
+   * @param matchAnyMessageType If true, match messages of all types rather than
+   *        only messageType
+   */
+  static void encodeMessageSubscriptionRequest(
+      flatbuffers::FlatBufferBuilder& builder, bool subscribe,
+      uint64_t appId, bool matchAnyAppId, uint32_t messageType,
+      bool matchAnyMessageType);
+
   /**
    * Decodes the host client ID included in the message container
    *
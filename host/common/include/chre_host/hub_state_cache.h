@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_HOST_HUB_STATE_CACHE_H_
+#define CHRE_HOST_HUB_STATE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "chre_host/host_messages_generated.h"
+
+namespace android {
+namespace chre {
+
+/**
+ * Caches the most recent HubInfoResponse and NanoappListResponse sent by CHRE,
+ * so that the daemon can answer repeated requests without a round trip to
+ * CHRE. The hub info never changes while CHRE is running. The nanoapp list is
+ * invalidated by load and unload responses, and by NanoappStatusChange
+ * notifications for changes the host didn't request.
+ *
+ * This relies on CHRE sending its responses and notifications in the order it
+ * processes them: a list response received after an invalidating message
+ * reflects the change, and one received before it is discarded by it.
+ *
+ * This class is thread-safe.
+ */
+class HubStateCache {
+ public:
+  struct Stats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t invalidationCount = 0;
+  };
+
+  /**
+   * Looks up the cached response to a request sent by a host client.
+   *
+   * @param requestType The type of the request
+   * @param clientId The host client ID to address the response to
+   * @param response Populated with the encoded response on success
+   *
+   * @return true if the request can be answered with the contents of response,
+   *         false if it must be forwarded to CHRE
+   */
+  bool getCachedResponse(::chre::fbs::ChreMessage requestType,
+                         uint16_t clientId, std::vector<uint8_t> *response);
+
+  /**
+   * Updates the cache based on a message received from CHRE.
+   *
+   * @param messageType The type of the message
+   * @param message A verified message container
+   * @param messageLen The size of the message, in bytes
+   */
+  void onMessageFromChre(::chre::fbs::ChreMessage messageType,
+                         const void *message, size_t messageLen);
+
+  Stats getStats() const;
+
+ private:
+  mutable std::mutex mMutex;
+
+  std::vector<uint8_t> mHubInfoResponse;
+  std::vector<uint8_t> mNanoappListResponse;
+  Stats mStats;
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_HUB_STATE_CACHE_H_
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_HOST_MESSAGE_CAPTURE_H_
+#define CHRE_HOST_MESSAGE_CAPTURE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include <android-base/macros.h>
+
+namespace android {
+namespace chre {
+
+/**
+ * Capture files hold every host protocol frame exchanged between the daemon
+ * and its clients, so that a session can be replayed later. A file starts with
+ * the 8 bytes of kMagic, followed by one record per frame: a RecordHeader in
+ * native byte order, then the frame itself.
+ */
+namespace capture {
+
+constexpr char kMagic[8] = { 'C', 'H', 'R', 'E', 'C', 'A', 'P', '1' };
+
+enum class Direction : uint8_t {
+  //! Sent by the client, towards CHRE
+  FromClient = 0,
+  //! Delivered to the client
+  ToClient = 1,
+};
+
+struct RecordHeader {
+  //! Monotonic time the frame was received or sent, in nanoseconds
+  uint64_t timestampNs;
+  uint32_t length;
+  uint16_t clientId;
+  Direction direction;
+  uint8_t reserved;
+};
+
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader must be packed");
+
+/**
+ * @return The current time in the time base used for RecordHeader timestamps
+ */
+uint64_t getTimestampNs();
+
+}  // namespace capture
+
+/**
+ * Appends frames to a capture file. Frames are buffered and only guaranteed to
+ * be on disk after close().
+ *
+ * This class is thread-safe.
+ */
+class MessageCaptureWriter {
+ public:
+  MessageCaptureWriter() = default;
+  ~MessageCaptureWriter();
+
+  /**
+   * Creates (or truncates) the capture file and writes its header.
+   *
+   * @return true on success
+   */
+  bool open(const char *path);
+
+  void close();
+
+  bool isOpen() const;
+
+  /**
+   * Records a frame, timestamped with the current time. Does nothing if the
+   * file isn't open.
+   */
+  void record(capture::Direction direction, uint16_t clientId,
+              const void *data, size_t length);
+
+  /**
+   * @return The number of frames recorded since the file was opened
+   */
+  uint64_t getRecordCount() const;
+
+ private:
+  mutable std::mutex mMutex;
+  FILE *mFile = nullptr;
+  uint64_t mRecordCount = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageCaptureWriter);
+};
+
+/**
+ * Reads the frames of a capture file in order.
+ */
+class MessageCaptureReader {
+ public:
+  MessageCaptureReader() = default;
+  ~MessageCaptureReader();
+
+  /**
+   * Opens a capture file and validates its header.
+   *
+   * @return true on success
+   */
+  bool open(const char *path);
+
+  /**
+   * Reads the next frame.
+   *
+   * @param header Populated with the frame's record header
+   * @param data Populated with the frame
+   *
+   * @return false at the end of the file, or if it is truncated or corrupt
+   */
+  bool readNext(capture::RecordHeader *header, std::vector<uint8_t> *data);
+
+ private:
+  //! Frames larger than this are treated as corruption
+  static constexpr uint32_t kMaxFrameSize = 1024 * 1024;
+
+  FILE *mFile = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageCaptureReader);
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_MESSAGE_CAPTURE_H_
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_HOST_PRIORITY_DISPATCHER_H_
+#define CHRE_HOST_PRIORITY_DISPATCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace android {
+namespace chre {
+
+/**
+ * Hands messages off to one worker thread per priority class, so that slow
+ * handling of low priority messages (e.g. a burst of logs, or a client that's
+ * slow to read) doesn't delay higher priority ones. Messages of the same
+ * priority are handled in the order they were enqueued, but there is no
+ * ordering between priorities, so messages whose relative order matters must
+ * be given the same priority.
+ *
+ * Each priority has a bounded queue. When a queue is full, messages that the
+ * sender marked as droppable (e.g. logs) are dropped and counted, while
+ * enqueue() blocks for any other message until there is space, so that
+ * backpressure reaches the sender rather than losing messages. The time each
+ * message spends queued is tracked per priority.
+ *
+ * This class is thread-safe.
+ */
+class PriorityDispatcher {
+ public:
+  enum class Priority : uint8_t {
+    High = 0,
+    Normal,
+    Low,
+  };
+
+  //! The number of values in Priority
+  static constexpr size_t kPriorityCount = 3;
+
+  /**
+   * Invoked on the worker thread for the message's priority.
+   *
+   * @param message A copy of the enqueued message, valid for the duration of
+   *        the call
+   * @param length The size of the message, in bytes
+   */
+  using Handler = std::function<void(const uint8_t *message, size_t length)>;
+
+  struct Stats {
+    uint64_t dispatchedCount = 0;
+    uint64_t droppedCount = 0;
+
+    //! The number of messages that had to wait for space in the queue
+    uint64_t blockedCount = 0;
+
+    uint64_t totalQueueDelayNs = 0;
+    uint64_t maxQueueDelayNs = 0;
+    size_t maxQueueDepth = 0;
+  };
+
+  ~PriorityDispatcher();
+
+  /**
+   * Starts the worker threads. Must only be called once.
+   *
+   * @param handler Invoked for each message
+   * @param maxQueueDepth The number of messages each priority can hold before
+   *        enqueue() blocks, or drops droppable messages
+   *
+   * @return true if all worker threads were started
+   */
+  bool start(Handler handler, size_t maxQueueDepth);
+
+  /**
+   * Stops the worker threads after they handle the messages already queued.
+   * Messages enqueued after this is called are dropped.
+   */
+  void stop();
+
+  /**
+   * Copies a message into the queue for the given priority. If the queue is
+   * full, droppable messages are dropped, while others wait for the worker to
+   * make space.
+   *
+   * @param droppable true if the message may be dropped rather than waiting
+   *        for space, i.e. losing it is preferable to delaying the sender
+   *
+   * @return false if the message was dropped
+   */
+  bool enqueue(Priority priority, const void *message, size_t length,
+               bool droppable);
+
+  Stats getStats(Priority priority) const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedMessage {
+    std::vector<uint8_t> data;
+    Clock::time_point enqueueTime;
+  };
+
+  struct Queue {
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+
+    //! Notified when the worker takes a message out of a full queue
+    std::condition_variable spaceCond;
+    std::deque<QueuedMessage> messages;
+    std::thread thread;
+    Stats stats;
+    bool stopping = false;
+  };
+
+  Handler mHandler;
+  size_t mMaxQueueDepth = 0;
+  Queue mQueues[kPriorityCount];
+
+  void workerLoop(Queue *queue);
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_PRIORITY_DISPATCHER_H_
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_HOST_SHARED_MEMORY_RING_H_
+#define CHRE_HOST_SHARED_MEMORY_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace android {
+namespace chre {
+
+/**
+ * A single-producer, single-consumer queue of variable-length messages held in
+ * a memfd shared between two processes, used to deliver messages from the
+ * daemon to a client without a socket send/recv per message. Messages are
+ * written directly into the ring by the producer and handed to the consumer in
+ * place.
+ *
+ * The consumer creates the ring and passes its file descriptors to the
+ * producer, which validates the region before use, as the two sides don't
+ * trust each other. An eventfd wakes the consumer, but it is only signaled
+ * when the consumer has drained the ring and is about to block, so a busy
+ * stream needs no system calls at all.
+ *
+ * Each side must only be used from one thread at a time.
+ */
+class SharedMemoryRing {
+ public:
+  /**
+   * Invoked for each message drained from the ring. The data is only valid for
+   * the duration of the call.
+   */
+  typedef std::function<void(const void *data, size_t length)> MessageHandler;
+
+  //! The smallest ring that can be created, in bytes
+  static constexpr size_t kMinCapacity = 4096;
+
+  SharedMemoryRing() = default;
+  ~SharedMemoryRing();
+
+  SharedMemoryRing(const SharedMemoryRing&) = delete;
+  SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+  /**
+   * Creates a new ring, for use as the consumer.
+   *
+   * @param capacity The minimum number of bytes of message storage, rounded up
+   *        to a power of two no smaller than kMinCapacity
+   *
+   * @return true on success
+   */
+  bool create(size_t capacity);
+
+  /**
+   * Maps a ring created by another process, for use as the producer. Takes
+   * ownership of the file descriptors, which are closed on failure.
+   *
+   * @param memFd The memfd returned by the creator's getMemFd()
+   * @param eventFd The eventfd returned by the creator's getEventFd(), which
+   *        is switched to non-blocking mode
+   *
+   * @return true if the ring was mapped and is well-formed, and eventFd is an
+   *         eventfd
+   */
+  bool attach(int memFd, int eventFd);
+
+  /**
+   * Unmaps the ring and closes its file descriptors.
+   */
+  void reset();
+
+  bool isValid() const {
+    return (mHeader != nullptr);
+  }
+
+  int getMemFd() const {
+    return mMemFd;
+  }
+
+  int getEventFd() const {
+    return mEventFd;
+  }
+
+  /**
+   * Copies a message into the ring, waking the consumer if it is waiting.
+   * Must only be called by the producer.
+   *
+   * @return false if there isn't room for the message, in which case it is
+   *         counted as dropped, or the ring has been corrupted
+   */
+  bool write(const void *data, size_t length);
+
+  /**
+   * Passes each message in the ring to the handler, in order, releasing its
+   * space once the handler returns. Must only be called by the consumer.
+   *
+   * @return The number of messages handled
+   */
+  size_t drain(const MessageHandler& handler);
+
+  /**
+   * Informs the producer that the consumer is about to block on the eventfd.
+   * Must only be called by the consumer.
+   *
+   * @return true if the consumer should block, false if messages arrived in
+   *         the meantime and should be drained first
+   */
+  bool prepareToWait();
+
+  /**
+   * Consumes the wakeup signaled through the eventfd, once it has become
+   * readable. Must only be called by the consumer.
+   */
+  void clearWakeup();
+
+  /**
+   * @return The number of messages the producer dropped because the ring was
+   *         full
+   */
+  uint32_t getDroppedCount() const;
+
+ private:
+  struct Header;
+
+  Header *mHeader = nullptr;
+  uint8_t *mData = nullptr;
+  size_t mCapacity = 0;
+  size_t mMappedSize = 0;
+  int mMemFd = -1;
+  int mEventFd = -1;
+
+  //! This side's position in the ring: the write position for the producer,
+  //! or the read position for the consumer. Kept privately so that the other
+  //! process can't influence where this one accesses memory.
+  uint64_t mPosition = 0;
+};
+
+/**
+ * The packet a client sends over its socket to ask the server to deliver its
+ * messages through a SharedMemoryRing, with the ring's memfd and eventfd
+ * attached (SCM_RIGHTS). The server replies with the same packet, setting
+ * accepted if all subsequent messages to the client will be delivered through
+ * the ring.
+ */
+struct SharedMemoryTransportSetup {
+  char magic[8];
+  uint32_t accepted;
+  uint32_t reserved;
+
+  /**
+   * @return A setup packet with the magic populated
+   */
+  static SharedMemoryTransportSetup make(bool accepted);
+
+  /**
+   * @return true if the data holds a setup packet
+   */
+  static bool isSetupPacket(const void *data, size_t length);
+};
+
+/**
+ * The packet a client sends over its socket after handling a message that the
+ * server sent over the socket while a SharedMemoryRing was in use, once it has
+ * drained the ring. The server writes nothing to the ring between falling back
+ * to the socket and receiving an acknowledgement that covers every message it
+ * sent over the socket, so that no message written to the ring can overtake
+ * one still queued in the socket.
+ */
+struct SharedMemoryRingDrained {
+  char magic[8];
+
+  //! The number of messages the client has received over the socket since
+  //! the ring was accepted
+  uint32_t socketMessageCount;
+  uint32_t reserved;
+
+  /**
+   * @return An acknowledgement with the magic populated
+   */
+  static SharedMemoryRingDrained make(uint32_t socketMessageCount);
+
+  /**
+   * @return true if the data holds an acknowledgement
+   */
+  static bool isDrainedPacket(const void *data, size_t length);
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_SHARED_MEMORY_RING_H_
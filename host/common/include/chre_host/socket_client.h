@@ -26,6 +26,8 @@
 #include <utils/RefBase.h>
 #include <utils/StrongPointer.h>
 
+#include "chre_host/shared_memory_ring.h"
+
 namespace android {
 namespace chre {
 
@@ -121,6 +123,21 @@ class SocketClient {
    */
   bool sendMessage(const void *data, size_t length);
 
+  /**
+   * Requests that messages from the server be delivered through a shared
+   * memory ring rather than the socket, which avoids a syscall per message when
+   * the receive thread is busy. The ring is negotiated each time the socket
+   * connects; if the server declines, messages continue to arrive over the
+   * socket. Broadcasts that don't fit in the ring are dropped by the server,
+   * and responses that don't fit are sent over the socket, which delays
+   * everything after them until the receive thread catches up, so the
+   * capacity should cover the largest expected burst. Must be called before
+   * connect() or connectInBackground().
+   *
+   * @param capacity Size of the ring in bytes, or 0 to use the socket only
+   */
+  void enableSharedMemoryTransport(size_t capacity);
+
  private:
   static constexpr size_t kMaxSocketNameLen = 64;
   char mSocketName[kMaxSocketNameLen];
@@ -138,15 +155,32 @@ class SocketClient {
   std::condition_variable mShutdownCond;
   std::mutex mShutdownMutex;
 
+  //! Requested shared memory ring capacity, 0 if disabled
+  size_t mRingCapacity = 0;
+
+  //! Ring created for the current connection, only accessed from the thread
+  //! that (re-)connects the socket and the RX thread
+  SharedMemoryRing mRing;
+
+  //! Set once the server acknowledges that it delivers through mRing
+  bool mRingActive = false;
+
+  //! The number of messages received over the socket while mRingActive, which
+  //! is echoed back to the server in SharedMemoryRingDrained
+  uint32_t mSocketMessageCount = 0;
+
   bool doConnect(const char *socketName,
                  const ::android::sp<ICallbacks>& callbacks,
                  bool connectInBackground);
+  void drainRing();
   bool inReceiveThread() const;
   void receiveThread();
   bool receiveThreadRunning() const;
   bool reconnect();
+  void requestSharedMemoryTransport();
   void startReceiveThread();
   bool tryConnect(bool suppressErrorLogs = false);
+  bool waitForSocketData();
 };
 
 }  // namespace chre
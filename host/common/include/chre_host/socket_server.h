@@ -22,14 +22,29 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 
 #include <android-base/macros.h>
 #include <cutils/sockets.h>
 
+#include "chre_host/message_capture.h"
+#include "chre_host/shared_memory_ring.h"
+
 namespace android {
 namespace chre {
 
+/**
+ * Serves clients connecting over a local SEQPACKET socket. A client may ask
+ * for the messages sent to it to be delivered through a SharedMemoryRing
+ * instead, by sending a SharedMemoryTransportSetup packet (see
+ * SocketClient::enableSharedMemoryTransport()). Once accepted, messages to
+ * that client go through the ring. Broadcasts that don't fit are dropped,
+ * while a message sent to the client by ID that doesn't fit is sent over the
+ * socket instead. All messages then go over the socket until the client
+ * acknowledges that it has drained the ring and received every one of them
+ * (see SharedMemoryRingDrained), which keeps them in order.
+ */
 class SocketServer {
  public:
   SocketServer();
@@ -46,6 +61,25 @@ class SocketServer {
   typedef std::function<void(uint16_t clientId, void *data, size_t len)>
       ClientMessageCallback;
 
+  /**
+   * Defines the function signature of the optional callback given to run()
+   * which is invoked after a client disconnects.
+   *
+   * @param clientId The unique identifier of the client that disconnected
+   */
+  typedef std::function<void(uint16_t clientId)> ClientDisconnectedCallback;
+
+  /**
+   * Defines the function signature of the predicate given to
+   * sendToInterestedClients(), which is invoked with the mutex guarding the
+   * client list held.
+   *
+   * @param clientId The unique identifier of a connected client
+   *
+   * @return true if the message should be delivered to the client
+   */
+  typedef std::function<bool(uint16_t clientId)> ClientFilter;
+
   /**
    * Opens the socket, and runs the receive loop until an error is encountered,
    * or SIGINT/SIGTERM is received. Masks off all other signals.
@@ -56,9 +90,23 @@ class SocketServer {
    *        development purposes)
    * @param clientMessageCallback Callback to be invoked when a message is
    *        received from a client
+   * @param clientDisconnectedCallback Callback to be invoked when a client
+   *        disconnects, or nullptr
    */
   void run(const char *socketName, bool allowSocketCreation,
-           ClientMessageCallback clientMessageCallback);
+           ClientMessageCallback clientMessageCallback,
+           ClientDisconnectedCallback clientDisconnectedCallback = nullptr);
+
+  /**
+   * Records every frame received from or delivered to a client through the
+   * given writer. Must be called before run().
+   *
+   * @param captureWriter An open writer that outlives this object, or nullptr
+   *        to disable capture
+   */
+  void setCaptureWriter(MessageCaptureWriter *captureWriter) {
+    mCaptureWriter = captureWriter;
+  }
 
   /**
    * Delivers data to all connected clients. This method is thread-safe.
@@ -68,6 +116,18 @@ class SocketServer {
    */
   void sendToAllClients(const void *data, size_t length);
 
+  /**
+   * Delivers data to the connected clients accepted by the given filter. This
+   * method is thread-safe.
+   *
+   * @param data Pointer to buffer containing message data
+   * @param length Number of bytes of data to send
+   * @param filter Predicate selecting the clients to deliver to, or nullptr to
+   *        deliver to all clients
+   */
+  void sendToInterestedClients(const void *data, size_t length,
+                               const ClientFilter& filter);
+
   /**
    * Sends a message to one client, specified via its unique client ID. This
    * method is thread-safe.
@@ -94,6 +154,16 @@ class SocketServer {
 
   struct ClientData {
     uint16_t clientId;
+
+    //! The ring messages are delivered through, if the client negotiated one
+    std::unique_ptr<SharedMemoryRing> ring;
+
+    //! Set while messages go over the socket because the ring filled up
+    bool ringFallback = false;
+
+    //! The number of messages sent over the socket since the ring was
+    //! accepted, compared against SharedMemoryRingDrained::socketMessageCount
+    uint32_t socketMessageCount = 0;
   };
 
   // Maps from socket FD to ClientData
@@ -104,10 +174,16 @@ class SocketServer {
   std::mutex mClientsMutex;
 
   ClientMessageCallback mClientMessageCallback;
+  ClientDisconnectedCallback mClientDisconnectedCallback;
+  MessageCaptureWriter *mCaptureWriter = nullptr;
 
   void acceptClientConnection();
   void disconnectClient(int clientSocket);
   void handleClientData(int clientSocket);
+  void handleRingDrained(int clientSocket, uint32_t socketMessageCount);
+  void handleSharedMemorySetup(int clientSocket, int *fds, size_t fdCount);
+  bool sendToClient(const void *data, size_t length, int clientSocket,
+                    ClientData& clientData, bool directed);
   bool sendToClientSocket(const void *data, size_t length, int clientSocket,
                           uint16_t clientId);
   void serviceSocket();
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_HOST_TRANSACTION_MANAGER_H_
+#define CHRE_HOST_TRANSACTION_MANAGER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace android {
+namespace chre {
+
+/**
+ * Tracks nanoapp load and unload transactions that have been sent to CHRE but
+ * not yet completed, so that a client can have many transactions in flight at
+ * once rather than waiting for each response before issuing the next request.
+ * When a response arrives, the client passes it to completeTransaction(),
+ * which invokes the completion callback registered for that transaction ID.
+ *
+ * This class is thread-safe. Completion callbacks are invoked without holding
+ * the internal lock, from the thread that calls completeTransaction() or
+ * failAllTransactions().
+ */
+class TransactionManager {
+ public:
+  /**
+   * Invoked when a transaction completes.
+   *
+   * @param transactionId The ID of the completed transaction
+   * @param success true if CHRE reported that the transaction succeeded
+   */
+  typedef std::function<void(uint32_t transactionId, bool success)>
+      CompletionCallback;
+
+  /**
+   * @return A transaction ID that is not currently in use by a pending
+   *         transaction tracked by this instance
+   */
+  uint32_t getNextTransactionId();
+
+  /**
+   * Starts tracking a transaction. This should be called before the request is
+   * sent, so the response can't arrive before the transaction is known.
+   *
+   * @param transactionId The ID that will be included in the request
+   * @param callback Invoked when the transaction completes
+   *
+   * @return true if the transaction was added, false if a transaction with the
+   *         same ID is already pending
+   */
+  bool addTransaction(uint32_t transactionId, CompletionCallback callback);
+
+  /**
+   * Stops tracking a pending transaction without invoking its completion
+   * callback, for example if the request couldn't be sent.
+   *
+   * @return true if a pending transaction with the given ID was found
+   */
+  bool removeTransaction(uint32_t transactionId);
+
+  /**
+   * Completes a pending transaction, invoking and then discarding its
+   * completion callback.
+   *
+   * @param transactionId The ID included in the response from CHRE
+   * @param success The result reported by CHRE
+   *
+   * @return true if a pending transaction with the given ID was found
+   */
+  bool completeTransaction(uint32_t transactionId, bool success);
+
+  /**
+   * Completes all pending transactions as failed, for example when the
+   * connection to CHRE is lost and their responses will never arrive.
+   */
+  void failAllTransactions();
+
+  /**
+   * @return The number of transactions that are currently pending
+   */
+  size_t getPendingTransactionCount() const;
+
+  /**
+   * Blocks until all pending transactions have completed, or the timeout
+   * expires.
+   *
+   * @param timeout The maximum amount of time to wait
+   *
+   * @return true if no transactions remain pending
+   */
+  bool waitForAllTransactions(std::chrono::milliseconds timeout);
+
+ private:
+  mutable std::mutex mMutex;
+
+  //! Notified when a transaction completes
+  std::condition_variable mCond;
+
+  //! Completion callbacks of pending transactions, keyed by transaction ID
+  std::map<uint32_t, CompletionCallback> mPendingTransactions;
+
+  uint32_t mNextTransactionId = 1;
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_TRANSACTION_MANAGER_H_
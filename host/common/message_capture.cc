@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre_host/message_capture.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "chre_host/log.h"
+
+namespace android {
+namespace chre {
+
+namespace capture {
+
+uint64_t getTimestampNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+}  // namespace capture
+
+MessageCaptureWriter::~MessageCaptureWriter() {
+  close();
+}
+
+bool MessageCaptureWriter::open(const char *path) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  bool success = false;
+
+  if (mFile != nullptr) {
+    LOGE("Capture file already open");
+  } else {
+    mFile = fopen(path, "we");
+    if (mFile == nullptr) {
+      LOGE("Couldn't open capture file '%s': %s", path, strerror(errno));
+    } else if (fwrite(capture::kMagic, sizeof(capture::kMagic), 1, mFile)
+                   != 1) {
+      LOGE("Couldn't write capture file header");
+      fclose(mFile);
+      mFile = nullptr;
+    } else {
+      mRecordCount = 0;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+void MessageCaptureWriter::close() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mFile != nullptr) {
+    if (fclose(mFile) != 0) {
+      LOG_ERROR("Couldn't close capture file", errno);
+    }
+    mFile = nullptr;
+  }
+}
+
+bool MessageCaptureWriter::isOpen() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return (mFile != nullptr);
+}
+
+void MessageCaptureWriter::record(capture::Direction direction,
+                                  uint16_t clientId, const void *data,
+                                  size_t length) {
+  capture::RecordHeader header = {};
+  header.length = static_cast<uint32_t>(length);
+  header.clientId = clientId;
+  header.direction = direction;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mFile != nullptr) {
+    // Timestamp under the lock so records are in chronological order
+    header.timestampNs = capture::getTimestampNs();
+    if (fwrite(&header, sizeof(header), 1, mFile) != 1
+        || (length > 0 && fwrite(data, length, 1, mFile) != 1)) {
+      LOGE("Couldn't write to capture file; stopping capture");
+      fclose(mFile);
+      mFile = nullptr;
+    } else {
+      mRecordCount++;
+    }
+  }
+}
+
+uint64_t MessageCaptureWriter::getRecordCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mRecordCount;
+}
+
+MessageCaptureReader::~MessageCaptureReader() {
+  if (mFile != nullptr) {
+    fclose(mFile);
+  }
+}
+
+bool MessageCaptureReader::open(const char *path) {
+  bool success = false;
+  char magic[sizeof(capture::kMagic)];
+
+  if (mFile != nullptr) {
+    LOGE("Capture file already open");
+  } else if ((mFile = fopen(path, "re")) == nullptr) {
+    LOGE("Couldn't open capture file '%s': %s", path, strerror(errno));
+  } else if (fread(magic, sizeof(magic), 1, mFile) != 1
+             || memcmp(magic, capture::kMagic, sizeof(magic)) != 0) {
+    LOGE("'%s' is not a capture file", path);
+    fclose(mFile);
+    mFile = nullptr;
+  } else {
+    success = true;
+  }
+
+  return success;
+}
+
+bool MessageCaptureReader::readNext(capture::RecordHeader *header,
+                                    std::vector<uint8_t> *data) {
+  bool success = false;
+
+  if (mFile != nullptr && fread(header, sizeof(*header), 1, mFile) == 1) {
+    if (header->length > kMaxFrameSize) {
+      LOGE("Capture record too large (%" PRIu32 " bytes)", header->length);
+    } else {
+      data->resize(header->length);
+      success = (header->length == 0
+                 || fread(data->data(), header->length, 1, mFile) == 1);
+      if (!success) {
+        LOGE("Capture file truncated");
+      }
+    }
+  }
+
+  return success;
+}
+
+}  // namespace chre
+}  // namespace android
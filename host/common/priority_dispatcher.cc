@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre_host/priority_dispatcher.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "chre_host/log.h"
+
+namespace android {
+namespace chre {
+
+constexpr size_t PriorityDispatcher::kPriorityCount;
+
+PriorityDispatcher::~PriorityDispatcher() {
+  stop();
+}
+
+bool PriorityDispatcher::start(Handler handler, size_t maxQueueDepth) {
+  bool success = false;
+  if (mHandler) {
+    LOGE("Dispatcher already started");
+  } else if (!handler || maxQueueDepth == 0) {
+    LOGE("Invalid dispatcher configuration");
+  } else {
+    mHandler = std::move(handler);
+    mMaxQueueDepth = maxQueueDepth;
+    for (Queue& queue : mQueues) {
+      queue.thread = std::thread(&PriorityDispatcher::workerLoop, this,
+                                 &queue);
+    }
+    success = true;
+  }
+
+  return success;
+}
+
+void PriorityDispatcher::stop() {
+  for (Queue& queue : mQueues) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.stopping = true;
+    queue.cond.notify_all();
+    queue.spaceCond.notify_all();
+  }
+
+  for (Queue& queue : mQueues) {
+    if (queue.thread.joinable()) {
+      queue.thread.join();
+    }
+  }
+}
+
+bool PriorityDispatcher::enqueue(Priority priority, const void *message,
+                                 size_t length, bool droppable) {
+  Queue& queue = mQueues[static_cast<size_t>(priority)];
+  const auto *bytes = static_cast<const uint8_t *>(message);
+
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  if (!droppable && !queue.stopping
+      && queue.messages.size() >= mMaxQueueDepth) {
+    queue.stats.blockedCount++;
+    queue.spaceCond.wait(lock, [this, &queue]() {
+      return (queue.stopping || queue.messages.size() < mMaxQueueDepth);
+    });
+  }
+
+  bool success = (!queue.stopping && queue.messages.size() < mMaxQueueDepth);
+  if (!success) {
+    if (queue.stats.droppedCount++ == 0) {
+      LOGW("Dropping messages of priority %" PRIu8,
+           static_cast<uint8_t>(priority));
+    }
+  } else {
+    queue.messages.emplace_back();
+    queue.messages.back().data.assign(bytes, bytes + length);
+    queue.messages.back().enqueueTime = Clock::now();
+    queue.stats.maxQueueDepth = std::max(queue.stats.maxQueueDepth,
+                                         queue.messages.size());
+    queue.cond.notify_one();
+  }
+
+  return success;
+}
+
+PriorityDispatcher::Stats PriorityDispatcher::getStats(
+    Priority priority) const {
+  const Queue& queue = mQueues[static_cast<size_t>(priority)];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  return queue.stats;
+}
+
+void PriorityDispatcher::workerLoop(Queue *queue) {
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  while (true) {
+    queue->cond.wait(lock, [queue]() {
+      return (queue->stopping || !queue->messages.empty());
+    });
+    if (queue->messages.empty()) {
+      break;
+    }
+
+    QueuedMessage message = std::move(queue->messages.front());
+    queue->messages.pop_front();
+    queue->spaceCond.notify_one();
+
+    auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - message.enqueueTime);
+    uint64_t delayNs = static_cast<uint64_t>(delay.count());
+    queue->stats.dispatchedCount++;
+    queue->stats.totalQueueDelayNs += delayNs;
+    queue->stats.maxQueueDelayNs = std::max(queue->stats.maxQueueDelayNs,
+                                            delayNs);
+
+    lock.unlock();
+    mHandler(message.data.data(), message.data.size());
+    lock.lock();
+  }
+}
+
+}  // namespace chre
+}  // namespace android
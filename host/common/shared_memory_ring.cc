@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre_host/shared_memory_ring.h"
+
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+namespace android {
+namespace chre {
+
+namespace {
+
+constexpr uint32_t kRingMagic = 0x52455243;  // "CRER" (little-endian)
+constexpr uint32_t kRingVersion = 1;
+
+//! Records are aligned to this, so that message payloads are aligned.
+constexpr size_t kRecordAlignment = 8;
+
+//! Each record starts with a 32-bit length, padded to the record alignment
+constexpr size_t kRecordHeaderSize = kRecordAlignment;
+
+//! A record length marking the end of the usable space before the ring wraps
+constexpr uint32_t kWrapMarker = UINT32_MAX;
+
+//! The largest ring accepted from the other process
+constexpr size_t kMaxCapacity = 64 * 1024 * 1024;
+
+//! The seals a producer requires, so that the consumer can't shrink the memfd
+//! out from under the mapping
+constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+constexpr char kSetupMagic[8] = {'C', 'H', 'R', 'E', 'R', 'I', 'N', 'G'};
+constexpr char kDrainedMagic[8] = {'C', 'H', 'R', 'E', 'D', 'R', 'N', 'D'};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "Shared memory atomics must be lock-free");
+
+size_t alignRecordSize(size_t size) {
+  return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+bool isPowerOfTwo(uint64_t value) {
+  return (value != 0 && (value & (value - 1)) == 0);
+}
+
+/**
+ * @return true if the file descriptor refers to an eventfd
+ */
+bool isEventFd(int fd) {
+  char procPath[32];
+  char target[32];
+  snprintf(procPath, sizeof(procPath), "/proc/self/fd/%d", fd);
+  ssize_t length = readlink(procPath, target, sizeof(target) - 1);
+
+  bool eventFd = false;
+  if (length > 0) {
+    target[length] = '\0';
+    eventFd = (strcmp(target, "anon_inode:[eventfd]") == 0);
+  }
+
+  return eventFd;
+}
+
+}  // anonymous namespace
+
+/**
+ * The layout at the start of the shared region. The positions increase
+ * monotonically and are reduced modulo the capacity to index the data that
+ * follows the header. The producer and consumer fields are kept on separate
+ * cache lines.
+ */
+struct SharedMemoryRing::Header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;
+
+  alignas(64) std::atomic<uint64_t> writePos;
+  std::atomic<uint32_t> droppedCount;
+
+  alignas(64) std::atomic<uint64_t> readPos;
+  std::atomic<uint32_t> consumerWaiting;
+};
+
+SharedMemoryRing::~SharedMemoryRing() {
+  reset();
+}
+
+bool SharedMemoryRing::create(size_t capacity) {
+  reset();
+
+  size_t ringCapacity = kMinCapacity;
+  while (ringCapacity < capacity && ringCapacity < kMaxCapacity) {
+    ringCapacity *= 2;
+  }
+  size_t mappedSize = sizeof(Header) + ringCapacity;
+
+  // The raw system call is used as not all supported C libraries provide a
+  // memfd_create() wrapper
+  mMemFd = static_cast<int>(syscall(SYS_memfd_create, "chre_ring",
+                                    MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  mEventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  bool success = false;
+  if (mMemFd >= 0 && mEventFd >= 0
+      && ftruncate(mMemFd, static_cast<off_t>(mappedSize)) == 0
+      && fcntl(mMemFd, F_ADD_SEALS, kRequiredSeals) == 0) {
+    void *region = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, mMemFd, 0);
+    if (region != MAP_FAILED) {
+      mHeader = new (region) Header();
+      mHeader->magic = kRingMagic;
+      mHeader->version = kRingVersion;
+      mHeader->capacity = ringCapacity;
+      mData = static_cast<uint8_t *>(region) + sizeof(Header);
+      mCapacity = ringCapacity;
+      mMappedSize = mappedSize;
+      success = true;
+    }
+  }
+
+  if (!success) {
+    int savedErrno = errno;
+    reset();
+    errno = savedErrno;
+  }
+
+  return success;
+}
+
+bool SharedMemoryRing::attach(int memFd, int eventFd) {
+  reset();
+  mMemFd = memFd;
+  mEventFd = eventFd;
+
+  // The consumer supplies the eventfd, so check that it is one, and make sure
+  // that signalling it can never block the producer
+  bool success = false;
+  struct stat memFdStat;
+  int seals = fcntl(memFd, F_GET_SEALS);
+  int eventFdFlags = fcntl(eventFd, F_GETFL);
+  if (isEventFd(eventFd) && eventFdFlags >= 0
+      && fcntl(eventFd, F_SETFL, eventFdFlags | O_NONBLOCK) == 0
+      && seals >= 0 && (seals & kRequiredSeals) == kRequiredSeals
+      && fstat(memFd, &memFdStat) == 0
+      && static_cast<size_t>(memFdStat.st_size) > sizeof(Header)) {
+    size_t mappedSize = static_cast<size_t>(memFdStat.st_size);
+    void *region = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, memFd, 0);
+    if (region != MAP_FAILED) {
+      auto *header = static_cast<Header *>(region);
+      uint64_t capacity = header->capacity;
+      uint64_t writePos = header->writePos.load();
+      if (header->magic != kRingMagic || header->version != kRingVersion
+          || !isPowerOfTwo(capacity) || capacity < kMinCapacity
+          || capacity > kMaxCapacity
+          || sizeof(Header) + capacity > mappedSize
+          || writePos - header->readPos.load() > capacity) {
+        munmap(region, mappedSize);
+      } else {
+        mHeader = header;
+        mData = static_cast<uint8_t *>(region) + sizeof(Header);
+        mCapacity = static_cast<size_t>(capacity);
+        mMappedSize = mappedSize;
+        mPosition = writePos;
+        success = true;
+      }
+    }
+  }
+
+  if (!success) {
+    reset();
+  }
+
+  return success;
+}
+
+void SharedMemoryRing::reset() {
+  if (mHeader != nullptr) {
+    munmap(mHeader, mMappedSize);
+    mHeader = nullptr;
+    mData = nullptr;
+  }
+  if (mMemFd >= 0) {
+    close(mMemFd);
+    mMemFd = -1;
+  }
+  if (mEventFd >= 0) {
+    close(mEventFd);
+    mEventFd = -1;
+  }
+  mCapacity = 0;
+  mMappedSize = 0;
+  mPosition = 0;
+}
+
+bool SharedMemoryRing::write(const void *data, size_t length) {
+  bool success = false;
+  if (mHeader != nullptr && length < kWrapMarker) {
+    size_t recordSize = alignRecordSize(kRecordHeaderSize + length);
+    uint64_t used = mPosition - mHeader->readPos.load(std::memory_order_acquire);
+    size_t offset = static_cast<size_t>(mPosition & (mCapacity - 1));
+    size_t contiguous = mCapacity - offset;
+
+    // Records are never split, so a record that doesn't fit before the end of
+    // the ring also consumes the remainder of it
+    size_t needed = recordSize + ((recordSize > contiguous) ? contiguous : 0);
+    if (used <= mCapacity && needed <= mCapacity - used) {
+      if (recordSize > contiguous) {
+        uint32_t marker = kWrapMarker;
+        memcpy(&mData[offset], &marker, sizeof(marker));
+        mPosition += contiguous;
+        offset = 0;
+      }
+
+      uint32_t recordLength = static_cast<uint32_t>(length);
+      memcpy(&mData[offset], &recordLength, sizeof(recordLength));
+      memcpy(&mData[offset + kRecordHeaderSize], data, length);
+      mPosition += recordSize;
+
+      // Publishing the write position and then checking whether the consumer
+      // is waiting pairs with the opposite order in prepareToWait(), so that
+      // at least one side observes the other
+      mHeader->writePos.store(mPosition, std::memory_order_seq_cst);
+      if (mHeader->consumerWaiting.load(std::memory_order_seq_cst) != 0
+          && mHeader->consumerWaiting.exchange(0) != 0) {
+        uint64_t wakeup = 1;
+        ssize_t ret = ::write(mEventFd, &wakeup, sizeof(wakeup));
+        (void) ret;
+      }
+      success = true;
+    } else if (used <= mCapacity) {
+      mHeader->droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  return success;
+}
+
+size_t SharedMemoryRing::drain(const MessageHandler& handler) {
+  size_t count = 0;
+  if (mHeader != nullptr) {
+    uint64_t writePos = mHeader->writePos.load(std::memory_order_acquire);
+    while (mPosition != writePos && writePos - mPosition <= mCapacity) {
+      size_t offset = static_cast<size_t>(mPosition & (mCapacity - 1));
+      uint32_t length;
+      memcpy(&length, &mData[offset], sizeof(length));
+
+      if (length == kWrapMarker) {
+        mPosition += mCapacity - offset;
+      } else if (length > mCapacity - offset - kRecordHeaderSize) {
+        // Corrupt record - give up on the rest of the ring
+        mPosition = writePos;
+      } else {
+        handler(&mData[offset + kRecordHeaderSize], length);
+        mPosition += alignRecordSize(kRecordHeaderSize + length);
+        count++;
+      }
+      mHeader->readPos.store(mPosition, std::memory_order_release);
+    }
+  }
+
+  return count;
+}
+
+bool SharedMemoryRing::prepareToWait() {
+  bool shouldWait = false;
+  if (mHeader != nullptr) {
+    mHeader->consumerWaiting.store(1, std::memory_order_seq_cst);
+    shouldWait = (mHeader->writePos.load(std::memory_order_seq_cst)
+                  == mPosition);
+    if (!shouldWait) {
+      mHeader->consumerWaiting.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  return shouldWait;
+}
+
+void SharedMemoryRing::clearWakeup() {
+  uint64_t wakeups;
+  ssize_t ret = read(mEventFd, &wakeups, sizeof(wakeups));
+  (void) ret;
+}
+
+uint32_t SharedMemoryRing::getDroppedCount() const {
+  return (mHeader != nullptr) ?
+      mHeader->droppedCount.load(std::memory_order_relaxed) : 0;
+}
+
+SharedMemoryTransportSetup SharedMemoryTransportSetup::make(bool accepted) {
+  SharedMemoryTransportSetup setup = {};
+  memcpy(setup.magic, kSetupMagic, sizeof(setup.magic));
+  setup.accepted = accepted ? 1 : 0;
+  return setup;
+}
+
+bool SharedMemoryTransportSetup::isSetupPacket(const void *data,
+                                               size_t length) {
+  return (length == sizeof(SharedMemoryTransportSetup)
+          && memcmp(data, kSetupMagic, sizeof(kSetupMagic)) == 0);
+}
+
+SharedMemoryRingDrained SharedMemoryRingDrained::make(
+    uint32_t socketMessageCount) {
+  SharedMemoryRingDrained drained = {};
+  memcpy(drained.magic, kDrainedMagic, sizeof(drained.magic));
+  drained.socketMessageCount = socketMessageCount;
+  return drained;
+}
+
+bool SharedMemoryRingDrained::isDrainedPacket(const void *data,
+                                              size_t length) {
+  return (length == sizeof(SharedMemoryRingDrained)
+          && memcmp(data, kDrainedMagic, sizeof(kDrainedMagic)) == 0);
+}
+
+}  // namespace chre
+}  // namespace android
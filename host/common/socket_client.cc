@@ -17,8 +17,10 @@
 #include "chre_host/socket_client.h"
 
 #include <inttypes.h>
-
+#include <poll.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #include <chrono>
 
@@ -100,6 +102,14 @@ bool SocketClient::sendMessage(const void *data, size_t length) {
   return success;
 }
 
+void SocketClient::enableSharedMemoryTransport(size_t capacity) {
+  if (receiveThreadRunning()) {
+    LOGE("Shared memory transport must be enabled before connecting");
+  } else {
+    mRingCapacity = capacity;
+  }
+}
+
 bool SocketClient::doConnect(const char *socketName,
                              const sp<ICallbacks>& callbacks,
                              bool connectInBackground) {
@@ -132,6 +142,12 @@ bool SocketClient::doConnect(const char *socketName,
   return success;
 }
 
+void SocketClient::drainRing() {
+  mRing.drain([this](const void *data, size_t length) {
+    mCallbacks->onMessageReceived(data, length);
+  });
+}
+
 bool SocketClient::inReceiveThread() const {
   return (std::this_thread::get_id() == mRxThread.get_id());
 }
@@ -143,6 +159,10 @@ void SocketClient::receiveThread() {
   LOGV("Receive thread started");
   while (!mGracefulShutdown && (mSockFd != INVALID_SOCKET || reconnect())) {
     while (!mGracefulShutdown) {
+      if (mRingActive && !waitForSocketData()) {
+        break;
+      }
+
       ssize_t bytesReceived = recv(mSockFd, buffer, sizeof(buffer), 0);
       if (bytesReceived < 0) {
         LOG_ERROR("Exiting RX thread", errno);
@@ -155,8 +175,40 @@ void SocketClient::receiveThread() {
         break;
       }
 
-      mCallbacks->onMessageReceived(buffer, bytesReceived);
+      if (mRing.isValid() && SharedMemoryTransportSetup::isSetupPacket(
+              buffer, static_cast<size_t>(bytesReceived))) {
+        mRingActive = (reinterpret_cast<const SharedMemoryTransportSetup *>(
+            buffer)->accepted != 0);
+        mSocketMessageCount = 0;
+        if (mRingActive) {
+          LOGD("Receiving messages through shared memory");
+        } else {
+          LOGW("Server declined shared memory transport");
+          mRing.reset();
+        }
+      } else {
+        if (mRingActive) {
+          // The server only uses the socket when the ring is full, so deliver
+          // what was written to the ring first to preserve ordering
+          drainRing();
+        }
+        mCallbacks->onMessageReceived(buffer, bytesReceived);
+        if (mRingActive) {
+          // The server stays on the socket until it knows that the ring is
+          // empty and it has no more messages in flight over the socket
+          SharedMemoryRingDrained drained = SharedMemoryRingDrained::make(
+              ++mSocketMessageCount);
+          sendMessage(&drained, sizeof(drained));
+        }
+      }
+    }
+
+    if (mRingActive) {
+      // Deliver anything the server wrote before disconnecting
+      drainRing();
     }
+    mRingActive = false;
+    mRing.reset();
 
     if (close(mSockFd) != 0) {
       LOG_ERROR("Couldn't close socket", errno);
@@ -219,6 +271,42 @@ bool SocketClient::reconnect() {
   return false;
 }
 
+void SocketClient::requestSharedMemoryTransport() {
+  if (!mRing.create(mRingCapacity)) {
+    LOGE("Couldn't create shared memory ring, using socket only");
+  } else {
+    SharedMemoryTransportSetup request =
+        SharedMemoryTransportSetup::make(false /* accepted */);
+    struct iovec iov = {};
+    iov.iov_base = &request;
+    iov.iov_len = sizeof(request);
+
+    int fds[2] = { mRing.getMemFd(), mRing.getEventFd() };
+    union {
+      struct cmsghdr align;
+      char buf[CMSG_SPACE(sizeof(fds))];
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    if (sendmsg(mSockFd, &msg, 0) != static_cast<ssize_t>(sizeof(request))) {
+      LOG_ERROR("Couldn't request shared memory transport", errno);
+      mRing.reset();
+    }
+  }
+}
+
 bool SocketClient::tryConnect(bool suppressErrorLogs) {
   errno = 0;
   mSockFd = socket_local_client(mSocketName,
@@ -227,10 +315,48 @@ bool SocketClient::tryConnect(bool suppressErrorLogs) {
   if (mSockFd == INVALID_SOCKET && !suppressErrorLogs) {
     LOGE("Couldn't create/connect client socket to '%s': %s",
          mSocketName, strerror(errno));
+  } else if (mSockFd != INVALID_SOCKET && mRingCapacity > 0) {
+    requestSharedMemoryTransport();
   }
 
   return (mSockFd != INVALID_SOCKET);
 }
 
+bool SocketClient::waitForSocketData() {
+  bool success = false;
+
+  while (!mGracefulShutdown) {
+    drainRing();
+    if (!mRing.prepareToWait()) {
+      continue;
+    }
+
+    struct pollfd pollFds[2] = {};
+    pollFds[0].fd = mSockFd;
+    pollFds[0].events = POLLIN;
+    pollFds[1].fd = mRing.getEventFd();
+    pollFds[1].events = POLLIN;
+
+    int ret = poll(pollFds, 2, -1 /* timeout */);
+    if (ret < 0) {
+      if (errno != EINTR) {
+        LOG_ERROR("Exiting RX thread", errno);
+        break;
+      }
+    } else {
+      if (pollFds[1].revents & POLLIN) {
+        mRing.clearWakeup();
+      }
+      if (pollFds[0].revents != 0) {
+        // Readable, hung up, or errored - recv() will tell which
+        success = true;
+        break;
+      }
+    }
+  }
+
+  return success;
+}
+
 }  // namespace chre
 }  // namespace android
@@ -66,8 +66,10 @@ SocketServer::SocketServer() {
 }
 
 void SocketServer::run(const char *socketName, bool allowSocketCreation,
-                       ClientMessageCallback clientMessageCallback) {
+                       ClientMessageCallback clientMessageCallback,
+                       ClientDisconnectedCallback clientDisconnectedCallback) {
   mClientMessageCallback = clientMessageCallback;
+  mClientDisconnectedCallback = clientDisconnectedCallback;
 
   mSockFd = android_get_control_socket(socketName);
   if (mSockFd == INVALID_SOCKET && allowSocketCreation) {
@@ -103,13 +105,22 @@ void SocketServer::run(const char *socketName, bool allowSocketCreation,
 }
 
 void SocketServer::sendToAllClients(const void *data, size_t length) {
+  sendToInterestedClients(data, length, nullptr);
+}
+
+void SocketServer::sendToInterestedClients(const void *data, size_t length,
+                                           const ClientFilter& filter) {
   std::lock_guard<std::mutex> lock(mClientsMutex);
 
   int deliveredCount = 0;
-  for (const auto& pair : mClients) {
+  int filteredCount = 0;
+  for (auto& pair : mClients) {
     int clientSocket = pair.first;
     uint16_t clientId = pair.second.clientId;
-    if (sendToClientSocket(data, length, clientSocket, clientId)) {
+    if (filter && !filter(clientId)) {
+      filteredCount++;
+    } else if (sendToClient(data, length, clientSocket, pair.second,
+                            false /* directed */)) {
       deliveredCount++;
     } else if (errno == EINTR) {
       // Exit early if we were interrupted - we should only get this for
@@ -118,7 +129,7 @@ void SocketServer::sendToAllClients(const void *data, size_t length) {
     }
   }
 
-  if (deliveredCount == 0) {
+  if (deliveredCount == 0 && filteredCount == 0) {
     LOGW("Got message but didn't deliver to any clients");
   }
 }
@@ -128,11 +139,12 @@ bool SocketServer::sendToClientById(const void *data, size_t length,
   std::lock_guard<std::mutex> lock(mClientsMutex);
 
   bool sent = false;
-  for (const auto& pair : mClients) {
+  for (auto& pair : mClients) {
     uint16_t thisClientId = pair.second.clientId;
     if (thisClientId == clientId) {
       int clientSocket = pair.first;
-      sent = sendToClientSocket(data, length, clientSocket, thisClientId);
+      sent = sendToClient(data, length, clientSocket, pair.second,
+                          true /* directed */);
       break;
     }
   }
@@ -174,12 +186,13 @@ void SocketServer::acceptClientConnection() {
       assert(slotFound);
       close(clientSocket);
     } else {
+      uint16_t clientId = clientData.clientId;
       {
         std::lock_guard<std::mutex> lock(mClientsMutex);
-        mClients[clientSocket] = clientData;
+        mClients[clientSocket] = std::move(clientData);
       }
       LOGI("Accepted new client connection (count %zu), assigned client ID %"
-           PRIu16, mClients.size(), clientData.clientId);
+           PRIu16, mClients.size(), clientId);
     }
   }
 }
@@ -189,26 +202,149 @@ void SocketServer::handleClientData(int clientSocket) {
   uint16_t clientId = clientData.clientId;
 
   uint8_t buffer[kMaxPacketSize];
-  ssize_t packetSize = recv(clientSocket, buffer, sizeof(buffer), MSG_DONTWAIT);
+  struct iovec iov = {};
+  iov.iov_base = buffer;
+  iov.iov_len = sizeof(buffer);
+
+  // Room for the file descriptors accompanying a SharedMemoryTransportSetup
+  constexpr size_t kMaxFds = 2;
+  union {
+    struct cmsghdr align;
+    char buf[CMSG_SPACE(kMaxFds * sizeof(int))];
+  } control;
+
+  struct msghdr msg = {};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+
+  ssize_t packetSize = recvmsg(clientSocket, &msg,
+                               MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+  int fds[kMaxFds];
+  size_t fdCount = 0;
+  if (packetSize >= 0) {
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; i++) {
+          int fd;
+          memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(fd));
+          if (fdCount < kMaxFds) {
+            fds[fdCount++] = fd;
+          } else {
+            close(fd);
+          }
+        }
+      }
+    }
+  }
+
   if (packetSize < 0) {
     LOGE("Couldn't get packet from client %" PRIu16 ": %s", clientId,
          strerror(errno));
   } else if (packetSize == 0) {
     LOGI("Client %" PRIu16 " disconnected", clientId);
     disconnectClient(clientSocket);
+  } else if (fdCount == 0 && SharedMemoryRingDrained::isDrainedPacket(
+                                  buffer, static_cast<size_t>(packetSize))) {
+    const auto *drained =
+        reinterpret_cast<const SharedMemoryRingDrained *>(buffer);
+    handleRingDrained(clientSocket, drained->socketMessageCount);
+  } else if (fdCount > 0 || SharedMemoryTransportSetup::isSetupPacket(
+                                 buffer, static_cast<size_t>(packetSize))) {
+    if (!SharedMemoryTransportSetup::isSetupPacket(
+            buffer, static_cast<size_t>(packetSize))) {
+      LOGW("Ignoring packet with file descriptors from client %" PRIu16,
+           clientId);
+      for (size_t i = 0; i < fdCount; i++) {
+        close(fds[i]);
+      }
+    } else {
+      handleSharedMemorySetup(clientSocket, fds, fdCount);
+    }
   } else {
     LOGV("Got %zd byte packet from client %" PRIu16, packetSize, clientId);
+    if (mCaptureWriter != nullptr) {
+      mCaptureWriter->record(capture::Direction::FromClient, clientId, buffer,
+                             static_cast<size_t>(packetSize));
+    }
     mClientMessageCallback(clientId, buffer, packetSize);
   }
 }
 
+void SocketServer::handleSharedMemorySetup(int clientSocket, int *fds,
+                                           size_t fdCount) {
+  std::lock_guard<std::mutex> lock(mClientsMutex);
+  ClientData& clientData = mClients[clientSocket];
+
+  std::unique_ptr<SharedMemoryRing> ring(new SharedMemoryRing());
+  bool accepted = false;
+  if (fdCount != 2) {
+    for (size_t i = 0; i < fdCount; i++) {
+      close(fds[i]);
+    }
+  } else if (clientData.ring != nullptr) {
+    LOGW("Client %" PRIu16 " already uses shared memory", clientData.clientId);
+    close(fds[0]);
+    close(fds[1]);
+  } else {
+    // Takes ownership of the file descriptors
+    accepted = ring->attach(fds[0], fds[1]);
+  }
+
+  // The reply goes over the socket before any message is written to the ring,
+  // so the client knows that everything after it arrives via the ring
+  SharedMemoryTransportSetup reply = SharedMemoryTransportSetup::make(accepted);
+  if (!sendToClientSocket(&reply, sizeof(reply), clientSocket,
+                          clientData.clientId)) {
+    accepted = false;
+  }
+
+  if (accepted) {
+    LOGI("Client %" PRIu16 " switched to shared memory transport",
+         clientData.clientId);
+    clientData.ring = std::move(ring);
+  } else {
+    LOGW("Rejected shared memory transport for client %" PRIu16,
+         clientData.clientId);
+  }
+}
+
+void SocketServer::handleRingDrained(int clientSocket,
+                                     uint32_t socketMessageCount) {
+  std::lock_guard<std::mutex> lock(mClientsMutex);
+  ClientData& clientData = mClients[clientSocket];
+
+  // An older acknowledgement means the client has yet to receive messages sent
+  // over the socket, which anything written to the ring could overtake
+  if (clientData.ringFallback
+      && socketMessageCount == clientData.socketMessageCount) {
+    LOGD("Client %" PRIu16 " drained its shared memory ring, resuming it",
+         clientData.clientId);
+    clientData.ringFallback = false;
+  }
+}
+
 void SocketServer::disconnectClient(int clientSocket) {
+  uint16_t clientId;
   {
     std::lock_guard<std::mutex> lock(mClientsMutex);
+    const ClientData& clientData = mClients[clientSocket];
+    clientId = clientData.clientId;
+    if (clientData.ring != nullptr && clientData.ring->getDroppedCount() > 0) {
+      LOGW("Dropped %" PRIu32 " messages to client %" PRIu16 " due to a full "
+           "shared memory ring", clientData.ring->getDroppedCount(), clientId);
+    }
     mClients.erase(clientSocket);
   }
   close(clientSocket);
 
+  if (mClientDisconnectedCallback) {
+    mClientDisconnectedCallback(clientId);
+  }
+
   bool removed = false;
   for (size_t i = 1; i <= kMaxActiveClients; i++) {
     if (mPollFds[i].fd == clientSocket) {
@@ -224,6 +360,47 @@ void SocketServer::disconnectClient(int clientSocket) {
   }
 }
 
+bool SocketServer::sendToClient(const void *data, size_t length,
+                                int clientSocket, ClientData& clientData,
+                                bool directed) {
+  bool sent;
+  if (clientData.ring == nullptr) {
+    sent = sendToClientSocket(data, length, clientSocket, clientData.clientId);
+  } else {
+    errno = 0;
+    bool useSocket = clientData.ringFallback;
+    if (!useSocket) {
+      sent = clientData.ring->write(data, length);
+      if (!sent && directed) {
+        // Responses to a client's own requests must not be lost, so they fall
+        // back to the socket, which the client drains the ring ahead of
+        LOGW("Shared memory ring for client %" PRIu16 " is full, using "
+             "socket", clientData.clientId);
+        clientData.ringFallback = true;
+        useSocket = true;
+      } else if (!sent) {
+        LOGV("Shared memory ring for client %" PRIu16 " is full",
+             clientData.clientId);
+      }
+    }
+
+    if (useSocket) {
+      sent = sendToClientSocket(data, length, clientSocket,
+                                clientData.clientId);
+      if (sent) {
+        clientData.socketMessageCount++;
+      }
+    }
+  }
+
+  if (sent && mCaptureWriter != nullptr) {
+    mCaptureWriter->record(capture::Direction::ToClient, clientData.clientId,
+                           data, length);
+  }
+
+  return sent;
+}
+
 bool SocketServer::sendToClientSocket(const void *data, size_t length,
                                       int clientSocket, uint16_t clientId) {
   errno = 0;
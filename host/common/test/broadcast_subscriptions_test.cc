@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "chre_host/broadcast_subscriptions.h"
+
+using android::chre::BroadcastSubscriptions;
+
+namespace {
+
+constexpr uint16_t kClientId = 1;
+constexpr uint16_t kOtherClientId = 2;
+constexpr uint64_t kAppId = 0x0123456789abcdef;
+constexpr uint64_t kOtherAppId = 0x0123456789abcdee;
+constexpr uint32_t kMessageType = 1234;
+constexpr uint32_t kOtherMessageType = 5678;
+
+BroadcastSubscriptions::Subscription makeSubscription(
+    uint64_t appId, uint32_t messageType) {
+  BroadcastSubscriptions::Subscription subscription = {};
+  subscription.appId = appId;
+  subscription.messageType = messageType;
+  return subscription;
+}
+
+}  // anonymous namespace
+
+TEST(BroadcastSubscriptions, ClientWithoutSubscriptionsReceivesEverything) {
+  BroadcastSubscriptions subscriptions;
+  EXPECT_TRUE(subscriptions.shouldDeliver(kClientId, kAppId, kMessageType));
+  EXPECT_TRUE(subscriptions.shouldDeliver(kClientId, kOtherAppId,
+                                          kOtherMessageType));
+  EXPECT_EQ(subscriptions.getTotalFilteredCount(), 0u);
+}
+
+TEST(BroadcastSubscriptions, SubscribedClientOnlyReceivesMatches) {
+  BroadcastSubscriptions subscriptions;
+  subscriptions.addSubscription(kClientId,
+                                makeSubscription(kAppId, kMessageType));
+
+  EXPECT_TRUE(subscriptions.shouldDeliver(kClientId, kAppId, kMessageType));
+  EXPECT_FALSE(subscriptions.shouldDeliver(kClientId, kAppId,
+                                           kOtherMessageType));
+  EXPECT_FALSE(subscriptions.shouldDeliver(kClientId, kOtherAppId,
+                                           kMessageType));
+  EXPECT_EQ(subscriptions.getTotalFilteredCount(), 2u);
+}
+
+TEST(BroadcastSubscriptions, WildcardsMatchAnyValue) {
+  BroadcastSubscriptions subscriptions;
+  BroadcastSubscriptions::Subscription anyType =
+      makeSubscription(kAppId, 0);
+  anyType.matchAnyMessageType = true;
+  subscriptions.addSubscription(kClientId, anyType);
+
+  BroadcastSubscriptions::Subscription anyApp =
+      makeSubscription(0, kOtherMessageType);
+  anyApp.matchAnyAppId = true;
+  subscriptions.addSubscription(kOtherClientId, anyApp);
+
+  EXPECT_TRUE(subscriptions.shouldDeliver(kClientId, kAppId,
+                                          kOtherMessageType));
+  EXPECT_FALSE(subscriptions.shouldDeliver(kClientId, kOtherAppId,
+                                           kOtherMessageType));
+  EXPECT_TRUE(subscriptions.shouldDeliver(kOtherClientId, kOtherAppId,
+                                          kOtherMessageType));
+  EXPECT_FALSE(subscriptions.shouldDeliver(kOtherClientId, kAppId,
+                                           kMessageType));
+}
+
+TEST(BroadcastSubscriptions, DuplicateSubscriptionIsRemovedOnce) {
+  BroadcastSubscriptions subscriptions;
+  BroadcastSubscriptions::Subscription subscription =
+      makeSubscription(kAppId, kMessageType);
+  subscriptions.addSubscription(kClientId, subscription);
+  subscriptions.addSubscription(kClientId, subscription);
+
+  EXPECT_TRUE(subscriptions.removeSubscription(kClientId, subscription));
+  EXPECT_FALSE(subscriptions.removeSubscription(kClientId, subscription));
+}
+
+TEST(BroadcastSubscriptions, RemovingLastSubscriptionKeepsClientFiltered) {
+  BroadcastSubscriptions subscriptions;
+  BroadcastSubscriptions::Subscription subscription =
+      makeSubscription(kAppId, kMessageType);
+  subscriptions.addSubscription(kClientId, subscription);
+  ASSERT_TRUE(subscriptions.removeSubscription(kClientId, subscription));
+
+  EXPECT_FALSE(subscriptions.shouldDeliver(kClientId, kAppId, kMessageType));
+  EXPECT_FALSE(subscriptions.shouldDeliver(kClientId, kOtherAppId,
+                                           kOtherMessageType));
+}
+
+TEST(BroadcastSubscriptions, RemovingUnknownSubscriptionFails) {
+  BroadcastSubscriptions subscriptions;
+  EXPECT_FALSE(subscriptions.removeSubscription(
+      kClientId, makeSubscription(kAppId, kMessageType)));
+  EXPECT_TRUE(subscriptions.shouldDeliver(kClientId, kAppId, kMessageType));
+}
+
+TEST(BroadcastSubscriptions, SubscriptionsArePerClient) {
+  BroadcastSubscriptions subscriptions;
+  subscriptions.addSubscription(kClientId,
+                                makeSubscription(kAppId, kMessageType));
+
+  EXPECT_FALSE(subscriptions.shouldDeliver(kClientId, kOtherAppId,
+                                           kMessageType));
+  EXPECT_TRUE(subscriptions.shouldDeliver(kOtherClientId, kOtherAppId,
+                                          kMessageType));
+}
+
+TEST(BroadcastSubscriptions, RemoveClientReturnsStatsAndResetsState) {
+  BroadcastSubscriptions subscriptions;
+  subscriptions.addSubscription(kClientId,
+                                makeSubscription(kAppId, kMessageType));
+  subscriptions.shouldDeliver(kClientId, kAppId, kMessageType);
+  subscriptions.shouldDeliver(kClientId, kOtherAppId, kMessageType);
+  subscriptions.shouldDeliver(kClientId, kOtherAppId, kMessageType);
+
+  BroadcastSubscriptions::ClientStats stats =
+      subscriptions.removeClient(kClientId);
+  EXPECT_EQ(stats.deliveredCount, 1u);
+  EXPECT_EQ(stats.filteredCount, 2u);
+  EXPECT_EQ(subscriptions.getTotalFilteredCount(), 2u);
+
+  // A client reusing the ID starts out unsubscribed
+  EXPECT_TRUE(subscriptions.shouldDeliver(kClientId, kOtherAppId,
+                                          kMessageType));
+}
@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/apps/echo/echo_messages.h"
+#include "chre/util/nanoapp/app_id.h"
+#include "chre_host/host_protocol_host.h"
+#include "chre_host/log.h"
+#include "chre_host/socket_client.h"
+#include "latency_summary.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <utils/StrongPointer.h>
+
+/**
+ * @file
+ * A benchmark that measures the round-trip latency and throughput of the host
+ * link. It sends nanoapp messages to the Echo nanoapp, hub info requests and
+ * nanoapp list requests through the CHRE daemon at the configured rates, and
+ * reports latency percentiles and achieved throughput for each kind of request
+ * once the run completes. The configuration is given as key=value arguments,
+ * for example:
+ *
+ *   chre_link_benchmark_client duration_ms=5000 messages=500 message_size=256
+ *
+ * Run without arguments to use the defaults listed in kOptions. Hub info and
+ * nanoapp list requests may be answered from the daemon's cache, in which case
+ * they measure the socket path only.
+ */
+
+using android::sp;
+using android::chre::IChreMessageHandlers;
+using android::chre::SocketClient;
+using android::chre::HostProtocolHost;
+using android::chre::logLatencySummary;
+using android::chre::summarizeLatencies;
+using flatbuffers::FlatBufferBuilder;
+
+// Aliased for consistency with the way these symbols are referenced in
+// CHRE-side code
+namespace fbs = ::chre::fbs;
+
+namespace {
+
+//! The host endpoint we use when sending; set to CHRE_HOST_ENDPOINT_UNSPECIFIED
+constexpr uint16_t kHostEndpoint = 0xfffe;
+
+//! How often the sending loop checks whether more requests are due
+constexpr auto kPacingInterval = std::chrono::microseconds(500);
+
+//! How long to wait for outstanding responses after the run ends
+constexpr auto kDrainTimeout = std::chrono::seconds(2);
+
+//! The benchmark configuration, populated from the command line
+struct BenchmarkConfig {
+  uint32_t durationMillis;
+  uint32_t messagesPerSec;
+  uint32_t messageSize;
+  uint32_t hubInfoRequestsPerSec;
+  uint32_t nanoappListRequestsPerSec;
+  uint32_t maxInFlight;
+};
+
+//! A command line option that sets one field of the BenchmarkConfig
+struct Option {
+  const char *name;
+  uint32_t BenchmarkConfig::*field;
+  uint32_t defaultValue;
+};
+
+const Option kOptions[] = {
+  {"duration_ms",    &BenchmarkConfig::durationMillis,            5000},
+  {"messages",       &BenchmarkConfig::messagesPerSec,            200},
+  {"message_size",   &BenchmarkConfig::messageSize,               64},
+  {"hub_info",       &BenchmarkConfig::hubInfoRequestsPerSec,     0},
+  {"nanoapp_list",   &BenchmarkConfig::nanoappListRequestsPerSec, 0},
+  {"max_in_flight",  &BenchmarkConfig::maxInFlight,               32},
+};
+
+//! Placed at the start of each echo payload so responses can be matched to
+//! requests. The run ID distinguishes our echoes from those of other clients,
+//! since the daemon broadcasts nanoapp messages.
+struct EchoHeader {
+  uint32_t runId;
+  uint32_t sequence;
+};
+
+//! The kinds of requests the benchmark sends
+enum RequestKind : size_t {
+  kRequestKindMessage = 0,
+  kRequestKindHubInfo,
+  kRequestKindNanoappList,
+  kRequestKindCount,
+};
+
+const char *const kRequestKindNames[kRequestKindCount] = {
+  "Echo messages",
+  "Hub info",
+  "Nanoapp list",
+};
+
+using Clock = std::chrono::steady_clock;
+
+//! Statistics gathered for one kind of request
+struct RequestStats {
+  uint32_t sent = 0;
+  uint32_t sendFailed = 0;
+
+  //! Requests that were due but not sent because maxInFlight were outstanding
+  uint32_t skipped = 0;
+
+  //! Round-trip latency of each response received, in nanoseconds
+  std::vector<uint64_t> latenciesNs;
+};
+
+class SocketCallbacks : public SocketClient::ICallbacks,
+                        public IChreMessageHandlers {
+ public:
+  explicit SocketCallbacks(uint32_t runId) : mRunId(runId) {}
+
+  void onMessageReceived(const void *data, size_t length) override {
+    if (!HostProtocolHost::decodeMessageFromChre(data, length, *this)) {
+      LOGE("Failed to decode message");
+    }
+  }
+
+  void onDisconnected() override {
+    LOGE("Socket disconnected");
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDisconnected = true;
+    mCond.notify_all();
+  }
+
+  void handleNanoappMessage(
+      uint64_t appId, uint32_t messageType, uint16_t /*hostEndpoint*/,
+      const void *messageData, size_t messageLen) override {
+    EchoHeader header;
+    if (appId == chre::kEchoAppId
+        && messageType == chre::echo::kMessageTypeEchoResponse
+        && messageLen >= sizeof(header)) {
+      memcpy(&header, messageData, sizeof(header));
+      if (header.runId == mRunId) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto pending = mPendingMessages.find(header.sequence);
+        if (pending != mPendingMessages.end()) {
+          recordLatency(kRequestKindMessage, pending->second);
+          mPendingMessages.erase(pending);
+          notifyIfDrained();
+        }
+      }
+    }
+  }
+
+  void handleHubInfoResponse(
+      const char * /*name*/, const char * /*vendor*/,
+      const char * /*toolchain*/, uint32_t /*legacyPlatformVersion*/,
+      uint32_t /*legacyToolchainVersion*/, float /*peakMips*/,
+      float /*stoppedPower*/, float /*sleepPower*/, float /*peakPower*/,
+      uint32_t /*maxMessageLen*/, uint64_t /*platformId*/,
+      uint32_t /*version*/, bool /*supportsCachedLoad*/) override {
+    onFifoResponse(kRequestKindHubInfo);
+  }
+
+  void handleNanoappListResponse(
+      const fbs::NanoappListResponseT& /*response*/) override {
+    onFifoResponse(kRequestKindNanoappList);
+  }
+
+  /**
+   * Records a request as outstanding. Must be called before the request is
+   * sent, so the response can't arrive first.
+   *
+   * @param sequence Echo sequence number; ignored for other kinds
+   */
+  void onRequestSending(RequestKind kind, uint32_t sequence) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Clock::time_point now = Clock::now();
+    if (kind == kRequestKindMessage) {
+      mPendingMessages[sequence] = now;
+    } else {
+      mPendingFifo[kind].push_back(now);
+    }
+  }
+
+  /**
+   * Updates the statistics after attempting to send a request recorded via
+   * onRequestSending(), withdrawing it if the send failed.
+   */
+  void onRequestSent(RequestKind kind, uint32_t sequence, bool success) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (success) {
+      mStats[kind].sent++;
+    } else {
+      mStats[kind].sendFailed++;
+      if (kind == kRequestKindMessage) {
+        mPendingMessages.erase(sequence);
+      } else if (!mPendingFifo[kind].empty()) {
+        mPendingFifo[kind].pop_back();
+      }
+    }
+  }
+
+  void onRequestSkipped(RequestKind kind) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats[kind].skipped++;
+  }
+
+  size_t getInFlightCount(RequestKind kind) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return getInFlightCountLocked(kind);
+  }
+
+  /**
+   * Waits for all outstanding requests to be answered.
+   *
+   * @return true if nothing is outstanding
+   */
+  template<typename DurationType>
+  bool waitForOutstanding(DurationType timeout) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    return mCond.wait_for(lock, timeout, [this]() {
+      return (mDisconnected || getTotalInFlightCountLocked() == 0);
+    }) && !mDisconnected;
+  }
+
+  /**
+   * Logs the results for each kind of request that was sent.
+   *
+   * @param elapsedMillis The duration of the sending phase
+   * @param messageSize The size of each echo payload
+   */
+  void printResults(uint32_t elapsedMillis, uint32_t messageSize) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    LOGI("Run completed in %" PRIu32 " ms", elapsedMillis);
+    for (size_t i = 0; i < kRequestKindCount; i++) {
+      RequestKind kind = static_cast<RequestKind>(i);
+      RequestStats& stats = mStats[kind];
+      if (stats.sent == 0 && stats.sendFailed == 0 && stats.skipped == 0) {
+        continue;
+      }
+
+      std::vector<uint64_t>& latencies = stats.latenciesNs;
+      size_t received = latencies.size();
+      double rate = (elapsedMillis == 0)
+          ? 0.0 : received * 1000.0 / elapsedMillis;
+      LOGI("  %-14s sent %" PRIu32 " failed %" PRIu32 " skipped %" PRIu32
+           ", received %zu lost %zu, %.1f/s", kRequestKindNames[kind],
+           stats.sent, stats.sendFailed, stats.skipped, received,
+           getInFlightCountLocked(kind), rate);
+      if (kind == kRequestKindMessage) {
+        LOGI("  %-14s %.1f KiB/s each way", "", rate * messageSize / 1024.0);
+      }
+
+      if (!latencies.empty()) {
+        logLatencySummary(kRequestKindNames[kind],
+                          summarizeLatencies(&latencies));
+      }
+    }
+  }
+
+ private:
+  const uint32_t mRunId;
+  std::mutex mMutex;
+  std::condition_variable mCond;
+  bool mDisconnected = false;
+  RequestStats mStats[kRequestKindCount];
+
+  //! Send times of outstanding echo messages, by sequence number
+  std::unordered_map<uint32_t, Clock::time_point> mPendingMessages;
+
+  //! Send times of outstanding requests of other kinds, which the daemon
+  //! answers in order
+  std::deque<Clock::time_point> mPendingFifo[kRequestKindCount];
+
+  size_t getInFlightCountLocked(RequestKind kind) const {
+    return (kind == kRequestKindMessage)
+        ? mPendingMessages.size() : mPendingFifo[kind].size();
+  }
+
+  size_t getTotalInFlightCountLocked() const {
+    size_t count = 0;
+    for (size_t i = 0; i < kRequestKindCount; i++) {
+      count += getInFlightCountLocked(static_cast<RequestKind>(i));
+    }
+    return count;
+  }
+
+  void recordLatency(RequestKind kind, Clock::time_point sendTime) {
+    mStats[kind].latenciesNs.push_back(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - sendTime).count()));
+  }
+
+  void notifyIfDrained() {
+    if (getTotalInFlightCountLocked() == 0) {
+      mCond.notify_all();
+    }
+  }
+
+  void onFifoResponse(RequestKind kind) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::deque<Clock::time_point>& pending = mPendingFifo[kind];
+    if (!pending.empty()) {
+      recordLatency(kind, pending.front());
+      pending.pop_front();
+      notifyIfDrained();
+    }
+  }
+};
+
+bool parseOptions(int argc, char **argv, BenchmarkConfig *config) {
+  for (const Option& option : kOptions) {
+    config->*option.field = option.defaultValue;
+  }
+
+  bool success = true;
+  for (int i = 1; i < argc && success; i++) {
+    const char *separator = strchr(argv[i], '=');
+    success = false;
+    if (separator != nullptr) {
+      size_t nameLen = static_cast<size_t>(separator - argv[i]);
+      for (const Option& option : kOptions) {
+        if (strlen(option.name) == nameLen
+            && strncmp(option.name, argv[i], nameLen) == 0) {
+          char *end;
+          unsigned long value = strtoul(separator + 1, &end, 0);
+          success = (*end == '\0' && value <= UINT32_MAX);
+          config->*option.field = static_cast<uint32_t>(value);
+          break;
+        }
+      }
+    }
+
+    if (!success) {
+      LOGE("Invalid argument '%s'", argv[i]);
+    }
+  }
+
+  // The upper bound on message_size depends on the platform; the Echo nanoapp
+  // drops requests larger than it can return, and they're reported as lost
+  if (success && config->messageSize < sizeof(EchoHeader)) {
+    LOGE("message_size must be at least %zu", sizeof(EchoHeader));
+    success = false;
+  } else if (success && config->maxInFlight == 0) {
+    LOGE("max_in_flight must be non-zero");
+    success = false;
+  }
+
+  return success;
+}
+
+void printUsage() {
+  LOGI("Usage: chre_link_benchmark_client [option=value ...]");
+  for (const Option& option : kOptions) {
+    LOGI("  %s (default %" PRIu32 ")", option.name, option.defaultValue);
+  }
+}
+
+bool sendRequest(SocketClient& client, SocketCallbacks& callbacks,
+                 RequestKind kind, uint32_t sequence,
+                 std::vector<uint8_t>& echoPayload) {
+  FlatBufferBuilder builder(64 + echoPayload.size());
+  if (kind == kRequestKindMessage) {
+    EchoHeader *header = reinterpret_cast<EchoHeader *>(echoPayload.data());
+    header->sequence = sequence;
+    HostProtocolHost::encodeNanoappMessage(
+        builder, chre::kEchoAppId, chre::echo::kMessageTypeEchoRequest,
+        kHostEndpoint, echoPayload.data(), echoPayload.size());
+  } else if (kind == kRequestKindHubInfo) {
+    HostProtocolHost::encodeHubInfoRequest(builder);
+  } else {
+    HostProtocolHost::encodeNanoappListRequest(builder);
+  }
+
+  callbacks.onRequestSending(kind, sequence);
+  bool success = client.sendMessage(builder.GetBufferPointer(),
+                                    builder.GetSize());
+  callbacks.onRequestSent(kind, sequence, success);
+  return success;
+}
+
+bool subscribeToEchoResponses(SocketClient& client) {
+  FlatBufferBuilder builder(64);
+  HostProtocolHost::encodeMessageSubscriptionRequest(
+      builder, true /* subscribe */, chre::kEchoAppId,
+      false /* matchAnyAppId */, chre::echo::kMessageTypeEchoResponse,
+      false /* matchAnyMessageType */);
+  return client.sendMessage(builder.GetBufferPointer(), builder.GetSize());
+}
+
+/**
+ * Sends requests at the configured rates until the run duration has elapsed.
+ * Requests that fall due while maxInFlight of the same kind are outstanding
+ * are skipped rather than deferred, so the offered load never exceeds the
+ * target rate.
+ *
+ * @return The elapsed time in milliseconds
+ */
+uint32_t runBenchmark(SocketClient& client, SocketCallbacks& callbacks,
+                      const BenchmarkConfig& config, uint32_t runId) {
+  const uint32_t rates[kRequestKindCount] = {
+    config.messagesPerSec,
+    config.hubInfoRequestsPerSec,
+    config.nanoappListRequestsPerSec,
+  };
+  uint64_t scheduled[kRequestKindCount] = {};
+  uint32_t nextSequence = 0;
+
+  std::vector<uint8_t> echoPayload(config.messageSize);
+  EchoHeader header = {runId, 0};
+  memcpy(echoPayload.data(), &header, sizeof(header));
+  for (size_t i = sizeof(header); i < echoPayload.size(); i++) {
+    echoPayload[i] = static_cast<uint8_t>(i);
+  }
+
+  Clock::time_point start = Clock::now();
+  auto duration = std::chrono::milliseconds(config.durationMillis);
+  bool connected = true;
+  Clock::duration elapsed;
+  while (connected && (elapsed = Clock::now() - start) < duration) {
+    uint64_t elapsedMicros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+            .count());
+    for (size_t i = 0; i < kRequestKindCount && connected; i++) {
+      RequestKind kind = static_cast<RequestKind>(i);
+      // The first request of each kind is due immediately
+      uint64_t due = (rates[i] == 0)
+          ? 0 : rates[i] * elapsedMicros / 1000000 + 1;
+      while (scheduled[i] < due && connected) {
+        scheduled[i]++;
+        if (callbacks.getInFlightCount(kind) >= config.maxInFlight) {
+          callbacks.onRequestSkipped(kind);
+        } else if (!sendRequest(client, callbacks, kind, nextSequence++,
+                                echoPayload)) {
+          connected = client.isConnected();
+        }
+      }
+    }
+
+    std::this_thread::sleep_for(kPacingInterval);
+  }
+
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          Clock::now() - start).count());
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv) {
+  int ret = -1;
+  SocketClient client;
+  BenchmarkConfig config;
+  uint32_t runId = static_cast<uint32_t>(getpid());
+  sp<SocketCallbacks> callbacks = new SocketCallbacks(runId);
+
+  if (!parseOptions(argc, argv, &config)) {
+    printUsage();
+  } else if (!client.connect("chre", callbacks)) {
+    LOGE("Couldn't connect to socket");
+  } else if (config.messagesPerSec > 0 && !subscribeToEchoResponses(client)) {
+    LOGE("Failed to subscribe to echo responses");
+  } else {
+    LOGI("Running for %" PRIu32 " ms: %" PRIu32 " messages/s of %" PRIu32
+         " bytes, %" PRIu32 " hub info/s, %" PRIu32 " nanoapp list/s",
+         config.durationMillis, config.messagesPerSec, config.messageSize,
+         config.hubInfoRequestsPerSec, config.nanoappListRequestsPerSec);
+    uint32_t elapsedMillis = runBenchmark(client, *callbacks, config, runId);
+    if (!callbacks->waitForOutstanding(kDrainTimeout)) {
+      LOGW("Some requests were not answered; counting them as lost");
+    }
+    callbacks->printResults(elapsedMillis, config.messageSize);
+    ret = 0;
+  }
+
+  return ret;
+}
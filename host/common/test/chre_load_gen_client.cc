@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/apps/load_gen/load_gen_messages.h"
+#include "chre/util/nanoapp/app_id.h"
+#include "chre_host/host_protocol_host.h"
+#include "chre_host/log.h"
+#include "chre_host/socket_client.h"
+#include "latency_summary.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <utils/StrongPointer.h>
+
+/**
+ * @file
+ * A stress harness that drives the LoadGen nanoapp through the CHRE daemon:
+ * it sends a load configuration, measures the load messages that reach the
+ * host, and prints the throughput and latency the nanoapp observed inside
+ * CHRE. The configuration is given as key=value arguments, for example:
+ *
+ *   chre_load_gen_client duration_ms=5000 self_events=2000 host_messages=100
+ *
+ * Run without arguments to use the defaults listed in kOptions.
+ */
+
+using android::sp;
+using android::chre::IChreMessageHandlers;
+using android::chre::LatencySummary;
+using android::chre::logLatencySummary;
+using android::chre::SocketClient;
+using android::chre::HostProtocolHost;
+using chre::load_gen::LoadGenConfig;
+using chre::load_gen::LoadGenLatency;
+using chre::load_gen::LoadGenResult;
+using flatbuffers::FlatBufferBuilder;
+
+// Aliased for consistency with the way these symbols are referenced in
+// CHRE-side code
+namespace fbs = ::chre::fbs;
+
+namespace {
+
+//! The host endpoint we use when sending; set to CHRE_HOST_ENDPOINT_UNSPECIFIED
+constexpr uint16_t kHostEndpoint = 0xfffe;
+
+//! How long to wait for results beyond the configured run duration
+constexpr auto kResultTimeout = std::chrono::seconds(5);
+
+//! A command line option that sets one field of the LoadGenConfig
+struct Option {
+  const char *name;
+  uint32_t LoadGenConfig::*field;
+  uint32_t defaultValue;
+};
+
+const Option kOptions[] = {
+  {"duration_ms",        &LoadGenConfig::durationMillis,         10000},
+  {"self_events",        &LoadGenConfig::selfEventsPerSec,       1000},
+  {"broadcast_events",   &LoadGenConfig::broadcastEventsPerSec,  0},
+  {"timers",             &LoadGenConfig::timerCount,             2},
+  {"timer_period_us",    &LoadGenConfig::timerPeriodMicros,      10000},
+  {"host_messages",      &LoadGenConfig::hostMessagesPerSec,     50},
+  {"host_message_size",  &LoadGenConfig::hostMessageSize,        64},
+  {"heap_allocs",        &LoadGenConfig::heapAllocsPerSec,       500},
+  {"heap_alloc_size",    &LoadGenConfig::heapAllocSize,          128},
+  {"heap_outstanding",   &LoadGenConfig::heapMaxOutstanding,     16},
+};
+
+class SocketCallbacks : public SocketClient::ICallbacks,
+                        public IChreMessageHandlers {
+ public:
+  void onMessageReceived(const void *data, size_t length) override {
+    if (!HostProtocolHost::decodeMessageFromChre(data, length, *this)) {
+      LOGE("Failed to decode message");
+    }
+  }
+
+  void onDisconnected() override {
+    LOGE("Socket disconnected");
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDisconnected = true;
+    mCond.notify_all();
+  }
+
+  void handleNanoappMessage(
+      uint64_t appId, uint32_t messageType, uint16_t /*hostEndpoint*/,
+      const void *messageData, size_t messageLen) override {
+    if (appId != chre::kLoadGenAppId) {
+      // Not ours
+    } else if (messageType == chre::load_gen::kMessageTypeLoad) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mLoadMessagesReceived++;
+      mLoadBytesReceived += messageLen;
+    } else if (messageType == chre::load_gen::kMessageTypeResult) {
+      if (messageLen != sizeof(LoadGenResult)) {
+        LOGE("Result has unexpected size %zu", messageLen);
+      } else {
+        std::lock_guard<std::mutex> lock(mMutex);
+        memcpy(&mResult, messageData, sizeof(mResult));
+        mResultReceived = true;
+        mCond.notify_all();
+      }
+    }
+  }
+
+  void handleHubInfoResponse(
+      const char * /*name*/, const char * /*vendor*/,
+      const char * /*toolchain*/, uint32_t /*legacyPlatformVersion*/,
+      uint32_t /*legacyToolchainVersion*/, float /*peakMips*/,
+      float /*stoppedPower*/, float /*sleepPower*/, float /*peakPower*/,
+      uint32_t /*maxMessageLen*/, uint64_t /*platformId*/,
+      uint32_t /*version*/, bool /*supportsCachedLoad*/) override {}
+
+  void handleNanoappListResponse(
+      const fbs::NanoappListResponseT& /*response*/) override {}
+
+  /**
+   * Waits for the nanoapp to report the results of a run.
+   *
+   * @return true if results were received before the timeout
+   */
+  template<typename DurationType>
+  bool waitForResult(DurationType timeout) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCond.wait_for(lock, timeout, [this]() {
+      return (mResultReceived || mDisconnected);
+    });
+    return mResultReceived;
+  }
+
+  LoadGenResult getResult() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mResult;
+  }
+
+  void getLoadMessageStats(uint32_t *count, uint64_t *bytes) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    *count = mLoadMessagesReceived;
+    *bytes = mLoadBytesReceived;
+  }
+
+ private:
+  std::mutex mMutex;
+  std::condition_variable mCond;
+  bool mDisconnected = false;
+  bool mResultReceived = false;
+  LoadGenResult mResult = {};
+  uint32_t mLoadMessagesReceived = 0;
+  uint64_t mLoadBytesReceived = 0;
+};
+
+bool parseOptions(int argc, char **argv, LoadGenConfig *config) {
+  for (const Option& option : kOptions) {
+    config->*option.field = option.defaultValue;
+  }
+
+  bool success = true;
+  for (int i = 1; i < argc && success; i++) {
+    const char *separator = strchr(argv[i], '=');
+    success = false;
+    if (separator != nullptr) {
+      size_t nameLen = static_cast<size_t>(separator - argv[i]);
+      for (const Option& option : kOptions) {
+        if (strlen(option.name) == nameLen
+            && strncmp(option.name, argv[i], nameLen) == 0) {
+          char *end;
+          unsigned long value = strtoul(separator + 1, &end, 0);
+          success = (*end == '\0' && value <= UINT32_MAX);
+          config->*option.field = static_cast<uint32_t>(value);
+          break;
+        }
+      }
+    }
+
+    if (!success) {
+      LOGE("Invalid argument '%s'", argv[i]);
+    }
+  }
+
+  return success;
+}
+
+void printUsage() {
+  LOGI("Usage: chre_load_gen_client [option=value ...]");
+  for (const Option& option : kOptions) {
+    LOGI("  %s (default %" PRIu32 ")", option.name, option.defaultValue);
+  }
+}
+
+bool sendNanoappMessage(SocketClient& client, uint32_t messageType,
+                        const void *data, size_t dataLen) {
+  FlatBufferBuilder builder(64 + dataLen);
+  HostProtocolHost::encodeNanoappMessage(
+      builder, chre::kLoadGenAppId, messageType, kHostEndpoint, data,
+      dataLen);
+  return client.sendMessage(builder.GetBufferPointer(), builder.GetSize());
+}
+
+/**
+ * @return The rate in operations per second, given a count over a duration
+ */
+double getRate(uint32_t count, uint32_t elapsedMillis) {
+  return (elapsedMillis == 0) ? 0.0 : count * 1000.0 / elapsedMillis;
+}
+
+void printLatency(const char *name, const LoadGenLatency& latency) {
+  // The nanoapp only reports a summary, so there are no percentiles
+  LatencySummary summary;
+  summary.count = latency.count;
+  summary.minMicros = latency.minMicros;
+  summary.meanMicros = latency.meanMicros;
+  summary.maxMicros = latency.maxMicros;
+  logLatencySummary(name, summary);
+}
+
+void printResults(const LoadGenConfig& config, const LoadGenResult& result,
+                  uint32_t loadMessagesReceived, uint64_t loadBytesReceived) {
+  uint32_t elapsed = result.elapsedMillis;
+  LOGI("Run completed in %" PRIu32 " ms, %" PRIu32 " events handled "
+       "(%.1f/s)", elapsed, result.eventsHandled,
+       getRate(result.eventsHandled, elapsed));
+
+  LOGI("  Self events:      %" PRIu32 " sent %" PRIu32 " failed, "
+       "%.1f/s (target %" PRIu32 "/s)", result.selfEventsSent,
+       result.selfEventsFailed, getRate(result.selfEventsSent, elapsed),
+       config.selfEventsPerSec);
+  printLatency("Self events", result.selfEventLatency);
+
+  LOGI("  Broadcast events: %" PRIu32 " sent %" PRIu32 " failed, "
+       "%.1f/s (target %" PRIu32 "/s)", result.broadcastEventsSent,
+       result.broadcastEventsFailed,
+       getRate(result.broadcastEventsSent, elapsed),
+       config.broadcastEventsPerSec);
+  printLatency("Broadcast events", result.broadcastEventLatency);
+
+  LOGI("  Timers:           %" PRIu32 " of %" PRIu32 " started",
+       result.timersStarted, config.timerCount);
+  printLatency("Timer lateness", result.timerLateness);
+
+  LOGI("  Host messages:    %" PRIu32 " sent %" PRIu32 " failed %" PRIu32
+       " throttled, %.1f/s (target %" PRIu32 "/s)", result.hostMessagesSent,
+       result.hostMessagesFailed, result.hostMessagesThrottled,
+       getRate(result.hostMessagesSent, elapsed), config.hostMessagesPerSec);
+  printLatency("Host messages", result.hostMessageLatency);
+  LOGI("  Host received:    %" PRIu32 " messages, %" PRIu64 " bytes "
+       "(%.1f KiB/s)", loadMessagesReceived, loadBytesReceived,
+       (elapsed == 0) ? 0.0 : loadBytesReceived / 1.024 / elapsed);
+
+  LOGI("  Heap:             %" PRIu32 " allocs %" PRIu32 " failed, "
+       "%.1f/s (target %" PRIu32 "/s), mean %" PRIu32 " ns/alloc",
+       result.heapAllocs, result.heapAllocFailures,
+       getRate(result.heapAllocs, elapsed), config.heapAllocsPerSec,
+       result.heapMeanAllocNanos);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv) {
+  int ret = -1;
+  SocketClient client;
+  sp<SocketCallbacks> callbacks = new SocketCallbacks();
+  LoadGenConfig config;
+
+  if (!parseOptions(argc, argv, &config)) {
+    printUsage();
+  } else if (!client.connect("chre", callbacks)) {
+    LOGE("Couldn't connect to socket");
+  } else if (!sendNanoappMessage(client, chre::load_gen::kMessageTypeStart,
+                                 &config, sizeof(config))) {
+    LOGE("Failed to send start message");
+  } else {
+    LOGI("Started %" PRIu32 " ms run", config.durationMillis);
+    auto timeout = std::chrono::milliseconds(config.durationMillis)
+        + kResultTimeout;
+    if (!callbacks->waitForResult(timeout)) {
+      LOGE("Timed out waiting for results; stopping run");
+      sendNanoappMessage(client, chre::load_gen::kMessageTypeStop, nullptr, 0);
+    } else {
+      uint32_t loadMessagesReceived;
+      uint64_t loadBytesReceived;
+      callbacks->getLoadMessageStats(&loadMessagesReceived,
+                                     &loadBytesReceived);
+      printResults(config, callbacks->getResult(), loadMessagesReceived,
+                   loadBytesReceived);
+      ret = 0;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre_host/host_protocol_host.h"
+#include "chre_host/log.h"
+#include "chre_host/message_capture.h"
+#include "chre_host/socket_client.h"
+#include "latency_summary.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <utils/StrongPointer.h>
+
+/**
+ * @file
+ * Replays the client traffic recorded by "chre_daemon --capture=<path>"
+ * against a running CHRE daemon, using one connection per client in the
+ * capture. Requests are sent at their original relative times, optionally
+ * scaled, and the time until each is answered is compared with the latency
+ * observed when the capture was taken.
+ *
+ * Usage: chre_replay_client <capture file> [speed=<factor>]
+ *
+ * A speed of 2 replays twice as fast as the original; 0 sends every request as
+ * soon as the previous one has been sent.
+ */
+
+using android::sp;
+using android::chre::HostProtocolHost;
+using android::chre::logLatencySummary;
+using android::chre::MessageCaptureReader;
+using android::chre::SocketClient;
+using android::chre::summarizeLatencies;
+
+namespace capture = android::chre::capture;
+
+// Aliased for consistency with the way these symbols are referenced in
+// CHRE-side code
+namespace fbs = ::chre::fbs;
+
+namespace {
+
+//! How long to wait for outstanding responses after the last request is sent
+constexpr auto kResponseTimeout = std::chrono::seconds(5);
+
+/**
+ * @return The message type CHRE sends in response to the given request type,
+ *         or NONE if the request is not answered
+ */
+fbs::ChreMessage getResponseType(fbs::ChreMessage requestType) {
+  switch (requestType) {
+    case fbs::ChreMessage::HubInfoRequest:
+      return fbs::ChreMessage::HubInfoResponse;
+    case fbs::ChreMessage::NanoappListRequest:
+      return fbs::ChreMessage::NanoappListResponse;
+    case fbs::ChreMessage::LoadNanoappRequest:
+    case fbs::ChreMessage::LoadNanoappCommitRequest:
+    case fbs::ChreMessage::LoadCachedNanoappRequest:
+      return fbs::ChreMessage::LoadNanoappResponse;
+    case fbs::ChreMessage::UnloadNanoappRequest:
+      return fbs::ChreMessage::UnloadNanoappResponse;
+    case fbs::ChreMessage::DebugDumpRequest:
+      return fbs::ChreMessage::DebugDumpResponse;
+    default:
+      return fbs::ChreMessage::NONE;
+  }
+}
+
+/**
+ * Matches responses to requests per client, in order, and collects the
+ * latency of each response type. Thread-safe.
+ */
+class LatencyTracker {
+ public:
+  void onRequest(uint16_t clientId, fbs::ChreMessage requestType,
+                 uint64_t timeNs) {
+    fbs::ChreMessage responseType = getResponseType(requestType);
+    if (responseType != fbs::ChreMessage::NONE) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mPending[std::make_pair(clientId, responseType)].push_back(timeNs);
+    }
+  }
+
+  void onResponse(uint16_t clientId, fbs::ChreMessage responseType,
+                  uint64_t timeNs) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto pending = mPending.find(std::make_pair(clientId, responseType));
+    if (pending != mPending.end() && !pending->second.empty()) {
+      uint64_t requestTimeNs = pending->second.front();
+      pending->second.pop_front();
+      mLatencies[responseType].push_back(timeNs - requestTimeNs);
+    }
+  }
+
+  size_t getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t count = 0;
+    for (const auto& pending : mPending) {
+      count += pending.second.size();
+    }
+    return count;
+  }
+
+  void print(const char *label) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    LOGI("%s:", label);
+    for (auto& entry : mLatencies) {
+      logLatencySummary(fbs::EnumNameChreMessage(entry.first),
+                        summarizeLatencies(&entry.second));
+    }
+
+    size_t unanswered = 0;
+    for (const auto& pending : mPending) {
+      unanswered += pending.second.size();
+    }
+    if (unanswered > 0) {
+      LOGI("  %zu requests unanswered", unanswered);
+    }
+  }
+
+ private:
+  mutable std::mutex mMutex;
+  std::map<std::pair<uint16_t, fbs::ChreMessage>, std::deque<uint64_t>>
+      mPending;
+  std::map<fbs::ChreMessage, std::vector<uint64_t>> mLatencies;
+};
+
+/**
+ * Delivers the responses received on one replay connection to the tracker,
+ * attributed to the client ID it stands in for.
+ */
+class ReplayCallbacks : public SocketClient::ICallbacks {
+ public:
+  ReplayCallbacks(uint16_t capturedClientId, LatencyTracker *tracker)
+      : mCapturedClientId(capturedClientId), mTracker(tracker) {}
+
+  void onMessageReceived(const void *data, size_t length) override {
+    uint64_t timeNs = capture::getTimestampNs();
+    uint16_t hostClientId;
+    fbs::ChreMessage messageType;
+    if (HostProtocolHost::extractHostClientIdAndType(
+            data, length, &hostClientId, &messageType)) {
+      mTracker->onResponse(mCapturedClientId, messageType, timeNs);
+    }
+  }
+
+  void onDisconnected() override {
+    LOGW("Connection for client %" PRIu16 " lost", mCapturedClientId);
+  }
+
+ private:
+  const uint16_t mCapturedClientId;
+  LatencyTracker *mTracker;
+};
+
+struct ReplayConnection {
+  SocketClient client;
+  sp<ReplayCallbacks> callbacks;
+};
+
+bool parseOptions(int argc, char **argv, const char **capturePath,
+                  double *speed) {
+  constexpr char kSpeedOption[] = "speed=";
+  bool success = (argc == 2 || argc == 3);
+
+  *capturePath = (argc >= 2) ? argv[1] : nullptr;
+  *speed = 1.0;
+  if (success && argc == 3) {
+    char *end;
+    success = (strncmp(argv[2], kSpeedOption, sizeof(kSpeedOption) - 1) == 0);
+    if (success) {
+      *speed = strtod(argv[2] + sizeof(kSpeedOption) - 1, &end);
+      success = (*end == '\0' && *speed >= 0.0);
+    }
+  }
+
+  return success;
+}
+
+/**
+ * Reads the capture, computing the latencies it recorded, and returns the
+ * frames sent by clients.
+ */
+bool loadCapture(const char *path, LatencyTracker *originalTracker,
+                 std::vector<capture::RecordHeader> *headers,
+                 std::vector<std::vector<uint8_t>> *frames) {
+  MessageCaptureReader reader;
+  bool success = reader.open(path);
+
+  capture::RecordHeader header;
+  std::vector<uint8_t> frame;
+  while (success && reader.readNext(&header, &frame)) {
+    uint16_t hostClientId;
+    fbs::ChreMessage messageType;
+    if (!HostProtocolHost::extractHostClientIdAndType(
+            frame.data(), frame.size(), &hostClientId, &messageType)) {
+      LOGW("Skipping undecodable frame");
+    } else if (header.direction == capture::Direction::ToClient) {
+      originalTracker->onResponse(header.clientId, messageType,
+                                  header.timestampNs);
+    } else {
+      originalTracker->onRequest(header.clientId, messageType,
+                                 header.timestampNs);
+      headers->push_back(header);
+      frames->push_back(frame);
+    }
+  }
+
+  return success;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv) {
+  int ret = -1;
+  const char *capturePath;
+  double speed;
+  LatencyTracker originalTracker;
+  LatencyTracker replayTracker;
+  std::vector<capture::RecordHeader> headers;
+  std::vector<std::vector<uint8_t>> frames;
+  std::map<uint16_t, std::unique_ptr<ReplayConnection>> connections;
+
+  if (!parseOptions(argc, argv, &capturePath, &speed)) {
+    LOGE("Usage: chre_replay_client <capture file> [speed=<factor>]");
+  } else if (!loadCapture(capturePath, &originalTracker, &headers, &frames)) {
+    LOGE("Couldn't load capture");
+  } else if (headers.empty()) {
+    LOGE("Capture contains no client messages");
+  } else {
+    LOGI("Replaying %zu messages at %.2fx", headers.size(), speed);
+    auto replayStart = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds maxLateness(0);
+    size_t sendFailures = 0;
+    bool connected = true;
+
+    for (size_t i = 0; i < headers.size() && connected; i++) {
+      const capture::RecordHeader& header = headers[i];
+      std::unique_ptr<ReplayConnection>& connection =
+          connections[header.clientId];
+      if (connection == nullptr) {
+        connection.reset(new ReplayConnection());
+        connection->callbacks = new ReplayCallbacks(header.clientId,
+                                                    &replayTracker);
+        connected = connection->client.connect("chre", connection->callbacks);
+        if (!connected) {
+          LOGE("Couldn't connect to socket");
+          continue;
+        }
+      }
+
+      if (speed > 0.0) {
+        auto target = replayStart + std::chrono::nanoseconds(
+            static_cast<int64_t>(
+                (header.timestampNs - headers.front().timestampNs) / speed));
+        std::this_thread::sleep_until(target);
+        maxLateness = std::max(maxLateness, std::chrono::duration_cast<
+            std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                                      - target));
+      }
+
+      fbs::ChreMessage messageType =
+          fbs::GetMessageContainer(frames[i].data())->message_type();
+      replayTracker.onRequest(header.clientId, messageType,
+                              capture::getTimestampNs());
+      if (!connection->client.sendMessage(frames[i].data(),
+                                          frames[i].size())) {
+        sendFailures++;
+      }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + kResponseTimeout;
+    while (replayTracker.getPendingCount() > 0
+           && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (connected) {
+      LOGI("Replay finished; %zu send failures, max scheduling lateness %"
+           PRId64 " us", sendFailures,
+           static_cast<int64_t>(maxLateness.count() / 1000));
+      originalTracker.print("Captured latency");
+      replayTracker.print("Replayed latency");
+      ret = 0;
+    }
+  }
+
+  for (auto& connection : connections) {
+    connection.second->client.disconnect();
+  }
+
+  return ret;
+}
@@ -18,6 +18,7 @@
 #include "chre_host/host_protocol_host.h"
 #include "chre_host/log.h"
 #include "chre_host/socket_client.h"
+#include "chre_host/transaction_manager.h"
 
 #include <inttypes.h>
 #include <sys/socket.h>
@@ -39,6 +40,7 @@ using android::sp;
 using android::chre::IChreMessageHandlers;
 using android::chre::SocketClient;
 using android::chre::HostProtocolHost;
+using android::chre::TransactionManager;
 using flatbuffers::FlatBufferBuilder;
 
 // Aliased for consistency with the way these symbols are referenced in
@@ -50,6 +52,12 @@ namespace {
 //! The host endpoint we use when sending; set to CHRE_HOST_ENDPOINT_UNSPECIFIED
 constexpr uint16_t kHostEndpoint = 0xfffe;
 
+//! Size of each fragment used when sending a nanoapp binary
+constexpr size_t kLoadFragmentSize = 4096;
+
+//! Tracks load/unload requests that are in flight simultaneously
+TransactionManager gTransactions;
+
 class SocketCallbacks : public SocketClient::ICallbacks,
                         public IChreMessageHandlers {
  public:
@@ -69,6 +77,7 @@ class SocketCallbacks : public SocketClient::ICallbacks,
 
   void onDisconnected() override {
     LOGI("Socket disconnected");
+    gTransactions.failAllTransactions();
   }
 
   void handleNanoappMessage(
@@ -84,7 +93,8 @@ class SocketCallbacks : public SocketClient::ICallbacks,
       const char *toolchain, uint32_t legacyPlatformVersion,
       uint32_t legacyToolchainVersion, float peakMips, float stoppedPower,
       float sleepPower, float peakPower, uint32_t maxMessageLen,
-      uint64_t platformId, uint32_t version) override {
+      uint64_t platformId, uint32_t version,
+      bool /*supportsCachedLoad*/) override {
     LOGI("Got hub info response:");
     LOGI("  Name: '%s'", name);
     LOGI("  Vendor: '%s'", vendor);
@@ -113,12 +123,16 @@ class SocketCallbacks : public SocketClient::ICallbacks,
       const ::chre::fbs::LoadNanoappResponseT& response) override {
     LOGI("Got load nanoapp response, transaction ID 0x%" PRIx32 " result %d",
          response.transaction_id, response.success);
+    gTransactions.completeTransaction(response.transaction_id,
+                                      response.success);
   }
 
   void handleUnloadNanoappResponse(
       const ::chre::fbs::UnloadNanoappResponseT& response) override {
     LOGI("Got unload nanoapp response, transaction ID 0x%" PRIx32 " result %d",
          response.transaction_id, response.success);
+    gTransactions.completeTransaction(response.transaction_id,
+                                      response.success);
   }
 };
 
@@ -156,7 +170,13 @@ void sendMessageToNanoapp(SocketClient& client) {
   }
 }
 
-void sendLoadNanoappRequest(SocketClient& client, const char *filename) {
+void logTransactionResult(uint32_t transactionId, bool success) {
+  LOGI("Transaction 0x%" PRIx32 " completed with result %d", transactionId,
+       success);
+}
+
+void sendLoadNanoappRequest(SocketClient& client, const char *filename,
+                            uint64_t appId) {
   std::ifstream file(filename, std::ios::binary | std::ios::ate);
   if (!file) {
     LOGE("Couldn't open file '%s': %s", filename, strerror(errno));
@@ -171,27 +191,35 @@ void sendLoadNanoappRequest(SocketClient& client, const char *filename) {
     return;
   }
 
-  FlatBufferBuilder builder(size + 128);
-  HostProtocolHost::encodeLoadNanoappRequest(
-      builder, 1, 0x476f6f676c00100b, 0, 0x01000000, buffer);
-
-  LOGI("Sending load nanoapp request (%" PRIu32 " bytes total w/%zu bytes of "
-       "payload)", builder.GetSize(), buffer.size());
-  if (!client.sendMessage(builder.GetBufferPointer(), builder.GetSize())) {
+  uint32_t transactionId = gTransactions.getNextTransactionId();
+  gTransactions.addTransaction(transactionId, logTransactionResult);
+
+  LOGI("Sending load request for nanoapp 0x%016" PRIx64 " (transaction 0x%"
+       PRIx32 ", %zu bytes of payload)", appId, transactionId, buffer.size());
+  bool sent = HostProtocolHost::encodeFragmentedLoadNanoapp(
+      transactionId, appId, 0 /* appVersion */, 0x01000000, buffer.data(),
+      buffer.size(), kLoadFragmentSize,
+      [&client](const uint8_t *message, size_t messageLen) {
+        return client.sendMessage(message, messageLen);
+      });
+  if (!sent) {
     LOGE("Failed to send message");
+    gTransactions.removeTransaction(transactionId);
   }
 }
 
 void sendUnloadNanoappRequest(SocketClient& client, uint64_t appId) {
   FlatBufferBuilder builder(48);
-  constexpr uint32_t kTransactionId = 4321;
+  uint32_t transactionId = gTransactions.getNextTransactionId();
+  gTransactions.addTransaction(transactionId, logTransactionResult);
   HostProtocolHost::encodeUnloadNanoappRequest(
-      builder, kTransactionId, appId, true /* allowSystemNanoappUnload */);
+      builder, transactionId, appId, true /* allowSystemNanoappUnload */);
 
   LOGI("Sending unload request for nanoapp 0x%016" PRIx64 " (size %" PRIu32 ")",
        appId, builder.GetSize());
   if (!client.sendMessage(builder.GetBufferPointer(), builder.GetSize())) {
     LOGE("Failed to send message");
+    gTransactions.removeTransaction(transactionId);
   }
 }
 
@@ -208,11 +236,20 @@ int main() {
     requestHubInfo(client);
     requestNanoappList(client);
     sendMessageToNanoapp(client);
-    sendLoadNanoappRequest(client, "/data/activity.so");
+
+    // The load and unload requests are pipelined: each is sent without waiting
+    // for the previous one to complete, and CHRE processes them in order
+    sendLoadNanoappRequest(client, "/data/activity.so", 0x476f6f676c00100b);
     sendUnloadNanoappRequest(client, chre::kSpammerAppId);
 
-    LOGI("Sleeping, waiting on responses");
-    std::this_thread::sleep_for(std::chrono::seconds(5));
+    LOGI("Waiting on responses");
+    if (!gTransactions.waitForAllTransactions(std::chrono::seconds(5))) {
+      LOGW("Timed out with %zu transaction(s) pending",
+           gTransactions.getPendingTransactionCount());
+    }
+
+    // Allow time for responses to the other requests to arrive
+    std::this_thread::sleep_for(std::chrono::seconds(1));
   }
 
  return 0;
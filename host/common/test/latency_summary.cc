@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "latency_summary.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "chre_host/log.h"
+
+namespace android {
+namespace chre {
+
+uint64_t getPercentile(const std::vector<uint64_t>& sorted,
+                       size_t percentile) {
+  return sorted[(sorted.size() - 1) * percentile / 100];
+}
+
+LatencySummary summarizeLatencies(std::vector<uint64_t> *latenciesNs) {
+  LatencySummary summary;
+
+  std::vector<uint64_t>& latencies = *latenciesNs;
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    uint64_t total = 0;
+    for (uint64_t latency : latencies) {
+      total += latency;
+    }
+
+    summary.count = latencies.size();
+    summary.minMicros = latencies.front() / 1000;
+    summary.meanMicros = total / latencies.size() / 1000;
+    summary.maxMicros = latencies.back() / 1000;
+    summary.hasPercentiles = true;
+    summary.p50Micros = getPercentile(latencies, 50) / 1000;
+    summary.p90Micros = getPercentile(latencies, 90) / 1000;
+    summary.p99Micros = getPercentile(latencies, 99) / 1000;
+  }
+
+  return summary;
+}
+
+void logLatencySummary(const char *label, const LatencySummary& summary) {
+  if (summary.count == 0) {
+    LOGI("  %-22s latency (us): n=0", label);
+  } else if (!summary.hasPercentiles) {
+    LOGI("  %-22s latency (us): n=%zu min %" PRIu64 " max %" PRIu64 " mean %"
+         PRIu64, label, summary.count, summary.minMicros, summary.maxMicros,
+         summary.meanMicros);
+  } else {
+    LOGI("  %-22s latency (us): n=%zu min %" PRIu64 " p50 %" PRIu64 " p90 %"
+         PRIu64 " p99 %" PRIu64 " max %" PRIu64 " mean %" PRIu64, label,
+         summary.count, summary.minMicros, summary.p50Micros,
+         summary.p90Micros, summary.p99Micros, summary.maxMicros,
+         summary.meanMicros);
+  }
+}
+
+}  // namespace chre
+}  // namespace android
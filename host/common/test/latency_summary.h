@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_HOST_TEST_LATENCY_SUMMARY_H_
+#define CHRE_HOST_TEST_LATENCY_SUMMARY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace android {
+namespace chre {
+
+/**
+ * Summary statistics for a set of latency measurements, in microseconds, as
+ * reported by the host test clients.
+ */
+struct LatencySummary {
+  size_t count = 0;
+  uint64_t minMicros = 0;
+  uint64_t meanMicros = 0;
+  uint64_t maxMicros = 0;
+
+  //! Percentiles are only available when the individual measurements are
+  //! known, rather than a summary computed elsewhere (e.g. by a nanoapp)
+  bool hasPercentiles = false;
+  uint64_t p50Micros = 0;
+  uint64_t p90Micros = 0;
+  uint64_t p99Micros = 0;
+};
+
+/**
+ * @param sorted Measurements in ascending order, which must not be empty
+ * @param percentile The percentile to select, from 0 to 100
+ *
+ * @return The measurement at index (size - 1) * percentile / 100, so that
+ *         percentile 0 is the minimum and percentile 100 is the maximum
+ */
+uint64_t getPercentile(const std::vector<uint64_t>& sorted, size_t percentile);
+
+/**
+ * Summarizes a set of latency measurements, including percentiles.
+ *
+ * @param latenciesNs Latencies in nanoseconds, which are sorted in place
+ *
+ * @return The summary, with a count of zero if there were no measurements
+ */
+LatencySummary summarizeLatencies(std::vector<uint64_t> *latenciesNs);
+
+/**
+ * Logs a summary as one line, with the same layout for every client.
+ *
+ * @param label Describes what was measured
+ * @param summary The summary to log
+ */
+void logLatencySummary(const char *label, const LatencySummary& summary);
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_TEST_LATENCY_SUMMARY_H_
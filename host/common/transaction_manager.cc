@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre_host/transaction_manager.h"
+
+#include <inttypes.h>
+
+#include <utility>
+
+#include "chre_host/log.h"
+
+namespace android {
+namespace chre {
+
+uint32_t TransactionManager::getNextTransactionId() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  while (mPendingTransactions.find(mNextTransactionId)
+             != mPendingTransactions.end()) {
+    mNextTransactionId++;
+  }
+
+  return mNextTransactionId++;
+}
+
+bool TransactionManager::addTransaction(uint32_t transactionId,
+                                        CompletionCallback callback) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  bool added = mPendingTransactions.emplace(
+      transactionId, std::move(callback)).second;
+  if (!added) {
+    LOGE("Transaction ID %" PRIu32 " is already pending", transactionId);
+  }
+
+  return added;
+}
+
+bool TransactionManager::removeTransaction(uint32_t transactionId) {
+  bool removed;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    removed = (mPendingTransactions.erase(transactionId) > 0);
+  }
+
+  if (removed) {
+    mCond.notify_all();
+  }
+  return removed;
+}
+
+bool TransactionManager::completeTransaction(uint32_t transactionId,
+                                             bool success) {
+  CompletionCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mPendingTransactions.find(transactionId);
+    if (iter != mPendingTransactions.end()) {
+      callback = std::move(iter->second);
+      mPendingTransactions.erase(iter);
+    }
+  }
+
+  bool found = static_cast<bool>(callback);
+  if (!found) {
+    LOGW("Got response for unknown transaction ID %" PRIu32, transactionId);
+  } else {
+    callback(transactionId, success);
+    mCond.notify_all();
+  }
+
+  return found;
+}
+
+void TransactionManager::failAllTransactions() {
+  std::map<uint32_t, CompletionCallback> transactions;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    transactions.swap(mPendingTransactions);
+  }
+
+  for (auto& transaction : transactions) {
+    transaction.second(transaction.first, false /* success */);
+  }
+  mCond.notify_all();
+}
+
+size_t TransactionManager::getPendingTransactionCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mPendingTransactions.size();
+}
+
+bool TransactionManager::waitForAllTransactions(
+    std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mMutex);
+  return mCond.wait_for(lock, timeout,
+                        [this]() { return mPendingTransactions.empty(); });
+}
+
+}  // namespace chre
+}  // namespace android
@@ -26,6 +26,8 @@
 #include <unistd.h>
 #include <utils/Log.h>
 
+#include "chre/util/system/crc32.h"
+
 namespace android {
 namespace hardware {
 namespace contexthub {
@@ -59,6 +61,14 @@ constexpr uint16_t extractChrePatchVersion(uint32_t chreVersion) {
   return static_cast<uint16_t>(chreVersion);
 }
 
+//! Maximum number of bytes of a nanoapp binary sent in each fragment; see
+//! HostProtocolHost::encodeFragmentedLoadNanoapp()
+constexpr size_t kLoadFragmentSize = 4096;
+
+//! How long loadNanoApp() waits for CHRE to answer a cached load request
+//! before leaving the transaction to complete asynchronously
+constexpr auto kCachedLoadResponseTimeout = std::chrono::seconds(1);
+
 /**
  * @return file descriptor contained in the hidl_handle, or -1 if there is none
  */
@@ -202,16 +212,43 @@ Return<Result> GenericContextHub::loadNanoApp(
   if (hubId != kDefaultHubId) {
     result = Result::BAD_PARAMS;
   } else {
-    FlatBufferBuilder builder(128 + appBinary.customBinary.size());
     uint32_t targetApiVersion = (appBinary.targetChreApiMajorVersion << 24) |
                                 (appBinary.targetChreApiMinorVersion << 16);
-    HostProtocolHost::encodeLoadNanoappRequest(
-        builder, transactionId, appBinary.appId, appBinary.appVersion,
-        targetApiVersion, appBinary.customBinary);
-    if (!mClient.sendMessage(builder.GetBufferPointer(), builder.GetSize())) {
-      result = Result::UNKNOWN_FAILURE;
+    bool supportsCachedLoad;
+    {
+      std::lock_guard<std::mutex> lock(mHubInfoMutex);
+      supportsCachedLoad = (mHubInfoValid && mSupportsCachedLoad);
+    }
+
+    if (!addTransaction(transactionId)) {
+      result = Result::TRANSACTION_PENDING;
     } else {
-      result = Result::OK;
+      // CHRE retains binaries it has loaded before, so if it supports it, first
+      // ask it to load the binary by reference; the binary is only transferred
+      // if CHRE reports a miss
+      bool sendBinary = true;
+      bool success = true;
+      if (supportsCachedLoad) {
+        success = sendCachedLoadRequest(transactionId, appBinary,
+                                        targetApiVersion, &sendBinary);
+      }
+
+      if (success && sendBinary) {
+        success = HostProtocolHost::encodeFragmentedLoadNanoapp(
+            transactionId, appBinary.appId, appBinary.appVersion,
+            targetApiVersion, appBinary.customBinary.data(),
+            appBinary.customBinary.size(), kLoadFragmentSize,
+            [this](const uint8_t *message, size_t messageLen) {
+              return mClient.sendMessage(message, messageLen);
+            });
+      }
+
+      if (!success) {
+        mTransactions.removeTransaction(transactionId);
+        result = Result::UNKNOWN_FAILURE;
+      } else {
+        result = Result::OK;
+      }
     }
   }
 
@@ -233,7 +270,11 @@ Return<Result> GenericContextHub::unloadNanoApp(
     FlatBufferBuilder builder(64);
     HostProtocolHost::encodeUnloadNanoappRequest(
         builder, transactionId, appId, false /* allowSystemNanoappUnload */);
-    if (!mClient.sendMessage(builder.GetBufferPointer(), builder.GetSize())) {
+    if (!addTransaction(transactionId)) {
+      result = Result::TRANSACTION_PENDING;
+    } else if (!mClient.sendMessage(builder.GetBufferPointer(),
+                                    builder.GetSize())) {
+      mTransactions.removeTransaction(transactionId);
       result = Result::UNKNOWN_FAILURE;
     } else {
       result = Result::OK;
@@ -304,6 +345,14 @@ void GenericContextHub::SocketCallbacks::onConnected() {
 
 void GenericContextHub::SocketCallbacks::onDisconnected() {
   ALOGW("Lost connection to CHRE daemon");
+
+  // Responses to any outstanding transactions will never arrive
+  {
+    std::lock_guard<std::mutex> lock(mParent.mPendingCachedLoadsMutex);
+    mParent.mPendingCachedLoads.clear();
+    mParent.mPendingCachedLoadsCond.notify_all();
+  }
+  mParent.mTransactions.failAllTransactions();
 }
 
 void GenericContextHub::SocketCallbacks::handleNanoappMessage(
@@ -330,7 +379,7 @@ void GenericContextHub::SocketCallbacks::handleHubInfoResponse(
     const char *toolchain, uint32_t legacyPlatformVersion,
     uint32_t legacyToolchainVersion, float peakMips, float stoppedPower,
     float sleepPower, float peakPower, uint32_t maxMessageLen,
-    uint64_t platformId, uint32_t version) {
+    uint64_t platformId, uint32_t version, bool supportsCachedLoad) {
   ALOGD("Got hub info response");
 
   std::lock_guard<std::mutex> lock(mParent.mHubInfoMutex);
@@ -356,6 +405,7 @@ void GenericContextHub::SocketCallbacks::handleHubInfoResponse(
     mParent.mHubInfo.chreApiMinorVersion = extractChreApiMinorVersion(version);
     mParent.mHubInfo.chrePatchVersion = extractChrePatchVersion(version);
 
+    mParent.mSupportsCachedLoad = supportsCachedLoad;
     mParent.mHubInfoValid = true;
     mParent.mHubInfoCond.notify_all();
   }
@@ -395,26 +445,19 @@ void GenericContextHub::SocketCallbacks::handleNanoappListResponse(
 
 void GenericContextHub::SocketCallbacks::handleLoadNanoappResponse(
     const ::chre::fbs::LoadNanoappResponseT& response) {
-  ALOGV("Got load nanoapp response for transaction %" PRIu32 " with result %d",
-        response.transaction_id, response.success);
-
-  invokeClientCallback([&]() {
-    TransactionResult result = (response.success) ?
-        TransactionResult::SUCCESS : TransactionResult::FAILURE;
-    mParent.mCallbacks->handleTxnResult(response.transaction_id, result);
-  });
+  ALOGV("Got load nanoapp response for transaction %" PRIu32 " with result %d "
+        "cache miss %d", response.transaction_id, response.success,
+        response.cache_miss);
+  mParent.handleLoadResult(response.transaction_id, response.success,
+                           response.cache_miss);
 }
 
 void GenericContextHub::SocketCallbacks::handleUnloadNanoappResponse(
     const ::chre::fbs::UnloadNanoappResponseT& response) {
   ALOGV("Got unload nanoapp response for transaction %" PRIu32 " with result "
         "%d", response.transaction_id, response.success);
-
-  invokeClientCallback([&]() {
-    TransactionResult result = (response.success) ?
-        TransactionResult::SUCCESS : TransactionResult::FAILURE;
-    mParent.mCallbacks->handleTxnResult(response.transaction_id, result);
-  });
+  mParent.mTransactions.completeTransaction(response.transaction_id,
+                                            response.success);
 }
 
 void GenericContextHub::SocketCallbacks::handleDebugDumpData(
@@ -450,6 +493,92 @@ void GenericContextHub::SocketCallbacks::invokeClientCallback(
   }
 }
 
+bool GenericContextHub::addTransaction(uint32_t transactionId) {
+  // Load and unload requests may be issued without waiting for earlier ones to
+  // complete; their results are reported to the framework as each response
+  // arrives
+  return mTransactions.addTransaction(
+      transactionId, [this](uint32_t completedTransactionId, bool success) {
+        mSocketCallbacks->invokeClientCallback([&]() {
+          TransactionResult result = (success) ?
+              TransactionResult::SUCCESS : TransactionResult::FAILURE;
+          mCallbacks->handleTxnResult(completedTransactionId, result);
+        });
+      });
+}
+
+bool GenericContextHub::sendCachedLoadRequest(
+    uint32_t transactionId, const NanoAppBinary& appBinary,
+    uint32_t targetApiVersion, bool *sendBinary) {
+  uint32_t crc = ::chre::crc32(appBinary.customBinary.data(),
+                               appBinary.customBinary.size());
+  FlatBufferBuilder builder(64);
+  HostProtocolHost::encodeLoadCachedNanoappRequest(
+      builder, transactionId, appBinary.appId, appBinary.appVersion,
+      targetApiVersion, crc);
+
+  std::unique_lock<std::mutex> lock(mPendingCachedLoadsMutex);
+  mPendingCachedLoads[transactionId] = PendingCachedLoad();
+  lock.unlock();
+
+  bool success = mClient.sendMessage(builder.GetBufferPointer(),
+                                     builder.GetSize());
+  lock.lock();
+  auto iter = mPendingCachedLoads.find(transactionId);
+  if (success) {
+    // The entry is removed if the connection is lost while waiting
+    mPendingCachedLoadsCond.wait_for(
+        lock, kCachedLoadResponseTimeout, [this, transactionId, &iter]() {
+          iter = mPendingCachedLoads.find(transactionId);
+          return (iter == mPendingCachedLoads.end() || iter->second.responded);
+        });
+  }
+
+  *sendBinary = false;
+  if (iter != mPendingCachedLoads.end()) {
+    if (!success || iter->second.responded) {
+      *sendBinary = iter->second.cacheMiss;
+      mPendingCachedLoads.erase(iter);
+    } else {
+      // Most likely a cache hit that is still being loaded; its response will
+      // complete the transaction
+      ALOGW("No response to cached load for transaction %" PRIu32 " yet",
+            transactionId);
+      iter->second.callerWaiting = false;
+    }
+  }
+
+  return success;
+}
+
+void GenericContextHub::handleLoadResult(uint32_t transactionId, bool success,
+                                         bool cacheMiss) {
+  bool binaryNeeded = false;
+  {
+    std::lock_guard<std::mutex> lock(mPendingCachedLoadsMutex);
+    auto iter = mPendingCachedLoads.find(transactionId);
+    if (iter != mPendingCachedLoads.end()) {
+      if (iter->second.callerWaiting) {
+        // The caller still holds the binary, so it transfers it on a miss
+        iter->second.responded = true;
+        iter->second.cacheMiss = cacheMiss;
+        binaryNeeded = cacheMiss;
+        mPendingCachedLoadsCond.notify_all();
+      } else {
+        mPendingCachedLoads.erase(iter);
+      }
+    }
+  }
+
+  if (!binaryNeeded) {
+    if (cacheMiss) {
+      ALOGE("Nanoapp binary for transaction %" PRIu32 " not cached, and no "
+            "longer available to send", transactionId);
+    }
+    mTransactions.completeTransaction(transactionId, success && !cacheMiss);
+  }
+}
+
 void GenericContextHub::writeToDebugFile(const char *str) {
   writeToDebugFile(str, strlen(str));
 }
@@ -19,7 +19,9 @@
 
 #include <condition_variable>
 #include <functional>
+#include <map>
 #include <mutex>
+#include <vector>
 
 #include <android/hardware/contexthub/1.0/IContexthub.h>
 #include <hidl/MQDescriptor.h>
@@ -27,6 +29,7 @@
 
 #include "chre_host/socket_client.h"
 #include "chre_host/host_protocol_host.h"
+#include "chre_host/transaction_manager.h"
 
 namespace android {
 namespace hardware {
@@ -84,7 +87,8 @@ class GenericContextHub : public IContexthub {
         const char *toolchain, uint32_t legacyPlatformVersion,
         uint32_t legacyToolchainVersion, float peakMips, float stoppedPower,
         float sleepPower, float peakPower, uint32_t maxMessageLen,
-        uint64_t platformId, uint32_t version) override;
+        uint64_t platformId, uint32_t version,
+        bool supportsCachedLoad) override;
 
     void handleNanoappListResponse(
         const ::chre::fbs::NanoappListResponseT& response) override;
@@ -101,23 +105,44 @@ class GenericContextHub : public IContexthub {
     void handleDebugDumpResponse(
       const ::chre::fbs::DebugDumpResponseT& response) override;
 
-   private:
-    GenericContextHub& mParent;
-    bool mHaveConnected = false;
-
     /**
      * Acquires mParent.mCallbacksLock and invokes the synchronous callback
      * argument if mParent.mCallbacks is not null.
      */
     void invokeClientCallback(std::function<void()> callback);
+
+   private:
+    GenericContextHub& mParent;
+    bool mHaveConnected = false;
   };
 
   sp<SocketCallbacks> mSocketCallbacks;
 
+  // Load and unload transactions sent to CHRE that are awaiting a response
+  ::android::chre::TransactionManager mTransactions;
+
+  // A load request that was sent to CHRE by reference to its cached binary.
+  // While loadNanoApp() is waiting for the response it still holds the binary,
+  // so it transfers the binary itself on a cache miss.
+  struct PendingCachedLoad {
+    bool callerWaiting = true;
+    bool responded = false;
+    bool cacheMiss = false;
+  };
+
+  // Cached loads awaiting a response, keyed by transaction ID, and a condition
+  // variable notified when one of them gets its response
+  std::map<uint32_t, PendingCachedLoad> mPendingCachedLoads;
+  std::mutex mPendingCachedLoadsMutex;
+  std::condition_variable mPendingCachedLoadsCond;
+
   // Cached hub info used for getHubs(), and synchronization primitives to make
   // that function call synchronous if we need to query it
   ContextHub mHubInfo;
   bool mHubInfoValid = false;
+  // Whether CHRE advertised support for LoadCachedNanoappRequest in its hub
+  // info; older versions drop that request without replying
+  bool mSupportsCachedLoad = false;
   std::mutex mHubInfoMutex;
   std::condition_variable mHubInfoCond;
 
@@ -127,6 +152,24 @@ class GenericContextHub : public IContexthub {
   std::mutex mDebugDumpMutex;
   std::condition_variable mDebugDumpCond;
 
+  // Starts tracking a load/unload transaction, whose result will be reported
+  // to the framework when the response arrives. Returns false if a
+  // transaction with the same ID is already pending.
+  bool addTransaction(uint32_t transactionId);
+
+  // Asks CHRE to load a nanoapp from its cached binary, and waits a short time
+  // for the response in the caller's context. Sets sendBinary to true if CHRE
+  // reported a cache miss, in which case the caller must transfer the binary.
+  // Returns false if the request couldn't be sent.
+  bool sendCachedLoadRequest(uint32_t transactionId,
+                             const NanoAppBinary& appBinary,
+                             uint32_t targetApiVersion, bool *sendBinary);
+
+  // Handles the response to a load request. A cache miss reported while
+  // loadNanoApp() is waiting is handed back to it and the transaction stays
+  // pending; otherwise the transaction is completed.
+  void handleLoadResult(uint32_t transactionId, bool success, bool cacheMiss);
+
   // Write a string to mDebugFd
   void writeToDebugFile(const char *str);
   void writeToDebugFile(const char *str, size_t len);
@@ -31,9 +31,15 @@
  *     - TODO: confirm this and see whether we can merge this responsibility
  *       into the TX thread
  *   - Message to host (RX) thread: blocks in FastRPC call, waiting on incoming
- *     message from CHRE
+ *     message from CHRE, and hands each one to a dispatch worker
+ *   - Dispatch worker threads: one per message priority (see
+ *     getDispatchPriority()), routing messages from CHRE to clients and
+ *     emitting CHRE logs, so that a log burst or a slow client doesn't delay
+ *     time sync or nanoapp messages
  *   - Message to CHRE (TX) thread: blocks waiting on outbound queue, delivers
  *     messages to CHRE over FastRPC
+ *   - Time sync timeout thread: moves the time sync probe exchange on when a
+ *     probe response doesn't arrive in time
  *
  * TODO: This file originated from an implementation for another device, and was
  * written in C, but then it was converted to C++ when adding socket support. It
@@ -53,9 +59,18 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include "chre/platform/slpi/fastrpc.h"
+#include "chre/util/system/time_sync_estimator.h"
+#include "chre_host/broadcast_subscriptions.h"
 #include "chre_host/log.h"
 #include "chre_host/host_protocol_host.h"
+#include "chre_host/hub_state_cache.h"
+#include "chre_host/message_capture.h"
+#include "chre_host/priority_dispatcher.h"
 #include "chre_host/socket_server.h"
 #include "generated/chre_slpi.h"
 
@@ -64,8 +79,13 @@
 //! The format string to use for logs from the CHRE implementation.
 #define HUB_LOG_FORMAT_STR "Hub (t=%.6f): %s"
 
+using android::chre::BroadcastSubscriptions;
 using android::chre::HostProtocolHost;
+using android::chre::HubStateCache;
+using android::chre::MessageCaptureWriter;
+using android::chre::PriorityDispatcher;
 using android::elapsedRealtimeNano;
+using chre::TimeSyncEstimator;
 
 // Aliased for consistency with the way these symbols are referenced in
 // CHRE-side code
@@ -82,6 +102,7 @@ struct reverse_monitor_thread_data {
 static void *chre_message_to_host_thread(void *arg);
 static void *chre_monitor_thread(void *arg);
 static void *chre_reverse_monitor_thread(void *arg);
+static void *chre_time_sync_timeout_thread(void *arg);
 static bool init_reverse_monitor(struct reverse_monitor_thread_data *data);
 static bool start_thread(pthread_t *thread_handle,
                          thread_entry_point_f *thread_entry,
@@ -90,6 +111,41 @@ static bool start_thread(pthread_t *thread_handle,
 //! Set to true when we request a graceful shutdown of CHRE
 static volatile bool chre_shutdown_requested = false;
 
+//! The broadcast nanoapp messages each client has subscribed to
+static BroadcastSubscriptions gBroadcastSubscriptions;
+
+//! Answers hub info and nanoapp list requests without involving CHRE when the
+//! previous response is still valid
+static HubStateCache gHubStateCache;
+
+//! Hands messages received from CHRE to a worker thread for their priority
+static PriorityDispatcher gDispatcher;
+
+//! The number of messages of each priority that can wait for a dispatch worker
+//! before the receive thread blocks, or log messages are dropped
+static constexpr size_t kMaxDispatchQueueDepth = 256;
+
+//! The number of probes exchanged with CHRE to produce each time offset
+static constexpr uint32_t kTimeSyncProbeCount = 8;
+
+//! How long to wait for the response to a time sync probe before giving up on
+//! it and moving on to the next probe
+static constexpr std::chrono::milliseconds kTimeSyncProbeTimeout(100);
+
+//! State of the time sync probe exchange in progress, if any
+static struct {
+  std::mutex mutex;
+
+  //! Notified when a probe is sent, or the timeout thread should exit
+  std::condition_variable cond;
+  TimeSyncEstimator estimator;
+  std::chrono::steady_clock::time_point probeDeadline;
+  uint32_t sequence;
+  uint32_t probesSent;
+  bool inProgress;
+  bool stopping;
+} gTimeSync;
+
 #if !defined(LOG_NDEBUG) || LOG_NDEBUG != 0
 static void log_buffer(const uint8_t * /*buffer*/, size_t /*size*/) {}
 #else
@@ -134,7 +190,7 @@ static void log_buffer(const uint8_t *buffer, size_t size) {
 }
 #endif
 
-static void parseAndEmitLogMessages(unsigned char *message) {
+static void parseAndEmitLogMessages(const unsigned char *message) {
   const fbs::MessageContainer *container = fbs::GetMessageContainer(message);
   const auto *logMessage = static_cast<const fbs::LogMessage *>(
       container->message());
@@ -179,8 +235,18 @@ static void parseAndEmitLogMessages(unsigned char *message) {
   }
 }
 
-static int64_t getTimeOffset() {
-  int64_t timeOffset = 0;
+/**
+ * Computes the AP to SLPI time offset from a single read of both clocks. Only
+ * possible where the SLPI time counter can be read directly; elsewhere the
+ * offset is only available through the probe exchange started by
+ * startTimeSync().
+ *
+ * @param timeOffset Populated with the offset, in nanoseconds, on success
+ *
+ * @return true if the offset was read
+ */
+static bool getTimeOffset(int64_t *timeOffset) {
+  bool success = false;
 
 #if defined(__aarch64__)
   // Reads the system time counter (CNTPCT) and its frequency (CNTFRQ)
@@ -202,20 +268,43 @@ static int64_t getTimeOffset() {
         (qTimerCount * 1000000) : UINT64_MAX;
     qTimerNanos /= qTimerFreqKHz;
 
-    timeOffset = hostTimeNano - qTimerNanos;
+    *timeOffset = hostTimeNano - qTimerNanos;
+    success = true;
   }
 #else
-#error "Unsupported CPU architecture type"
+  (void) timeOffset;
 #endif
 
-  return timeOffset;
+  return success;
 }
 
-static void sendTimeSyncMessage() {
-  int64_t timeOffset = getTimeOffset();
+/**
+ * Delivers a nanoapp message with an unspecified host endpoint to the clients
+ * that have subscribed to it.
+ *
+ * @param server The server to deliver the message through
+ * @param message A verified message container holding a NanoappMessage
+ * @param messageLen The size of the message, in bytes
+ */
+static void sendNanoappBroadcast(::android::chre::SocketServer *server,
+                                 const unsigned char *message,
+                                 size_t messageLen) {
+  const fbs::MessageContainer *container = fbs::GetMessageContainer(message);
+  const auto *nanoappMessage = static_cast<const fbs::NanoappMessage *>(
+      container->message());
+  uint64_t appId = nanoappMessage->app_id();
+  uint32_t messageType = nanoappMessage->message_type();
+
+  server->sendToInterestedClients(message, messageLen,
+      [appId, messageType](uint16_t clientId) {
+        return gBroadcastSubscriptions.shouldDeliver(
+            clientId, appId, messageType);
+      });
+}
 
+static void sendTimeSyncMessage(int64_t timeOffset, int64_t uncertainty) {
   flatbuffers::FlatBufferBuilder builder(64);
-  HostProtocolHost::encodeTimeSyncMessage(builder, timeOffset);
+  HostProtocolHost::encodeTimeSyncMessage(builder, timeOffset, uncertainty);
   int success = chre_slpi_deliver_message_from_host(
       static_cast<const unsigned char *>(builder.GetBufferPointer()),
       static_cast<int>(builder.GetSize()));
@@ -226,15 +315,185 @@ static void sendTimeSyncMessage() {
 }
 
 /**
- * Entry point for the thread that receives messages sent by CHRE.
+ * Sends the next probe of the time sync exchange. Must be called with
+ * gTimeSync.mutex held.
+ */
+static void sendTimeSyncProbe() {
+  gTimeSync.sequence++;
+  gTimeSync.probesSent++;
+
+  flatbuffers::FlatBufferBuilder builder(64);
+  HostProtocolHost::encodeTimeSyncProbe(builder, gTimeSync.sequence,
+                                        elapsedRealtimeNano());
+  int success = chre_slpi_deliver_message_from_host(
+      static_cast<const unsigned char *>(builder.GetBufferPointer()),
+      static_cast<int>(builder.GetSize()));
+
+  if (success != 0) {
+    LOGE("Failed to deliver time sync probe to CHRE: %d", success);
+    gTimeSync.inProgress = false;
+  } else {
+    gTimeSync.probeDeadline =
+        std::chrono::steady_clock::now() + kTimeSyncProbeTimeout;
+    gTimeSync.cond.notify_one();
+  }
+}
+
+/**
+ * Sends the next probe of the time sync exchange, or once all probes have been
+ * sent, ends the exchange and sends CHRE the offset estimated from the samples
+ * collected. Must be called with gTimeSync.mutex held.
+ */
+static void continueTimeSync() {
+  int64_t timeOffset;
+  int64_t uncertainty;
+  if (gTimeSync.probesSent < kTimeSyncProbeCount) {
+    sendTimeSyncProbe();
+  } else if (!gTimeSync.estimator.getEstimate(&timeOffset, &uncertainty)) {
+    LOGE("Time sync failed: no valid samples");
+    gTimeSync.inProgress = false;
+  } else {
+    LOGD("Time offset %" PRId64 " ns (+/- %" PRId64 " ns) from %zu samples",
+         timeOffset, uncertainty, gTimeSync.estimator.getSampleCount());
+    sendTimeSyncMessage(timeOffset, uncertainty);
+    gTimeSync.inProgress = false;
+  }
+}
+
+/**
+ * Starts a new exchange of time sync probes with CHRE, abandoning any exchange
+ * already in progress. Probes are sent one at a time, so that each only
+ * waits on its own round trip.
+ */
+static void startTimeSync() {
+  std::lock_guard<std::mutex> lock(gTimeSync.mutex);
+  gTimeSync.estimator.reset();
+  gTimeSync.probesSent = 0;
+  gTimeSync.inProgress = true;
+  sendTimeSyncProbe();
+}
+
+/**
+ * Adds the sample from a TimeSyncProbeResponse to the exchange in progress,
+ * and either sends the next probe or sends CHRE the resulting offset.
+ *
+ * @param message A verified message container holding a TimeSyncProbeResponse
+ */
+static void handleTimeSyncProbeResponse(const unsigned char *message) {
+  int64_t hostReceiveTime = elapsedRealtimeNano();
+  const fbs::MessageContainer *container = fbs::GetMessageContainer(message);
+  const auto *response = static_cast<const fbs::TimeSyncProbeResponse *>(
+      container->message());
+
+  std::lock_guard<std::mutex> lock(gTimeSync.mutex);
+  if (!gTimeSync.inProgress || response->sequence() != gTimeSync.sequence) {
+    LOGW("Ignoring stale time sync probe response %" PRIu32,
+         response->sequence());
+  } else {
+    if (!gTimeSync.estimator.addSample(
+            response->host_send_time(), response->chre_receive_time(),
+            response->chre_send_time(), hostReceiveTime)) {
+      LOGW("Discarding inconsistent time sync sample");
+    }
+
+    continueTimeSync();
+  }
+}
+
+/**
+ * Selects the dispatch worker that handles a message from CHRE. Messages
+ * whose relative order is visible to clients share a priority: a nanoapp's
+ * first messages must not overtake the response to the request that loaded
+ * it, and debug dump data must precede the debug dump response. Only log
+ * messages may be dropped if their queue is full (see isDroppable()).
+ *
+ * @param messageType The type of a message received from CHRE
+ *
+ * @return The priority to dispatch the message at
+ */
+static PriorityDispatcher::Priority getDispatchPriority(
+    fbs::ChreMessage messageType) {
+  PriorityDispatcher::Priority priority;
+
+  switch (messageType) {
+    case fbs::ChreMessage::TimeSyncRequest:
+    case fbs::ChreMessage::NanoappMessage:
+    case fbs::ChreMessage::HubInfoResponse:
+    case fbs::ChreMessage::NanoappListResponse:
+    case fbs::ChreMessage::LoadNanoappResponse:
+    case fbs::ChreMessage::UnloadNanoappResponse:
+      priority = PriorityDispatcher::Priority::High;
+      break;
+    case fbs::ChreMessage::LogMessage:
+    case fbs::ChreMessage::DebugDumpData:
+    case fbs::ChreMessage::DebugDumpResponse:
+      priority = PriorityDispatcher::Priority::Low;
+      break;
+    default:
+      priority = PriorityDispatcher::Priority::Normal;
+  }
+
+  return priority;
+}
+
+/**
+ * @param messageType The type of a message received from CHRE
+ *
+ * @return true if the message may be dropped when its dispatch queue is full,
+ *         rather than blocking the thread receiving messages from CHRE. Debug
+ *         dump data shares the low priority queue with logs, but dropping it
+ *         would leave a truncated dump, or one that never completes.
+ */
+static bool isDroppable(fbs::ChreMessage messageType) {
+  return (messageType == fbs::ChreMessage::LogMessage);
+}
+
+/**
+ * Handles a message from CHRE on the dispatch worker for its priority.
+ *
+ * @param server The server to deliver client-bound messages through
+ * @param message The message received from CHRE
+ * @param messageLen The size of the message, in bytes
+ */
+static void dispatchMessageFromChre(::android::chre::SocketServer *server,
+                                    const uint8_t *message,
+                                    size_t messageLen) {
+  uint16_t hostClientId;
+  fbs::ChreMessage messageType;
+  if (!HostProtocolHost::extractHostClientIdAndType(
+      message, messageLen, &hostClientId, &messageType)) {
+    LOGW("Failed to extract host client ID from message - sending "
+         "broadcast");
+    server->sendToAllClients(message, messageLen);
+  } else if (messageType == fbs::ChreMessage::LogMessage) {
+    parseAndEmitLogMessages(message);
+  } else if (messageType == fbs::ChreMessage::TimeSyncRequest) {
+    startTimeSync();
+  } else if (messageType == fbs::ChreMessage::NanoappStatusChange) {
+    // Only consumed by gHubStateCache
+    LOGV("Nanoapp status changed");
+  } else if (hostClientId == chre::kHostClientIdUnspecified
+      && messageType == fbs::ChreMessage::NanoappMessage) {
+    sendNanoappBroadcast(server, message, messageLen);
+  } else if (hostClientId == chre::kHostClientIdUnspecified) {
+    server->sendToAllClients(message, messageLen);
+  } else {
+    server->sendToClientById(message, messageLen, hostClientId);
+  }
+}
+
+/**
+ * Entry point for the thread that receives messages sent by CHRE. Aside from
+ * time sync probe responses, which are handled immediately so that queueing
+ * doesn't inflate the measured round trip, messages are handed off to
+ * gDispatcher.
  *
  * @return always returns NULL
  */
-static void *chre_message_to_host_thread(void *arg) {
+static void *chre_message_to_host_thread(void * /*arg*/) {
   unsigned char messageBuffer[4096];
   unsigned int messageLen;
   int result = 0;
-  auto *server = static_cast<::android::chre::SocketServer *>(arg);
 
   while (true) {
     messageLen = 0;
@@ -249,24 +508,21 @@ static void *chre_message_to_host_thread(void *arg) {
     } else if (result == CHRE_FASTRPC_SUCCESS && messageLen > 0) {
       log_buffer(messageBuffer, messageLen);
       uint16_t hostClientId;
-      fbs::ChreMessage messageType;
-      if (!HostProtocolHost::extractHostClientIdAndType(
+      fbs::ChreMessage messageType = fbs::ChreMessage::NONE;
+      if (HostProtocolHost::extractHostClientIdAndType(
           messageBuffer, messageLen, &hostClientId, &messageType)) {
-        LOGW("Failed to extract host client ID from message - sending "
-             "broadcast");
-        hostClientId = chre::kHostClientIdUnspecified;
+        // Updated here, in the order CHRE sent the messages, rather than by
+        // the dispatch workers
+        gHubStateCache.onMessageFromChre(messageType, messageBuffer,
+                                         static_cast<size_t>(messageLen));
       }
 
-      if (messageType == fbs::ChreMessage::LogMessage) {
-        parseAndEmitLogMessages(messageBuffer);
-      } else if (messageType == fbs::ChreMessage::TimeSyncRequest) {
-        sendTimeSyncMessage();
-      } else if (hostClientId == chre::kHostClientIdUnspecified) {
-        server->sendToAllClients(messageBuffer,
-                                 static_cast<size_t>(messageLen));
+      if (messageType == fbs::ChreMessage::TimeSyncProbeResponse) {
+        handleTimeSyncProbeResponse(messageBuffer);
       } else {
-        server->sendToClientById(messageBuffer,
-                                 static_cast<size_t>(messageLen), hostClientId);
+        gDispatcher.enqueue(getDispatchPriority(messageType), messageBuffer,
+                            static_cast<size_t>(messageLen),
+                            isDroppable(messageType));
       }
     } else if (!chre_shutdown_requested) {
       LOGE("Received an unknown result and no shutdown was requested. Quitting");
@@ -300,6 +556,36 @@ static void *chre_monitor_thread(void *arg) {
   return NULL;
 }
 
+/**
+ * Entry point for the thread that keeps the time sync probe exchange from
+ * stalling when CHRE doesn't answer a probe. A probe that times out is
+ * abandoned, so a late response to it is ignored as stale, and the exchange
+ * continues with the next probe, or ends with the samples collected so far.
+ *
+ * @return always returns NULL
+ */
+static void *chre_time_sync_timeout_thread(void * /*arg*/) {
+  std::unique_lock<std::mutex> lock(gTimeSync.mutex);
+  while (!gTimeSync.stopping) {
+    if (!gTimeSync.inProgress) {
+      gTimeSync.cond.wait(lock);
+    } else {
+      gTimeSync.cond.wait_until(lock, gTimeSync.probeDeadline);
+
+      // The exchange may have moved on while waiting, pushing the deadline
+      // out, or ended
+      if (!gTimeSync.stopping && gTimeSync.inProgress
+          && std::chrono::steady_clock::now() >= gTimeSync.probeDeadline) {
+        LOGW("Time sync probe %" PRIu32 " timed out", gTimeSync.sequence);
+        continueTimeSync();
+      }
+    }
+  }
+
+  LOGV("Time sync timeout thread exited");
+  return NULL;
+}
+
 /**
  * Entry point for the "reverse" monitor thread, which invokes a FastRPC method
  * to register a thread destructor, and blocks waiting on a condition variable.
@@ -370,7 +656,60 @@ static bool start_thread(pthread_t *thread_handle,
 
 namespace {
 
-void onMessageReceivedFromClient(uint16_t clientId, void *data, size_t length) {
+/**
+ * Applies a MessageSubscriptionRequest sent by a client. These are handled
+ * here and not passed on to CHRE.
+ */
+void handleMessageSubscriptionRequest(uint16_t clientId,
+                                      const fbs::MessageContainer *container) {
+  const auto *request = static_cast<const fbs::MessageSubscriptionRequest *>(
+      container->message());
+
+  BroadcastSubscriptions::Subscription subscription;
+  subscription.appId = request->app_id();
+  subscription.messageType = request->message_type();
+  subscription.matchAnyAppId = request->match_any_app_id();
+  subscription.matchAnyMessageType = request->match_any_message_type();
+
+  if (request->subscribe()) {
+    gBroadcastSubscriptions.addSubscription(clientId, subscription);
+  } else if (!gBroadcastSubscriptions.removeSubscription(clientId,
+                                                         subscription)) {
+    LOGW("Client %" PRIu16 " removed a subscription it didn't hold",
+         clientId);
+  }
+}
+
+/**
+ * Responds to a client's hub info or nanoapp list request from gHubStateCache.
+ *
+ * @return true if the request was answered, false if it must be sent to CHRE
+ */
+bool sendCachedResponse(::android::chre::SocketServer *server,
+                        uint16_t clientId, fbs::ChreMessage requestType) {
+  std::vector<uint8_t> response;
+  bool answered = gHubStateCache.getCachedResponse(requestType, clientId,
+                                                   &response);
+  if (answered) {
+    LOGV("Answering request type %" PRIu8 " from cache",
+         static_cast<uint8_t>(requestType));
+    server->sendToClientById(response.data(), response.size(), clientId);
+  }
+
+  return answered;
+}
+
+void onClientDisconnected(uint16_t clientId) {
+  BroadcastSubscriptions::ClientStats stats =
+      gBroadcastSubscriptions.removeClient(clientId);
+  LOGI("Client %" PRIu16 " received %" PRIu64 " broadcasts, %" PRIu64
+       " filtered (%" PRIu64 " filtered across all clients)", clientId,
+       stats.deliveredCount, stats.filteredCount,
+       gBroadcastSubscriptions.getTotalFilteredCount());
+}
+
+void onMessageReceivedFromClient(::android::chre::SocketServer *server,
+                                 uint16_t clientId, void *data, size_t length) {
   constexpr size_t kMaxPayloadSize = 1024 * 1024;  // 1 MiB
 
   // This limitation is due to FastRPC, but there's no case where we should come
@@ -383,6 +722,14 @@ void onMessageReceivedFromClient(uint16_t clientId, void *data, size_t length) {
          kMaxPayloadSize);
   } else if (!HostProtocolHost::mutateHostClientId(data, length, clientId)) {
     LOGE("Couldn't set host client ID in message container!");
+  } else if (fbs::GetMessageContainer(data)->message_type()
+                 == fbs::ChreMessage::MessageSubscriptionRequest) {
+    // The message was verified by mutateHostClientId()
+    handleMessageSubscriptionRequest(clientId, fbs::GetMessageContainer(data));
+  } else if (sendCachedResponse(
+                 server, clientId,
+                 fbs::GetMessageContainer(data)->message_type())) {
+    // Answered without involving CHRE
   } else {
     LOGV("Delivering message from host (size %zu)", length);
     log_buffer(static_cast<const uint8_t *>(data), length);
@@ -394,32 +741,139 @@ void onMessageReceivedFromClient(uint16_t clientId, void *data, size_t length) {
   }
 }
 
+/**
+ * Parses the daemon's command line. The only option is --capture=<path>,
+ * which records all client traffic to a capture file that can be replayed
+ * with chre_replay_client.
+ *
+ * @param capturePath Populated with the capture file path, or nullptr if
+ *        capture wasn't requested
+ *
+ * @return true if the command line was valid
+ */
+bool parseOptions(int argc, char **argv, const char **capturePath) {
+  constexpr char kCaptureOption[] = "--capture=";
+  bool success = true;
+
+  *capturePath = nullptr;
+  for (int i = 1; i < argc && success; i++) {
+    if (strncmp(argv[i], kCaptureOption, sizeof(kCaptureOption) - 1) == 0
+        && argv[i][sizeof(kCaptureOption) - 1] != '\0') {
+      *capturePath = argv[i] + sizeof(kCaptureOption) - 1;
+    } else {
+      LOGE("Invalid argument '%s'; usage: chre_daemon [--capture=<path>]",
+           argv[i]);
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+/**
+ * Stops the dispatch workers once they've handled the messages already
+ * received from CHRE, and logs the queueing delay for each priority.
+ */
+void stopDispatcher() {
+  static const char *const kPriorityNames[PriorityDispatcher::kPriorityCount] =
+      {"high", "normal", "low"};
+
+  gDispatcher.stop();
+  for (size_t i = 0; i < PriorityDispatcher::kPriorityCount; i++) {
+    PriorityDispatcher::Stats stats = gDispatcher.getStats(
+        static_cast<PriorityDispatcher::Priority>(i));
+    uint64_t meanDelayNs = (stats.dispatchedCount == 0)
+        ? 0 : stats.totalQueueDelayNs / stats.dispatchedCount;
+    LOGI("Dispatched %" PRIu64 " %s priority messages (%" PRIu64 " dropped, "
+         "%" PRIu64 " blocked), queueing delay mean %" PRIu64 " us max %"
+         PRIu64 " us, max depth %zu", stats.dispatchedCount, kPriorityNames[i],
+         stats.droppedCount, stats.blockedCount, meanDelayNs / 1000,
+         stats.maxQueueDelayNs / 1000, stats.maxQueueDepth);
+  }
+}
+
+/**
+ * Stops and joins the time sync timeout thread.
+ *
+ * @param thread The thread started with chre_time_sync_timeout_thread()
+ */
+void stopTimeSyncTimeoutThread(pthread_t thread) {
+  {
+    std::lock_guard<std::mutex> lock(gTimeSync.mutex);
+    gTimeSync.stopping = true;
+  }
+  gTimeSync.cond.notify_one();
+
+  int ret = pthread_join(thread, NULL);
+  if (ret != 0) {
+    LOG_ERROR("Join on time sync timeout thread failed", ret);
+  }
+}
+
 }  // anonymous namespace
 
-int main() {
+int main(int argc, char **argv) {
   int ret = -1;
   pthread_t monitor_thread;
   pthread_t msg_to_host_thread;
+  pthread_t time_sync_thread;
   struct reverse_monitor_thread_data reverse_monitor;
   ::android::chre::SocketServer server;
-
-  if (!init_reverse_monitor(&reverse_monitor)) {
+  MessageCaptureWriter captureWriter;
+  const char *capturePath;
+
+  if (!parseOptions(argc, argv, &capturePath)) {
+    LOGE("Couldn't parse command line");
+  } else if (capturePath != nullptr && !captureWriter.open(capturePath)) {
+    LOGE("Couldn't start capture");
+  } else if (!gDispatcher.start(
+      [&server](const uint8_t *message, size_t length) {
+        dispatchMessageFromChre(&server, message, length);
+      }, kMaxDispatchQueueDepth)) {
+    LOGE("Couldn't start dispatch workers");
+  } else if (!init_reverse_monitor(&reverse_monitor)) {
     LOGE("Couldn't initialize reverse monitor");
   } else {
-    // Send time offset message before nanoapps start
-    sendTimeSyncMessage();
+    // Send time offset message before nanoapps start, if it can be read
+    // directly; the probe exchange below refines it once CHRE is running
+    int64_t timeOffset;
+    if (getTimeOffset(&timeOffset)) {
+      sendTimeSyncMessage(timeOffset, 0 /* uncertainty */);
+    }
     if ((ret = chre_slpi_start_thread()) != CHRE_FASTRPC_SUCCESS) {
       LOGE("Failed to start CHRE on SLPI: %d", ret);
     } else {
       if (!start_thread(&monitor_thread, chre_monitor_thread, NULL)) {
         LOGE("Couldn't start monitor thread");
       } else if (!start_thread(&msg_to_host_thread, chre_message_to_host_thread,
-                               &server)) {
+                               NULL)) {
         LOGE("Couldn't start CHRE->Host message thread");
+      } else if (!start_thread(&time_sync_thread,
+                               chre_time_sync_timeout_thread, NULL)) {
+        LOGE("Couldn't start time sync timeout thread");
       } else {
         LOGI("CHRE on SLPI started");
+        startTimeSync();
+        if (captureWriter.isOpen()) {
+          LOGI("Capturing client traffic to %s", capturePath);
+          server.setCaptureWriter(&captureWriter);
+        }
         // TODO: take 2nd argument as command-line parameter
-        server.run("chre", true, onMessageReceivedFromClient);
+        server.run("chre", true,
+                   [&server](uint16_t clientId, void *data, size_t length) {
+                     onMessageReceivedFromClient(&server, clientId, data,
+                                                 length);
+                   }, onClientDisconnected);
+
+        stopTimeSyncTimeoutThread(time_sync_thread);
+        HubStateCache::Stats stats = gHubStateCache.getStats();
+        LOGI("Hub state cache: %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+             " invalidations", stats.hitCount, stats.missCount,
+             stats.invalidationCount);
+        if (captureWriter.isOpen()) {
+          LOGI("Captured %" PRIu64 " frames", captureWriter.getRecordCount());
+          captureWriter.close();
+        }
       }
 
       chre_shutdown_requested = true;
@@ -447,6 +901,7 @@ int main() {
           LOG_ERROR("Join on monitor thread failed", ret);
         }
 
+        stopDispatcher();
         LOGI("Shutdown complete");
       }
     }
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_PLATFORM_ATOMIC_H_
+#define CHRE_PLATFORM_ATOMIC_H_
+
+#include <cstdint>
+
+#include "chre/target_platform/atomic_base.h"
+#include "chre/util/non_copyable.h"
+
+namespace chre {
+
+/**
+ * The memory ordering constraint applied to an atomic operation. These have
+ * the same meaning as the equivalently named std::memory_order values.
+ */
+enum class MemoryOrder {
+  Relaxed,
+  Acquire,
+  Release,
+  AcquireRelease,
+  SequentiallyConsistent,
+};
+
+/**
+ * A boolean that can be safely read and written from multiple threads without
+ * holding a lock. AtomicBoolBase is subclassed here to allow platforms to
+ * inject their own storage and implementation.
+ */
+class AtomicBool : public AtomicBoolBase,
+                   public NonCopyable {
+ public:
+  /**
+   * @param startingValue The initial value of the atomic.
+   */
+  explicit AtomicBool(bool startingValue = false);
+
+  /**
+   * @param order The memory ordering constraint. Must not be Release or
+   *        AcquireRelease.
+   * @return The current value.
+   */
+  bool load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const;
+
+  /**
+   * @param value The new value.
+   * @param order The memory ordering constraint. Must not be Acquire or
+   *        AcquireRelease.
+   */
+  void store(bool value,
+             MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically replaces the current value.
+   *
+   * @param value The new value.
+   * @param order The memory ordering constraint.
+   * @return The value held immediately before the exchange.
+   */
+  bool exchange(bool value,
+                MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+};
+
+/**
+ * An unsigned 32-bit integer that can be safely read and modified from
+ * multiple threads without holding a lock. Arithmetic wraps on overflow.
+ */
+class AtomicUint32 : public AtomicUint32Base,
+                     public NonCopyable {
+ public:
+  /**
+   * @param startingValue The initial value of the atomic.
+   */
+  explicit AtomicUint32(uint32_t startingValue = 0);
+
+  /**
+   * @param order The memory ordering constraint. Must not be Release or
+   *        AcquireRelease.
+   * @return The current value.
+   */
+  uint32_t load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const;
+
+  /**
+   * @param value The new value.
+   * @param order The memory ordering constraint. Must not be Acquire or
+   *        AcquireRelease.
+   */
+  void store(uint32_t value,
+             MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically replaces the current value.
+   *
+   * @param value The new value.
+   * @param order The memory ordering constraint.
+   * @return The value held immediately before the exchange.
+   */
+  uint32_t exchange(uint32_t value,
+                    MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically replaces the current value with desired if it is equal to
+   * expected.
+   *
+   * @param expected The value the atomic is expected to hold. Updated with the
+   *        current value if the comparison fails.
+   * @param desired The value to store if the comparison succeeds.
+   * @param order The memory ordering constraint of a successful exchange. A
+   *        failed exchange uses relaxed ordering.
+   * @return true if the value was replaced.
+   */
+  bool compareExchange(uint32_t *expected, uint32_t desired,
+                       MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically adds to the current value.
+   *
+   * @param arg The value to add.
+   * @param order The memory ordering constraint.
+   * @return The value held immediately before the addition.
+   */
+  uint32_t fetchAdd(uint32_t arg,
+                    MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically subtracts from the current value.
+   *
+   * @param arg The value to subtract.
+   * @param order The memory ordering constraint.
+   * @return The value held immediately before the subtraction.
+   */
+  uint32_t fetchSub(uint32_t arg,
+                    MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+};
+
+/**
+ * A pointer that can be safely read and written from multiple threads without
+ * holding a lock. The pointed-to object is not protected.
+ */
+template<typename ElementType>
+class AtomicPtr : public AtomicPtrBase,
+                  public NonCopyable {
+ public:
+  /**
+   * @param startingValue The initial value of the atomic.
+   */
+  explicit AtomicPtr(ElementType *startingValue = nullptr);
+
+  /**
+   * @param order The memory ordering constraint. Must not be Release or
+   *        AcquireRelease.
+   * @return The current value.
+   */
+  ElementType *load(
+      MemoryOrder order = MemoryOrder::SequentiallyConsistent) const;
+
+  /**
+   * @param value The new value.
+   * @param order The memory ordering constraint. Must not be Acquire or
+   *        AcquireRelease.
+   */
+  void store(ElementType *value,
+             MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically replaces the current value.
+   *
+   * @param value The new value.
+   * @param order The memory ordering constraint.
+   * @return The value held immediately before the exchange.
+   */
+  ElementType *exchange(
+      ElementType *value,
+      MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+
+  /**
+   * Atomically replaces the current value with desired if it is equal to
+   * expected.
+   *
+   * @param expected The value the atomic is expected to hold. Updated with the
+   *        current value if the comparison fails.
+   * @param desired The value to store if the comparison succeeds.
+   * @param order The memory ordering constraint of a successful exchange. A
+   *        failed exchange uses relaxed ordering.
+   * @return true if the value was replaced.
+   */
+  bool compareExchange(ElementType **expected, ElementType *desired,
+                       MemoryOrder order = MemoryOrder::SequentiallyConsistent);
+};
+
+}  // namespace chre
+
+#include "chre/target_platform/atomic_base_impl.h"
+
+#endif  // CHRE_PLATFORM_ATOMIC_H_
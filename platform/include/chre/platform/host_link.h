@@ -55,6 +55,19 @@ class HostLink : public HostLinkBase,
    * @return true if the message was successfully queued
    */
   bool sendMessage(const MessageToHost *message);
+
+  /**
+   * Notifies the host that a nanoapp started or stopped, so it can invalidate
+   * any state it has cached about the running nanoapps. Must be invoked in the
+   * order the changes occur, relative to any responses to host requests.
+   *
+   * @param appId The nanoapp's app ID
+   * @param appVersion The nanoapp's version
+   * @param instanceId The nanoapp's instance ID
+   * @param started true if the nanoapp started, false if it stopped
+   */
+  void sendNanoappStatusChange(uint64_t appId, uint32_t appVersion,
+                               uint32_t instanceId, bool started);
 };
 
 }  // namespace chre
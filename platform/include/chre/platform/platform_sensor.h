@@ -128,6 +128,24 @@ class PlatformSensor : public PlatformSensorBase,
    *         supplied request.
    */
   bool applyRequest(const SensorRequest& request);
+
+  /**
+   * Submits the sensor request to the platform sensor without waiting for it
+   * to be applied, so that the event loop is not blocked by the round trip to
+   * the sensor hardware or framework. The implementation of this method is
+   * supplied by the platform, and is subject to the same requirements as
+   * applyRequest().
+   *
+   * If this method returns true, the platform must report the outcome exactly
+   * once by invoking SensorRequestManager::handleSensorConfigResult() from the
+   * context of the main CHRE thread, e.g. via a deferred callback. No further
+   * request is submitted to this sensor until then.
+   *
+   * @param request The new request to set this sensor to.
+   * @return true if the request was submitted, false if it was rejected
+   *         immediately, in which case no result is reported.
+   */
+  bool applyRequestAsync(const SensorRequest& request);
 };
 
 }  // namespace chre
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chre/platform/linux/futex_mutex.h"
+#include "chre/util/lock_guard.h"
+
+using chre::FutexMutex;
+using chre::LockGuard;
+using chre::benchmark::State;
+using chre::benchmark::doNotOptimize;
+
+namespace {
+
+//! The number of lock/unlock pairs each thread performs per iteration of the
+//! contended benchmarks.
+constexpr size_t kLocksPerThread = 10000;
+
+typedef std::mutex StdMutex;
+
+template<typename MutexType>
+void UncontendedLock(State& state) {
+  MutexType mutex;
+  size_t counter = 0;
+  while (state.keepRunning()) {
+    LockGuard<MutexType> lock(mutex);
+    counter++;
+  }
+  doNotOptimize(counter);
+}
+
+/**
+ * Runs getArg() threads that each take the lock kLocksPerThread times around
+ * a short critical section, similar to posting into the event pool.
+ */
+template<typename MutexType>
+void ContendedLock(State& state) {
+  MutexType mutex;
+  size_t counter = 0;
+  while (state.keepRunning()) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < state.getArg(); i++) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < kLocksPerThread; j++) {
+          LockGuard<MutexType> lock(mutex);
+          counter++;
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  doNotOptimize(counter);
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK_TEMPLATE(UncontendedLock, StdMutex, 0);
+CHRE_BENCHMARK_TEMPLATE(UncontendedLock, FutexMutex, 0);
+CHRE_BENCHMARK_TEMPLATE(ContendedLock, StdMutex, 1, 2, 4, 8);
+CHRE_BENCHMARK_TEMPLATE(ContendedLock, FutexMutex, 1, 2, 4, 8);
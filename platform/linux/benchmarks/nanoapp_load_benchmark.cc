@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+
+#include <dlfcn.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "chre/core/nanoapp.h"
+#include "chre/platform/shared/nanoapp_support_lib_dso.h"
+#include "chre/platform/shared/platform_log.h"
+
+using chre::Nanoapp;
+using chre::benchmark::State;
+using chre::benchmark::doNotOptimize;
+
+namespace {
+
+//! The environment variable holding the path to a nanoapp shared object built
+//! for the google_x86_linux variant, e.g. by run_benchmarks.sh.
+constexpr char kNanoappPathEnvVar[] = "CHRE_BENCHMARK_NANOAPP";
+
+/**
+ * The nanoapp binary under test, and the ID and version that it declares,
+ * which are needed to pass app info validation when loading it.
+ */
+struct NanoappBinary {
+  const char *path;
+  uint64_t appId;
+  uint32_t appVersion;
+  std::vector<char> contents;
+};
+
+/**
+ * Reads the nanoapp named by kNanoappPathEnvVar into memory and extracts its
+ * app info. Also initializes logging, as loading a nanoapp logs through it.
+ *
+ * @return The nanoapp binary, or nullptr if it is not available.
+ */
+const NanoappBinary *getNanoappBinary() {
+  static bool initialized = false;
+  static NanoappBinary binary;
+  static bool valid = false;
+
+  if (!initialized) {
+    initialized = true;
+    chre::PlatformLogSingleton::init();
+
+    binary.path = getenv(kNanoappPathEnvVar);
+    FILE *file = (binary.path != nullptr) ? fopen(binary.path, "rb") : nullptr;
+    if (file != nullptr) {
+      char buffer[4096];
+      size_t bytesRead;
+      while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        binary.contents.insert(binary.contents.end(), buffer,
+                               buffer + bytesRead);
+      }
+      fclose(file);
+
+      void *handle = dlopen(binary.path, RTLD_NOW | RTLD_LOCAL);
+      if (handle != nullptr) {
+        auto *appInfo = static_cast<const struct chreNslNanoappInfo *>(
+            dlsym(handle, CHRE_NSL_DSO_NANOAPP_INFO_SYMBOL_NAME));
+        if (appInfo != nullptr) {
+          binary.appId = appInfo->appId;
+          binary.appVersion = appInfo->appVersion;
+          valid = true;
+        }
+        dlclose(handle);
+      }
+    }
+  }
+
+  return valid ? &binary : nullptr;
+}
+
+/**
+ * Measures a full dynamic load/unload cycle of a nanoapp from a file: dlopen,
+ * app info validation, the start and end entry points, and dlclose.
+ */
+void NanoappLoadFromFile(State& state) {
+  const NanoappBinary *binary = getNanoappBinary();
+  if (binary == nullptr) {
+    state.skip("set CHRE_BENCHMARK_NANOAPP to a nanoapp .so");
+    return;
+  }
+
+  size_t startCount = 0;
+  while (state.keepRunning()) {
+    Nanoapp nanoapp;
+    nanoapp.loadFromFile(binary->appId, binary->path);
+    if (nanoapp.start()) {
+      startCount++;
+      nanoapp.end();
+    }
+  }
+  doNotOptimize(startCount);
+}
+
+/**
+ * Measures a full dynamic load/unload cycle of a nanoapp from a buffer, as is
+ * done for binaries sent by the host. This also includes copying the binary
+ * into a memfd, so the difference from NanoappLoadFromFile approximates the
+ * cost attributable to binary size.
+ */
+void NanoappLoadFromBuffer(State& state) {
+  const NanoappBinary *binary = getNanoappBinary();
+  if (binary == nullptr) {
+    state.skip("set CHRE_BENCHMARK_NANOAPP to a nanoapp .so");
+    return;
+  }
+
+  size_t startCount = 0;
+  while (state.keepRunning()) {
+    Nanoapp nanoapp;
+    if (nanoapp.loadFromBuffer(binary->appId, binary->appVersion,
+                               binary->contents.data(),
+                               binary->contents.size())
+        && nanoapp.start()) {
+      startCount++;
+      nanoapp.end();
+    }
+  }
+  doNotOptimize(startCount);
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK(NanoappLoadFromFile, 0);
+CHRE_BENCHMARK(NanoappLoadFromBuffer, 0);
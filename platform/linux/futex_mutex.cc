@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/platform/linux/futex_mutex.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace chre {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(int),
+              "The futex word must be a plain 32-bit integer");
+
+long futex(std::atomic<uint32_t> *address, int op, uint32_t value) {
+  return syscall(SYS_futex, reinterpret_cast<int *>(address), op, value,
+                 nullptr, nullptr, 0);
+}
+
+/**
+ * Hints to the CPU that we are in a spin-wait loop.
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
+}  // anonymous namespace
+
+void FutexMutex::getContentionStats(ContentionStats *stats) const {
+  stats->contendedCount = mContendedCount.load(std::memory_order_relaxed);
+  stats->spinAcquireCount = mSpinAcquireCount.load(std::memory_order_relaxed);
+  stats->sleepCount = mSleepCount.load(std::memory_order_relaxed);
+}
+
+void FutexMutex::lockContended() {
+  mContendedCount.fetch_add(1, std::memory_order_relaxed);
+
+  // Adaptive phase: critical sections in CHRE are typically much shorter than
+  // a context switch, so poll for a short while before involving the kernel.
+  // Only attempt the CAS when the lock looks free to avoid bouncing the cache
+  // line between cores.
+  for (uint32_t i = 0; i < kSpinCount; i++) {
+    uint32_t expected = mState.load(std::memory_order_relaxed);
+    if (expected == kUnlocked
+        && mState.compare_exchange_weak(expected, kLocked,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      mSpinAcquireCount.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    cpuRelax();
+  }
+
+  // Sleeping phase: mark the lock as having waiters so that unlock() knows to
+  // issue a wake. If we observe it unlocked while doing so, we own it (in the
+  // conservative "with waiters" state, which costs at most one spurious wake).
+  uint32_t state = mState.exchange(kLockedWithWaiters,
+                                   std::memory_order_acquire);
+  while (state != kUnlocked) {
+    mSleepCount.fetch_add(1, std::memory_order_relaxed);
+    futex(&mState, FUTEX_WAIT_PRIVATE, kLockedWithWaiters);
+    state = mState.exchange(kLockedWithWaiters, std::memory_order_acquire);
+  }
+}
+
+void FutexMutex::wakeOne() {
+  futex(&mState, FUTEX_WAKE_PRIVATE, 1);
+}
+
+}  // namespace chre
@@ -27,4 +27,9 @@ bool HostLink::sendMessage(const MessageToHost *message) {
   return false;
 }
 
+void HostLink::sendNanoappStatusChange(uint64_t appId, uint32_t appVersion,
+                                       uint32_t instanceId, bool started) {
+  // TODO: implement
+}
+
 }  // namespace chre
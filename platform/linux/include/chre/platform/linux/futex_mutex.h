@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_PLATFORM_LINUX_FUTEX_MUTEX_H_
+#define CHRE_PLATFORM_LINUX_FUTEX_MUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "chre/util/non_copyable.h"
+
+namespace chre {
+
+/**
+ * A lightweight mutex built directly on the Linux futex syscall. Uncontended
+ * lock and unlock are a single atomic operation each with no syscall. When the
+ * lock is held, the caller spins for a short, bounded period before sleeping
+ * in the kernel, which avoids a context switch for the short critical sections
+ * that dominate CHRE (event pool, inbound event queue, timer list).
+ *
+ * Meets the BasicLockable and Lockable requirements, so it can be used with
+ * LockGuard and std::condition_variable_any.
+ */
+class FutexMutex : public NonCopyable {
+ public:
+  //! The number of times the lock state is polled before sleeping.
+  static constexpr uint32_t kSpinCount = 100;
+
+  /**
+   * Counters describing how often the mutex was found to be held. These are
+   * only updated on the contended path, so they add no cost to uncontended
+   * locking.
+   */
+  struct ContentionStats {
+    //! Number of lock() calls that found the mutex already held.
+    uint32_t contendedCount;
+
+    //! Number of contended lock() calls that acquired it while spinning.
+    uint32_t spinAcquireCount;
+
+    //! Number of times a thread went to sleep in the kernel waiting for it.
+    uint32_t sleepCount;
+  };
+
+  /**
+   * Acquires the mutex, spinning briefly and then sleeping if it is held by
+   * another thread. Illegal to call if the current thread already holds it.
+   */
+  void lock() {
+    uint32_t expected = kUnlocked;
+    if (!mState.compare_exchange_strong(expected, kLocked,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      lockContended();
+    }
+  }
+
+  /**
+   * Attempts to acquire the mutex without blocking.
+   *
+   * @return true if the mutex was acquired, false otherwise
+   */
+  bool try_lock() {
+    uint32_t expected = kUnlocked;
+    return mState.compare_exchange_strong(expected, kLocked,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  }
+
+  /**
+   * Releases the mutex, waking one sleeping waiter if there are any. Illegal
+   * to call if the current thread does not hold the lock.
+   */
+  void unlock() {
+    if (mState.exchange(kUnlocked, std::memory_order_release)
+            == kLockedWithWaiters) {
+      wakeOne();
+    }
+  }
+
+  /**
+   * Obtains a snapshot of the contention counters.
+   *
+   * @param stats Populated with the current counter values. Must not be null.
+   */
+  void getContentionStats(ContentionStats *stats) const;
+
+ private:
+  //! The mutex is not held.
+  static constexpr uint32_t kUnlocked = 0;
+
+  //! The mutex is held and no thread is sleeping on it.
+  static constexpr uint32_t kLocked = 1;
+
+  //! The mutex is held and one or more threads may be sleeping on it.
+  static constexpr uint32_t kLockedWithWaiters = 2;
+
+  //! The lock word, used directly as the futex address.
+  std::atomic<uint32_t> mState{kUnlocked};
+
+  //! @see ContentionStats
+  std::atomic<uint32_t> mContendedCount{0};
+  std::atomic<uint32_t> mSpinAcquireCount{0};
+  std::atomic<uint32_t> mSleepCount{0};
+
+  /**
+   * The slow path of lock(), taken when the initial acquire attempt fails.
+   */
+  void lockContended();
+
+  /**
+   * Wakes one thread sleeping in lockContended().
+   */
+  void wakeOne();
+};
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_LINUX_FUTEX_MUTEX_H_
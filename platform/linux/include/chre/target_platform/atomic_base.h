@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_LINUX_ATOMIC_BASE_H_
+#define CHRE_PLATFORM_LINUX_ATOMIC_BASE_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace chre {
+
+/**
+ * Storage for the Linux implementation of AtomicBool.
+ */
+class AtomicBoolBase {
+ protected:
+  //! Defer to the std::atomic implementation.
+  std::atomic<bool> mValue;
+};
+
+/**
+ * Storage for the Linux implementation of AtomicUint32.
+ */
+class AtomicUint32Base {
+ protected:
+  //! Defer to the std::atomic implementation.
+  std::atomic<uint32_t> mValue;
+};
+
+/**
+ * Storage for the Linux implementation of AtomicPtr.
+ */
+class AtomicPtrBase {
+ protected:
+  //! Defer to the std::atomic implementation. The pointer type is restored by
+  //! AtomicPtr.
+  std::atomic<void *> mValue;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_LINUX_ATOMIC_BASE_H_
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_LINUX_ATOMIC_BASE_IMPL_H_
+#define CHRE_PLATFORM_LINUX_ATOMIC_BASE_IMPL_H_
+
+#include "chre/platform/atomic.h"
+
+namespace chre {
+
+namespace atomic_internal {
+
+/**
+ * Converts a CHRE memory order into its std::memory_order equivalent.
+ */
+inline std::memory_order toStdMemoryOrder(MemoryOrder order) {
+  switch (order) {
+    case MemoryOrder::Relaxed:
+      return std::memory_order_relaxed;
+    case MemoryOrder::Acquire:
+      return std::memory_order_acquire;
+    case MemoryOrder::Release:
+      return std::memory_order_release;
+    case MemoryOrder::AcquireRelease:
+      return std::memory_order_acq_rel;
+    default:
+      return std::memory_order_seq_cst;
+  }
+}
+
+}  // namespace atomic_internal
+
+inline AtomicBool::AtomicBool(bool startingValue) {
+  mValue.store(startingValue, std::memory_order_relaxed);
+}
+
+inline bool AtomicBool::load(MemoryOrder order) const {
+  return mValue.load(atomic_internal::toStdMemoryOrder(order));
+}
+
+inline void AtomicBool::store(bool value, MemoryOrder order) {
+  mValue.store(value, atomic_internal::toStdMemoryOrder(order));
+}
+
+inline bool AtomicBool::exchange(bool value, MemoryOrder order) {
+  return mValue.exchange(value, atomic_internal::toStdMemoryOrder(order));
+}
+
+inline AtomicUint32::AtomicUint32(uint32_t startingValue) {
+  mValue.store(startingValue, std::memory_order_relaxed);
+}
+
+inline uint32_t AtomicUint32::load(MemoryOrder order) const {
+  return mValue.load(atomic_internal::toStdMemoryOrder(order));
+}
+
+inline void AtomicUint32::store(uint32_t value, MemoryOrder order) {
+  mValue.store(value, atomic_internal::toStdMemoryOrder(order));
+}
+
+inline uint32_t AtomicUint32::exchange(uint32_t value, MemoryOrder order) {
+  return mValue.exchange(value, atomic_internal::toStdMemoryOrder(order));
+}
+
+inline bool AtomicUint32::compareExchange(uint32_t *expected, uint32_t desired,
+                                          MemoryOrder order) {
+  return mValue.compare_exchange_strong(
+      *expected, desired, atomic_internal::toStdMemoryOrder(order),
+      std::memory_order_relaxed);
+}
+
+inline uint32_t AtomicUint32::fetchAdd(uint32_t arg, MemoryOrder order) {
+  return mValue.fetch_add(arg, atomic_internal::toStdMemoryOrder(order));
+}
+
+inline uint32_t AtomicUint32::fetchSub(uint32_t arg, MemoryOrder order) {
+  return mValue.fetch_sub(arg, atomic_internal::toStdMemoryOrder(order));
+}
+
+template<typename ElementType>
+AtomicPtr<ElementType>::AtomicPtr(ElementType *startingValue) {
+  mValue.store(startingValue, std::memory_order_relaxed);
+}
+
+template<typename ElementType>
+ElementType *AtomicPtr<ElementType>::load(MemoryOrder order) const {
+  return static_cast<ElementType *>(
+      mValue.load(atomic_internal::toStdMemoryOrder(order)));
+}
+
+template<typename ElementType>
+void AtomicPtr<ElementType>::store(ElementType *value, MemoryOrder order) {
+  mValue.store(value, atomic_internal::toStdMemoryOrder(order));
+}
+
+template<typename ElementType>
+ElementType *AtomicPtr<ElementType>::exchange(ElementType *value,
+                                              MemoryOrder order) {
+  return static_cast<ElementType *>(
+      mValue.exchange(value, atomic_internal::toStdMemoryOrder(order)));
+}
+
+template<typename ElementType>
+bool AtomicPtr<ElementType>::compareExchange(ElementType **expected,
+                                             ElementType *desired,
+                                             MemoryOrder order) {
+  void *expectedValue = *expected;
+  bool success = mValue.compare_exchange_strong(
+      expectedValue, desired, atomic_internal::toStdMemoryOrder(order),
+      std::memory_order_relaxed);
+  *expected = static_cast<ElementType *>(expectedValue);
+  return success;
+}
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_LINUX_ATOMIC_BASE_IMPL_H_
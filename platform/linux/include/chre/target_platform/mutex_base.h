@@ -17,14 +17,24 @@
 #ifndef CHRE_PLATFORM_LINUX_MUTEX_BASE_H_
 #define CHRE_PLATFORM_LINUX_MUTEX_BASE_H_
 
+#ifdef CHRE_USE_FUTEX_MUTEX
+#include "chre/platform/linux/futex_mutex.h"
+#else
 #include <mutex>
+#endif  // CHRE_USE_FUTEX_MUTEX
 
 /**
  * The Linux implementation of MutexBase.
  */
 struct MutexBase {
+#ifdef CHRE_USE_FUTEX_MUTEX
+  //! Builds that define CHRE_USE_FUTEX_MUTEX use the spin-then-sleep futex
+  //! mutex, which avoids kernel involvement for short contended sections.
+  chre::FutexMutex mMutex;
+#else
   //! When running on Linux we map the mutex implementation to std::mutex.
   std::mutex mMutex;
+#endif  // CHRE_USE_FUTEX_MUTEX
 };
 
 #endif  // CHRE_PLATFORM_LINUX_MUTEX_BASE_H_
@@ -17,27 +17,187 @@
 #ifndef CHRE_PLATFORM_LINUX_PLATFORM_NANOAPP_BASE_H_
 #define CHRE_PLATFORM_LINUX_PLATFORM_NANOAPP_BASE_H_
 
+#include <cstddef>
 #include <cstdint>
 
+#include "chre/platform/shared/nanoapp_support_lib_dso.h"
 #include "chre/util/entry_points.h"
 
 namespace chre {
 
 /**
- * Linux-specific nanoapp functionality.
+ * Linux-specific nanoapp functionality. Dynamic nanoapps are shared objects
+ * built with the nanoapp support library, and are opened with dlopen() when
+ * started, in the same way as on the SLPI.
  */
-struct PlatformNanoappBase {
-  //! The function pointer of the nanoapp start entry point.
-  chreNanoappStartFunction *mStart;
+class PlatformNanoappBase {
+ public:
+  /**
+   * Copies the supplied application binary data into an anonymous in-memory
+   * file (memfd), from which it is opened when start() is called. The
+   * application may be invalid - full checking and initialization happens just
+   * before invoking start() nanoapp entry point.
+   *
+   * @param appId The unique app identifier associated with this binary
+   * @param appVersion An application-defined version number
+   * @param appBinary Buffer containing the complete ELF binary for this
+   *        nanoapp, without any CHRE-specific header
+   * @param appBinaryLen Size of appBinary, in bytes
+   *
+   * @return true if the in-memory file was created and populated successfully
+   */
+  bool loadFromBuffer(uint64_t appId, uint32_t appVersion,
+                      const void *appBinary, size_t appBinaryLen);
 
-  //! The function pointer of the nanoapp handle event entry point.
-  chreNanoappHandleEventFunction *mHandleEvent;
+  /**
+   * Creates an anonymous in-memory file (memfd) sized to hold a nanoapp binary
+   * that will be supplied in fragments via copyNanoappFragment(). This allows
+   * the binary to be written directly into its final location as it arrives.
+   *
+   * @param appId The unique app identifier associated with this binary
+   * @param appVersion An application-defined version number
+   * @param appBinaryLen Total size of the app binary, in bytes
+   *
+   * @return true if the in-memory file was created successfully
+   */
+  bool reserveBuffer(uint64_t appId, uint32_t appVersion, size_t appBinaryLen);
 
-  //! The function pointer of the nanoapp end entry point.
-  chreNanoappEndFunction *mEnd;
+  /**
+   * Copies a fragment of the app binary into the storage allocated by
+   * reserveBuffer().
+   *
+   * @param offset Byte offset of the fragment within the app binary
+   * @param fragment Buffer containing the fragment data
+   * @param fragmentLen Size of fragment, in bytes
+   *
+   * @return true if the fragment lies within the reserved storage and was
+   *         copied successfully
+   */
+  bool copyNanoappFragment(size_t offset, const void *fragment,
+                           size_t fragmentLen);
 
-  uint64_t mAppId;
-  uint32_t mAppVersion;
+  /**
+   * Makes this nanoapp use the in-memory file already held by another, without
+   * copying the binary. The file is freed once no nanoapp holds it. This must
+   * only be used once the source binary is complete, as it must not be
+   * modified while shared.
+   *
+   * @param appId The unique app identifier associated with this binary
+   * @param appVersion An application-defined version number
+   * @param source The nanoapp whose binary will be shared
+   *
+   * @return true if the source holds a binary, which is now shared
+   */
+  bool shareBinary(uint64_t appId, uint32_t appVersion,
+                   const PlatformNanoappBase& source);
+
+  /**
+   * @return The size of the binary loaded via loadFromBuffer(),
+   *         reserveBuffer() or shareBinary(), in bytes, or 0 if there is none
+   */
+  size_t getAppBinaryLen() const {
+    return mAppBinaryLen;
+  }
+
+  /**
+   * Associate this Nanoapp with a nanoapp included in a .so on the filesystem.
+   * Actually loading the .so into memory is done when start() is called.
+   *
+   * @param appId The nanoapp's ID
+   * @param filename The path of the .so file that holds this nanoapp. This
+   *        string is not deep-copied, so the memory must remain valid for the
+   *        lifetime of this Nanoapp instance.
+   */
+  void loadFromFile(uint64_t appId, const char *filename);
+
+  /**
+   * Associate this Nanoapp instance with a nanoapp that is statically built
+   * into the CHRE binary with the given app info structure.
+   */
+  void loadStatic(const struct chreNslNanoappInfo *appInfo);
+
+  /**
+   * @return true if the app's binary data is available to be started, i.e. a
+   *         previous call to loadFromBuffer(), loadFromFile() or loadStatic()
+   *         was successful
+   */
+  bool isLoaded() const;
+
+ protected:
+  //! The app ID we received in the metadata alongside the nanoapp binary. This
+  //! is also included in (and checked against) mAppInfo.
+  uint64_t mExpectedAppId = 0;
+
+  //! The application-defined version number we received in the metadata
+  //! alongside the nanoapp binary. This is also included in (and checked
+  //! against) mAppInfo.
+  uint32_t mExpectedAppVersion = 0;
+
+  //! File descriptor of the memfd holding the complete DSO binary - only valid
+  //! if loadFromBuffer(), reserveBuffer() or shareBinary() was used to load
+  //! this nanoapp
+  int mAppBinaryFd = -1;
+  size_t mAppBinaryLen = 0;
+
+  //! If this is a non-static nanoapp loaded via loadFromFile(), this will be
+  //! set to the filename string to pass to dlopen()
+  const char *mFilename = nullptr;
+
+  //! The dynamic shared object (DSO) handle returned by dlopen()
+  void *mDsoHandle = nullptr;
+
+  //! Pointer to the app info structure within this nanoapp
+  const struct chreNslNanoappInfo *mAppInfo = nullptr;
+
+  //! Set to true if this app is built into the CHRE binary, and was loaded via
+  //! loadStatic(). In this case, the member variables above are not valid or
+  //! applicable.
+  bool mIsStatic = false;
+
+  /**
+   * Calls through to openNanoappFromBuffer or openNanoappFromFile, depending on
+   * how this nanoapp was loaded.
+   */
+  bool openNanoapp();
+
+  /**
+   * Calls dlopen on the memfd holding the app binary, and fetches and validates
+   * the app info pointer. This will result in execution of any on-load handlers
+   * (e.g. static global constructors) in the nanoapp.
+   *
+   * @return true if the app was opened successfully and the app info structure
+   *         passed validation
+   */
+  bool openNanoappFromBuffer();
+
+  /**
+   * Calls dlopen on the app filename, and fetches and validates the app info
+   * pointer. This will result in execution of any on-load handlers (e.g.
+   * static global constructors) in the nanoapp.
+   *
+   * @return true if the app was opened successfully and the app info
+   *         structure passed validation
+   */
+  bool openNanoappFromFile();
+
+  /**
+   * Calls dlopen on the given path, and fetches and validates the app info
+   * pointer. Shared by openNanoappFromBuffer() and openNanoappFromFile().
+   *
+   * @param path The path to pass to dlopen()
+   * @param skipVersionValidation if true, the app version included in the
+   *        binary is not checked against mExpectedAppVersion
+   *
+   * @return true if the app was opened successfully and the app info
+   *         structure passed validation
+   */
+  bool openNanoappFromPath(const char *path, bool skipVersionValidation);
+
+  /**
+   * Releases the DSO handle if it was active, by calling dlclose(). This will
+   * result in execution of any unload handlers in the nanoapp.
+   */
+  void closeNanoapp();
 };
 
 }  // namespace chre
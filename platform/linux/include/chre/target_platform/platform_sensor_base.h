@@ -17,6 +17,10 @@
 #ifndef CHRE_PLATFORM_LINUX_PLATFORM_SENSOR_BASE_H_
 #define CHRE_PLATFORM_LINUX_PLATFORM_SENSOR_BASE_H_
 
+#include <cstddef>
+
+#include "chre/core/sensor_request.h"
+
 namespace chre {
 
 /**
@@ -28,7 +32,21 @@ class PlatformSensorBase {
   static constexpr size_t kMaxSensorNameSize = 32;
 
   //! The name of this sensor for the Linux platform.
-  char sensorName[kMaxSensorNameSize];
+  char sensorName[kMaxSensorNameSize] = {};
+
+  //! The type of this sensor.
+  SensorType sensorType = SensorType::Unknown;
+
+  /**
+   * Sets the sensor types that PlatformSensor::getSensors() reports. Linux has
+   * no sensors of its own, so this allows tests to exercise the common sensor
+   * code. These sensors accept every request, but never produce samples.
+   *
+   * @param sensorTypes The sensor types to report. Must remain valid until
+   *        this is called again, or nullptr to report no sensors.
+   * @param count The number of entries in sensorTypes.
+   */
+  static void setFakeSensorTypes(const SensorType *sensorTypes, size_t count);
 };
 
 }  // namespace chre
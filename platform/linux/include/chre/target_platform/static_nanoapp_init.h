@@ -19,6 +19,7 @@
 
 #include "chre/core/nanoapp.h"
 #include "chre/platform/fatal_error.h"
+#include "chre/platform/shared/nanoapp_support_lib_dso.h"
 #include "chre/util/unique_ptr.h"
 
 /**
@@ -28,24 +29,35 @@
  * @param appName the name of the nanoapp. This will be prefixed by gNanoapp
  * when creating the global instance of the nanoapp.
  * @param appId the app's unique 64-bit ID
+ * @param appVersion the application-defined 32-bit version number
  */
-#define CHRE_STATIC_NANOAPP_INIT(appName, appId, appVersion) \
-namespace chre {                                             \
-                                                             \
-UniquePtr<Nanoapp> initializeStaticNanoapp##appName() {      \
-  UniquePtr<Nanoapp> nanoapp = MakeUnique<Nanoapp>();        \
-  if (nanoapp.isNull()) {                                    \
-    FATAL_ERROR("Failed to allocate nanoapp " #appName);     \
-  } else {                                                   \
-    nanoapp->mStart = nanoappStart;                          \
-    nanoapp->mHandleEvent = nanoappHandleEvent;              \
-    nanoapp->mEnd = nanoappEnd;                              \
-    nanoapp->mAppId = appId;                                 \
-    nanoapp->mAppVersion = appVersion;                       \
-  }                                                          \
-                                                             \
-  return nanoapp;                                            \
-}                                                            \
+#define CHRE_STATIC_NANOAPP_INIT(appName, appId_, appVersion_) \
+namespace chre {                                               \
+                                                               \
+UniquePtr<Nanoapp> initializeStaticNanoapp##appName() {        \
+  UniquePtr<Nanoapp> nanoapp = MakeUnique<Nanoapp>();          \
+  static struct chreNslNanoappInfo appInfo;                    \
+  appInfo.magic = CHRE_NSL_NANOAPP_INFO_MAGIC;                 \
+  appInfo.structMinorVersion =                                 \
+    CHRE_NSL_NANOAPP_INFO_STRUCT_MINOR_VERSION;                \
+  appInfo.targetApiVersion = CHRE_API_VERSION;                 \
+  appInfo.vendor = "Google";                                   \
+  appInfo.name = #appName;                                     \
+  appInfo.isSystemNanoapp = true;                              \
+  appInfo.appId = appId_;                                      \
+  appInfo.appVersion = appVersion_;                            \
+  appInfo.entryPoints.start = nanoappStart;                    \
+  appInfo.entryPoints.handleEvent = nanoappHandleEvent;        \
+  appInfo.entryPoints.end = nanoappEnd;                        \
+  if (nanoapp.isNull()) {                                      \
+    FATAL_ERROR("Failed to allocate nanoapp " #appName);       \
+  } else {                                                     \
+    nanoapp->loadStatic(&appInfo);                             \
+  }                                                            \
+                                                               \
+  return nanoapp;                                              \
+}                                                              \
+                                                               \
 }  /* namespace chre */
 
 #endif  // CHRE_PLATFORM_LINUX_STATIC_NANOAPP_INIT_H_
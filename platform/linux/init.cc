@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "ash/platform/linux/ash.h"
 #include "chre/core/event.h"
 #include "chre/core/event_loop.h"
 #include "chre/core/event_loop_manager.h"
@@ -56,6 +57,7 @@ int main() {
   });
   chreThread.join();
 
+  chre::ashDeinit();
   chre::deinit();
   chre::PlatformLogSingleton::deinit();
   return 0;
@@ -14,46 +14,303 @@
  * limitations under the License.
  */
 
-#include "chre_api/chre/version.h"
 #include "chre/platform/platform_nanoapp.h"
 
+#include "chre/platform/assert.h"
+#include "chre/platform/log.h"
+#include "chre/platform/shared/nanoapp_dso_util.h"
+#include "chre/platform/shared/nanoapp_support_lib_dso.h"
+#include "chre/util/system/debug_dump.h"
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <linux/memfd.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+
 namespace chre {
 
-PlatformNanoapp::~PlatformNanoapp() {}
+namespace {
+
+/**
+ * Creates an anonymous in-memory file. The raw system call is used as not all
+ * supported C libraries provide a memfd_create() wrapper.
+ *
+ * @param name The name of the file, for debugging purposes only
+ *
+ * @return The file descriptor, or -1 on failure with errno set
+ */
+int createMemfd(const char *name) {
+  return static_cast<int>(syscall(SYS_memfd_create, name, MFD_CLOEXEC));
+}
+
+/**
+ * Writes the entire buffer to a file descriptor at the given offset, retrying
+ * on short writes. The file offset is not modified.
+ *
+ * @return true if all bytes were written
+ */
+bool writeFullyAt(int fd, const void *buffer, size_t size, size_t offset) {
+  const uint8_t *data = static_cast<const uint8_t *>(buffer);
+  while (size > 0) {
+    ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (written < 0 && errno != EINTR) {
+      return false;
+    } else if (written > 0) {
+      data += written;
+      size -= static_cast<size_t>(written);
+      offset += static_cast<size_t>(written);
+    }
+  }
+
+  return true;
+}
+
+}  // anonymous namespace
+
+PlatformNanoapp::~PlatformNanoapp() {
+  closeNanoapp();
+  if (mAppBinaryFd >= 0) {
+    close(mAppBinaryFd);
+  }
+}
 
 bool PlatformNanoapp::start() {
-  return mStart();
+  // Invoke the start entry point after successfully opening the app
+  return openNanoapp() ? mAppInfo->entryPoints.start() : false;
 }
 
 void PlatformNanoapp::handleEvent(uint32_t senderInstanceId,
                                   uint16_t eventType,
                                   const void *eventData) {
-  mHandleEvent(senderInstanceId, eventType, eventData);
+  mAppInfo->entryPoints.handleEvent(senderInstanceId, eventType, eventData);
 }
 
 void PlatformNanoapp::end() {
-  mEnd();
+  mAppInfo->entryPoints.end();
+  closeNanoapp();
 }
 
 uint64_t PlatformNanoapp::getAppId() const {
-  return mAppId;
+  return (mAppInfo != nullptr) ? mAppInfo->appId : mExpectedAppId;
 }
 
 uint32_t PlatformNanoapp::getAppVersion() const {
-  return mAppVersion;
+  return (mAppInfo != nullptr) ? mAppInfo->appVersion : mExpectedAppVersion;
 }
 
 uint32_t PlatformNanoapp::getTargetApiVersion() const {
-  return CHRE_API_VERSION;
+  return (mAppInfo != nullptr) ? mAppInfo->targetApiVersion : 0;
 }
 
 bool PlatformNanoapp::isSystemNanoapp() const {
-  return true;
+  // Static nanoapps are always system nanoapps. Dynamic nanoapps declare this
+  // in their app info structure, which is only available while they are open.
+  return (mAppInfo != nullptr) ? mAppInfo->isSystemNanoapp : false;
 }
 
 bool PlatformNanoapp::logStateToBuffer(char *buffer, size_t *bufferPos,
                                        size_t bufferSize) const {
-  return true;
+  bool success = true;
+  if (mAppInfo != nullptr) {
+    success &= debugDumpPrint(buffer, bufferPos, bufferSize, " %s: vendor=\"%s\"",
+                              mAppInfo->name, mAppInfo->vendor);
+  }
+  return success;
+}
+
+bool PlatformNanoappBase::loadFromBuffer(uint64_t appId, uint32_t appVersion,
+                                         const void *appBinary,
+                                         size_t appBinaryLen) {
+  return (reserveBuffer(appId, appVersion, appBinaryLen)
+      && copyNanoappFragment(0, appBinary, appBinaryLen));
+}
+
+bool PlatformNanoappBase::reserveBuffer(uint64_t appId, uint32_t appVersion,
+                                        size_t appBinaryLen) {
+  CHRE_ASSERT(!isLoaded());
+  bool success = false;
+  constexpr size_t kMaxAppSize = 2 * 1024 * 1024;  // 2 MiB
+
+  // The memfd name only appears in /proc/self/maps, but makes it possible to
+  // tell which nanoapp a mapping belongs to
+  constexpr size_t kMaxFilenameLen = 17;
+  char filename[kMaxFilenameLen];
+  snprintf(filename, sizeof(filename), "%016" PRIx64, appId);
+
+  if (appBinaryLen > kMaxAppSize) {
+    LOGE("Rejecting app size %zu above limit %zu", appBinaryLen, kMaxAppSize);
+  } else {
+    int fd = createMemfd(filename);
+    if (fd < 0) {
+      LOGE("Couldn't create memfd for nanoapp 0x%016" PRIx64 ": %s", appId,
+           strerror(errno));
+    } else if (ftruncate(fd, static_cast<off_t>(appBinaryLen)) != 0) {
+      LOGE("Couldn't size memfd to %zu bytes for nanoapp 0x%016" PRIx64 ": %s",
+           appBinaryLen, appId, strerror(errno));
+      close(fd);
+    } else {
+      mExpectedAppId = appId;
+      mExpectedAppVersion = appVersion;
+      mAppBinaryFd = fd;
+      mAppBinaryLen = appBinaryLen;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+bool PlatformNanoappBase::copyNanoappFragment(size_t offset,
+                                              const void *fragment,
+                                              size_t fragmentLen) {
+  bool success = false;
+
+  if (mAppBinaryFd < 0) {
+    LOGE("Got nanoapp fragment without a reserved buffer");
+  } else if (offset > mAppBinaryLen || fragmentLen > mAppBinaryLen - offset) {
+    LOGE("Nanoapp fragment (offset %zu size %zu) overflows binary size %zu",
+         offset, fragmentLen, mAppBinaryLen);
+  } else if (!writeFullyAt(mAppBinaryFd, fragment, fragmentLen, offset)) {
+    LOGE("Couldn't write %zu byte fragment for nanoapp 0x%016" PRIx64 ": %s",
+         fragmentLen, mExpectedAppId, strerror(errno));
+  } else {
+    success = true;
+  }
+
+  return success;
+}
+
+bool PlatformNanoappBase::shareBinary(uint64_t appId, uint32_t appVersion,
+                                      const PlatformNanoappBase& source) {
+  CHRE_ASSERT(!isLoaded());
+  bool success = false;
+
+  if (source.mAppBinaryFd < 0) {
+    LOGE("Nanoapp 0x%016" PRIx64 " has no binary to share", appId);
+  } else {
+    // Each holder has its own descriptor for the same in-memory file
+    int fd = fcntl(source.mAppBinaryFd, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) {
+      LOGE("Couldn't share binary of nanoapp 0x%016" PRIx64 ": %s", appId,
+           strerror(errno));
+    } else {
+      mExpectedAppId = appId;
+      mExpectedAppVersion = appVersion;
+      mAppBinaryFd = fd;
+      mAppBinaryLen = source.mAppBinaryLen;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+void PlatformNanoappBase::loadFromFile(uint64_t appId, const char *filename) {
+  CHRE_ASSERT(!isLoaded());
+  mExpectedAppId = appId;
+  mFilename = filename;
+}
+
+void PlatformNanoappBase::loadStatic(const struct chreNslNanoappInfo *appInfo) {
+  CHRE_ASSERT(!isLoaded());
+  mIsStatic = true;
+  mAppInfo = appInfo;
+}
+
+bool PlatformNanoappBase::isLoaded() const {
+  return (mIsStatic || mAppBinaryFd >= 0 || mFilename != nullptr);
+}
+
+void PlatformNanoappBase::closeNanoapp() {
+  if (mDsoHandle != nullptr) {
+    const char *name = (mAppInfo != nullptr) ? mAppInfo->name : "unknown";
+    if (dlclose(mDsoHandle) != 0) {
+      LOGE("dlclose of %s failed: %s", name, dlerror());
+    }
+    mAppInfo = nullptr;
+    mDsoHandle = nullptr;
+  }
+}
+
+bool PlatformNanoappBase::openNanoapp() {
+  bool success = false;
+
+  if (mIsStatic) {
+    success = true;
+  } else if (mFilename != nullptr) {
+    success = openNanoappFromFile();
+  } else if (mAppBinaryFd >= 0) {
+    success = openNanoappFromBuffer();
+  } else {
+    CHRE_ASSERT(false);
+  }
+
+  return success;
+}
+
+bool PlatformNanoappBase::openNanoappFromBuffer() {
+  CHRE_ASSERT(mAppBinaryFd >= 0);
+
+  // dlopen() requires a path, which the kernel provides for any open file
+  // descriptor, including one that has no name on the filesystem
+  constexpr size_t kMaxPathLen = 32;
+  char path[kMaxPathLen];
+  snprintf(path, sizeof(path), "/proc/self/fd/%d", mAppBinaryFd);
+
+  return openNanoappFromPath(path, false /* skipVersionValidation */);
+}
+
+bool PlatformNanoappBase::openNanoappFromFile() {
+  CHRE_ASSERT(mFilename != nullptr);
+  bool success = openNanoappFromPath(mFilename,
+                                     true /* skipVersionValidation */);
+  if (success) {
+    // Save the app version field in case this app gets disabled and we still
+    // get a query request for the version later on.
+    mExpectedAppVersion = mAppInfo->appVersion;
+  }
+
+  return success;
+}
+
+bool PlatformNanoappBase::openNanoappFromPath(const char *path,
+                                              bool skipVersionValidation) {
+  CHRE_ASSERT_LOG(mDsoHandle == nullptr, "Re-opening nanoapp");
+  bool success = false;
+
+  mDsoHandle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (mDsoHandle == nullptr) {
+    LOGE("Failed to load nanoapp from %s: %s", path, dlerror());
+  } else {
+    mAppInfo = static_cast<const struct chreNslNanoappInfo *>(
+        dlsym(mDsoHandle, CHRE_NSL_DSO_NANOAPP_INFO_SYMBOL_NAME));
+    if (mAppInfo == nullptr) {
+      LOGE("Failed to find app info symbol in %s: %s", path, dlerror());
+    } else {
+      success = validateAppInfo(mExpectedAppId, mExpectedAppVersion, mAppInfo,
+                                skipVersionValidation);
+      if (!success) {
+        mAppInfo = nullptr;
+      } else {
+        LOGI("Successfully loaded nanoapp %s (0x%016" PRIx64 ") version 0x%"
+             PRIx32 " from %s", mAppInfo->name, mAppInfo->appId,
+             mAppInfo->appVersion, path);
+      }
+    }
+
+    if (!success) {
+      dlclose(mDsoHandle);
+      mDsoHandle = nullptr;
+    }
+  }
+
+  return success;
 }
 
 }  // namespace chre
@@ -16,7 +16,26 @@
 
 #include "chre/platform/platform_sensor.h"
 
+#include <cstring>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/platform/log.h"
+#include "chre/platform/memory.h"
+
 namespace chre {
+namespace {
+
+//! The sensor types reported by getSensors(); see setFakeSensorTypes()
+const SensorType *gFakeSensorTypes = nullptr;
+size_t gFakeSensorTypeCount = 0;
+
+}  // anonymous namespace
+
+void PlatformSensorBase::setFakeSensorTypes(const SensorType *sensorTypes,
+                                            size_t count) {
+  gFakeSensorTypes = sensorTypes;
+  gFakeSensorTypeCount = (sensorTypes == nullptr) ? 0 : count;
+}
 
 PlatformSensor::PlatformSensor(PlatformSensor&& other) {
   *this = std::move(other);
@@ -39,7 +58,17 @@ bool PlatformSensor::getSensors(DynamicVector<Sensor> *sensors) {
 
   // TODO: Implement this. Perhaps look at all sensor trace files provided and
   // return the list of sensor data available.
-  return false;
+  bool success = true;
+  for (size_t i = 0; i < gFakeSensorTypeCount && success; i++) {
+    Sensor sensor;
+    sensor.sensorType = gFakeSensorTypes[i];
+    strncpy(sensor.sensorName, getSensorTypeName(sensor.sensorType),
+            kMaxSensorNameSize - 1);
+    sensor.sensorName[kMaxSensorNameSize - 1] = '\0';
+    success = sensors->push_back(std::move(sensor));
+  }
+
+  return (success && gFakeSensorTypeCount > 0);
 }
 
 bool PlatformSensor::applyRequest(const SensorRequest& request) {
@@ -47,12 +76,45 @@ bool PlatformSensor::applyRequest(const SensorRequest& request) {
   // sensor samples from mock sensor data once the sensor has transitioned to
   // being enabled. Maybe consider resampling input data if the provided mock
   // data rate is higher than requested.
-  return false;
+  return (sensorType != SensorType::Unknown);
+}
+
+bool PlatformSensor::applyRequestAsync(const SensorRequest& request) {
+  // Linux has no sensor framework to wait on, so the request is applied
+  // immediately and its result delivered the way an asynchronous platform
+  // would, via a deferred callback.
+  struct CallbackState {
+    SensorType sensorType;
+    bool success;
+  };
+
+  bool submitted = false;
+  auto *cbState = memoryAlloc<CallbackState>();
+  if (cbState == nullptr) {
+    LOG_OOM();
+  } else {
+    cbState->sensorType = getSensorType();
+    cbState->success = applyRequest(request);
+
+    auto callback = [](uint16_t /* eventType */, void *eventData) {
+      auto *state = static_cast<CallbackState *>(eventData);
+      EventLoopManagerSingleton::get()->getSensorRequestManager()
+          .handleSensorConfigResult(state->sensorType, state->success);
+      memoryFree(state);
+    };
+
+    submitted = EventLoopManagerSingleton::get()->deferCallback(
+        SystemCallbackType::SensorConfigResult, cbState, callback);
+    if (!submitted) {
+      memoryFree(cbState);
+    }
+  }
+
+  return submitted;
 }
 
 SensorType PlatformSensor::getSensorType() const {
-  // TODO: Implement this.
-  return SensorType::Unknown;
+  return sensorType;
 }
 
 uint64_t PlatformSensor::getMinInterval() const {
@@ -61,12 +123,12 @@ uint64_t PlatformSensor::getMinInterval() const {
 }
 
 const char *PlatformSensor::getSensorName() const {
-  // TODO: Implement this.
-  return "";
+  return sensorName;
 }
 
 PlatformSensor& PlatformSensor::operator=(PlatformSensor&& other) {
-  // TODO: Implement this.
+  memcpy(sensorName, other.sensorName, kMaxSensorNameSize);
+  sensorType = other.sensorType;
   return *this;
 }
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "chre/platform/atomic.h"
+
+using chre::AtomicBool;
+using chre::AtomicPtr;
+using chre::AtomicUint32;
+using chre::MemoryOrder;
+
+TEST(AtomicBool, LoadStoreExchange) {
+  AtomicBool flag;
+  EXPECT_FALSE(flag.load());
+
+  flag.store(true, MemoryOrder::Release);
+  EXPECT_TRUE(flag.load(MemoryOrder::Acquire));
+
+  EXPECT_TRUE(flag.exchange(false));
+  EXPECT_FALSE(flag.load(MemoryOrder::Relaxed));
+
+  AtomicBool initiallySet(true);
+  EXPECT_TRUE(initiallySet.load());
+}
+
+TEST(AtomicUint32, Arithmetic) {
+  AtomicUint32 value(5);
+  EXPECT_EQ(5, value.fetchAdd(3));
+  EXPECT_EQ(8, value.fetchSub(2, MemoryOrder::Relaxed));
+  EXPECT_EQ(6, value.exchange(10));
+  EXPECT_EQ(10, value.load());
+
+  value.store(UINT32_MAX);
+  value.fetchAdd(1);
+  EXPECT_EQ(0, value.load());
+}
+
+TEST(AtomicUint32, CompareExchange) {
+  AtomicUint32 value(1);
+  uint32_t expected = 2;
+  EXPECT_FALSE(value.compareExchange(&expected, 3));
+  EXPECT_EQ(1, expected);
+  EXPECT_TRUE(value.compareExchange(&expected, 3, MemoryOrder::AcquireRelease));
+  EXPECT_EQ(3, value.load());
+}
+
+TEST(AtomicUint32, ConcurrentIncrement) {
+  constexpr uint32_t kThreadCount = 4;
+  constexpr uint32_t kIterations = 100000;
+  AtomicUint32 counter;
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&]() {
+      for (uint32_t j = 0; j < kIterations; j++) {
+        counter.fetchAdd(1, MemoryOrder::Relaxed);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(kThreadCount * kIterations, counter.load());
+}
+
+TEST(AtomicPtr, LoadStoreCompareExchange) {
+  int a = 1;
+  int b = 2;
+  AtomicPtr<int> ptr;
+  EXPECT_EQ(nullptr, ptr.load());
+
+  ptr.store(&a, MemoryOrder::Release);
+  EXPECT_EQ(&a, ptr.load(MemoryOrder::Acquire));
+
+  int *expected = &b;
+  EXPECT_FALSE(ptr.compareExchange(&expected, nullptr));
+  EXPECT_EQ(&a, expected);
+  EXPECT_TRUE(ptr.compareExchange(&expected, &b));
+  EXPECT_EQ(&b, ptr.exchange(nullptr));
+  EXPECT_EQ(nullptr, ptr.load());
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include "chre/platform/linux/futex_mutex.h"
+#include "chre/util/lock_guard.h"
+
+using chre::FutexMutex;
+using chre::LockGuard;
+
+TEST(FutexMutex, TryLock) {
+  FutexMutex mutex;
+  EXPECT_TRUE(mutex.try_lock());
+  EXPECT_FALSE(mutex.try_lock());
+  mutex.unlock();
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(FutexMutex, UncontendedLockDoesNotCountContention) {
+  FutexMutex mutex;
+  for (int i = 0; i < 10; i++) {
+    LockGuard<FutexMutex> lock(mutex);
+  }
+
+  FutexMutex::ContentionStats stats;
+  mutex.getContentionStats(&stats);
+  EXPECT_EQ(0, stats.contendedCount);
+  EXPECT_EQ(0, stats.spinAcquireCount);
+  EXPECT_EQ(0, stats.sleepCount);
+}
+
+TEST(FutexMutex, MutualExclusionUnderContention) {
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kIterations = 100000;
+  FutexMutex mutex;
+  size_t counter = 0;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < kIterations; j++) {
+        LockGuard<FutexMutex> lock(mutex);
+        counter++;
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(kThreadCount * kIterations, counter);
+
+  FutexMutex::ContentionStats stats;
+  mutex.getContentionStats(&stats);
+  EXPECT_LE(stats.spinAcquireCount, stats.contendedCount);
+}
+
+TEST(FutexMutex, WakesSleepingWaiter) {
+  FutexMutex mutex;
+  mutex.lock();
+
+  bool acquired = false;
+  std::thread waiter([&]() {
+    mutex.lock();
+    acquired = true;
+    mutex.unlock();
+  });
+
+  // Hold the lock long enough for the waiter to exhaust its spin phase.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  mutex.unlock();
+  waiter.join();
+
+  EXPECT_TRUE(acquired);
+  FutexMutex::ContentionStats stats;
+  mutex.getContentionStats(&stats);
+  EXPECT_EQ(1, stats.contendedCount);
+  EXPECT_GE(stats.sleepCount, 1);
+}
+
+TEST(FutexMutex, WorksWithConditionVariableAny) {
+  FutexMutex mutex;
+  std::condition_variable_any cv;
+  bool ready = false;
+
+  std::thread notifier([&]() {
+    LockGuard<FutexMutex> lock(mutex);
+    ready = true;
+    cv.notify_one();
+  });
+
+  mutex.lock();
+  while (!ready) {
+    cv.wait(mutex);
+  }
+  mutex.unlock();
+  notifier.join();
+  EXPECT_TRUE(ready);
+}
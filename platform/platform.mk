@@ -32,6 +32,9 @@ HEXAGON_SRCS += platform/shared/chre_api_wwan.cc
 HEXAGON_SRCS += platform/shared/host_protocol_chre.cc
 HEXAGON_SRCS += platform/shared/host_protocol_common.cc
 HEXAGON_SRCS += platform/shared/memory.cc
+HEXAGON_SRCS += platform/shared/nanoapp_binary_cache.cc
+HEXAGON_SRCS += platform/shared/nanoapp_dso_util.cc
+HEXAGON_SRCS += platform/shared/nanoapp_load_manager.cc
 HEXAGON_SRCS += platform/shared/pal_system_api.cc
 HEXAGON_SRCS += platform/shared/platform_gnss.cc
 HEXAGON_SRCS += platform/shared/platform_wifi.cc
@@ -40,6 +43,7 @@ HEXAGON_SRCS += platform/shared/system_time.cc
 HEXAGON_SRCS += platform/slpi/fatal_error.cc
 HEXAGON_SRCS += platform/slpi/host_link.cc
 HEXAGON_SRCS += platform/slpi/init.cc
+HEXAGON_SRCS += platform/slpi/nanoapp_loader.cc
 HEXAGON_SRCS += platform/slpi/platform_log.cc
 HEXAGON_SRCS += platform/slpi/platform_nanoapp.cc
 HEXAGON_SRCS += platform/slpi/platform_sensor.cc
@@ -53,10 +57,17 @@ HEXAGON_SRCS += platform/slpi/system_timer.cc
 X86_CFLAGS += -Iplatform/shared/include
 X86_CFLAGS += -Iplatform/linux/include
 
+# Build with CHRE_USE_FUTEX_MUTEX=true to back chre::Mutex with the futex-based
+# adaptive mutex instead of std::mutex.
+ifeq ($(CHRE_USE_FUTEX_MUTEX), true)
+X86_CFLAGS += -DCHRE_USE_FUTEX_MUTEX
+endif
+
 # x86-specific Source Files ####################################################
 
 X86_SRCS += platform/linux/context.cc
 X86_SRCS += platform/linux/fatal_error.cc
+X86_SRCS += platform/linux/futex_mutex.cc
 X86_SRCS += platform/linux/host_link.cc
 X86_SRCS += platform/linux/platform_log.cc
 X86_SRCS += platform/linux/system_time.cc
@@ -71,6 +82,9 @@ X86_SRCS += platform/shared/chre_api_version.cc
 X86_SRCS += platform/shared/chre_api_wifi.cc
 X86_SRCS += platform/shared/chre_api_wwan.cc
 X86_SRCS += platform/shared/memory.cc
+X86_SRCS += platform/shared/nanoapp_binary_cache.cc
+X86_SRCS += platform/shared/nanoapp_dso_util.cc
+X86_SRCS += platform/shared/nanoapp_load_manager.cc
 X86_SRCS += platform/shared/pal_gnss_stub.cc
 X86_SRCS += platform/shared/pal_wifi_stub.cc
 X86_SRCS += platform/shared/pal_wwan_stub.cc
@@ -89,5 +103,14 @@ GOOGLETEST_CFLAGS += -Iplatform/slpi/include
 # GoogleTest Source Files ######################################################
 
 GOOGLETEST_SRCS += platform/linux/assert.cc
+GOOGLETEST_SRCS += platform/linux/tests/atomic_test.cc
+GOOGLETEST_SRCS += platform/linux/tests/futex_mutex_test.cc
+GOOGLETEST_SRCS += platform/shared/tests/nanoapp_binary_cache_test.cc
+GOOGLETEST_SRCS += platform/shared/tests/nanoapp_load_manager_test.cc
 GOOGLETEST_SRCS += platform/slpi/platform_sensor_util.cc
 GOOGLETEST_SRCS += platform/slpi/tests/platform_sensor_util_test.cc
+
+# Benchmark Source Files #######################################################
+
+BENCHMARK_SRCS += platform/linux/benchmarks/mutex_benchmark.cc
+BENCHMARK_SRCS += platform/linux/benchmarks/nanoapp_load_benchmark.cc
@@ -24,6 +24,7 @@
 #include "chre/core/host_comms_manager.h"
 #include "chre/platform/fatal_error.h"
 #include "chre/platform/log.h"
+#include "chre/platform/shared/event_batch.h"
 #include "chre/util/macros.h"
 
 using chre::EventLoop;
@@ -67,6 +68,33 @@ DLL_EXPORT bool chreSendEvent(uint16_t eventType, void *eventData,
   return success;
 }
 
+DLL_EXPORT bool chreSendEvents(const struct chreEventBatchEntry *events,
+                               uint32_t eventCount,
+                               uint32_t targetInstanceId) {
+  Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
+
+  // Prevent an app that is in the process of being unloaded from generating new
+  // events
+  bool success = false;
+  EventLoop& eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+  if (eventLoop.currentNanoappIsStopping()) {
+    LOGW("Rejecting events from app instance %" PRIu32 " because it's "
+         "stopping", nanoapp->getInstanceId());
+  } else {
+    success = eventLoop.postEvents(events, eventCount,
+                                   nanoapp->getInstanceId(), targetInstanceId);
+  }
+
+  if (!success) {
+    for (uint32_t i = 0; i < eventCount; i++) {
+      if (events[i].freeCallback != nullptr) {
+        events[i].freeCallback(events[i].eventType, events[i].eventData);
+      }
+    }
+  }
+  return success;
+}
+
 DLL_EXPORT bool chreSendMessageToHost(void *message, uint32_t messageSize,
                                       uint32_t messageType,
                                       chreMessageFreeFunction *freeCallback) {
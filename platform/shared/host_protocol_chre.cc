@@ -70,6 +70,47 @@ bool HostProtocolChre::decodeMessageFromHost(const void *message,
         break;
       }
 
+      case fbs::ChreMessage::LoadNanoappBeginRequest: {
+        const auto *request = static_cast<const fbs::LoadNanoappBeginRequest *>(
+            container->message());
+        HostMessageHandlers::handleLoadNanoappBeginRequest(
+            hostClientId, request->transaction_id(), request->app_id(),
+            request->app_version(), request->target_api_version(),
+            request->total_app_size());
+        break;
+      }
+
+      case fbs::ChreMessage::LoadNanoappFragment: {
+        const auto *fragment = static_cast<const fbs::LoadNanoappFragment *>(
+            container->message());
+        // Required field; verifier ensures that this is not null
+        const flatbuffers::Vector<uint8_t> *data = fragment->data();
+        HostMessageHandlers::handleLoadNanoappFragment(
+            hostClientId, fragment->transaction_id(), fragment->offset(),
+            data->data(), data->size());
+        break;
+      }
+
+      case fbs::ChreMessage::LoadNanoappCommitRequest: {
+        const auto *request =
+            static_cast<const fbs::LoadNanoappCommitRequest *>(
+                container->message());
+        HostMessageHandlers::handleLoadNanoappCommitRequest(
+            hostClientId, request->transaction_id(), request->crc32());
+        break;
+      }
+
+      case fbs::ChreMessage::LoadCachedNanoappRequest: {
+        const auto *request =
+            static_cast<const fbs::LoadCachedNanoappRequest *>(
+                container->message());
+        HostMessageHandlers::handleLoadCachedNanoappRequest(
+            hostClientId, request->transaction_id(), request->app_id(),
+            request->app_version(), request->target_api_version(),
+            request->crc32());
+        break;
+      }
+
       case fbs::ChreMessage::UnloadNanoappRequest: {
         const auto *request = static_cast<const fbs::UnloadNanoappRequest *>(
             container->message());
@@ -82,7 +123,16 @@ bool HostProtocolChre::decodeMessageFromHost(const void *message,
       case fbs::ChreMessage::TimeSyncMessage: {
         const auto *request = static_cast<const fbs::TimeSyncMessage *>(
             container->message());
-        HostMessageHandlers::handleTimeSyncMessage(request->offset());
+        HostMessageHandlers::handleTimeSyncMessage(request->offset(),
+                                                   request->uncertainty());
+        break;
+      }
+
+      case fbs::ChreMessage::TimeSyncProbe: {
+        const auto *probe = static_cast<const fbs::TimeSyncProbe *>(
+            container->message());
+        HostMessageHandlers::handleTimeSyncProbe(probe->sequence(),
+                                                 probe->host_send_time());
         break;
       }
 
@@ -105,7 +155,8 @@ void HostProtocolChre::encodeHubInfoResponse(
     const char *toolchain, uint32_t legacyPlatformVersion,
     uint32_t legacyToolchainVersion, float peakMips, float stoppedPower,
     float sleepPower, float peakPower, uint32_t maxMessageLen,
-    uint64_t platformId, uint32_t version, uint16_t hostClientId) {
+    uint64_t platformId, uint32_t version, bool supportsCachedLoad,
+    uint16_t hostClientId) {
   auto nameOffset = addStringAsByteVector(builder, name);
   auto vendorOffset = addStringAsByteVector(builder, vendor);
   auto toolchainOffset = addStringAsByteVector(builder, toolchain);
@@ -113,7 +164,7 @@ void HostProtocolChre::encodeHubInfoResponse(
   auto response = fbs::CreateHubInfoResponse(
       builder, nameOffset, vendorOffset, toolchainOffset, legacyPlatformVersion,
       legacyToolchainVersion, peakMips, stoppedPower, sleepPower, peakPower,
-      maxMessageLen, platformId, version);
+      maxMessageLen, platformId, version, supportsCachedLoad);
   finalize(builder, fbs::ChreMessage::HubInfoResponse, response.Union(),
            hostClientId);
 }
@@ -142,9 +193,9 @@ void HostProtocolChre::finishNanoappListResponse(
 
 void HostProtocolChre::encodeLoadNanoappResponse(
     flatbuffers::FlatBufferBuilder& builder, uint16_t hostClientId,
-    uint32_t transactionId, bool success) {
+    uint32_t transactionId, bool success, bool cacheMiss) {
   auto response = fbs::CreateLoadNanoappResponse(builder, transactionId,
-                                                 success);
+                                                 success, cacheMiss);
   finalize(builder, fbs::ChreMessage::LoadNanoappResponse, response.Union(),
            hostClientId);
 }
@@ -191,4 +242,21 @@ void HostProtocolChre::encodeTimeSyncRequest(
   finalize(builder, fbs::ChreMessage::TimeSyncRequest, request.Union());
 }
 
+void HostProtocolChre::encodeTimeSyncProbeResponse(
+    flatbuffers::FlatBufferBuilder& builder, uint32_t sequence,
+    int64_t hostSendTime, int64_t chreReceiveTime, int64_t chreSendTime) {
+  auto response = fbs::CreateTimeSyncProbeResponse(
+      builder, sequence, hostSendTime, chreReceiveTime, chreSendTime);
+  finalize(builder, fbs::ChreMessage::TimeSyncProbeResponse, response.Union());
+}
+
+void HostProtocolChre::encodeNanoappStatusChange(
+    flatbuffers::FlatBufferBuilder& builder, uint64_t appId,
+    uint32_t appVersion, uint32_t instanceId, bool started) {
+  auto notification = fbs::CreateNanoappStatusChange(
+      builder, appId, appVersion, instanceId, started);
+  finalize(builder, fbs::ChreMessage::NanoappStatusChange,
+           notification.Union());
+}
+
 }  // namespace chre
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_SHARED_EVENT_BATCH_H_
+#define CHRE_PLATFORM_SHARED_EVENT_BATCH_H_
+
+/**
+ * @file
+ * Batched event sending, an extension to the CHRE API provided by this
+ * implementation. It is not part of the CHRE API specification, so nanoapps
+ * that include this header and call chreSendEvents() will not load on
+ * implementations that lack it.
+ *
+ * This header file must retain compatibility with C.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "chre/event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The maximum number of events that can be sent in one call to
+ * chreSendEvents().
+ */
+#define CHRE_SEND_EVENTS_MAX_COUNT  UINT32_C(32)
+
+/**
+ * One of the events sent by chreSendEvents().  The fields have the same
+ * meaning as the corresponding arguments to chreSendEvent().
+ *
+ * @see chreSendEvents
+ */
+struct chreEventBatchEntry {
+    uint16_t eventType;
+    void *eventData;
+    chreEventCompleteFunction *freeCallback;
+};
+
+/**
+ * Enqueue a batch of events to be sent to another nanoapp (or this one).
+ * This is equivalent to calling chreSendEvent() for each entry in order,
+ * except that either all of the events are enqueued or none of them are, and
+ * it is cheaper than separate calls.
+ *
+ * @param events  The events to send, which are delivered in array order.
+ *     The array itself is not retained after the call.
+ * @param eventCount  The number of entries in 'events', which must be no
+ *     greater than CHRE_SEND_EVENTS_MAX_COUNT.
+ * @param targetInstanceId  The ID of the instance we're delivering these
+ *     events to.  Note that this is allowed to be our own instance.
+ * @returns true if all of the events were enqueued, false if none were.
+ *     As with chreSendEvent(), when this returns 'false' the 'freeCallback'
+ *     of every entry will be invoked, if non-NULL, possibly from within
+ *     chreSendEvents().
+ *
+ * @see chreSendEvent
+ */
+bool chreSendEvents(const struct chreEventBatchEntry *events,
+                    uint32_t eventCount, uint32_t targetInstanceId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // CHRE_PLATFORM_SHARED_EVENT_BATCH_H_
@@ -41,6 +41,22 @@ struct DebugDumpResponse;
 
 struct TimeSyncRequest;
 
+struct LoadNanoappBeginRequest;
+
+struct LoadNanoappFragment;
+
+struct LoadNanoappCommitRequest;
+
+struct LoadCachedNanoappRequest;
+
+struct MessageSubscriptionRequest;
+
+struct NanoappStatusChange;
+
+struct TimeSyncProbe;
+
+struct TimeSyncProbeResponse;
+
 struct HostAddress;
 
 struct MessageContainer;
@@ -64,8 +80,16 @@ enum class ChreMessage : uint8_t {
   DebugDumpData = 13,
   DebugDumpResponse = 14,
   TimeSyncRequest = 15,
+  LoadNanoappBeginRequest = 16,
+  LoadNanoappFragment = 17,
+  LoadNanoappCommitRequest = 18,
+  LoadCachedNanoappRequest = 19,
+  MessageSubscriptionRequest = 20,
+  NanoappStatusChange = 21,
+  TimeSyncProbe = 22,
+  TimeSyncProbeResponse = 23,
   MIN = NONE,
-  MAX = TimeSyncRequest
+  MAX = TimeSyncProbeResponse
 };
 
 inline const char **EnumNamesChreMessage() {
@@ -86,6 +110,14 @@ inline const char **EnumNamesChreMessage() {
     "DebugDumpData",
     "DebugDumpResponse",
     "TimeSyncRequest",
+    "LoadNanoappBeginRequest",
+    "LoadNanoappFragment",
+    "LoadNanoappCommitRequest",
+    "LoadCachedNanoappRequest",
+    "MessageSubscriptionRequest",
+    "NanoappStatusChange",
+    "TimeSyncProbe",
+    "TimeSyncProbeResponse",
     nullptr
   };
   return names;
@@ -160,6 +192,38 @@ template<> struct ChreMessageTraits<TimeSyncRequest> {
   static const ChreMessage enum_value = ChreMessage::TimeSyncRequest;
 };
 
+template<> struct ChreMessageTraits<LoadNanoappBeginRequest> {
+  static const ChreMessage enum_value = ChreMessage::LoadNanoappBeginRequest;
+};
+
+template<> struct ChreMessageTraits<LoadNanoappFragment> {
+  static const ChreMessage enum_value = ChreMessage::LoadNanoappFragment;
+};
+
+template<> struct ChreMessageTraits<LoadNanoappCommitRequest> {
+  static const ChreMessage enum_value = ChreMessage::LoadNanoappCommitRequest;
+};
+
+template<> struct ChreMessageTraits<LoadCachedNanoappRequest> {
+  static const ChreMessage enum_value = ChreMessage::LoadCachedNanoappRequest;
+};
+
+template<> struct ChreMessageTraits<MessageSubscriptionRequest> {
+  static const ChreMessage enum_value = ChreMessage::MessageSubscriptionRequest;
+};
+
+template<> struct ChreMessageTraits<NanoappStatusChange> {
+  static const ChreMessage enum_value = ChreMessage::NanoappStatusChange;
+};
+
+template<> struct ChreMessageTraits<TimeSyncProbe> {
+  static const ChreMessage enum_value = ChreMessage::TimeSyncProbe;
+};
+
+template<> struct ChreMessageTraits<TimeSyncProbeResponse> {
+  static const ChreMessage enum_value = ChreMessage::TimeSyncProbeResponse;
+};
+
 bool VerifyChreMessage(flatbuffers::Verifier &verifier, const void *obj, ChreMessage type);
 bool VerifyChreMessageVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
 
@@ -315,7 +379,8 @@ struct HubInfoResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_PEAK_POWER = 20,
     VT_MAX_MSG_LEN = 22,
     VT_PLATFORM_ID = 24,
-    VT_CHRE_PLATFORM_VERSION = 26
+    VT_CHRE_PLATFORM_VERSION = 26,
+    VT_SUPPORTS_CACHED_LOAD = 28
   };
   /// The name of the hub. Nominally a UTF-8 string, but note that we're not
   /// using the built-in "string" data type from FlatBuffers here, because the
@@ -363,6 +428,11 @@ struct HubInfoResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t chre_platform_version() const {
     return GetField<uint32_t>(VT_CHRE_PLATFORM_VERSION, 0);
   }
+  /// Whether CHRE handles LoadCachedNanoappRequest. Hosts must not send that
+  /// request unless this is set, as older implementations drop it silently.
+  bool supports_cached_load() const {
+    return GetField<uint8_t>(VT_SUPPORTS_CACHED_LOAD, 0) != 0;
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<flatbuffers::uoffset_t>(verifier, VT_NAME) &&
@@ -380,6 +450,7 @@ struct HubInfoResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint32_t>(verifier, VT_MAX_MSG_LEN) &&
            VerifyField<uint64_t>(verifier, VT_PLATFORM_ID) &&
            VerifyField<uint32_t>(verifier, VT_CHRE_PLATFORM_VERSION) &&
+           VerifyField<uint8_t>(verifier, VT_SUPPORTS_CACHED_LOAD) &&
            verifier.EndTable();
   }
 };
@@ -423,13 +494,16 @@ struct HubInfoResponseBuilder {
   void add_chre_platform_version(uint32_t chre_platform_version) {
     fbb_.AddElement<uint32_t>(HubInfoResponse::VT_CHRE_PLATFORM_VERSION, chre_platform_version, 0);
   }
+  void add_supports_cached_load(bool supports_cached_load) {
+    fbb_.AddElement<uint8_t>(HubInfoResponse::VT_SUPPORTS_CACHED_LOAD, static_cast<uint8_t>(supports_cached_load), 0);
+  }
   HubInfoResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   HubInfoResponseBuilder &operator=(const HubInfoResponseBuilder &);
   flatbuffers::Offset<HubInfoResponse> Finish() {
-    const auto end = fbb_.EndTable(start_, 12);
+    const auto end = fbb_.EndTable(start_, 13);
     auto o = flatbuffers::Offset<HubInfoResponse>(end);
     return o;
   }
@@ -448,7 +522,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(
     float peak_power = 0.0f,
     uint32_t max_msg_len = 0,
     uint64_t platform_id = 0,
-    uint32_t chre_platform_version = 0) {
+    uint32_t chre_platform_version = 0,
+    bool supports_cached_load = false) {
   HubInfoResponseBuilder builder_(_fbb);
   builder_.add_platform_id(platform_id);
   builder_.add_chre_platform_version(chre_platform_version);
@@ -462,6 +537,7 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponse(
   builder_.add_toolchain(toolchain);
   builder_.add_vendor(vendor);
   builder_.add_name(name);
+  builder_.add_supports_cached_load(supports_cached_load);
   return builder_.Finish();
 }
 
@@ -478,7 +554,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponseDirect(
     float peak_power = 0.0f,
     uint32_t max_msg_len = 0,
     uint64_t platform_id = 0,
-    uint32_t chre_platform_version = 0) {
+    uint32_t chre_platform_version = 0,
+    bool supports_cached_load = false) {
   return chre::fbs::CreateHubInfoResponse(
       _fbb,
       name ? _fbb.CreateVector<int8_t>(*name) : 0,
@@ -492,7 +569,8 @@ inline flatbuffers::Offset<HubInfoResponse> CreateHubInfoResponseDirect(
       peak_power,
       max_msg_len,
       platform_id,
-      chre_platform_version);
+      chre_platform_version,
+      supports_cached_load);
 }
 
 struct NanoappListRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -749,7 +827,8 @@ inline flatbuffers::Offset<LoadNanoappRequest> CreateLoadNanoappRequestDirect(
 struct LoadNanoappResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum {
     VT_TRANSACTION_ID = 4,
-    VT_SUCCESS = 6
+    VT_SUCCESS = 6,
+    VT_CACHE_MISS = 8
   };
   uint32_t transaction_id() const {
     return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
@@ -757,10 +836,17 @@ struct LoadNanoappResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   bool success() const {
     return GetField<uint8_t>(VT_SUCCESS, 0) != 0;
   }
+  /// Set to true if the request was a LoadCachedNanoappRequest and CHRE does
+  /// not hold a matching binary in its cache; the host should retry by
+  /// transferring the binary
+  bool cache_miss() const {
+    return GetField<uint8_t>(VT_CACHE_MISS, 0) != 0;
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
            VerifyField<uint8_t>(verifier, VT_SUCCESS) &&
+           VerifyField<uint8_t>(verifier, VT_CACHE_MISS) &&
            verifier.EndTable();
   }
 };
@@ -774,13 +860,16 @@ struct LoadNanoappResponseBuilder {
   void add_success(bool success) {
     fbb_.AddElement<uint8_t>(LoadNanoappResponse::VT_SUCCESS, static_cast<uint8_t>(success), 0);
   }
+  void add_cache_miss(bool cache_miss) {
+    fbb_.AddElement<uint8_t>(LoadNanoappResponse::VT_CACHE_MISS, static_cast<uint8_t>(cache_miss), 0);
+  }
   LoadNanoappResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   LoadNanoappResponseBuilder &operator=(const LoadNanoappResponseBuilder &);
   flatbuffers::Offset<LoadNanoappResponse> Finish() {
-    const auto end = fbb_.EndTable(start_, 2);
+    const auto end = fbb_.EndTable(start_, 3);
     auto o = flatbuffers::Offset<LoadNanoappResponse>(end);
     return o;
   }
@@ -789,9 +878,11 @@ struct LoadNanoappResponseBuilder {
 inline flatbuffers::Offset<LoadNanoappResponse> CreateLoadNanoappResponse(
     flatbuffers::FlatBufferBuilder &_fbb,
     uint32_t transaction_id = 0,
-    bool success = false) {
+    bool success = false,
+    bool cache_miss = false) {
   LoadNanoappResponseBuilder builder_(_fbb);
   builder_.add_transaction_id(transaction_id);
+  builder_.add_cache_miss(cache_miss);
   builder_.add_success(success);
   return builder_.Finish();
 }
@@ -974,15 +1065,21 @@ inline flatbuffers::Offset<LogMessage> CreateLogMessageDirect(
 /// Represents a message sent to CHRE to indicate AP timestamp for time sync
 struct TimeSyncMessage FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum {
-    VT_OFFSET = 4
+    VT_OFFSET = 4,
+    VT_UNCERTAINTY = 6
   };
   /// Offset between AP and CHRE timestamp
   int64_t offset() const {
     return GetField<int64_t>(VT_OFFSET, 0);
   }
+  /// Maximum error of the offset in nanoseconds, or 0 if unknown
+  int64_t uncertainty() const {
+    return GetField<int64_t>(VT_UNCERTAINTY, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int64_t>(verifier, VT_OFFSET) &&
+           VerifyField<int64_t>(verifier, VT_UNCERTAINTY) &&
            verifier.EndTable();
   }
 };
@@ -993,13 +1090,16 @@ struct TimeSyncMessageBuilder {
   void add_offset(int64_t offset) {
     fbb_.AddElement<int64_t>(TimeSyncMessage::VT_OFFSET, offset, 0);
   }
+  void add_uncertainty(int64_t uncertainty) {
+    fbb_.AddElement<int64_t>(TimeSyncMessage::VT_UNCERTAINTY, uncertainty, 0);
+  }
   TimeSyncMessageBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   TimeSyncMessageBuilder &operator=(const TimeSyncMessageBuilder &);
   flatbuffers::Offset<TimeSyncMessage> Finish() {
-    const auto end = fbb_.EndTable(start_, 1);
+    const auto end = fbb_.EndTable(start_, 2);
     auto o = flatbuffers::Offset<TimeSyncMessage>(end);
     return o;
   }
@@ -1007,8 +1107,10 @@ struct TimeSyncMessageBuilder {
 
 inline flatbuffers::Offset<TimeSyncMessage> CreateTimeSyncMessage(
     flatbuffers::FlatBufferBuilder &_fbb,
-    int64_t offset = 0) {
+    int64_t offset = 0,
+    int64_t uncertainty = 0) {
   TimeSyncMessageBuilder builder_(_fbb);
+  builder_.add_uncertainty(uncertainty);
   builder_.add_offset(offset);
   return builder_.Finish();
 }
@@ -1177,6 +1279,599 @@ inline flatbuffers::Offset<TimeSyncRequest> CreateTimeSyncRequest(
   return builder_.Finish();
 }
 
+/// Starts a fragmented nanoapp load transaction. The binary is delivered in
+/// one or more LoadNanoappFragment messages, followed by a
+/// LoadNanoappCommitRequest. Other messages may be interleaved with the
+/// transfer. The result is reported via LoadNanoappResponse, which may be sent
+/// early if the transaction fails before it is committed.
+struct LoadNanoappBeginRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_APP_ID = 6,
+    VT_APP_VERSION = 8,
+    VT_TARGET_API_VERSION = 10,
+    VT_TOTAL_APP_SIZE = 12
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  uint32_t app_version() const {
+    return GetField<uint32_t>(VT_APP_VERSION, 0);
+  }
+  uint32_t target_api_version() const {
+    return GetField<uint32_t>(VT_TARGET_API_VERSION, 0);
+  }
+  /// Total size of the app binary, in bytes
+  uint32_t total_app_size() const {
+    return GetField<uint32_t>(VT_TOTAL_APP_SIZE, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_APP_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_TARGET_API_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_TOTAL_APP_SIZE) &&
+           verifier.EndTable();
+  }
+};
+
+struct LoadNanoappBeginRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(LoadNanoappBeginRequest::VT_APP_ID, app_id, 0);
+  }
+  void add_app_version(uint32_t app_version) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_APP_VERSION, app_version, 0);
+  }
+  void add_target_api_version(uint32_t target_api_version) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_TARGET_API_VERSION, target_api_version, 0);
+  }
+  void add_total_app_size(uint32_t total_app_size) {
+    fbb_.AddElement<uint32_t>(LoadNanoappBeginRequest::VT_TOTAL_APP_SIZE, total_app_size, 0);
+  }
+  LoadNanoappBeginRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadNanoappBeginRequestBuilder &operator=(const LoadNanoappBeginRequestBuilder &);
+  flatbuffers::Offset<LoadNanoappBeginRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 5);
+    auto o = flatbuffers::Offset<LoadNanoappBeginRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LoadNanoappBeginRequest> CreateLoadNanoappBeginRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint64_t app_id = 0,
+    uint32_t app_version = 0,
+    uint32_t target_api_version = 0,
+    uint32_t total_app_size = 0) {
+  LoadNanoappBeginRequestBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_total_app_size(total_app_size);
+  builder_.add_target_api_version(target_api_version);
+  builder_.add_app_version(app_version);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
+}
+
+struct LoadNanoappFragment FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_OFFSET = 6,
+    VT_DATA = 8
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  /// Byte offset of this fragment within the app binary. Fragments must be
+  /// sent in order, so this is always equal to the sum of the sizes of all
+  /// previous fragments in the transaction.
+  uint32_t offset() const {
+    return GetField<uint32_t>(VT_OFFSET, 0);
+  }
+  const flatbuffers::Vector<uint8_t> *data() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint32_t>(verifier, VT_OFFSET) &&
+           VerifyFieldRequired<flatbuffers::uoffset_t>(verifier, VT_DATA) &&
+           verifier.Verify(data()) &&
+           verifier.EndTable();
+  }
+};
+
+struct LoadNanoappFragmentBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadNanoappFragment::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_offset(uint32_t offset) {
+    fbb_.AddElement<uint32_t>(LoadNanoappFragment::VT_OFFSET, offset, 0);
+  }
+  void add_data(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data) {
+    fbb_.AddOffset(LoadNanoappFragment::VT_DATA, data);
+  }
+  LoadNanoappFragmentBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadNanoappFragmentBuilder &operator=(const LoadNanoappFragmentBuilder &);
+  flatbuffers::Offset<LoadNanoappFragment> Finish() {
+    const auto end = fbb_.EndTable(start_, 3);
+    auto o = flatbuffers::Offset<LoadNanoappFragment>(end);
+    fbb_.Required(o, LoadNanoappFragment::VT_DATA);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LoadNanoappFragment> CreateLoadNanoappFragment(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint32_t offset = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0) {
+  LoadNanoappFragmentBuilder builder_(_fbb);
+  builder_.add_data(data);
+  builder_.add_offset(offset);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<LoadNanoappFragment> CreateLoadNanoappFragmentDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint32_t offset = 0,
+    const std::vector<uint8_t> *data = nullptr) {
+  return chre::fbs::CreateLoadNanoappFragment(
+      _fbb,
+      transaction_id,
+      offset,
+      data ? _fbb.CreateVector<uint8_t>(*data) : 0);
+}
+
+struct LoadNanoappCommitRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_CRC32 = 6
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  /// CRC-32 (as used by IEEE 802.3) of the complete app binary
+  uint32_t crc32() const {
+    return GetField<uint32_t>(VT_CRC32, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint32_t>(verifier, VT_CRC32) &&
+           verifier.EndTable();
+  }
+};
+
+struct LoadNanoappCommitRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadNanoappCommitRequest::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_crc32(uint32_t crc32) {
+    fbb_.AddElement<uint32_t>(LoadNanoappCommitRequest::VT_CRC32, crc32, 0);
+  }
+  LoadNanoappCommitRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadNanoappCommitRequestBuilder &operator=(const LoadNanoappCommitRequestBuilder &);
+  flatbuffers::Offset<LoadNanoappCommitRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 2);
+    auto o = flatbuffers::Offset<LoadNanoappCommitRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LoadNanoappCommitRequest> CreateLoadNanoappCommitRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint32_t crc32 = 0) {
+  LoadNanoappCommitRequestBuilder builder_(_fbb);
+  builder_.add_crc32(crc32);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
+}
+
+/// Requests that CHRE load a nanoapp from a binary it has cached from a previous
+/// load, avoiding the need to transfer it again. The binary is identified by
+/// its app ID, version and CRC-32, as supplied when it was originally loaded
+/// via LoadNanoappCommitRequest. The result is reported via
+/// LoadNanoappResponse.
+struct LoadCachedNanoappRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_TRANSACTION_ID = 4,
+    VT_APP_ID = 6,
+    VT_APP_VERSION = 8,
+    VT_TARGET_API_VERSION = 10,
+    VT_CRC32 = 12
+  };
+  uint32_t transaction_id() const {
+    return GetField<uint32_t>(VT_TRANSACTION_ID, 0);
+  }
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  uint32_t app_version() const {
+    return GetField<uint32_t>(VT_APP_VERSION, 0);
+  }
+  uint32_t target_api_version() const {
+    return GetField<uint32_t>(VT_TARGET_API_VERSION, 0);
+  }
+  /// CRC-32 (as used by IEEE 802.3) of the complete app binary
+  uint32_t crc32() const {
+    return GetField<uint32_t>(VT_CRC32, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_TRANSACTION_ID) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_APP_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_TARGET_API_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_CRC32) &&
+           verifier.EndTable();
+  }
+};
+
+struct LoadCachedNanoappRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_transaction_id(uint32_t transaction_id) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_TRANSACTION_ID, transaction_id, 0);
+  }
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(LoadCachedNanoappRequest::VT_APP_ID, app_id, 0);
+  }
+  void add_app_version(uint32_t app_version) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_APP_VERSION, app_version, 0);
+  }
+  void add_target_api_version(uint32_t target_api_version) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_TARGET_API_VERSION, target_api_version, 0);
+  }
+  void add_crc32(uint32_t crc32) {
+    fbb_.AddElement<uint32_t>(LoadCachedNanoappRequest::VT_CRC32, crc32, 0);
+  }
+  LoadCachedNanoappRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LoadCachedNanoappRequestBuilder &operator=(const LoadCachedNanoappRequestBuilder &);
+  flatbuffers::Offset<LoadCachedNanoappRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 5);
+    auto o = flatbuffers::Offset<LoadCachedNanoappRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LoadCachedNanoappRequest> CreateLoadCachedNanoappRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t transaction_id = 0,
+    uint64_t app_id = 0,
+    uint32_t app_version = 0,
+    uint32_t target_api_version = 0,
+    uint32_t crc32 = 0) {
+  LoadCachedNanoappRequestBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_crc32(crc32);
+  builder_.add_target_api_version(target_api_version);
+  builder_.add_app_version(app_version);
+  builder_.add_transaction_id(transaction_id);
+  return builder_.Finish();
+}
+
+/// Sent by a host client to select which broadcast NanoappMessages (those with
+/// an unspecified host endpoint) it receives. This message is handled by the
+/// host daemon and is not delivered to CHRE. A client that holds no
+/// subscriptions receives all broadcasts; once it has added a subscription, it
+/// only receives broadcasts that match at least one of its subscriptions.
+/// Messages addressed to a specific client are always delivered.
+struct MessageSubscriptionRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_SUBSCRIBE = 4,
+    VT_APP_ID = 6,
+    VT_MATCH_ANY_APP_ID = 8,
+    VT_MESSAGE_TYPE = 10,
+    VT_MATCH_ANY_MESSAGE_TYPE = 12
+  };
+  /// true to add this subscription, false to remove a previously added one
+  /// with identical fields
+  bool subscribe() const {
+    return GetField<uint8_t>(VT_SUBSCRIBE, 1) != 0;
+  }
+  /// The app ID of the nanoapp whose messages are wanted. Ignored if
+  /// match_any_app_id is set.
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  bool match_any_app_id() const {
+    return GetField<uint8_t>(VT_MATCH_ANY_APP_ID, 0) != 0;
+  }
+  /// The message type wanted. Ignored if match_any_message_type is set.
+  uint32_t message_type() const {
+    return GetField<uint32_t>(VT_MESSAGE_TYPE, 0);
+  }
+  bool match_any_message_type() const {
+    return GetField<uint8_t>(VT_MATCH_ANY_MESSAGE_TYPE, 0) != 0;
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_SUBSCRIBE) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint8_t>(verifier, VT_MATCH_ANY_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_MESSAGE_TYPE) &&
+           VerifyField<uint8_t>(verifier, VT_MATCH_ANY_MESSAGE_TYPE) &&
+           verifier.EndTable();
+  }
+};
+
+struct MessageSubscriptionRequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_subscribe(bool subscribe) {
+    fbb_.AddElement<uint8_t>(MessageSubscriptionRequest::VT_SUBSCRIBE, static_cast<uint8_t>(subscribe), 1);
+  }
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(MessageSubscriptionRequest::VT_APP_ID, app_id, 0);
+  }
+  void add_match_any_app_id(bool match_any_app_id) {
+    fbb_.AddElement<uint8_t>(MessageSubscriptionRequest::VT_MATCH_ANY_APP_ID, static_cast<uint8_t>(match_any_app_id), 0);
+  }
+  void add_message_type(uint32_t message_type) {
+    fbb_.AddElement<uint32_t>(MessageSubscriptionRequest::VT_MESSAGE_TYPE, message_type, 0);
+  }
+  void add_match_any_message_type(bool match_any_message_type) {
+    fbb_.AddElement<uint8_t>(MessageSubscriptionRequest::VT_MATCH_ANY_MESSAGE_TYPE, static_cast<uint8_t>(match_any_message_type), 0);
+  }
+  MessageSubscriptionRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MessageSubscriptionRequestBuilder &operator=(const MessageSubscriptionRequestBuilder &);
+  flatbuffers::Offset<MessageSubscriptionRequest> Finish() {
+    const auto end = fbb_.EndTable(start_, 5);
+    auto o = flatbuffers::Offset<MessageSubscriptionRequest>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MessageSubscriptionRequest> CreateMessageSubscriptionRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    bool subscribe = true,
+    uint64_t app_id = 0,
+    bool match_any_app_id = false,
+    uint32_t message_type = 0,
+    bool match_any_message_type = false) {
+  MessageSubscriptionRequestBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_message_type(message_type);
+  builder_.add_match_any_message_type(match_any_message_type);
+  builder_.add_match_any_app_id(match_any_app_id);
+  builder_.add_subscribe(subscribe);
+  return builder_.Finish();
+}
+
+/// Sent by CHRE whenever a nanoapp starts or stops, including loads and unloads
+/// not requested by the host. Consumed by the host daemon to keep its cached
+/// NanoappListResponse up to date; not delivered to clients.
+struct NanoappStatusChange FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_APP_ID = 4,
+    VT_APP_VERSION = 6,
+    VT_INSTANCE_ID = 8,
+    VT_STARTED = 10
+  };
+  uint64_t app_id() const {
+    return GetField<uint64_t>(VT_APP_ID, 0);
+  }
+  uint32_t app_version() const {
+    return GetField<uint32_t>(VT_APP_VERSION, 0);
+  }
+  uint32_t instance_id() const {
+    return GetField<uint32_t>(VT_INSTANCE_ID, 0);
+  }
+  /// true if the nanoapp started, false if it stopped
+  bool started() const {
+    return GetField<uint8_t>(VT_STARTED, 0) != 0;
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint64_t>(verifier, VT_APP_ID) &&
+           VerifyField<uint32_t>(verifier, VT_APP_VERSION) &&
+           VerifyField<uint32_t>(verifier, VT_INSTANCE_ID) &&
+           VerifyField<uint8_t>(verifier, VT_STARTED) &&
+           verifier.EndTable();
+  }
+};
+
+struct NanoappStatusChangeBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_app_id(uint64_t app_id) {
+    fbb_.AddElement<uint64_t>(NanoappStatusChange::VT_APP_ID, app_id, 0);
+  }
+  void add_app_version(uint32_t app_version) {
+    fbb_.AddElement<uint32_t>(NanoappStatusChange::VT_APP_VERSION, app_version, 0);
+  }
+  void add_instance_id(uint32_t instance_id) {
+    fbb_.AddElement<uint32_t>(NanoappStatusChange::VT_INSTANCE_ID, instance_id, 0);
+  }
+  void add_started(bool started) {
+    fbb_.AddElement<uint8_t>(NanoappStatusChange::VT_STARTED, static_cast<uint8_t>(started), 0);
+  }
+  NanoappStatusChangeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  NanoappStatusChangeBuilder &operator=(const NanoappStatusChangeBuilder &);
+  flatbuffers::Offset<NanoappStatusChange> Finish() {
+    const auto end = fbb_.EndTable(start_, 4);
+    auto o = flatbuffers::Offset<NanoappStatusChange>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<NanoappStatusChange> CreateNanoappStatusChange(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t app_id = 0,
+    uint32_t app_version = 0,
+    uint32_t instance_id = 0,
+    bool started = false) {
+  NanoappStatusChangeBuilder builder_(_fbb);
+  builder_.add_app_id(app_id);
+  builder_.add_instance_id(instance_id);
+  builder_.add_app_version(app_version);
+  builder_.add_started(started);
+  return builder_.Finish();
+}
+
+/// Sent by the host daemon to measure the offset between the AP and CHRE
+/// clocks. CHRE replies with a TimeSyncProbeResponse, and the daemon sends a
+/// TimeSyncMessage once it has collected enough probes.
+struct TimeSyncProbe FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_SEQUENCE = 4,
+    VT_HOST_SEND_TIME = 6
+  };
+  /// Identifies the probe within the current exchange
+  uint32_t sequence() const {
+    return GetField<uint32_t>(VT_SEQUENCE, 0);
+  }
+  /// AP time the probe was sent, in nanoseconds
+  int64_t host_send_time() const {
+    return GetField<int64_t>(VT_HOST_SEND_TIME, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_SEQUENCE) &&
+           VerifyField<int64_t>(verifier, VT_HOST_SEND_TIME) &&
+           verifier.EndTable();
+  }
+};
+
+struct TimeSyncProbeBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_sequence(uint32_t sequence) {
+    fbb_.AddElement<uint32_t>(TimeSyncProbe::VT_SEQUENCE, sequence, 0);
+  }
+  void add_host_send_time(int64_t host_send_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbe::VT_HOST_SEND_TIME, host_send_time, 0);
+  }
+  TimeSyncProbeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  TimeSyncProbeBuilder &operator=(const TimeSyncProbeBuilder &);
+  flatbuffers::Offset<TimeSyncProbe> Finish() {
+    const auto end = fbb_.EndTable(start_, 2);
+    auto o = flatbuffers::Offset<TimeSyncProbe>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<TimeSyncProbe> CreateTimeSyncProbe(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t sequence = 0,
+    int64_t host_send_time = 0) {
+  TimeSyncProbeBuilder builder_(_fbb);
+  builder_.add_host_send_time(host_send_time);
+  builder_.add_sequence(sequence);
+  return builder_.Finish();
+}
+
+struct TimeSyncProbeResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_SEQUENCE = 4,
+    VT_HOST_SEND_TIME = 6,
+    VT_CHRE_RECEIVE_TIME = 8,
+    VT_CHRE_SEND_TIME = 10
+  };
+  /// Copied from the TimeSyncProbe
+  uint32_t sequence() const {
+    return GetField<uint32_t>(VT_SEQUENCE, 0);
+  }
+  int64_t host_send_time() const {
+    return GetField<int64_t>(VT_HOST_SEND_TIME, 0);
+  }
+  /// CHRE time the probe was received and the response was sent, in
+  /// nanoseconds
+  int64_t chre_receive_time() const {
+    return GetField<int64_t>(VT_CHRE_RECEIVE_TIME, 0);
+  }
+  int64_t chre_send_time() const {
+    return GetField<int64_t>(VT_CHRE_SEND_TIME, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_SEQUENCE) &&
+           VerifyField<int64_t>(verifier, VT_HOST_SEND_TIME) &&
+           VerifyField<int64_t>(verifier, VT_CHRE_RECEIVE_TIME) &&
+           VerifyField<int64_t>(verifier, VT_CHRE_SEND_TIME) &&
+           verifier.EndTable();
+  }
+};
+
+struct TimeSyncProbeResponseBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_sequence(uint32_t sequence) {
+    fbb_.AddElement<uint32_t>(TimeSyncProbeResponse::VT_SEQUENCE, sequence, 0);
+  }
+  void add_host_send_time(int64_t host_send_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbeResponse::VT_HOST_SEND_TIME, host_send_time, 0);
+  }
+  void add_chre_receive_time(int64_t chre_receive_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbeResponse::VT_CHRE_RECEIVE_TIME, chre_receive_time, 0);
+  }
+  void add_chre_send_time(int64_t chre_send_time) {
+    fbb_.AddElement<int64_t>(TimeSyncProbeResponse::VT_CHRE_SEND_TIME, chre_send_time, 0);
+  }
+  TimeSyncProbeResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  TimeSyncProbeResponseBuilder &operator=(const TimeSyncProbeResponseBuilder &);
+  flatbuffers::Offset<TimeSyncProbeResponse> Finish() {
+    const auto end = fbb_.EndTable(start_, 4);
+    auto o = flatbuffers::Offset<TimeSyncProbeResponse>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<TimeSyncProbeResponse> CreateTimeSyncProbeResponse(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t sequence = 0,
+    int64_t host_send_time = 0,
+    int64_t chre_receive_time = 0,
+    int64_t chre_send_time = 0) {
+  TimeSyncProbeResponseBuilder builder_(_fbb);
+  builder_.add_chre_send_time(chre_send_time);
+  builder_.add_chre_receive_time(chre_receive_time);
+  builder_.add_host_send_time(host_send_time);
+  builder_.add_sequence(sequence);
+  return builder_.Finish();
+}
+
 /// The top-level container that encapsulates all possible messages. Note that
 /// per FlatBuffers requirements, we can't use a union as the top-level
 /// structure (root type), so we must wrap it in a table.
@@ -1314,6 +2009,38 @@ inline bool VerifyChreMessage(flatbuffers::Verifier &verifier, const void *obj,
       auto ptr = reinterpret_cast<const TimeSyncRequest *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case ChreMessage::LoadNanoappBeginRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappBeginRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::LoadNanoappFragment: {
+      auto ptr = reinterpret_cast<const LoadNanoappFragment *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::LoadNanoappCommitRequest: {
+      auto ptr = reinterpret_cast<const LoadNanoappCommitRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::LoadCachedNanoappRequest: {
+      auto ptr = reinterpret_cast<const LoadCachedNanoappRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::MessageSubscriptionRequest: {
+      auto ptr = reinterpret_cast<const MessageSubscriptionRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::NanoappStatusChange: {
+      auto ptr = reinterpret_cast<const NanoappStatusChange *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::TimeSyncProbe: {
+      auto ptr = reinterpret_cast<const TimeSyncProbe *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case ChreMessage::TimeSyncProbeResponse: {
+      auto ptr = reinterpret_cast<const TimeSyncProbeResponse *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return false;
   }
 }
@@ -46,11 +46,28 @@ class HostMessageHandlers {
       uint32_t appVersion, uint32_t targetApiVersion, const void *appBinary,
       size_t appBinaryLen);
 
+  static void handleLoadNanoappBeginRequest(
+      uint16_t hostClientId, uint32_t transactionId, uint64_t appId,
+      uint32_t appVersion, uint32_t targetApiVersion, size_t totalAppSize);
+
+  static void handleLoadNanoappFragment(
+      uint16_t hostClientId, uint32_t transactionId, size_t offset,
+      const void *fragment, size_t fragmentLen);
+
+  static void handleLoadNanoappCommitRequest(
+      uint16_t hostClientId, uint32_t transactionId, uint32_t crc32);
+
+  static void handleLoadCachedNanoappRequest(
+      uint16_t hostClientId, uint32_t transactionId, uint64_t appId,
+      uint32_t appVersion, uint32_t targetApiVersion, uint32_t crc32);
+
   static void handleUnloadNanoappRequest(
       uint16_t hostClientId, uint32_t transactionId, uint64_t appId,
       bool allowSystemNanoappUnload);
 
-  static void handleTimeSyncMessage(int64_t offset);
+  static void handleTimeSyncMessage(int64_t offset, int64_t uncertainty);
+
+  static void handleTimeSyncProbe(uint32_t sequence, int64_t hostSendTime);
 
   static void handleDebugDumpRequest(uint16_t hostClientId);
 };
@@ -78,13 +95,16 @@ class HostProtocolChre : public HostProtocolCommon {
    *
    * @param builder A newly constructed FlatBufferBuilder that will be used to
    *        encode the message
+   * @param supportsCachedLoad true if the platform handles
+   *        LoadCachedNanoappRequest
    */
   static void encodeHubInfoResponse(
       flatbuffers::FlatBufferBuilder& builder, const char *name,
       const char *vendor, const char *toolchain, uint32_t legacyPlatformVersion,
       uint32_t legacyToolchainVersion, float peakMips, float stoppedPower,
       float sleepPower, float peakPower, uint32_t maxMessageLen,
-      uint64_t platformId, uint32_t version, uint16_t hostClientId);
+      uint64_t platformId, uint32_t version, bool supportsCachedLoad,
+      uint16_t hostClientId);
 
   /**
    * Supports construction of a NanoappListResponse by adding a single
@@ -126,11 +146,12 @@ class HostProtocolChre : public HostProtocolCommon {
 
   /**
    * Encodes a response to the host communicating the result of dynamically
-   * loading a nanoapp.
+   * loading a nanoapp. cacheMiss is set when a cached load was requested but
+   * the binary is not in the cache.
    */
   static void encodeLoadNanoappResponse(
       flatbuffers::FlatBufferBuilder& builder, uint16_t hostClientId,
-      uint32_t transactionId, bool success);
+      uint32_t transactionId, bool success, bool cacheMiss = false);
 
   /**
    * Encodes a response to the host communicating the result of dynamically
@@ -168,6 +189,21 @@ class HostProtocolChre : public HostProtocolCommon {
    * Encodes a message requesting time sync from host.
    */
   static void encodeTimeSyncRequest(flatbuffers::FlatBufferBuilder& builder);
+
+  /**
+   * Encodes the response to a TimeSyncProbe, copying the sequence number and
+   * host send time from the probe.
+   */
+  static void encodeTimeSyncProbeResponse(
+      flatbuffers::FlatBufferBuilder& builder, uint32_t sequence,
+      int64_t hostSendTime, int64_t chreReceiveTime, int64_t chreSendTime);
+
+  /**
+   * Encodes a NanoappStatusChange notification to the host.
+   */
+  static void encodeNanoappStatusChange(
+      flatbuffers::FlatBufferBuilder& builder, uint64_t appId,
+      uint32_t appVersion, uint32_t instanceId, bool started);
 };
 
 }  // namespace chre
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_SHARED_NANOAPP_BINARY_CACHE_H_
+#define CHRE_PLATFORM_SHARED_NANOAPP_BINARY_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/core/nanoapp.h"
+#include "chre/util/dynamic_vector.h"
+#include "chre/util/non_copyable.h"
+#include "chre/util/unique_ptr.h"
+
+//! The default limit on the total size of binaries retained by
+//! NanoappBinaryCache, in bytes. Cached binaries stay in memory after their
+//! nanoapps are unloaded, so this is kept small.
+#ifndef CHRE_NANOAPP_BINARY_CACHE_SIZE
+#define CHRE_NANOAPP_BINARY_CACHE_SIZE (64 * 1024)
+#endif  // CHRE_NANOAPP_BINARY_CACHE_SIZE
+
+namespace chre {
+
+/**
+ * Retains the binaries of nanoapps that were previously transferred from the
+ * host, opened and passed validation, so that a subsequent load of the same
+ * binary (e.g. after the nanoapp is unloaded and then requested again) can be
+ * satisfied without transferring it again. Binaries are addressed by their
+ * content: the app ID, app version and CRC-32 of the binary must all match.
+ *
+ * The cache shares the binary that the nanoapp was actually loaded from (via
+ * PlatformNanoappBase::shareBinary()) rather than copying it, and a nanoapp
+ * loaded from the cache shares it in the same way.
+ *
+ * The total size of the cached binaries is bounded by the capacity supplied at
+ * construction. When inserting a binary would exceed it, the least recently
+ * used binaries are evicted.
+ *
+ * This class is not thread-safe.
+ */
+class NanoappBinaryCache : public NonCopyable {
+ public:
+  //! The default limit on the total size of cached binaries, in bytes
+  static constexpr size_t kDefaultCapacity = CHRE_NANOAPP_BINARY_CACHE_SIZE;
+
+  /**
+   * @param capacity The maximum total size of cached binaries, in bytes
+   */
+  explicit NanoappBinaryCache(size_t capacity = kDefaultCapacity)
+      : mCapacity(capacity) {}
+
+  /**
+   * @return true if a binary of the given size fits in the cache
+   */
+  bool canCache(size_t binaryLen) const {
+    return (binaryLen > 0 && binaryLen <= mCapacity);
+  }
+
+  /**
+   * Retains a nanoapp's binary, keyed by its app ID and version, replacing
+   * any existing entry with the same key, and evicting least recently used
+   * entries as needed to make room. Only nanoapps that have been opened and
+   * passed validation may be inserted, so that a bad image is never served
+   * from the cache.
+   *
+   * @param nanoapp A nanoapp loaded from a buffer, whose binary is shared
+   *        with the cache
+   * @param crc CRC-32 of the binary
+   *
+   * @return true if the binary was added to the cache
+   */
+  bool insert(const Nanoapp& nanoapp, uint32_t crc);
+
+  /**
+   * @return true if the cache holds a binary matching the given key
+   */
+  bool contains(uint64_t appId, uint32_t appVersion, uint32_t crc) const;
+
+  /**
+   * Loads a cached binary into a Nanoapp via shareBinary(), without copying
+   * it, and marks the binary as most recently used.
+   *
+   * @param appId The ID of the nanoapp to load
+   * @param appVersion The version of the nanoapp to load
+   * @param crc CRC-32 of the binary
+   * @param nanoapp The Nanoapp to load the binary into
+   *
+   * @return true if a matching binary was found and loaded into the Nanoapp
+   */
+  bool loadNanoapp(uint64_t appId, uint32_t appVersion, uint32_t crc,
+                   Nanoapp *nanoapp);
+
+  /**
+   * @return The number of binaries in the cache
+   */
+  size_t getEntryCount() const {
+    return mEntries.size();
+  }
+
+  /**
+   * @return The total size of the binaries in the cache, in bytes
+   */
+  size_t getCachedBytes() const {
+    return mCachedBytes;
+  }
+
+ private:
+  //! A cached nanoapp binary and the key it is addressed by
+  struct Entry {
+    //! Never started; only holds a reference to the binary
+    UniquePtr<Nanoapp> image;
+    size_t binaryLen;
+    uint64_t appId;
+    uint32_t appVersion;
+    uint32_t crc;
+  };
+
+  //! Cached binaries, ordered from least to most recently used
+  DynamicVector<Entry> mEntries;
+
+  //! The maximum value of mCachedBytes
+  const size_t mCapacity;
+
+  //! The sum of binaryLen for all entries
+  size_t mCachedBytes = 0;
+
+  /**
+   * @return The index of the matching entry in mEntries, or mEntries.size() if
+   *         there is none
+   */
+  size_t findEntry(uint64_t appId, uint32_t appVersion, uint32_t crc) const;
+
+  /**
+   * Removes an entry from the cache, freeing its binary.
+   */
+  void removeEntry(size_t index);
+};
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_SHARED_NANOAPP_BINARY_CACHE_H_
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_SHARED_NANOAPP_LOAD_MANAGER_H_
+#define CHRE_PLATFORM_SHARED_NANOAPP_LOAD_MANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/core/nanoapp.h"
+#include "chre/platform/shared/nanoapp_binary_cache.h"
+#include "chre/util/fixed_size_vector.h"
+#include "chre/util/non_copyable.h"
+#include "chre/util/unique_ptr.h"
+
+namespace chre {
+
+/**
+ * Tracks the state of fragmented nanoapp load transactions, in which the host
+ * delivers the app binary as a sequence of fragments rather than in a single
+ * message. Each fragment is copied directly into the storage reserved by the
+ * platform for the nanoapp binary, so the complete binary is never buffered
+ * in a message. Up to kMaxPendingLoads transactions can be in progress at
+ * once, each identified by the host client ID and transaction ID, so the
+ * host can stream several nanoapps concurrently.
+ *
+ * Once a nanoapp received this way has been opened and passed validation, the
+ * platform can retain its binary in a NanoappBinaryCache via cacheNanoapp(),
+ * so the host can later reload the same binary by reference via
+ * loadFromCache() rather than transferring it again. The cache shares the
+ * binary the nanoapp was loaded from, so no additional copy is made.
+ *
+ * This class is not thread-safe, and is expected to be used only from the
+ * context that receives messages from the host.
+ */
+class NanoappLoadManager : public NonCopyable {
+ public:
+  //! The maximum number of load transactions that can be in progress at once
+  static constexpr size_t kMaxPendingLoads = 4;
+
+  /**
+   * @return true if a load transaction is in progress for the given client
+   *         and transaction ID
+   */
+  bool hasPendingLoad(uint16_t hostClientId, uint32_t transactionId) const;
+
+  /**
+   * @return The number of load transactions in progress
+   */
+  size_t getPendingLoadCount() const {
+    return mPendingLoads.size();
+  }
+
+  /**
+   * @return true if no more load transactions can be started until one
+   *         finishes or is cancelled
+   */
+  bool full() const {
+    return mPendingLoads.full();
+  }
+
+  /**
+   * Starts a new load transaction, allocating a Nanoapp and reserving storage
+   * for its binary. If a transaction with the same client and transaction ID
+   * is already in progress, it is discarded and replaced. It is illegal to
+   * call this when full() returns true and the transaction is not a
+   * replacement; use cancelOldestLoad() to make room.
+   *
+   * @param hostClientId The host client that initiated the transaction
+   * @param transactionId The host-assigned transaction ID
+   * @param appId The ID of the nanoapp being loaded
+   * @param appVersion The version of the nanoapp being loaded
+   * @param totalBinaryLen The size of the complete app binary, in bytes
+   *
+   * @return true if the transaction was started
+   */
+  bool prepareForLoad(uint16_t hostClientId, uint32_t transactionId,
+                      uint64_t appId, uint32_t appVersion,
+                      size_t totalBinaryLen);
+
+  /**
+   * Copies the next fragment of the app binary into place. Fragments must be
+   * delivered in order within a transaction. On failure, the transaction is
+   * discarded.
+   *
+   * @param hostClientId The host client that initiated the transaction
+   * @param transactionId The host-assigned transaction ID
+   * @param offset Byte offset of the fragment within the app binary
+   * @param fragment Buffer containing the fragment data
+   * @param fragmentLen Size of fragment, in bytes
+   *
+   * @return true if the fragment was accepted
+   */
+  bool copyNanoappFragment(uint16_t hostClientId, uint32_t transactionId,
+                           size_t offset, const void *fragment,
+                           size_t fragmentLen);
+
+  /**
+   * Completes a transaction, verifying that the entire binary was received
+   * and that its CRC matches the one supplied by the host. The transaction is
+   * finished regardless of the result.
+   *
+   * @param hostClientId The host client that initiated the transaction
+   * @param transactionId The host-assigned transaction ID
+   * @param expectedCrc CRC-32 of the complete app binary, as computed by the
+   *        host
+   * @param nanoapp Output parameter populated with the loaded Nanoapp on
+   *        success, which is then ready to be passed to
+   *        EventLoop::startNanoapp()
+   *
+   * @return true if the binary was received completely and intact
+   */
+  bool finishLoad(uint16_t hostClientId, uint32_t transactionId,
+                  uint32_t expectedCrc, UniquePtr<Nanoapp> *nanoapp);
+
+  /**
+   * Retains the binary of a nanoapp for later use by loadFromCache(). This
+   * must only be called once the nanoapp has been opened and passed
+   * validation (e.g. after it has been started), so that a bad image is never
+   * cached.
+   *
+   * @param nanoapp The validated nanoapp, whose binary is shared with the
+   *        cache rather than copied
+   * @param crc CRC-32 of the complete app binary
+   *
+   * @return true if the binary was cached
+   */
+  bool cacheNanoapp(const Nanoapp& nanoapp, uint32_t crc) {
+    return mBinaryCache.insert(nanoapp, crc);
+  }
+
+  /**
+   * Loads a nanoapp from a binary retained from a previous successful load,
+   * if one is cached with a matching app ID, version and CRC. The binary is
+   * shared with the cache rather than copied, so this is inexpensive.
+   *
+   * @param appId The ID of the nanoapp to load
+   * @param appVersion The version of the nanoapp to load
+   * @param crc CRC-32 of the complete app binary
+   * @param nanoapp Output parameter populated with the loaded Nanoapp on
+   *        success, which is then ready to be passed to
+   *        EventLoop::startNanoapp()
+   *
+   * @return true if the binary was found in the cache and loaded
+   */
+  bool loadFromCache(uint64_t appId, uint32_t appVersion, uint32_t crc,
+                     UniquePtr<Nanoapp> *nanoapp);
+
+  /**
+   * @return true if a binary matching the given key is cached
+   */
+  bool isCached(uint64_t appId, uint32_t appVersion, uint32_t crc) const {
+    return mBinaryCache.contains(appId, appVersion, crc);
+  }
+
+  /**
+   * Discards a transaction, if it is in progress.
+   */
+  void cancelLoad(uint16_t hostClientId, uint32_t transactionId);
+
+  /**
+   * Discards the transaction that was started least recently. It is illegal
+   * to call this when no transactions are in progress.
+   *
+   * @param hostClientId Output parameter populated with the host client ID of
+   *        the discarded transaction
+   * @param transactionId Output parameter populated with the ID of the
+   *        discarded transaction
+   */
+  void cancelOldestLoad(uint16_t *hostClientId, uint32_t *transactionId);
+
+ private:
+  //! The state of a single load transaction
+  struct PendingLoad {
+    //! The Nanoapp being loaded
+    UniquePtr<Nanoapp> nanoapp;
+
+    //! The host client that initiated the transaction
+    uint16_t hostClientId;
+
+    //! The host-assigned ID of the transaction
+    uint32_t transactionId;
+
+    //! The size of the complete app binary, in bytes
+    size_t totalBinaryLen;
+
+    //! The number of bytes of the app binary received so far
+    size_t bytesReceived;
+
+    //! Running CRC-32 of the bytes received so far
+    uint32_t crc;
+  };
+
+  //! Transactions in progress, in the order they were started
+  FixedSizeVector<PendingLoad, kMaxPendingLoads> mPendingLoads;
+
+  //! Binaries from previous successful loads
+  NanoappBinaryCache mBinaryCache;
+
+  /**
+   * @return The index of the matching transaction in mPendingLoads, or
+   *         mPendingLoads.size() if there is none
+   */
+  size_t findLoad(uint16_t hostClientId, uint32_t transactionId) const;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_SHARED_NANOAPP_LOAD_MANAGER_H_
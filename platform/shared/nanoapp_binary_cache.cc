@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/platform/shared/nanoapp_binary_cache.h"
+
+#include <inttypes.h>
+
+#include <utility>
+
+#include "chre/platform/log.h"
+
+namespace chre {
+
+bool NanoappBinaryCache::insert(const Nanoapp& nanoapp, uint32_t crc) {
+  bool success = false;
+
+  uint64_t appId = nanoapp.getAppId();
+  uint32_t appVersion = nanoapp.getAppVersion();
+  size_t binaryLen = nanoapp.getAppBinaryLen();
+  size_t index = findEntry(appId, appVersion, crc);
+  if (index != mEntries.size()) {
+    removeEntry(index);
+  }
+
+  auto image = MakeUnique<Nanoapp>();
+  if (!canCache(binaryLen)) {
+    LOGW("Not caching %zu byte binary for nanoapp 0x%016" PRIx64, binaryLen,
+         appId);
+  } else if (image.isNull()) {
+    LOGE("Couldn't allocate nanoapp binary cache entry");
+  } else if (image->shareBinary(appId, appVersion, nanoapp)) {
+    while (mCapacity - mCachedBytes < binaryLen) {
+      LOGD("Evicting cached binary for nanoapp 0x%016" PRIx64,
+           mEntries.front().appId);
+      removeEntry(0);
+    }
+
+    Entry entry;
+    entry.image = std::move(image);
+    entry.binaryLen = binaryLen;
+    entry.appId = appId;
+    entry.appVersion = appVersion;
+    entry.crc = crc;
+    if (!mEntries.push_back(std::move(entry))) {
+      LOGE("Couldn't allocate nanoapp binary cache entry");
+    } else {
+      mCachedBytes += binaryLen;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+bool NanoappBinaryCache::contains(uint64_t appId, uint32_t appVersion,
+                                  uint32_t crc) const {
+  return (findEntry(appId, appVersion, crc) != mEntries.size());
+}
+
+bool NanoappBinaryCache::loadNanoapp(uint64_t appId, uint32_t appVersion,
+                                     uint32_t crc, Nanoapp *nanoapp) {
+  bool success = false;
+
+  size_t index = findEntry(appId, appVersion, crc);
+  if (index != mEntries.size()) {
+    // Move the entry to the back, marking it as most recently used
+    for (size_t i = index; i + 1 < mEntries.size(); i++) {
+      mEntries.swap(i, i + 1);
+    }
+
+    const Entry& entry = mEntries.back();
+    success = nanoapp->shareBinary(appId, appVersion, *entry.image);
+  }
+
+  return success;
+}
+
+size_t NanoappBinaryCache::findEntry(uint64_t appId, uint32_t appVersion,
+                                     uint32_t crc) const {
+  size_t index = 0;
+  while (index < mEntries.size()
+         && (mEntries[index].appId != appId
+             || mEntries[index].appVersion != appVersion
+             || mEntries[index].crc != crc)) {
+    index++;
+  }
+
+  return index;
+}
+
+void NanoappBinaryCache::removeEntry(size_t index) {
+  mCachedBytes -= mEntries[index].binaryLen;
+  mEntries.erase(index);
+}
+
+}  // namespace chre
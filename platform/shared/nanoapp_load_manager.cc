@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/platform/shared/nanoapp_load_manager.h"
+
+#include <inttypes.h>
+
+#include <utility>
+
+#include "chre/platform/assert.h"
+#include "chre/platform/log.h"
+#include "chre/util/system/crc32.h"
+
+namespace chre {
+
+bool NanoappLoadManager::hasPendingLoad(uint16_t hostClientId,
+                                        uint32_t transactionId) const {
+  return (findLoad(hostClientId, transactionId) != mPendingLoads.size());
+}
+
+bool NanoappLoadManager::prepareForLoad(
+    uint16_t hostClientId, uint32_t transactionId, uint64_t appId,
+    uint32_t appVersion, size_t totalBinaryLen) {
+  bool success = false;
+
+  if (hasPendingLoad(hostClientId, transactionId)) {
+    LOGW("Restarting load transaction %" PRIu32, transactionId);
+    cancelLoad(hostClientId, transactionId);
+  }
+
+  auto nanoapp = MakeUnique<Nanoapp>();
+  if (mPendingLoads.full()) {
+    LOGE("Too many nanoapp load transactions in progress");
+  } else if (nanoapp.isNull()) {
+    LOGE("Couldn't allocate nanoapp for load transaction");
+  } else if (nanoapp->reserveBuffer(appId, appVersion, totalBinaryLen)) {
+    mPendingLoads.emplace_back();
+    PendingLoad& load = mPendingLoads.back();
+    load.nanoapp = std::move(nanoapp);
+    load.hostClientId = hostClientId;
+    load.transactionId = transactionId;
+    load.totalBinaryLen = totalBinaryLen;
+    load.bytesReceived = 0;
+    load.crc = 0;
+    success = true;
+  }
+
+  return success;
+}
+
+bool NanoappLoadManager::copyNanoappFragment(
+    uint16_t hostClientId, uint32_t transactionId, size_t offset,
+    const void *fragment, size_t fragmentLen) {
+  bool success = false;
+
+  size_t index = findLoad(hostClientId, transactionId);
+  if (index == mPendingLoads.size()) {
+    LOGE("Got nanoapp fragment for unknown transaction %" PRIu32,
+         transactionId);
+  } else {
+    PendingLoad& load = mPendingLoads[index];
+    if (offset != load.bytesReceived) {
+      LOGE("Got nanoapp fragment at offset %zu, expected %zu", offset,
+           load.bytesReceived);
+    } else if (load.nanoapp->copyNanoappFragment(offset, fragment,
+                                                 fragmentLen)) {
+      load.crc = crc32(fragment, fragmentLen, load.crc);
+      load.bytesReceived += fragmentLen;
+      success = true;
+    }
+
+    if (!success) {
+      mPendingLoads.erase(index);
+    }
+  }
+
+  return success;
+}
+
+bool NanoappLoadManager::finishLoad(
+    uint16_t hostClientId, uint32_t transactionId, uint32_t expectedCrc,
+    UniquePtr<Nanoapp> *nanoapp) {
+  bool success = false;
+
+  size_t index = findLoad(hostClientId, transactionId);
+  if (index == mPendingLoads.size()) {
+    LOGE("Got nanoapp load commit for unknown transaction %" PRIu32,
+         transactionId);
+  } else {
+    PendingLoad& load = mPendingLoads[index];
+    if (load.bytesReceived != load.totalBinaryLen) {
+      LOGE("Nanoapp load committed after %zu of %zu bytes",
+           load.bytesReceived, load.totalBinaryLen);
+    } else if (load.crc != expectedCrc) {
+      LOGE("Nanoapp binary CRC 0x%08" PRIx32 " doesn't match expected 0x%08"
+           PRIx32, load.crc, expectedCrc);
+    } else {
+      *nanoapp = std::move(load.nanoapp);
+      success = true;
+    }
+
+    mPendingLoads.erase(index);
+  }
+
+  return success;
+}
+
+bool NanoappLoadManager::loadFromCache(uint64_t appId, uint32_t appVersion,
+                                       uint32_t crc,
+                                       UniquePtr<Nanoapp> *nanoapp) {
+  bool success = false;
+
+  if (!mBinaryCache.contains(appId, appVersion, crc)) {
+    LOGD("No cached binary for nanoapp 0x%016" PRIx64 " version 0x%" PRIx32,
+         appId, appVersion);
+  } else {
+    auto cachedNanoapp = MakeUnique<Nanoapp>();
+    if (cachedNanoapp.isNull()) {
+      LOGE("Couldn't allocate nanoapp for cached load");
+    } else if (mBinaryCache.loadNanoapp(appId, appVersion, crc,
+                                        cachedNanoapp.get())) {
+      *nanoapp = std::move(cachedNanoapp);
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+void NanoappLoadManager::cancelLoad(uint16_t hostClientId,
+                                    uint32_t transactionId) {
+  size_t index = findLoad(hostClientId, transactionId);
+  if (index != mPendingLoads.size()) {
+    mPendingLoads.erase(index);
+  }
+}
+
+void NanoappLoadManager::cancelOldestLoad(uint16_t *hostClientId,
+                                          uint32_t *transactionId) {
+  CHRE_ASSERT(!mPendingLoads.empty());
+  if (!mPendingLoads.empty()) {
+    *hostClientId = mPendingLoads.front().hostClientId;
+    *transactionId = mPendingLoads.front().transactionId;
+    LOGW("Discarding incomplete load transaction %" PRIu32, *transactionId);
+    mPendingLoads.erase(0);
+  }
+}
+
+size_t NanoappLoadManager::findLoad(uint16_t hostClientId,
+                                    uint32_t transactionId) const {
+  size_t index = 0;
+  while (index < mPendingLoads.size()
+         && (mPendingLoads[index].hostClientId != hostClientId
+             || mPendingLoads[index].transactionId != transactionId)) {
+    index++;
+  }
+
+  return index;
+}
+
+}  // namespace chre
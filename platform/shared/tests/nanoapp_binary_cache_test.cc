@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "chre/platform/shared/nanoapp_binary_cache.h"
+
+using chre::MakeUnique;
+using chre::Nanoapp;
+using chre::NanoappBinaryCache;
+using chre::UniquePtr;
+
+namespace {
+
+constexpr uint64_t kAppId = 0x0123456789abcdef;
+constexpr uint32_t kAppVersion = 1;
+constexpr uint32_t kCrc = 0x12345678;
+
+/**
+ * @return A nanoapp loaded from a buffer of the given size, standing in for
+ *         one that has been validated
+ */
+UniquePtr<Nanoapp> makeNanoapp(uint64_t appId, size_t size) {
+  uint8_t binary[128] = {};
+  EXPECT_LE(size, sizeof(binary));
+  auto nanoapp = MakeUnique<Nanoapp>();
+  EXPECT_TRUE(nanoapp->loadFromBuffer(appId, kAppVersion, binary, size));
+  return nanoapp;
+}
+
+}  // anonymous namespace
+
+TEST(NanoappBinaryCache, InsertAndLoad) {
+  NanoappBinaryCache cache(100);
+  EXPECT_TRUE(cache.insert(*makeNanoapp(kAppId, 40), kCrc));
+  EXPECT_EQ(cache.getEntryCount(), 1);
+  EXPECT_EQ(cache.getCachedBytes(), 40);
+
+  EXPECT_TRUE(cache.contains(kAppId, kAppVersion, kCrc));
+  EXPECT_FALSE(cache.contains(kAppId + 1, kAppVersion, kCrc));
+  EXPECT_FALSE(cache.contains(kAppId, kAppVersion + 1, kCrc));
+  EXPECT_FALSE(cache.contains(kAppId, kAppVersion, kCrc + 1));
+
+  Nanoapp nanoapp;
+  EXPECT_TRUE(cache.loadNanoapp(kAppId, kAppVersion, kCrc, &nanoapp));
+  EXPECT_TRUE(nanoapp.isLoaded());
+  EXPECT_EQ(nanoapp.getAppId(), kAppId);
+  EXPECT_EQ(nanoapp.getAppBinaryLen(), 40);
+
+  Nanoapp missing;
+  EXPECT_FALSE(cache.loadNanoapp(kAppId, kAppVersion, kCrc + 1, &missing));
+  EXPECT_FALSE(missing.isLoaded());
+}
+
+TEST(NanoappBinaryCache, BinaryOutlivesInsertedNanoapp) {
+  NanoappBinaryCache cache(100);
+  {
+    UniquePtr<Nanoapp> source = makeNanoapp(kAppId, 40);
+    EXPECT_TRUE(cache.insert(*source, kCrc));
+  }
+
+  Nanoapp first;
+  Nanoapp second;
+  EXPECT_TRUE(cache.loadNanoapp(kAppId, kAppVersion, kCrc, &first));
+  EXPECT_TRUE(cache.loadNanoapp(kAppId, kAppVersion, kCrc, &second));
+  EXPECT_TRUE(first.isLoaded());
+  EXPECT_TRUE(second.isLoaded());
+}
+
+TEST(NanoappBinaryCache, ReplacesEntryWithSameKey) {
+  NanoappBinaryCache cache(100);
+  EXPECT_TRUE(cache.insert(*makeNanoapp(kAppId, 40), kCrc));
+  EXPECT_TRUE(cache.insert(*makeNanoapp(kAppId, 30), kCrc));
+  EXPECT_EQ(cache.getEntryCount(), 1);
+  EXPECT_EQ(cache.getCachedBytes(), 30);
+}
+
+TEST(NanoappBinaryCache, RejectsBinaryLargerThanCapacity) {
+  NanoappBinaryCache cache(100);
+  EXPECT_FALSE(cache.canCache(101));
+  EXPECT_FALSE(cache.insert(*makeNanoapp(kAppId, 101), kCrc));
+  EXPECT_EQ(cache.getEntryCount(), 0);
+  EXPECT_EQ(cache.getCachedBytes(), 0);
+}
+
+TEST(NanoappBinaryCache, RejectsNanoappWithoutBinary) {
+  NanoappBinaryCache cache(100);
+  Nanoapp empty;
+  EXPECT_FALSE(cache.insert(empty, kCrc));
+  EXPECT_EQ(cache.getEntryCount(), 0);
+}
+
+TEST(NanoappBinaryCache, EvictsLeastRecentlyUsed) {
+  NanoappBinaryCache cache(100);
+  EXPECT_TRUE(cache.insert(*makeNanoapp(kAppId, 40), kCrc));
+  EXPECT_TRUE(cache.insert(*makeNanoapp(kAppId + 1, 40), kCrc));
+
+  // Using the first entry makes the second one the least recently used
+  Nanoapp nanoapp;
+  EXPECT_TRUE(cache.loadNanoapp(kAppId, kAppVersion, kCrc, &nanoapp));
+
+  EXPECT_TRUE(cache.insert(*makeNanoapp(kAppId + 2, 40), kCrc));
+  EXPECT_EQ(cache.getEntryCount(), 2);
+  EXPECT_EQ(cache.getCachedBytes(), 80);
+  EXPECT_TRUE(cache.contains(kAppId, kAppVersion, kCrc));
+  EXPECT_FALSE(cache.contains(kAppId + 1, kAppVersion, kCrc));
+  EXPECT_TRUE(cache.contains(kAppId + 2, kAppVersion, kCrc));
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "chre/platform/shared/nanoapp_load_manager.h"
+#include "chre/util/system/crc32.h"
+
+using chre::Nanoapp;
+using chre::NanoappLoadManager;
+using chre::UniquePtr;
+using chre::crc32;
+
+namespace {
+
+constexpr uint16_t kHostClientId = 5;
+constexpr uint32_t kTransactionId = 100;
+constexpr uint64_t kAppId = 0x0123456789abcdef;
+constexpr uint32_t kAppVersion = 1;
+
+class NanoappLoadManagerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (size_t i = 0; i < sizeof(mBinary); i++) {
+      mBinary[i] = static_cast<uint8_t>(i);
+    }
+  }
+
+  bool prepare() {
+    return mManager.prepareForLoad(kHostClientId, kTransactionId, kAppId,
+                                   kAppVersion, sizeof(mBinary));
+  }
+
+  NanoappLoadManager mManager;
+  uint8_t mBinary[100];
+};
+
+}  // anonymous namespace
+
+TEST_F(NanoappLoadManagerTest, LoadInFragments) {
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.hasPendingLoad(kHostClientId, kTransactionId));
+  EXPECT_FALSE(mManager.hasPendingLoad(kHostClientId + 1, kTransactionId));
+  EXPECT_FALSE(mManager.hasPendingLoad(kHostClientId, kTransactionId + 1));
+
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, 40));
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 40,
+                                           &mBinary[40], 60));
+
+  UniquePtr<Nanoapp> nanoapp;
+  EXPECT_TRUE(mManager.finishLoad(kHostClientId, kTransactionId,
+                                  crc32(mBinary, sizeof(mBinary)), &nanoapp));
+  ASSERT_FALSE(nanoapp.isNull());
+  EXPECT_TRUE(nanoapp->isLoaded());
+  EXPECT_EQ(nanoapp->getAppId(), kAppId);
+  EXPECT_EQ(mManager.getPendingLoadCount(), 0);
+}
+
+TEST_F(NanoappLoadManagerTest, OutOfOrderFragmentCancelsLoad) {
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, 40));
+  EXPECT_FALSE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 60,
+                                            &mBinary[60], 40));
+  EXPECT_FALSE(mManager.hasPendingLoad(kHostClientId, kTransactionId));
+}
+
+TEST_F(NanoappLoadManagerTest, OversizedFragmentCancelsLoad) {
+  ASSERT_TRUE(prepare());
+  uint8_t oversized[sizeof(mBinary) + 1] = {};
+  EXPECT_FALSE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                            oversized, sizeof(oversized)));
+  EXPECT_FALSE(mManager.hasPendingLoad(kHostClientId, kTransactionId));
+}
+
+TEST_F(NanoappLoadManagerTest, IncompleteBinaryFailsCommit) {
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, 40));
+
+  UniquePtr<Nanoapp> nanoapp;
+  EXPECT_FALSE(mManager.finishLoad(kHostClientId, kTransactionId,
+                                   crc32(mBinary, 40), &nanoapp));
+  EXPECT_TRUE(nanoapp.isNull());
+  EXPECT_FALSE(mManager.hasPendingLoad(kHostClientId, kTransactionId));
+}
+
+TEST_F(NanoappLoadManagerTest, CrcMismatchFailsCommit) {
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, sizeof(mBinary)));
+
+  UniquePtr<Nanoapp> nanoapp;
+  EXPECT_FALSE(mManager.finishLoad(kHostClientId, kTransactionId,
+                                   crc32(mBinary, sizeof(mBinary)) ^ 1,
+                                   &nanoapp));
+  EXPECT_TRUE(nanoapp.isNull());
+  EXPECT_FALSE(mManager.hasPendingLoad(kHostClientId, kTransactionId));
+}
+
+TEST_F(NanoappLoadManagerTest, RestartedTransactionReplacesPendingLoad) {
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, 40));
+
+  ASSERT_TRUE(prepare());
+  EXPECT_EQ(mManager.getPendingLoadCount(), 1);
+
+  // The replacement transaction starts over from offset 0
+  EXPECT_FALSE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 40,
+                                            &mBinary[40], 60));
+}
+
+TEST_F(NanoappLoadManagerTest, InterleavedTransactions) {
+  constexpr uint32_t kOtherTransactionId = kTransactionId + 1;
+  ASSERT_TRUE(prepare());
+  ASSERT_TRUE(mManager.prepareForLoad(kHostClientId, kOtherTransactionId,
+                                      kAppId + 1, kAppVersion, 50));
+  EXPECT_EQ(mManager.getPendingLoadCount(), 2);
+
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, 50));
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kOtherTransactionId,
+                                           0, &mBinary[50], 50));
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 50,
+                                           &mBinary[50], 50));
+
+  UniquePtr<Nanoapp> other;
+  EXPECT_TRUE(mManager.finishLoad(kHostClientId, kOtherTransactionId,
+                                  crc32(&mBinary[50], 50), &other));
+  ASSERT_FALSE(other.isNull());
+  EXPECT_EQ(other->getAppId(), kAppId + 1);
+
+  UniquePtr<Nanoapp> nanoapp;
+  EXPECT_TRUE(mManager.finishLoad(kHostClientId, kTransactionId,
+                                  crc32(mBinary, sizeof(mBinary)), &nanoapp));
+  ASSERT_FALSE(nanoapp.isNull());
+  EXPECT_EQ(nanoapp->getAppId(), kAppId);
+}
+
+TEST_F(NanoappLoadManagerTest, CancelOldestLoad) {
+  for (uint32_t i = 0; i < NanoappLoadManager::kMaxPendingLoads; i++) {
+    ASSERT_TRUE(mManager.prepareForLoad(kHostClientId, kTransactionId + i,
+                                        kAppId, kAppVersion, sizeof(mBinary)));
+  }
+  EXPECT_TRUE(mManager.full());
+  EXPECT_FALSE(mManager.prepareForLoad(kHostClientId, 0, kAppId, kAppVersion,
+                                       sizeof(mBinary)));
+
+  uint16_t hostClientId;
+  uint32_t transactionId;
+  mManager.cancelOldestLoad(&hostClientId, &transactionId);
+  EXPECT_EQ(hostClientId, kHostClientId);
+  EXPECT_EQ(transactionId, kTransactionId);
+  EXPECT_FALSE(mManager.full());
+  EXPECT_TRUE(mManager.hasPendingLoad(kHostClientId, kTransactionId + 1));
+}
+
+TEST_F(NanoappLoadManagerTest, CompletedLoadIsNotCachedUntilValidated) {
+  uint32_t crc = crc32(mBinary, sizeof(mBinary));
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, sizeof(mBinary)));
+  UniquePtr<Nanoapp> nanoapp;
+  EXPECT_TRUE(mManager.finishLoad(kHostClientId, kTransactionId, crc,
+                                  &nanoapp));
+  EXPECT_FALSE(mManager.isCached(kAppId, kAppVersion, crc));
+
+  // Stands in for the platform caching the nanoapp once it has started
+  EXPECT_TRUE(mManager.cacheNanoapp(*nanoapp, crc));
+  EXPECT_TRUE(mManager.isCached(kAppId, kAppVersion, crc));
+
+  UniquePtr<Nanoapp> cached;
+  EXPECT_FALSE(mManager.loadFromCache(kAppId, kAppVersion + 1, crc, &cached));
+  EXPECT_TRUE(cached.isNull());
+  EXPECT_TRUE(mManager.loadFromCache(kAppId, kAppVersion, crc, &cached));
+  ASSERT_FALSE(cached.isNull());
+  EXPECT_TRUE(cached->isLoaded());
+  EXPECT_EQ(cached->getAppId(), kAppId);
+  EXPECT_EQ(cached->getAppBinaryLen(), sizeof(mBinary));
+}
+
+TEST_F(NanoappLoadManagerTest, FailedLoadIsNotCached) {
+  uint32_t crc = crc32(mBinary, sizeof(mBinary));
+  ASSERT_TRUE(prepare());
+  EXPECT_TRUE(mManager.copyNanoappFragment(kHostClientId, kTransactionId, 0,
+                                           mBinary, sizeof(mBinary)));
+  UniquePtr<Nanoapp> nanoapp;
+  EXPECT_FALSE(mManager.finishLoad(kHostClientId, kTransactionId, crc ^ 1,
+                                   &nanoapp));
+  EXPECT_FALSE(mManager.isCached(kAppId, kAppVersion, crc));
+  EXPECT_FALSE(mManager.isCached(kAppId, kAppVersion, crc ^ 1));
+}
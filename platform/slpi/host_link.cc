@@ -21,12 +21,16 @@
 #include "chre/core/host_comms_manager.h"
 #include "chre/platform/memory.h"
 #include "chre/platform/log.h"
+#include "chre/platform/mutex.h"
 #include "chre/platform/system_time.h"
 #include "chre/platform/shared/host_protocol_chre.h"
+#include "chre/platform/shared/nanoapp_load_manager.h"
 #include "chre/platform/shared/platform_log.h"
 #include "chre/platform/slpi/fastrpc.h"
+#include "chre/platform/slpi/nanoapp_loader.h"
 #include "chre/platform/slpi/system_time.h"
 #include "chre/util/fixed_size_blocking_queue.h"
+#include "chre/util/lock_guard.h"
 #include "chre/util/macros.h"
 #include "chre/util/unique_ptr.h"
 #include "chre_api/chre/version.h"
@@ -34,6 +38,8 @@
 #include <inttypes.h>
 #include <limits.h>
 
+#include <utility>
+
 using flatbuffers::FlatBufferBuilder;
 
 namespace chre {
@@ -54,7 +60,12 @@ struct LoadNanoappCallbackData {
   uint64_t appId;
   uint32_t transactionId;
   uint16_t hostClientId;
-  UniquePtr<Nanoapp> nanoapp = MakeUnique<Nanoapp>();
+  UniquePtr<Nanoapp> nanoapp;
+
+  //! If true, the binary is cached under crc32 once the nanoapp has started,
+  //! which means it was opened and passed validation
+  bool cacheWhenStarted;
+  uint32_t crc32;
 };
 
 struct NanoappListData {
@@ -74,6 +85,14 @@ enum class PendingMessageType {
   DebugDumpData,
   DebugDumpResponse,
   TimeSyncRequest,
+  NanoappStatusChange,
+  TimeSyncProbeResponse,
+};
+
+struct TimeSyncProbeData {
+  int64_t hostSendTime;
+  int64_t chreReceiveTime;
+  uint32_t sequence;
 };
 
 struct PendingMessage {
@@ -93,11 +112,17 @@ struct PendingMessage {
     data.builder = builder;
   }
 
+  PendingMessage(PendingMessageType msgType, TimeSyncProbeData *probe) {
+    type = msgType;
+    data.timeSyncProbe = probe;
+  }
+
   PendingMessageType type;
   union {
     const MessageToHost *msgToHost;
     uint16_t hostClientId;
     FlatBufferBuilder *builder;
+    TimeSyncProbeData *timeSyncProbe;
   } data;
 };
 
@@ -122,6 +147,15 @@ typedef void (MessageBuilderFunction)(FlatBufferBuilder& builder, void *cookie);
 FixedSizeBlockingQueue<PendingMessage, kOutboundQueueSize>
     gOutboundQueue;
 
+//! Tracks fragmented load transactions in progress, and caches binaries for
+//! later reloading. Accessed from the context of
+//! chre_slpi_deliver_message_from_host() and, to cache binaries once their
+//! nanoapps have started, from the event loop, so all accesses must hold
+//! gLoadManagerMutex. Nothing is copied while it is held, except a single
+//! fragment of a binary being transferred.
+NanoappLoadManager gLoadManager;
+Mutex gLoadManagerMutex;
+
 int copyToHostBuffer(const FlatBufferBuilder& builder, unsigned char *buffer,
                      size_t bufferSize, unsigned int *messageLen) {
   uint8_t *data = builder.GetBufferPointer();
@@ -229,18 +263,94 @@ void finishLoadingNanoappCallback(uint16_t /*eventType*/, void *data) {
   auto msgBuilder = [](FlatBufferBuilder& builder, void *cookie) {
     auto *cbData = static_cast<LoadNanoappCallbackData *>(cookie);
     EventLoop& eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
-    bool startedSuccessfully = (cbData->nanoapp->isLoaded()) ?
+
+    // The event loop takes ownership of the nanoapp, but it remains valid for
+    // the rest of this callback
+    Nanoapp *nanoapp = cbData->nanoapp.get();
+    bool startedSuccessfully = (nanoapp->isLoaded()) ?
         eventLoop.startNanoapp(cbData->nanoapp) : false;
+    if (startedSuccessfully && cbData->cacheWhenStarted) {
+      LockGuard<Mutex> lock(gLoadManagerMutex);
+      gLoadManager.cacheNanoapp(*nanoapp, cbData->crc32);
+    }
 
     HostProtocolChre::encodeLoadNanoappResponse(
         builder, cbData->hostClientId, cbData->transactionId,
         startedSuccessfully);
   };
 
+  // Wrap in a UniquePtr so the nanoapp is destroyed if it wasn't started
+  UniquePtr<LoadNanoappCallbackData> cbData(
+      static_cast<LoadNanoappCallbackData *>(data));
   constexpr size_t kInitialBufferSize = 48;
   buildAndEnqueueMessage(PendingMessageType::LoadNanoappResponse,
-                         kInitialBufferSize, msgBuilder, data);
-  memoryFree(data);
+                         kInitialBufferSize, msgBuilder, cbData.get());
+}
+
+/**
+ * Sends a LoadNanoappResponse indicating failure, for a load transaction that
+ * was aborted before the nanoapp could be handed to the event loop.
+ */
+void sendLoadNanoappFailure(uint16_t hostClientId, uint32_t transactionId,
+                            bool cacheMiss = false) {
+  struct LoadNanoappFailureData {
+    uint16_t hostClientId;
+    uint32_t transactionId;
+    bool cacheMiss;
+  };
+
+  auto msgBuilder = [](FlatBufferBuilder& builder, void *cookie) {
+    const auto *data = static_cast<const LoadNanoappFailureData *>(cookie);
+    HostProtocolChre::encodeLoadNanoappResponse(
+        builder, data->hostClientId, data->transactionId, false /* success */,
+        data->cacheMiss);
+  };
+
+  constexpr size_t kInitialBufferSize = 52;
+  LoadNanoappFailureData data;
+  data.hostClientId = hostClientId;
+  data.transactionId = transactionId;
+  data.cacheMiss = cacheMiss;
+  buildAndEnqueueMessage(PendingMessageType::LoadNanoappResponse,
+                         kInitialBufferSize, msgBuilder, &data);
+}
+
+/**
+ * Posts a callback to the event loop to start a loaded nanoapp and respond to
+ * the host. Sends a failure response if the callback can't be posted.
+ */
+void postFinishLoadingNanoapp(UniquePtr<LoadNanoappCallbackData>&& cbData) {
+  if (!EventLoopManagerSingleton::get()->deferCallback(
+          SystemCallbackType::FinishLoadingNanoapp, cbData.get(),
+          finishLoadingNanoappCallback)) {
+    LOGE("Couldn't post callback to finish loading nanoapp");
+    sendLoadNanoappFailure(cbData->hostClientId, cbData->transactionId);
+  } else {
+    cbData.release();
+  }
+}
+
+/**
+ * Invoked on the nanoapp loader thread once the nanoapp has been opened.
+ */
+void onNanoappOpened(void *data) {
+  UniquePtr<LoadNanoappCallbackData> cbData(
+      static_cast<LoadNanoappCallbackData *>(data));
+  postFinishLoadingNanoapp(std::move(cbData));
+}
+
+/**
+ * Finishes loading a nanoapp whose binary is resident in memory. The nanoapp
+ * is opened on the loader thread before being started by the event loop, so
+ * the host link isn't blocked by dlopen. If the loader can't accept the
+ * request, the nanoapp is opened by the event loop when it is started.
+ */
+void finishLoadingNanoapp(UniquePtr<LoadNanoappCallbackData>&& cbData) {
+  if (openNanoappAsync(cbData->nanoapp.get(), onNanoappOpened, cbData.get())) {
+    cbData.release();
+  } else {
+    postFinishLoadingNanoapp(std::move(cbData));
+  }
 }
 
 void handleUnloadNanoappCallback(uint16_t /*eventType*/, void *data) {
@@ -326,7 +436,25 @@ int generateHubInfoResponse(uint16_t hostClientId, unsigned char *buffer,
       builder, kHubName, kVendor, kToolchain, kLegacyPlatformVersion,
       kLegacyToolchainVersion, kPeakMips, kStoppedPower, kSleepPower,
       kPeakPower, CHRE_MESSAGE_TO_HOST_MAX_SIZE, chreGetPlatformId(),
-      chreGetVersion(), hostClientId);
+      chreGetVersion(), true /* supportsCachedLoad */, hostClientId);
+
+  return copyToHostBuffer(builder, buffer, bufferSize, messageLen);
+}
+
+/**
+ * Encodes the response to a time sync probe as late as possible, so that the
+ * CHRE send time excludes the time spent in the outbound queue.
+ */
+int generateTimeSyncProbeResponse(
+    TimeSyncProbeData *probe, unsigned char *buffer, size_t bufferSize,
+    unsigned int *messageLen) {
+  CHRE_ASSERT(probe != nullptr);
+  constexpr size_t kInitialBufferSize = 80;
+  FlatBufferBuilder builder(kInitialBufferSize);
+  HostProtocolChre::encodeTimeSyncProbeResponse(
+      builder, probe->sequence, probe->hostSendTime, probe->chreReceiveTime,
+      SystemTime::getMonotonicTime().toRawNanoseconds());
+  memoryFree(probe);
 
   return copyToHostBuffer(builder, buffer, bufferSize, messageLen);
 }
@@ -440,12 +568,18 @@ extern "C" int chre_slpi_get_message_to_host(
                                          bufferSize, messageLen);
         break;
 
+      case PendingMessageType::TimeSyncProbeResponse:
+        result = generateTimeSyncProbeResponse(pendingMsg.data.timeSyncProbe,
+                                               buffer, bufferSize, messageLen);
+        break;
+
       case PendingMessageType::NanoappListResponse:
       case PendingMessageType::LoadNanoappResponse:
       case PendingMessageType::UnloadNanoappResponse:
       case PendingMessageType::DebugDumpData:
       case PendingMessageType::DebugDumpResponse:
       case PendingMessageType::TimeSyncRequest:
+      case PendingMessageType::NanoappStatusChange:
         result = generateMessageFromBuilder(pendingMsg.data.builder,
                                             buffer, bufferSize, messageLen);
         break;
@@ -515,6 +649,28 @@ bool HostLink::sendMessage(const MessageToHost *message) {
       PendingMessage(PendingMessageType::NanoappMessageToHost, message));
 }
 
+void HostLink::sendNanoappStatusChange(uint64_t appId, uint32_t appVersion,
+                                       uint32_t instanceId, bool started) {
+  struct NanoappStatusChangeData {
+    uint64_t appId;
+    uint32_t appVersion;
+    uint32_t instanceId;
+    bool started;
+  };
+
+  auto msgBuilder = [](FlatBufferBuilder& builder, void *cookie) {
+    const auto *data = static_cast<const NanoappStatusChangeData *>(cookie);
+    HostProtocolChre::encodeNanoappStatusChange(
+        builder, data->appId, data->appVersion, data->instanceId,
+        data->started);
+  };
+
+  NanoappStatusChangeData data = { appId, appVersion, instanceId, started };
+  constexpr size_t kInitialSize = 72;
+  buildAndEnqueueMessage(PendingMessageType::NanoappStatusChange, kInitialSize,
+                         msgBuilder, &data);
+}
+
 bool HostLinkBase::flushOutboundQueue() {
   // This function is used in preFatalError() so it must never call FATAL_ERROR
   int waitCount = 5;
@@ -612,6 +768,10 @@ void HostMessageHandlers::handleLoadNanoappRequest(
   LOGD("Got load nanoapp request (txnId %" PRIu32 ") for appId 0x%016" PRIx64
        " version 0x%" PRIx32 " target API version 0x%08" PRIx32 " size %zu",
        transactionId, appId, appVersion, targetApiVersion, appBinaryLen);
+  if (!cbData.isNull()) {
+    cbData->nanoapp = MakeUnique<Nanoapp>();
+  }
+
   if (cbData.isNull() || cbData->nanoapp.isNull()) {
     LOGE("Couldn't allocate load nanoapp callback data");
   } else {
@@ -619,15 +779,109 @@ void HostMessageHandlers::handleLoadNanoappRequest(
     cbData->hostClientId  = hostClientId;
     cbData->appId = appId;
 
-    // Note that if this fails, we'll generate the error response in
-    // the normal deferred callback
+    // The binary must be copied before returning, as the message buffer is
+    // only valid for the duration of this call. Note that if this fails, we'll
+    // generate the error response in the normal deferred callback.
     cbData->nanoapp->loadFromBuffer(appId, appVersion, appBinary, appBinaryLen);
-    if (!EventLoopManagerSingleton::get()->deferCallback(
-            SystemCallbackType::FinishLoadingNanoapp, cbData.get(),
-            finishLoadingNanoappCallback)) {
-      LOGE("Couldn't post callback to finish loading nanoapp");
+    finishLoadingNanoapp(std::move(cbData));
+  }
+}
+
+void HostMessageHandlers::handleLoadNanoappBeginRequest(
+    uint16_t hostClientId, uint32_t transactionId, uint64_t appId,
+    uint32_t appVersion, uint32_t targetApiVersion, size_t totalAppSize) {
+  LOGD("Got load nanoapp begin request (txnId %" PRIu32 ") for appId 0x%016"
+       PRIx64 " version 0x%" PRIx32 " target API version 0x%08" PRIx32
+       " size %zu", transactionId, appId, appVersion, targetApiVersion,
+       totalAppSize);
+
+  LockGuard<Mutex> lock(gLoadManagerMutex);
+  if (gLoadManager.full()
+      && !gLoadManager.hasPendingLoad(hostClientId, transactionId)) {
+    uint16_t evictedHostClientId;
+    uint32_t evictedTransactionId;
+    gLoadManager.cancelOldestLoad(&evictedHostClientId, &evictedTransactionId);
+    sendLoadNanoappFailure(evictedHostClientId, evictedTransactionId);
+  }
+
+  if (!gLoadManager.prepareForLoad(hostClientId, transactionId, appId,
+                                   appVersion, totalAppSize)) {
+    LOGE("Couldn't prepare for loading nanoapp");
+    sendLoadNanoappFailure(hostClientId, transactionId);
+  }
+}
+
+void HostMessageHandlers::handleLoadNanoappFragment(
+    uint16_t hostClientId, uint32_t transactionId, size_t offset,
+    const void *fragment, size_t fragmentLen) {
+  LockGuard<Mutex> lock(gLoadManagerMutex);
+  if (!gLoadManager.hasPendingLoad(hostClientId, transactionId)) {
+    // The transaction was already aborted and a response sent
+    LOGW("Dropping nanoapp fragment for inactive transaction %" PRIu32,
+         transactionId);
+  } else if (!gLoadManager.copyNanoappFragment(hostClientId, transactionId,
+                                               offset, fragment,
+                                               fragmentLen)) {
+    sendLoadNanoappFailure(hostClientId, transactionId);
+  }
+}
+
+void HostMessageHandlers::handleLoadNanoappCommitRequest(
+    uint16_t hostClientId, uint32_t transactionId, uint32_t crc32) {
+  LOGD("Got load nanoapp commit request (txnId %" PRIu32 ")", transactionId);
+  LockGuard<Mutex> lock(gLoadManagerMutex);
+  if (!gLoadManager.hasPendingLoad(hostClientId, transactionId)) {
+    LOGW("Dropping nanoapp load commit for inactive transaction %" PRIu32,
+         transactionId);
+  } else {
+    auto cbData = MakeUnique<LoadNanoappCallbackData>();
+    if (cbData.isNull()) {
+      LOGE("Couldn't allocate load nanoapp callback data");
+      gLoadManager.cancelLoad(hostClientId, transactionId);
+      sendLoadNanoappFailure(hostClientId, transactionId);
+    } else if (!gLoadManager.finishLoad(hostClientId, transactionId, crc32,
+                                        &cbData->nanoapp)) {
+      sendLoadNanoappFailure(hostClientId, transactionId);
     } else {
-      cbData.release();
+      cbData->transactionId = transactionId;
+      cbData->hostClientId  = hostClientId;
+      cbData->appId = cbData->nanoapp->getAppId();
+      cbData->crc32 = crc32;
+      cbData->cacheWhenStarted = true;
+      finishLoadingNanoapp(std::move(cbData));
+    }
+  }
+}
+
+void HostMessageHandlers::handleLoadCachedNanoappRequest(
+    uint16_t hostClientId, uint32_t transactionId, uint64_t appId,
+    uint32_t appVersion, uint32_t targetApiVersion, uint32_t crc32) {
+  LOGD("Got load cached nanoapp request (txnId %" PRIu32 ") for appId 0x%016"
+       PRIx64 " version 0x%" PRIx32 " target API version 0x%08" PRIx32
+       " crc 0x%08" PRIx32, transactionId, appId, appVersion, targetApiVersion,
+       crc32);
+
+  auto cbData = MakeUnique<LoadNanoappCallbackData>();
+  if (cbData.isNull()) {
+    LOGE("Couldn't allocate load nanoapp callback data");
+    sendLoadNanoappFailure(hostClientId, transactionId);
+  } else {
+    // The nanoapp shares the cached binary, so this takes a reference rather
+    // than copying it, and the lock is held only briefly
+    bool cached;
+    {
+      LockGuard<Mutex> lock(gLoadManagerMutex);
+      cached = gLoadManager.loadFromCache(appId, appVersion, crc32,
+                                          &cbData->nanoapp);
+    }
+
+    if (!cached) {
+      sendLoadNanoappFailure(hostClientId, transactionId, true /* cacheMiss */);
+    } else {
+      cbData->transactionId = transactionId;
+      cbData->hostClientId  = hostClientId;
+      cbData->appId = appId;
+      finishLoadingNanoapp(std::move(cbData));
     }
   }
 }
@@ -655,10 +909,34 @@ void HostMessageHandlers::handleUnloadNanoappRequest(
   }
 }
 
-void HostMessageHandlers::handleTimeSyncMessage(int64_t offset) {
+void HostMessageHandlers::handleTimeSyncMessage(int64_t offset,
+                                                int64_t uncertainty) {
+  LOGD("Host time offset %" PRId64 " ns (+/- %" PRId64 " ns)", offset,
+       uncertainty);
   setEstimatedHostTimeOffset(offset);
 }
 
+void HostMessageHandlers::handleTimeSyncProbe(uint32_t sequence,
+                                              int64_t hostSendTime) {
+  // Timestamp the probe before anything else to keep the measured round trip
+  // tight
+  int64_t chreReceiveTime = SystemTime::getMonotonicTime().toRawNanoseconds();
+
+  auto *probe = memoryAlloc<TimeSyncProbeData>();
+  if (probe == nullptr) {
+    LOGE("Couldn't allocate time sync probe");
+  } else {
+    probe->hostSendTime = hostSendTime;
+    probe->chreReceiveTime = chreReceiveTime;
+    probe->sequence = sequence;
+    if (!gOutboundQueue.push(PendingMessage(
+            PendingMessageType::TimeSyncProbeResponse, probe))) {
+      LOGE("Couldn't push time sync probe response");
+      memoryFree(probe);
+    }
+  }
+}
+
 void HostMessageHandlers::handleDebugDumpRequest(uint16_t hostClientId) {
   auto *cbData = memoryAlloc<DebugDumpCallbackData>();
   if (cbData == nullptr) {
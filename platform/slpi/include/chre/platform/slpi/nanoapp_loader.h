@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_SLPI_NANOAPP_LOADER_H_
+#define CHRE_PLATFORM_SLPI_NANOAPP_LOADER_H_
+
+#include "chre/core/nanoapp.h"
+
+namespace chre {
+
+/**
+ * Invoked by the nanoapp loader thread after it has finished opening a nanoapp.
+ *
+ * @param data The pointer supplied to openNanoappAsync()
+ *
+ * @see openNanoappAsync()
+ */
+typedef void (NanoappOpenCompleteFunction)(void *data);
+
+/**
+ * Starts the nanoapp loader thread. Must be called before openNanoappAsync().
+ *
+ * @return true if the thread was started
+ */
+bool startNanoappLoader();
+
+/**
+ * Stops the nanoapp loader thread after it finishes processing all requests
+ * already queued, and waits for it to exit. No further requests are accepted
+ * once this is called.
+ */
+void stopNanoappLoader();
+
+/**
+ * Requests that a dynamically loaded nanoapp be opened (dlopen() of its binary
+ * and validation of its app info) on the nanoapp loader thread, rather than in
+ * the context of the caller or the CHRE event loop when the nanoapp is started.
+ * Opening can take a substantial amount of time for large binaries, so this
+ * allows the host link to return to processing other messages immediately.
+ *
+ * Once the nanoapp has been opened, or failed to open, the callback is invoked
+ * on the loader thread; it is typically used to post a callback to the event
+ * loop that starts the nanoapp. If opening failed, the nanoapp will be opened
+ * again (and fail again) when started, so failures are reported through the
+ * usual path.
+ *
+ * @param nanoapp The nanoapp to open. It must not be accessed by any other
+ *        thread until the callback is invoked.
+ * @param callback Function invoked once the nanoapp has been opened
+ * @param data Arbitrary pointer passed through to the callback
+ *
+ * @return true if the request was queued. If false is returned, the callback
+ *         will not be invoked.
+ */
+bool openNanoappAsync(Nanoapp *nanoapp, NanoappOpenCompleteFunction *callback,
+                      void *data);
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_SLPI_NANOAPP_LOADER_H_
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_PLATFORM_SLPI_ATOMIC_BASE_IMPL_H_
+#define CHRE_PLATFORM_SLPI_ATOMIC_BASE_IMPL_H_
+
+#include "chre/platform/atomic.h"
+
+namespace chre {
+
+namespace atomic_internal {
+
+/**
+ * Converts a CHRE memory order into the equivalent __ATOMIC_* constant used
+ * by the compiler's atomic builtins.
+ */
+inline int toBuiltinMemoryOrder(MemoryOrder order) {
+  switch (order) {
+    case MemoryOrder::Relaxed:
+      return __ATOMIC_RELAXED;
+    case MemoryOrder::Acquire:
+      return __ATOMIC_ACQUIRE;
+    case MemoryOrder::Release:
+      return __ATOMIC_RELEASE;
+    case MemoryOrder::AcquireRelease:
+      return __ATOMIC_ACQ_REL;
+    default:
+      return __ATOMIC_SEQ_CST;
+  }
+}
+
+}  // namespace atomic_internal
+
+inline AtomicBool::AtomicBool(bool startingValue) {
+  __atomic_store_n(&mValue, startingValue, __ATOMIC_RELAXED);
+}
+
+inline bool AtomicBool::load(MemoryOrder order) const {
+  return __atomic_load_n(&mValue, atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline void AtomicBool::store(bool value, MemoryOrder order) {
+  __atomic_store_n(&mValue, value,
+                   atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline bool AtomicBool::exchange(bool value, MemoryOrder order) {
+  return __atomic_exchange_n(&mValue, value,
+                             atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline AtomicUint32::AtomicUint32(uint32_t startingValue) {
+  __atomic_store_n(&mValue, startingValue, __ATOMIC_RELAXED);
+}
+
+inline uint32_t AtomicUint32::load(MemoryOrder order) const {
+  return __atomic_load_n(&mValue, atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline void AtomicUint32::store(uint32_t value, MemoryOrder order) {
+  __atomic_store_n(&mValue, value,
+                   atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline uint32_t AtomicUint32::exchange(uint32_t value, MemoryOrder order) {
+  return __atomic_exchange_n(&mValue, value,
+                             atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline bool AtomicUint32::compareExchange(uint32_t *expected, uint32_t desired,
+                                          MemoryOrder order) {
+  return __atomic_compare_exchange_n(
+      &mValue, expected, desired, false /* weak */,
+      atomic_internal::toBuiltinMemoryOrder(order), __ATOMIC_RELAXED);
+}
+
+inline uint32_t AtomicUint32::fetchAdd(uint32_t arg, MemoryOrder order) {
+  return __atomic_fetch_add(&mValue, arg,
+                            atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+inline uint32_t AtomicUint32::fetchSub(uint32_t arg, MemoryOrder order) {
+  return __atomic_fetch_sub(&mValue, arg,
+                            atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+template<typename ElementType>
+AtomicPtr<ElementType>::AtomicPtr(ElementType *startingValue) {
+  __atomic_store_n(&mValue, static_cast<void *>(startingValue),
+                   __ATOMIC_RELAXED);
+}
+
+template<typename ElementType>
+ElementType *AtomicPtr<ElementType>::load(MemoryOrder order) const {
+  return static_cast<ElementType *>(__atomic_load_n(
+      &mValue, atomic_internal::toBuiltinMemoryOrder(order)));
+}
+
+template<typename ElementType>
+void AtomicPtr<ElementType>::store(ElementType *value, MemoryOrder order) {
+  __atomic_store_n(&mValue, static_cast<void *>(value),
+                   atomic_internal::toBuiltinMemoryOrder(order));
+}
+
+template<typename ElementType>
+ElementType *AtomicPtr<ElementType>::exchange(ElementType *value,
+                                              MemoryOrder order) {
+  return static_cast<ElementType *>(__atomic_exchange_n(
+      &mValue, static_cast<void *>(value),
+      atomic_internal::toBuiltinMemoryOrder(order)));
+}
+
+template<typename ElementType>
+bool AtomicPtr<ElementType>::compareExchange(ElementType **expected,
+                                             ElementType *desired,
+                                             MemoryOrder order) {
+  void *expectedValue = *expected;
+  bool success = __atomic_compare_exchange_n(
+      &mValue, &expectedValue, static_cast<void *>(desired), false /* weak */,
+      atomic_internal::toBuiltinMemoryOrder(order), __ATOMIC_RELAXED);
+  *expected = static_cast<ElementType *>(expectedValue);
+  return success;
+}
+
+}  // namespace chre
+
+#endif  // CHRE_PLATFORM_SLPI_ATOMIC_BASE_IMPL_H_
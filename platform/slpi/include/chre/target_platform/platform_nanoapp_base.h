@@ -25,6 +25,8 @@
 
 namespace chre {
 
+class AtomicUint32;
+
 /**
  * SLPI-specific nanoapp functionality.
  */
@@ -46,6 +48,55 @@ class PlatformNanoappBase {
   bool loadFromBuffer(uint64_t appId, uint32_t appVersion,
                       const void *appBinary, size_t appBinaryLen);
 
+  /**
+   * Allocates a buffer to hold a nanoapp binary that will be supplied in
+   * fragments via copyNanoappFragment(). This allows the binary to be written
+   * directly into its final location as it arrives from the host.
+   *
+   * @param appId The unique app identifier associated with this binary
+   * @param appVersion An application-defined version number
+   * @param appBinaryLen Total size of the app binary, in bytes
+   *
+   * @return true if the allocation was successful
+   */
+  bool reserveBuffer(uint64_t appId, uint32_t appVersion, size_t appBinaryLen);
+
+  /**
+   * Copies a fragment of the app binary into the buffer allocated by
+   * reserveBuffer().
+   *
+   * @param offset Byte offset of the fragment within the app binary
+   * @param fragment Buffer containing the fragment data
+   * @param fragmentLen Size of fragment, in bytes
+   *
+   * @return true if the fragment lies within the reserved buffer and was copied
+   */
+  bool copyNanoappFragment(size_t offset, const void *fragment,
+                           size_t fragmentLen);
+
+  /**
+   * Makes this nanoapp use the binary already held by another, without copying
+   * it. The binary is reference counted, and freed once no nanoapp holds it.
+   * This must only be used once the source binary is complete, as it must not
+   * be modified while shared.
+   *
+   * @param appId The unique app identifier associated with this binary
+   * @param appVersion An application-defined version number
+   * @param source The nanoapp whose binary will be shared
+   *
+   * @return true if the source holds a binary, which is now shared
+   */
+  bool shareBinary(uint64_t appId, uint32_t appVersion,
+                   const PlatformNanoappBase& source);
+
+  /**
+   * @return The size of the binary loaded via loadFromBuffer(),
+   *         reserveBuffer() or shareBinary(), in bytes, or 0 if there is none
+   */
+  size_t getAppBinaryLen() const {
+    return mAppBinaryLen;
+  }
+
   /**
    * Associate this Nanoapp with a nanoapp included in a .so that is pre-loaded
    * onto the filesystem. Actually loading the .so into memory is done when
@@ -64,6 +115,20 @@ class PlatformNanoappBase {
    */
   void loadStatic(const struct chreNslNanoappInfo *appInfo);
 
+  /**
+   * Opens the nanoapp's binary and validates its app info in advance of
+   * start(), which would otherwise do so. This allows the potentially slow
+   * dlopen to be performed on a thread other than the CHRE event loop. It is
+   * only valid to call this when isLoaded() returns true, and before the
+   * nanoapp is handed off to the event loop.
+   *
+   * @return true if the app was opened successfully and the app info structure
+   *         passed validation
+   *
+   * @see openNanoappAsync()
+   */
+  bool open();
+
   /**
    * @return true if the app's binary data is resident in memory, i.e. a
    *         previous call to loadFromBuffer() or loadStatic() was successful
@@ -81,10 +146,14 @@ class PlatformNanoappBase {
   uint32_t mExpectedAppVersion = 0;
 
   //! Buffer containing the complete DSO binary - only populated if
-  //! loadFromBuffer() was used to load this nanoapp
+  //! loadFromBuffer(), reserveBuffer() or shareBinary() was used to load this
+  //! nanoapp
   void *mAppBinary = nullptr;
   size_t mAppBinaryLen = 0;
 
+  //! The number of nanoapps holding mAppBinary, which is shared with them
+  AtomicUint32 *mAppBinaryRefCount = nullptr;
+
   //! If this is a pre-loaded, but non-static nanoapp (i.e. loaded from
   //! loadFromFile), this will be set to the filename string to pass to dlopen()
   const char *mFilename = nullptr;
@@ -131,6 +200,12 @@ class PlatformNanoappBase {
    * result in execution of any unload handlers in the nanoapp.
    */
   void closeNanoapp();
+
+  /**
+   * Drops this nanoapp's reference to mAppBinary, freeing it if no other
+   * nanoapp holds it.
+   */
+  void releaseBinary();
 };
 
 }  // namespace chre
@@ -34,6 +34,7 @@ extern "C" {
 #include "chre/platform/mutex.h"
 #include "chre/platform/shared/platform_log.h"
 #include "chre/platform/slpi/fastrpc.h"
+#include "chre/platform/slpi/nanoapp_loader.h"
 #include "chre/platform/slpi/preloaded_nanoapps.h"
 #include "chre/util/lock_guard.h"
 
@@ -202,6 +203,11 @@ extern "C" int chre_slpi_start_thread(void) {
     } else {
       LOGD("Started CHRE thread");
       fastRpcResult = CHRE_FASTRPC_SUCCESS;
+
+      // If this fails, nanoapps are opened by the CHRE thread instead
+      if (!chre::startNanoappLoader()) {
+        LOGW("Nanoapps will be opened on the CHRE thread");
+      }
     }
   }
 
@@ -243,6 +249,9 @@ extern "C" int chre_slpi_stop_thread(void) {
   if (!gThreadRunning) {
     LOGD("Tried to stop CHRE thread, but not running");
   } else {
+    // Stop the loader first, so that any nanoapps it has opened are handed to
+    // the event loop before it stops
+    chre::stopNanoappLoader();
     EventLoopManagerSingleton::get()->getEventLoop().stop();
     if (gTlsKeyValid) {
       int ret = qurt_tls_delete_key(gTlsKey);
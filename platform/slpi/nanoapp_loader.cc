@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/platform/slpi/nanoapp_loader.h"
+
+#include <inttypes.h>
+
+#include <type_traits>
+
+extern "C" {
+
+#include "qurt.h"
+
+}  // extern "C"
+
+#include "chre/platform/atomic.h"
+#include "chre/platform/fatal_error.h"
+#include "chre/platform/log.h"
+#include "chre/util/fixed_size_blocking_queue.h"
+
+// Qualcomm-defined function needed to indicate that a thread may call dlopen()
+// (without it, the thread will deadlock when calling dlopen()). Returns 0 to
+// indicate success.
+extern "C" int HAP_thread_migrate(qurt_thread_t thread);
+
+namespace chre {
+
+namespace {
+
+//! Size of the stack for the loader thread, in bytes. This matches the CHRE
+//! thread, which has historically been used to dlopen() nanoapps.
+constexpr size_t kStackSize = (8 * 1024);
+
+//! Memory partition where the thread control block (TCB) should be stored
+//! (0 = big image). dlopen() is only supported in big image.
+constexpr unsigned char kTcbPartition = 0;
+
+//! The priority to set for the loader thread (value between 1-255, with 1 being
+//! the highest). This is lower than the CHRE thread, so that opening a nanoapp
+//! doesn't delay event processing.
+constexpr unsigned short kThreadPriority = 200;
+
+//! The number of open requests that may be queued for the loader thread
+constexpr size_t kRequestQueueSize = 8;
+
+//! How long stopNanoappLoader() waits before retrying when the request queue
+//! is full
+constexpr qurt_timer_duration_t kStopRetryIntervalUsec = 1000;
+
+struct OpenRequest {
+  //! The nanoapp to open, or nullptr to request that the loader thread exit
+  Nanoapp *nanoapp;
+  NanoappOpenCompleteFunction *callback;
+  void *data;
+};
+
+//! Buffer to use for the loader thread's stack.
+typename std::aligned_storage<kStackSize>::type gStack;
+
+//! QuRT OS handle for the loader thread.
+qurt_thread_t gThreadHandle;
+
+//! Set to true while the loader thread is running and accepting requests.
+//! Only modified by the thread that starts and stops CHRE, but read by the host
+//! link when queueing requests.
+AtomicBool gThreadRunning(false);
+
+FixedSizeBlockingQueue<OpenRequest, kRequestQueueSize> gRequestQueue;
+
+void nanoappLoaderThreadEntry(void * /*data*/) {
+  LOGD("Nanoapp loader thread started");
+
+  OpenRequest request = gRequestQueue.pop();
+  while (request.nanoapp != nullptr) {
+    // An unloaded nanoapp is reported as a failure when started, without
+    // attempting to open it
+    if (request.nanoapp->isLoaded() && !request.nanoapp->open()) {
+      LOGE("Failed to open nanoapp 0x%016" PRIx64,
+           request.nanoapp->getAppId());
+    }
+
+    request.callback(request.data);
+    request = gRequestQueue.pop();
+  }
+
+  LOGD("Nanoapp loader thread exiting");
+  qurt_thread_exit(0);
+}
+
+bool queueRequest(const OpenRequest& request) {
+  bool success = false;
+
+  if (!gThreadRunning.load()) {
+    LOGW("Nanoapp loader thread not running");
+  } else {
+    success = gRequestQueue.push(request);
+    if (!success) {
+      LOGW("Nanoapp loader queue full");
+    }
+  }
+
+  return success;
+}
+
+}  // anonymous namespace
+
+bool startNanoappLoader() {
+  bool success = false;
+
+  if (gThreadRunning.load()) {
+    LOGE("Nanoapp loader thread already running");
+  } else {
+    // Human-readable name for the thread (not const in QuRT API, but they make
+    // a copy)
+    char threadName[] = "CHRE_LOADER";
+    qurt_thread_attr_t attributes;
+
+    qurt_thread_attr_init(&attributes);
+    qurt_thread_attr_set_name(&attributes, threadName);
+    qurt_thread_attr_set_priority(&attributes, kThreadPriority);
+    qurt_thread_attr_set_stack_addr(&attributes, &gStack);
+    qurt_thread_attr_set_stack_size(&attributes, kStackSize);
+    qurt_thread_attr_set_tcb_partition(&attributes, kTcbPartition);
+
+    int result = qurt_thread_create(&gThreadHandle, &attributes,
+                                    nanoappLoaderThreadEntry, nullptr);
+    if (result != QURT_EOK) {
+      LOGE("Couldn't create nanoapp loader thread: %d", result);
+    } else if (HAP_thread_migrate(gThreadHandle) != 0) {
+      FATAL_ERROR("Couldn't migrate nanoapp loader thread");
+    } else {
+      gThreadRunning.store(true);
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+void stopNanoappLoader() {
+  if (gThreadRunning.load()) {
+    // Stop accepting requests, so the queue drains while waiting for room for
+    // the exit request. Requests already queued are processed first.
+    gThreadRunning.store(false);
+    OpenRequest exitRequest = {};
+    while (!gRequestQueue.push(exitRequest)) {
+      qurt_timer_sleep(kStopRetryIntervalUsec);
+    }
+
+    int status;
+    int result = qurt_thread_join(gThreadHandle, &status);
+    if (result != QURT_EOK) {
+      LOGE("qurt_thread_join failed with result %d", result);
+    }
+  }
+}
+
+bool openNanoappAsync(Nanoapp *nanoapp, NanoappOpenCompleteFunction *callback,
+                      void *data) {
+  bool success = false;
+
+  if (nanoapp != nullptr && callback != nullptr) {
+    OpenRequest request = {};
+    request.nanoapp = nanoapp;
+    request.callback = callback;
+    request.data = data;
+    success = queueRequest(request);
+  }
+
+  return success;
+}
+
+}  // namespace chre
@@ -17,11 +17,12 @@
 #include "chre/platform/platform_nanoapp.h"
 
 #include "chre/platform/assert.h"
+#include "chre/platform/atomic.h"
 #include "chre/platform/log.h"
 #include "chre/platform/memory.h"
+#include "chre/platform/shared/nanoapp_dso_util.h"
 #include "chre/platform/shared/nanoapp_support_lib_dso.h"
 #include "chre/util/system/debug_dump.h"
-#include "chre_api/chre/version.h"
 
 #include "dlfcn.h"
 
@@ -30,60 +31,9 @@
 
 namespace chre {
 
-namespace {
-
-/**
- * Performs sanity checks on the app info structure included in a dynamically
- * loaded nanoapp.
- *
- * @param expectedAppId The app ID passed alongside the binary
- * @param expectedAppVersion The app version number passed alongside the binary
- * @param appInfo App info structure included in the nanoapp binary
- * @param skipVersionValidation if true, ignore the expectedAppVersion parameter
- *
- * @return true if validation was successful
- */
-bool validateAppInfo(uint64_t expectedAppId, uint32_t expectedAppVersion,
-                     const struct chreNslNanoappInfo *appInfo,
-                     bool skipVersionValidation = false) {
-  uint32_t ourApiMajorVersion = CHRE_EXTRACT_MAJOR_VERSION(chreGetApiVersion());
-  uint32_t targetApiMajorVersion = CHRE_EXTRACT_MAJOR_VERSION(
-      appInfo->targetApiVersion);
-
-  bool success = false;
-  if (appInfo->magic != CHRE_NSL_NANOAPP_INFO_MAGIC) {
-    LOGE("Invalid app info magic: got 0x%08" PRIx32 " expected 0x%08" PRIx32,
-         appInfo->magic, static_cast<uint32_t>(CHRE_NSL_NANOAPP_INFO_MAGIC));
-  } else if (appInfo->appId == 0) {
-    LOGE("Rejecting invalid app ID 0");
-  } else if (expectedAppId != appInfo->appId) {
-    LOGE("Expected app ID (0x%016" PRIx64 ") doesn't match internal one (0x%016"
-         PRIx64 ")", expectedAppId, appInfo->appId);
-  } else if (!skipVersionValidation
-      && expectedAppVersion != appInfo->appVersion) {
-    LOGE("Expected app version (0x%" PRIx32 ") doesn't match internal one (0x%"
-         PRIx32 ")", expectedAppVersion, appInfo->appVersion);
-  } else if (targetApiMajorVersion != ourApiMajorVersion) {
-    LOGE("App targets a different major API version (%" PRIu32 ") than what we "
-         "provide (%" PRIu32 ")", targetApiMajorVersion, ourApiMajorVersion);
-  } else if (strlen(appInfo->name) > CHRE_NSL_DSO_NANOAPP_STRING_MAX_LEN) {
-    LOGE("App name is too long");
-  } else if (strlen(appInfo->vendor) > CHRE_NSL_DSO_NANOAPP_STRING_MAX_LEN) {
-    LOGE("App vendor is too long");
-  } else {
-    success = true;
-  }
-
-  return success;
-}
-
-}  // anonymous namespace
-
 PlatformNanoapp::~PlatformNanoapp() {
   closeNanoapp();
-  if (mAppBinary != nullptr) {
-    memoryFree(mAppBinary);
-  }
+  releaseBinary();
 }
 
 bool PlatformNanoapp::start() {
@@ -105,6 +55,12 @@ void PlatformNanoapp::end() {
 bool PlatformNanoappBase::loadFromBuffer(uint64_t appId, uint32_t appVersion,
                                          const void *appBinary,
                                          size_t appBinaryLen) {
+  return (reserveBuffer(appId, appVersion, appBinaryLen)
+      && copyNanoappFragment(0, appBinary, appBinaryLen));
+}
+
+bool PlatformNanoappBase::reserveBuffer(uint64_t appId, uint32_t appVersion,
+                                        size_t appBinaryLen) {
   CHRE_ASSERT(!isLoaded());
   bool success = false;
   constexpr size_t kMaxAppSize = 2 * 1024 * 1024;  // 2 MiB
@@ -113,14 +69,15 @@ bool PlatformNanoappBase::loadFromBuffer(uint64_t appId, uint32_t appVersion,
     LOGE("Rejecting app size %zu above limit %zu", appBinaryLen, kMaxAppSize);
   } else {
     mAppBinary = memoryAlloc(appBinaryLen);
-    if (mAppBinary == nullptr) {
+    mAppBinaryRefCount = memoryAlloc<AtomicUint32>(1);
+    if (mAppBinary == nullptr || mAppBinaryRefCount == nullptr) {
       LOGE("Couldn't allocate %zu byte buffer for nanoapp 0x%016" PRIx64,
            appBinaryLen, appId);
+      releaseBinary();
     } else {
       mExpectedAppId = appId;
       mExpectedAppVersion = appVersion;
       mAppBinaryLen = appBinaryLen;
-      memcpy(mAppBinary, appBinary, appBinaryLen);
       success = true;
     }
   }
@@ -128,6 +85,44 @@ bool PlatformNanoappBase::loadFromBuffer(uint64_t appId, uint32_t appVersion,
   return success;
 }
 
+bool PlatformNanoappBase::copyNanoappFragment(size_t offset,
+                                              const void *fragment,
+                                              size_t fragmentLen) {
+  bool success = false;
+
+  if (mAppBinary == nullptr) {
+    LOGE("Got nanoapp fragment without a reserved buffer");
+  } else if (offset > mAppBinaryLen || fragmentLen > mAppBinaryLen - offset) {
+    LOGE("Nanoapp fragment (offset %zu size %zu) overflows binary size %zu",
+         offset, fragmentLen, mAppBinaryLen);
+  } else {
+    memcpy(static_cast<uint8_t *>(mAppBinary) + offset, fragment, fragmentLen);
+    success = true;
+  }
+
+  return success;
+}
+
+bool PlatformNanoappBase::shareBinary(uint64_t appId, uint32_t appVersion,
+                                      const PlatformNanoappBase& source) {
+  CHRE_ASSERT(!isLoaded());
+  bool success = false;
+
+  if (source.mAppBinary == nullptr) {
+    LOGE("Nanoapp 0x%016" PRIx64 " has no binary to share", appId);
+  } else {
+    source.mAppBinaryRefCount->fetchAdd(1);
+    mAppBinary = source.mAppBinary;
+    mAppBinaryLen = source.mAppBinaryLen;
+    mAppBinaryRefCount = source.mAppBinaryRefCount;
+    mExpectedAppId = appId;
+    mExpectedAppVersion = appVersion;
+    success = true;
+  }
+
+  return success;
+}
+
 void PlatformNanoappBase::loadFromFile(uint64_t appId, const char *filename) {
   CHRE_ASSERT(!isLoaded());
   mExpectedAppId = appId;
@@ -140,6 +135,11 @@ void PlatformNanoappBase::loadStatic(const struct chreNslNanoappInfo *appInfo) {
   mAppInfo = appInfo;
 }
 
+bool PlatformNanoappBase::open() {
+  CHRE_ASSERT(isLoaded());
+  return openNanoapp();
+}
+
 bool PlatformNanoappBase::isLoaded() const {
   return (mIsStatic || mAppBinary != nullptr);
 }
@@ -155,10 +155,30 @@ void PlatformNanoappBase::closeNanoapp() {
   }
 }
 
+void PlatformNanoappBase::releaseBinary() {
+  // The last holder frees the binary. A buffer that failed to allocate fully
+  // has no other holders.
+  if (mAppBinaryRefCount == nullptr
+      || mAppBinaryRefCount->fetchSub(1) == 1) {
+    if (mAppBinary != nullptr) {
+      memoryFree(mAppBinary);
+    }
+    if (mAppBinaryRefCount != nullptr) {
+      mAppBinaryRefCount->~AtomicUint32();
+      memoryFree(mAppBinaryRefCount);
+    }
+  }
+
+  mAppBinary = nullptr;
+  mAppBinaryLen = 0;
+  mAppBinaryRefCount = nullptr;
+}
+
 bool PlatformNanoappBase::openNanoapp() {
   bool success = false;
 
-  if (mIsStatic) {
+  if (mIsStatic || mDsoHandle != nullptr) {
+    // Either nothing to open, or already opened via open()
     success = true;
   } else if (mFilename != nullptr) {
     success = openNanoappFromFile();
@@ -1201,6 +1201,31 @@ bool isRequestAllowed(SensorType sensorType, const SensorRequest& request) {
   return allowed;
 }
 
+/**
+ * Checks the outcome of a QMI SNS_SMGR_BUFFERING_REQ request.
+ *
+ * @param status The QMI transport status of the request.
+ * @param response The response received from SMGR.
+ * @return true if SMGR has accepted the request.
+ */
+bool isBufferingResponseSuccessful(
+    qmi_client_error_type status,
+    const sns_smgr_buffering_resp_msg_v01& response) {
+  bool success = false;
+  if (status != QMI_NO_ERR) {
+    LOGE("Error requesting sensor data: %d", status);
+  } else if (response.Resp.sns_result_t != SNS_RESULT_SUCCESS_V01
+      || (response.AckNak != SNS_SMGR_RESPONSE_ACK_SUCCESS_V01
+          && response.AckNak != SNS_SMGR_RESPONSE_ACK_MODIFIED_V01)) {
+    LOGE("Sensor data request failed with error: %d, AckNak: %d",
+         response.Resp.sns_err_t, response.AckNak);
+  } else {
+    success = true;
+  }
+
+  return success;
+}
+
 /**
  * Makes a QMI SNS_SMGR_BUFFERING_REQ request based on the arguments provided.
  *
@@ -1230,23 +1255,29 @@ bool makeQmiRequest(uint8_t sensorId, uint8_t dataType, uint8_t calType,
         sensorRequest, sizeof(*sensorRequest),
         sensorResponse, sizeof(*sensorResponse),
         kQmiTimeoutMs);
-
-    if (status != QMI_NO_ERR) {
-      LOGE("Error requesting sensor data: %d", status);
-    } else if (sensorResponse->Resp.sns_result_t != SNS_RESULT_SUCCESS_V01
-        || (sensorResponse->AckNak != SNS_SMGR_RESPONSE_ACK_SUCCESS_V01
-            && sensorResponse->AckNak != SNS_SMGR_RESPONSE_ACK_MODIFIED_V01)) {
-      LOGE("Sensor data request failed with error: %d, AckNak: %d",
-           sensorResponse->Resp.sns_err_t, sensorResponse->AckNak);
-    } else {
-      success = true;
-    }
+    success = isBufferingResponseSuccessful(status, *sensorResponse);
   }
   memoryFree(sensorRequest);
   memoryFree(sensorResponse);
   return success;
 }
 
+/**
+ * Updates internal states once a request has been accepted by SMGR.
+ *
+ * @param sensor The sensor the request was made to.
+ * @param request The sensor request that was accepted.
+ */
+void onRequestAccepted(Sensor *sensor, const SensorRequest& request) {
+  sensor->isSensorOff = (request.getMode() == SensorMode::Off);
+
+  if (request.getMode() == SensorMode::Off) {
+    sensor->lastEventValid = false;
+  }
+
+  updateSamplingStatus(sensor, request);
+}
+
 /**
  * Makes a QMI SNS_SMGR_BUFFERING_REQ request if necessary.
  *
@@ -1277,16 +1308,138 @@ bool makeRequest(SensorType sensorType, const SensorRequest& request) {
 
   // TODO: handle makeQmiRequest failures
   if (success) {
-    // Update internal states if request was accepted by SMGR.
-    sensor->isSensorOff = (request.getMode() == SensorMode::Off);
+    onRequestAccepted(sensor, request);
+  }
+  return success;
+}
 
-    if (request.getMode() == SensorMode::Off) {
-      sensor->lastEventValid = false;
+//! State carried from an asynchronous SNS_SMGR_BUFFERING_REQ request through
+//! to its completion on the CHRE thread.
+struct AsyncRequestState {
+  SensorType sensorType;
+  SensorRequest request;
+  bool success;
+  sns_smgr_buffering_resp_msg_v01 response;
+};
+
+/**
+ * Completes an asynchronous sensor request in the context of the CHRE thread,
+ * updating internal states and reporting the result to the core.
+ */
+void handleAsyncRequestResult(uint16_t /* type */, void *data) {
+  auto *state = static_cast<AsyncRequestState *>(data);
+  Sensor *sensor = EventLoopManagerSingleton::get()->getSensorRequestManager()
+      .getSensor(state->sensorType);
+
+  // A sensor that is no longer awaiting a result has since been configured
+  // synchronously, so the platform state must not be rolled back to this one.
+  if (state->success && sensor != nullptr && sensor->isConfigInFlight()) {
+    onRequestAccepted(sensor, state->request);
+  }
+
+  EventLoopManagerSingleton::get()->getSensorRequestManager()
+      .handleSensorConfigResult(state->sensorType, state->success);
+  memoryFree(state);
+}
+
+/**
+ * Schedules handleAsyncRequestResult() to run on the CHRE thread.
+ *
+ * @return true if the result was deferred, in which case ownership of state is
+ *         transferred to the callback.
+ */
+bool deferAsyncRequestResult(AsyncRequestState *state) {
+  return EventLoopManagerSingleton::get()->deferCallback(
+      SystemCallbackType::SensorConfigResult, state,
+      handleAsyncRequestResult);
+}
+
+/**
+ * This callback is invoked by the QMI framework when SMGR responds to an
+ * asynchronous SNS_SMGR_BUFFERING_REQ request. The signature is defined by the
+ * QMI library.
+ *
+ * @param userHandle The userHandle is used by the QMI library.
+ * @param messageId The type of the response.
+ * @param response The decoded response, which is owned by callbackData.
+ * @param responseLength The length of the response.
+ * @param callbackData The AsyncRequestState of the request.
+ * @param transportError The QMI transport status of the request.
+ */
+void smgrBufferingResponseCallback(qmi_client_type userHandle,
+                                   unsigned int messageId, void *response,
+                                   unsigned int responseLength,
+                                   void *callbackData,
+                                   qmi_client_error_type transportError) {
+  auto *state = static_cast<AsyncRequestState *>(callbackData);
+  state->success = isBufferingResponseSuccessful(transportError,
+                                                 state->response);
+  if (!deferAsyncRequestResult(state)) {
+    // The event loop only refuses callbacks once it is stopping, by which
+    // point sensors are configured synchronously (see Sensor::setRequest) and
+    // this result is stale.
+    LOGW("Dropping config result for sensorType %d",
+         static_cast<int>(state->sensorType));
+    memoryFree(state);
+  }
+}
+
+/**
+ * Makes a QMI SNS_SMGR_BUFFERING_REQ request if necessary, without waiting for
+ * SMGR to respond. The result is reported to the core via a deferred callback.
+ *
+ * @param sensorType The sensor type of the request.
+ * @param request The sensor request to be made.
+ * @return true if the request has been submitted.
+ */
+bool makeRequestAsync(SensorType sensorType, const SensorRequest& request) {
+  bool submitted = false;
+
+  Sensor *sensor = EventLoopManagerSingleton::get()->getSensorRequestManager()
+      .getSensor(sensorType);
+  auto *state = memoryAlloc<AsyncRequestState>();
+  if (sensor == nullptr) {
+    LOGE("Invalid sensorType %d", static_cast<size_t>(sensorType));
+  } else if (state == nullptr) {
+    LOG_OOM();
+  } else {
+    state->sensorType = sensorType;
+    state->request = request;
+
+    if (request.getMode() == SensorMode::Off && sensor->isSensorOff) {
+      // Do not make a QMI off request if the sensor is off. Otherwise, SMGR
+      // returns an error.
+      state->success = true;
+      submitted = deferAsyncRequestResult(state);
+    } else {
+      auto *sensorRequest = memoryAlloc<sns_smgr_buffering_req_msg_v01>();
+      if (sensorRequest == nullptr) {
+        LOG_OOM();
+      } else {
+        populateSensorRequest(request, sensor->sensorId, sensor->dataType,
+                              sensor->calType, sensor->minInterval,
+                              sensorRequest);
+
+        qmi_txn_handle txnHandle;
+        qmi_client_error_type status = qmi_client_send_msg_async(
+            gPlatformSensorServiceQmiClientHandle, SNS_SMGR_BUFFERING_REQ_V01,
+            sensorRequest, sizeof(*sensorRequest),
+            &state->response, sizeof(state->response),
+            smgrBufferingResponseCallback, state, &txnHandle);
+        if (status != QMI_NO_ERR) {
+          LOGE("Error submitting sensor data request: %d", status);
+        } else {
+          submitted = true;
+        }
+      }
+      memoryFree(sensorRequest);
     }
+  }
 
-    updateSamplingStatus(sensor, request);
+  if (!submitted) {
+    memoryFree(state);
   }
-  return success;
+  return submitted;
 }
 
 /**
@@ -1306,7 +1459,9 @@ bool makeAllPendingRequests(uint8_t sensorId) {
         ->getSensorRequestManager().getSensor(sensorTypes[i]);
 
     // If sensor is off and the request is not off, it's a pending request.
-    if (sensor != nullptr && sensor->isSensorOff
+    // Sensors with a request in flight are brought up to date by its result.
+    if (sensor != nullptr && !sensor->isConfigInFlight()
+        && sensor->isSensorOff
         && sensor->getRequest().getMode() != SensorMode::Off) {
       accepted |= makeRequest(sensorTypes[i], sensor->getRequest());
     }
@@ -1332,7 +1487,7 @@ bool removeAllPassiveRequests(uint8_t sensorId) {
         ->getSensorRequestManager().getSensor(sensorTypes[i]);
 
     // Turn off sensors that have a passive request
-    if (sensor != nullptr
+    if (sensor != nullptr && !sensor->isConfigInFlight()
         && sensorModeIsPassive(sensor->getRequest().getMode())) {
       SensorRequest offRequest;
       accepted |= makeRequest(sensorTypes[i], offRequest);
@@ -1452,6 +1607,19 @@ bool PlatformSensor::applyRequest(const SensorRequest& request) {
   return success;
 }
 
+bool PlatformSensor::applyRequestAsync(const SensorRequest& request) {
+  // Adds a sensor monitor the first time this sensor is requested.
+  addSensorMonitor(this->sensorId);
+
+  // Determines whether a (passive) request is allowed at this point.
+  bool requestAllowed = isRequestAllowed(getSensorType(), request);
+
+  // If request is not allowed, turn off the sensor. Otherwise, make request.
+  SensorRequest offRequest;
+  return makeRequestAsync(getSensorType(),
+                          requestAllowed ? request : offRequest);
+}
+
 SensorType PlatformSensor::getSensorType() const {
   return getSensorTypeFromSensorId(this->sensorId, this->dataType,
                                    this->calType);
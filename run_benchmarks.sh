@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Quit if any command produces an error.
+set -e
+
+# Build and run the CHRE microbenchmark binary.
+JOB_COUNT=$((`grep -c ^processor /proc/cpuinfo`))
+
+make google_x86_benchmark -j$JOB_COUNT
+
+# Build a dynamic nanoapp for the load/unload benchmarks, unless one was given.
+if [ -z "$CHRE_BENCHMARK_NANOAPP" ]; then
+  make -C apps/hello_world google_x86_linux CHRE_PREFIX=`pwd` -j$JOB_COUNT
+  export CHRE_BENCHMARK_NANOAPP=apps/hello_world/out/google_x86_linux/hello_world.so
+fi
+
+# Logs from loaded nanoapps are written to stderr, separate from the results.
+./out/google_x86_benchmark/libchre $1
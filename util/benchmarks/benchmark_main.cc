@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace chre {
+namespace benchmark {
+
+namespace {
+
+//! Runs are repeated with more iterations until they take at least this long.
+constexpr uint64_t kMinRunTimeNs = 100 * 1000 * 1000;
+
+//! An upper bound on iterations, so that trivially cheap benchmarks terminate.
+constexpr uint64_t kMaxIterations = 1000 * 1000 * 1000;
+
+struct BenchmarkInfo {
+  const char *name;
+  BenchmarkFunction *function;
+  std::vector<size_t> args;
+};
+
+/**
+ * @return The list of registered benchmarks. A function-local static is used
+ *         to avoid depending on static initialization order across files.
+ */
+std::vector<BenchmarkInfo>& getBenchmarks() {
+  static std::vector<BenchmarkInfo> benchmarks;
+  return benchmarks;
+}
+
+void runBenchmark(const BenchmarkInfo& info, size_t arg) {
+  uint64_t iterations = 1;
+  uint64_t elapsedNs;
+  while (true) {
+    State state(iterations, arg);
+    info.function(state);
+    if (state.getSkipReason() != nullptr) {
+      printf("%-48s %8zu skipped: %s\n", info.name, arg,
+             state.getSkipReason());
+      return;
+    }
+
+    elapsedNs = state.getElapsedNanoseconds();
+    if (elapsedNs >= kMinRunTimeNs || iterations >= kMaxIterations) {
+      break;
+    }
+
+    // Scale towards the target time, growing by at least 2x and at most 100x
+    // per step to converge quickly without overshooting badly.
+    uint64_t multiplier = (elapsedNs == 0)
+        ? 100 : (kMinRunTimeNs * 3 / 2) / elapsedNs + 1;
+    if (multiplier < 2) {
+      multiplier = 2;
+    } else if (multiplier > 100) {
+      multiplier = 100;
+    }
+    iterations *= multiplier;
+  }
+
+  printf("%-48s %8zu %14.1f ns/iter %12" PRIu64 " iters\n", info.name, arg,
+         static_cast<double>(elapsedNs) / static_cast<double>(iterations),
+         iterations);
+}
+
+}  // anonymous namespace
+
+Registration::Registration(const char *name, BenchmarkFunction *function,
+                           std::initializer_list<size_t> args) {
+  BenchmarkInfo info = { name, function, std::vector<size_t>(args) };
+  getBenchmarks().push_back(info);
+}
+
+}  // namespace benchmark
+}  // namespace chre
+
+/**
+ * Runs all registered benchmarks, or only those whose name contains the
+ * optional filter string given as the first argument.
+ */
+int main(int argc, char **argv) {
+  const char *filter = (argc > 1) ? argv[1] : nullptr;
+
+  printf("%-48s %8s %22s %18s\n", "Benchmark", "Arg", "Time", "Iterations");
+  for (const auto& info : chre::benchmark::getBenchmarks()) {
+    if (filter == nullptr || strstr(info.name, filter) != nullptr) {
+      for (size_t arg : info.args) {
+        chre::benchmark::runBenchmark(info, arg);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_BENCHMARK_BENCHMARK_H_
+#define CHRE_BENCHMARK_BENCHMARK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "chre/util/non_copyable.h"
+
+/**
+ * @file
+ * A minimal microbenchmark harness for the x86 benchmark variant. Benchmarks
+ * are free functions that run the measured operation once per iteration of a
+ * keepRunning() loop:
+ *
+ *   void benchmarkFoo(chre::benchmark::State& state) {
+ *     while (state.keepRunning()) {
+ *       ...
+ *     }
+ *   }
+ *   CHRE_BENCHMARK(benchmarkFoo, 16, 256, 4096);
+ *
+ * The runner repeats each benchmark with an increasing iteration count until
+ * the measurement is long enough to be stable and reports the mean time per
+ * iteration. Each argument listed in CHRE_BENCHMARK is a separate run, and is
+ * typically used as the number of elements operated on per iteration.
+ */
+
+namespace chre {
+namespace benchmark {
+
+/**
+ * The per-run state passed into a benchmark function.
+ */
+class State : public NonCopyable {
+ public:
+  /**
+   * @param iterations The number of times keepRunning() returns true.
+   * @param arg The argument that the benchmark was registered with.
+   */
+  State(uint64_t iterations, size_t arg)
+      : mRemainingIterations(iterations), mArg(arg) {}
+
+  /**
+   * Drives the benchmark loop. The timer is started by the first call and
+   * stopped by the call that returns false.
+   *
+   * @return true if another iteration should be run.
+   */
+  bool keepRunning() {
+    if (!mStarted) {
+      mStarted = true;
+      resumeTiming();
+    }
+
+    bool keepRunning = (mRemainingIterations > 0);
+    if (keepRunning) {
+      mRemainingIterations--;
+    } else {
+      pauseTiming();
+    }
+    return keepRunning;
+  }
+
+  /**
+   * Stops the timer, so that setup or teardown work inside the loop is not
+   * measured.
+   */
+  void pauseTiming() {
+    mElapsed += std::chrono::steady_clock::now() - mStartTime;
+  }
+
+  /**
+   * Restarts the timer after a call to pauseTiming().
+   */
+  void resumeTiming() {
+    mStartTime = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * @return The argument that this run was registered with.
+   */
+  size_t getArg() const {
+    return mArg;
+  }
+
+  /**
+   * Marks this run as skipped, e.g. because a resource it depends on is not
+   * available. The benchmark function must return without calling
+   * keepRunning().
+   *
+   * @param reason A string literal describing why the run was skipped.
+   */
+  void skip(const char *reason) {
+    mSkipReason = reason;
+  }
+
+  /**
+   * @return The reason passed to skip(), or nullptr if the run was not
+   *         skipped.
+   */
+  const char *getSkipReason() const {
+    return mSkipReason;
+  }
+
+  /**
+   * @return The total measured time in nanoseconds.
+   */
+  uint64_t getElapsedNanoseconds() const {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mElapsed)
+            .count());
+  }
+
+ private:
+  uint64_t mRemainingIterations;
+  const size_t mArg;
+  bool mStarted = false;
+  const char *mSkipReason = nullptr;
+  std::chrono::steady_clock::time_point mStartTime;
+  std::chrono::steady_clock::duration mElapsed =
+      std::chrono::steady_clock::duration::zero();
+};
+
+//! The signature of a benchmark function.
+typedef void (BenchmarkFunction)(State& state);
+
+/**
+ * Adds a benchmark to the set run by the benchmark binary. Invoked through
+ * CHRE_BENCHMARK at static initialization time.
+ */
+class Registration {
+ public:
+  Registration(const char *name, BenchmarkFunction *function,
+               std::initializer_list<size_t> args);
+};
+
+/**
+ * Prevents the compiler from optimizing away the computation of a value that
+ * is otherwise unused.
+ *
+ * @param value The value that must be materialized.
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Forces all pending writes to memory to be considered observable, so that
+ * stores into containers under test are not elided.
+ */
+inline void clobberMemory() {
+  asm volatile("" : : : "memory");
+}
+
+}  // namespace benchmark
+}  // namespace chre
+
+/**
+ * Registers a benchmark function to be run once for each of the supplied
+ * arguments (one or more size_t values).
+ */
+#define CHRE_BENCHMARK(function, ...)                            \
+  static ::chre::benchmark::Registration                         \
+      function##Registration(#function, function, {__VA_ARGS__})
+
+/**
+ * Registers an instantiation of a benchmark function template for the given
+ * (single token) type.
+ */
+#define CHRE_BENCHMARK_TEMPLATE(function, type, ...)                  \
+  static ::chre::benchmark::Registration                              \
+      function##_##type##Registration(#function "<" #type ">",        \
+                                      function<type>, {__VA_ARGS__})
+
+#endif  // CHRE_BENCHMARK_BENCHMARK_H_
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_BENCHMARK_BENCHMARK_ELEMENT_H_
+#define CHRE_BENCHMARK_BENCHMARK_ELEMENT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chre {
+namespace benchmark {
+
+//! The largest element count used by container benchmarks. Fixed capacity
+//! containers are sized to hold this many elements.
+constexpr size_t kMaxBenchmarkElements = 4096;
+
+/**
+ * A larger element type, roughly the size of an Event or sensor sample, used
+ * to show how container cost scales with element size.
+ */
+struct LargeElement {
+  LargeElement() : LargeElement(0) {}
+
+  LargeElement(size_t value) {
+    for (size_t i = 0; i < kWordCount; i++) {
+      words[i] = static_cast<uint64_t>(value);
+    }
+  }
+
+  bool operator==(const LargeElement& other) const {
+    return (words[0] == other.words[0]);
+  }
+
+  bool operator<(const LargeElement& other) const {
+    return (words[0] < other.words[0]);
+  }
+
+  bool operator>(const LargeElement& other) const {
+    return (words[0] > other.words[0]);
+  }
+
+  static constexpr size_t kWordCount = 8;
+  uint64_t words[kWordCount];
+};
+
+}  // namespace benchmark
+}  // namespace chre
+
+#endif  // CHRE_BENCHMARK_BENCHMARK_ELEMENT_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+#include "chre/benchmark/benchmark_element.h"
+
+#include <vector>
+
+#include "chre/platform/memory.h"
+#include "chre/util/memory_pool.h"
+#include "chre/util/synchronized_memory_pool.h"
+
+using chre::MemoryPool;
+using chre::SynchronizedMemoryPool;
+using chre::benchmark::LargeElement;
+using chre::benchmark::State;
+using chre::benchmark::clobberMemory;
+using chre::benchmark::kMaxBenchmarkElements;
+
+namespace {
+
+/**
+ * Allocates getArg() elements from the pool and then frees them all, which
+ * matches the burst pattern of the event pool.
+ */
+template<typename PoolType, typename ElementType>
+void allocateThenFree(State& state, PoolType& pool) {
+  std::vector<ElementType *> elements(state.getArg());
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < elements.size(); i++) {
+      elements[i] = pool.allocate(i);
+    }
+    clobberMemory();
+    for (ElementType *element : elements) {
+      pool.deallocate(element);
+    }
+  }
+}
+
+template<typename ElementType>
+void MemoryPoolAllocateFree(State& state) {
+  MemoryPool<ElementType, kMaxBenchmarkElements> pool;
+  allocateThenFree<decltype(pool), ElementType>(state, pool);
+}
+
+template<typename ElementType>
+void SynchronizedMemoryPoolAllocateFree(State& state) {
+  SynchronizedMemoryPool<ElementType, kMaxBenchmarkElements> pool;
+  allocateThenFree<decltype(pool), ElementType>(state, pool);
+}
+
+template<typename ElementType>
+void NewDeleteAllocateFree(State& state) {
+  std::vector<ElementType *> elements(state.getArg());
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < elements.size(); i++) {
+      elements[i] = new ElementType(i);
+    }
+    clobberMemory();
+    for (ElementType *element : elements) {
+      delete element;
+    }
+  }
+}
+
+template<typename ElementType>
+void MemoryAllocFree(State& state) {
+  std::vector<ElementType *> elements(state.getArg());
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < elements.size(); i++) {
+      elements[i] = chre::memoryAlloc<ElementType>(i);
+    }
+    clobberMemory();
+    for (ElementType *element : elements) {
+      chre::memoryFree(element);
+    }
+  }
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK_TEMPLATE(MemoryPoolAllocateFree, int, 1, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(MemoryPoolAllocateFree, LargeElement, 1, 16, 256,
+                        4096);
+CHRE_BENCHMARK_TEMPLATE(SynchronizedMemoryPoolAllocateFree, int, 1, 16, 256,
+                        4096);
+CHRE_BENCHMARK_TEMPLATE(SynchronizedMemoryPoolAllocateFree, LargeElement, 1,
+                        16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(NewDeleteAllocateFree, int, 1, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(NewDeleteAllocateFree, LargeElement, 1, 16, 256,
+                        4096);
+CHRE_BENCHMARK_TEMPLATE(MemoryAllocFree, int, 1, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(MemoryAllocFree, LargeElement, 1, 16, 256, 4096);
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+#include "chre/benchmark/benchmark_element.h"
+
+#include <deque>
+#include <functional>
+#include <list>
+#include <queue>
+#include <vector>
+
+#include "chre/util/array_queue.h"
+#include "chre/util/fixed_size_blocking_queue.h"
+#include "chre/util/intrusive_queue.h"
+#include "chre/util/priority_queue.h"
+
+using chre::ArrayQueue;
+using chre::FixedSizeBlockingQueue;
+using chre::IntrusiveListNode;
+using chre::IntrusiveQueue;
+using chre::PriorityQueue;
+using chre::benchmark::LargeElement;
+using chre::benchmark::State;
+using chre::benchmark::clobberMemory;
+using chre::benchmark::doNotOptimize;
+using chre::benchmark::kMaxBenchmarkElements;
+
+namespace {
+
+/**
+ * Fills a queue with getArg() elements and then drains it, one element at a
+ * time, using push(), front() and pop().
+ */
+template<typename QueueType, typename ElementType>
+void pushFrontPop(State& state, QueueType& queue) {
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < state.getArg(); i++) {
+      queue.push(ElementType(i));
+    }
+    while (!queue.empty()) {
+      doNotOptimize(queue.front());
+      queue.pop();
+    }
+  }
+}
+
+template<typename ElementType>
+void ArrayQueuePushPop(State& state) {
+  ArrayQueue<ElementType, kMaxBenchmarkElements> queue;
+  pushFrontPop<decltype(queue), ElementType>(state, queue);
+}
+
+template<typename ElementType>
+void StdDequePushPop(State& state) {
+  std::queue<ElementType, std::deque<ElementType>> queue;
+  pushFrontPop<decltype(queue), ElementType>(state, queue);
+}
+
+template<typename ElementType>
+void StdListPushPop(State& state) {
+  std::queue<ElementType, std::list<ElementType>> queue;
+  pushFrontPop<decltype(queue), ElementType>(state, queue);
+}
+
+/**
+ * Fills and drains an ArrayQueue using the bulk push/pop operations and
+ * readable regions, for comparison with ArrayQueuePushPop.
+ */
+template<typename ElementType>
+void ArrayQueueBulkPushPop(State& state) {
+  ArrayQueue<ElementType, kMaxBenchmarkElements> queue;
+  std::vector<ElementType> source;
+  for (size_t i = 0; i < state.getArg(); i++) {
+    source.push_back(ElementType(i));
+  }
+
+  typename ArrayQueue<ElementType, kMaxBenchmarkElements>::Region first;
+  typename ArrayQueue<ElementType, kMaxBenchmarkElements>::Region second;
+  while (state.keepRunning()) {
+    queue.push(source.data(), source.size());
+    queue.getReadableRegions(&first, &second);
+    for (size_t i = 0; i < first.size; i++) {
+      doNotOptimize(first.data[i]);
+    }
+    for (size_t i = 0; i < second.size; i++) {
+      doNotOptimize(second.data[i]);
+    }
+    queue.pop(first.size + second.size);
+  }
+}
+
+template<typename ElementType>
+void ArrayQueueEmplaceMultiple(State& state) {
+  ArrayQueue<ElementType, kMaxBenchmarkElements> queue;
+  while (state.keepRunning()) {
+    queue.emplaceMultiple(state.getArg(), 1);
+    clobberMemory();
+    queue.pop(state.getArg());
+  }
+}
+
+template<typename ElementType>
+void FixedSizeBlockingQueuePushPop(State& state) {
+  FixedSizeBlockingQueue<ElementType, kMaxBenchmarkElements> queue;
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < state.getArg(); i++) {
+      queue.push(ElementType(i));
+    }
+    while (!queue.empty()) {
+      doNotOptimize(queue.pop());
+    }
+  }
+}
+
+struct QueueItem : public IntrusiveListNode {
+  QueueItem() : value(0) {}
+
+  size_t value;
+};
+
+void IntrusiveQueuePushPop(State& state) {
+  // The intrusive queue does not allocate, so the elements are provided up
+  // front as they would be by their owner
+  std::vector<QueueItem> items(state.getArg());
+  IntrusiveQueue<QueueItem> queue;
+  while (state.keepRunning()) {
+    for (QueueItem& item : items) {
+      queue.push(item);
+    }
+    while (!queue.empty()) {
+      doNotOptimize(queue.front().value);
+      queue.pop();
+    }
+  }
+}
+
+template<typename ElementType>
+void PriorityQueuePushPop(State& state) {
+  PriorityQueue<ElementType, std::greater<ElementType>> queue;
+  while (state.keepRunning()) {
+    // Push in descending order so that each push has to sift to the top
+    for (size_t i = state.getArg(); i > 0; i--) {
+      queue.push(ElementType(i));
+    }
+    while (!queue.empty()) {
+      doNotOptimize(queue.top());
+      queue.pop();
+    }
+  }
+}
+
+template<typename ElementType>
+void StdPriorityQueuePushPop(State& state) {
+  std::priority_queue<ElementType, std::vector<ElementType>,
+                      std::greater<ElementType>> queue;
+  while (state.keepRunning()) {
+    for (size_t i = state.getArg(); i > 0; i--) {
+      queue.push(ElementType(i));
+    }
+    while (!queue.empty()) {
+      doNotOptimize(queue.top());
+      queue.pop();
+    }
+  }
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK_TEMPLATE(ArrayQueuePushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(ArrayQueuePushPop, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(ArrayQueueBulkPushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(ArrayQueueBulkPushPop, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(ArrayQueueEmplaceMultiple, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdDequePushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdDequePushPop, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdListPushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdListPushPop, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(FixedSizeBlockingQueuePushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK(IntrusiveQueuePushPop, 16, 256, 4096);
+
+CHRE_BENCHMARK_TEMPLATE(PriorityQueuePushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(PriorityQueuePushPop, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdPriorityQueuePushPop, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdPriorityQueuePushPop, LargeElement, 16, 256, 4096);
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "chre/benchmark/benchmark.h"
+#include "chre/benchmark/benchmark_element.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "chre/util/dynamic_vector.h"
+#include "chre/util/fixed_size_vector.h"
+
+using chre::DynamicVector;
+using chre::FixedSizeVector;
+using chre::benchmark::LargeElement;
+using chre::benchmark::State;
+using chre::benchmark::clobberMemory;
+using chre::benchmark::doNotOptimize;
+using chre::benchmark::kMaxBenchmarkElements;
+
+namespace {
+
+template<typename ElementType>
+void DynamicVectorPushBack(State& state) {
+  while (state.keepRunning()) {
+    DynamicVector<ElementType> vector;
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.push_back(ElementType(i));
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void FixedSizeVectorPushBack(State& state) {
+  while (state.keepRunning()) {
+    FixedSizeVector<ElementType, kMaxBenchmarkElements> vector;
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.push_back(ElementType(i));
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void StdVectorPushBack(State& state) {
+  while (state.keepRunning()) {
+    std::vector<ElementType> vector;
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.push_back(ElementType(i));
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void DynamicVectorInsertFront(State& state) {
+  while (state.keepRunning()) {
+    DynamicVector<ElementType> vector;
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.insert(0, ElementType(i));
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void StdVectorInsertFront(State& state) {
+  while (state.keepRunning()) {
+    std::vector<ElementType> vector;
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.insert(vector.begin(), ElementType(i));
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void DynamicVectorEraseFront(State& state) {
+  DynamicVector<ElementType> vector;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.push_back(ElementType(i));
+    }
+    state.resumeTiming();
+
+    while (!vector.empty()) {
+      vector.erase(0);
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void FixedSizeVectorEraseFront(State& state) {
+  FixedSizeVector<ElementType, kMaxBenchmarkElements> vector;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.push_back(ElementType(i));
+    }
+    state.resumeTiming();
+
+    while (!vector.empty()) {
+      vector.erase(0);
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void StdVectorEraseFront(State& state) {
+  std::vector<ElementType> vector;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    for (size_t i = 0; i < state.getArg(); i++) {
+      vector.push_back(ElementType(i));
+    }
+    state.resumeTiming();
+
+    while (!vector.empty()) {
+      vector.erase(vector.begin());
+    }
+    clobberMemory();
+  }
+}
+
+template<typename ElementType>
+void DynamicVectorFind(State& state) {
+  DynamicVector<ElementType> vector;
+  for (size_t i = 0; i < state.getArg(); i++) {
+    vector.push_back(ElementType(i));
+  }
+
+  // Search for the last element, so each find scans the whole vector
+  const ElementType target(state.getArg() - 1);
+  while (state.keepRunning()) {
+    doNotOptimize(vector.find(target));
+  }
+}
+
+template<typename ElementType>
+void StdVectorFind(State& state) {
+  std::vector<ElementType> vector;
+  for (size_t i = 0; i < state.getArg(); i++) {
+    vector.push_back(ElementType(i));
+  }
+
+  const ElementType target(state.getArg() - 1);
+  while (state.keepRunning()) {
+    doNotOptimize(std::find(vector.begin(), vector.end(), target));
+  }
+}
+
+}  // anonymous namespace
+
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorPushBack, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorPushBack, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(FixedSizeVectorPushBack, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(FixedSizeVectorPushBack, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdVectorPushBack, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdVectorPushBack, LargeElement, 16, 256, 4096);
+
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorInsertFront, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorInsertFront, LargeElement, 16, 256);
+CHRE_BENCHMARK_TEMPLATE(StdVectorInsertFront, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdVectorInsertFront, LargeElement, 16, 256);
+
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorEraseFront, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorEraseFront, LargeElement, 16, 256);
+CHRE_BENCHMARK_TEMPLATE(FixedSizeVectorEraseFront, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(FixedSizeVectorEraseFront, LargeElement, 16, 256);
+CHRE_BENCHMARK_TEMPLATE(StdVectorEraseFront, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdVectorEraseFront, LargeElement, 16, 256);
+
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorFind, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(DynamicVectorFind, LargeElement, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdVectorFind, int, 16, 256, 4096);
+CHRE_BENCHMARK_TEMPLATE(StdVectorFind, LargeElement, 16, 256, 4096);
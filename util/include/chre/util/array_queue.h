@@ -136,6 +136,102 @@ class ArrayQueue : public NonCopyable {
   template<typename... Args>
   bool emplace(Args&&... args);
 
+  /**
+   * Copies as many elements from the supplied array as will fit onto the back
+   * of the array queue. The copy is performed in at most two contiguous runs
+   * (one on each side of the wrap point) rather than element-at-a-time with a
+   * capacity check for each. All iterators and references are unaffected.
+   *
+   * @param elements A pointer to the first element to copy.
+   * @param count The number of elements available at elements.
+   * @return The number of elements that were pushed, which is less than count
+   *         if the array queue became full.
+   */
+  size_t push(const ElementType *elements, size_t count);
+
+  /**
+   * Constructs up to count elements onto the back of the array queue, each
+   * constructed from the same set of arguments. All iterators and references
+   * are unaffected.
+   *
+   * @param count The number of elements to construct.
+   * @param The arguments to the constructor of each element.
+   * @return The number of elements that were constructed, which is less than
+   *         count if the array queue became full.
+   */
+  template<typename... Args>
+  size_t emplaceMultiple(size_t count, const Args&... args);
+
+  /**
+   * Removes up to count elements from the front of the array queue. Only
+   * iterators and references to the removed elements are invalidated.
+   *
+   * @param count The maximum number of elements to remove.
+   * @return The number of elements that were removed.
+   */
+  size_t pop(size_t count);
+
+  /**
+   * Moves up to count elements from the front of the array queue into the
+   * supplied array, then removes them from the array queue. Only iterators
+   * and references to the removed elements are invalidated.
+   *
+   * @param destination The array to move elements into. Must have room for at
+   *        least count elements.
+   * @param count The maximum number of elements to remove.
+   * @return The number of elements that were moved into destination.
+   */
+  size_t pop(ElementType *destination, size_t count);
+
+  /**
+   * A contiguous run of elements within the storage of the array queue.
+   */
+  struct Region {
+    //! Pointer to the first element of the run, or nullptr if size is zero.
+    ElementType *data;
+
+    //! Number of elements in the run.
+    size_t size;
+  };
+
+  /**
+   * Obtains the elements currently in the array queue as up to two contiguous
+   * runs, in FIFO order: first runs from the front of the queue up to the end
+   * of storage (or the back of the queue), and second contains any elements
+   * that wrapped around to the start of storage. This allows consumers to
+   * process many elements at a time, followed by a single call to
+   * pop(size_t). The regions are invalidated by any operation that removes
+   * elements.
+   *
+   * @param first Populated with the first readable run. Must not be null.
+   * @param second Populated with the second readable run, which is empty if
+   *        the elements do not wrap. Must not be null.
+   */
+  void getReadableRegions(Region *first, Region *second);
+
+  /**
+   * Obtains the unused storage at the back of the array queue as up to two
+   * contiguous runs, in the order they will be filled. Elements are written
+   * directly into this storage and then made visible with commitWrite(). As
+   * no constructors are invoked, this is only available for trivially copyable
+   * element types.
+   *
+   * @param first Populated with the first writable run. Must not be null.
+   * @param second Populated with the second writable run, which is empty if
+   *        the free space does not wrap. Must not be null.
+   */
+  void getWritableRegions(Region *first, Region *second);
+
+  /**
+   * Appends elements that were written directly into the storage obtained
+   * from getWritableRegions() to the back of the array queue.
+   *
+   * @param count The number of elements that were written, in fill order.
+   * @return The number of elements appended, which is less than count only if
+   *         count exceeds the free space in the array queue.
+   */
+  size_t commitWrite(size_t count);
+
   /**
    * A template class that implements a forward iterator for the array queue.
    */
@@ -257,6 +353,28 @@ class ArrayQueue : public NonCopyable {
    */
   size_t relativeIndexToAbsolute(size_t index) const;
 
+  /**
+   * @return The storage index that the next pushed element will occupy.
+   */
+  size_t nextTailIndex() const;
+
+  /**
+   * Advances mTail by the given number of elements and increments mSize
+   * accordingly. The caller must ensure that count does not exceed the free
+   * space in the array queue.
+   *
+   * @param count The number of elements to advance by.
+   */
+  void advanceTail(size_t count);
+
+  /**
+   * Advances mHead by the given number of elements and decrements mSize
+   * accordingly. The caller must ensure that count does not exceed size().
+   *
+   * @param count The number of elements to advance by.
+   */
+  void advanceHead(size_t count);
+
   /*
    * Pulls mHead to the next element in the array queue and decrements mSize
    * accordingly. It is illegal to call this function on an empty array queue.
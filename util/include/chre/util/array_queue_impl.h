@@ -18,6 +18,7 @@
 #define CHRE_UTIL_ARRAY_QUEUE_IMPL_H_
 
 #include <new>
+#include <type_traits>
 #include <utility>
 
 #include "chre/platform/assert.h"
@@ -144,6 +145,126 @@ bool ArrayQueue<ElementType, kCapacity>::emplace(Args&&... args) {
   return success;
 }
 
+template<typename ElementType, size_t kCapacity>
+size_t ArrayQueue<ElementType, kCapacity>::push(const ElementType *elements,
+                                                size_t count) {
+  CHRE_ASSERT(elements != nullptr || count == 0);
+  size_t pushCount = (count < kCapacity - mSize) ? count : kCapacity - mSize;
+
+  size_t index = nextTailIndex();
+  size_t firstCount = kCapacity - index;
+  if (firstCount > pushCount) {
+    firstCount = pushCount;
+  }
+
+  ElementType *firstRun = data() + index;
+  for (size_t i = 0; i < firstCount; i++) {
+    new (&firstRun[i]) ElementType(elements[i]);
+  }
+  for (size_t i = firstCount; i < pushCount; i++) {
+    new (&data()[i - firstCount]) ElementType(elements[i]);
+  }
+
+  advanceTail(pushCount);
+  return pushCount;
+}
+
+template<typename ElementType, size_t kCapacity>
+template<typename... Args>
+size_t ArrayQueue<ElementType, kCapacity>::emplaceMultiple(
+    size_t count, const Args&... args) {
+  size_t pushCount = (count < kCapacity - mSize) ? count : kCapacity - mSize;
+
+  size_t index = nextTailIndex();
+  for (size_t i = 0; i < pushCount; i++) {
+    new (&data()[index]) ElementType(args...);
+    if (++index == kCapacity) {
+      index = 0;
+    }
+  }
+
+  advanceTail(pushCount);
+  return pushCount;
+}
+
+template<typename ElementType, size_t kCapacity>
+size_t ArrayQueue<ElementType, kCapacity>::pop(size_t count) {
+  size_t popCount = (count < mSize) ? count : mSize;
+
+  size_t index = mHead;
+  for (size_t i = 0; i < popCount; i++) {
+    data()[index].~ElementType();
+    if (++index == kCapacity) {
+      index = 0;
+    }
+  }
+
+  advanceHead(popCount);
+  return popCount;
+}
+
+template<typename ElementType, size_t kCapacity>
+size_t ArrayQueue<ElementType, kCapacity>::pop(ElementType *destination,
+                                               size_t count) {
+  CHRE_ASSERT(destination != nullptr || count == 0);
+  size_t popCount = (count < mSize) ? count : mSize;
+
+  size_t index = mHead;
+  for (size_t i = 0; i < popCount; i++) {
+    destination[i] = std::move(data()[index]);
+    data()[index].~ElementType();
+    if (++index == kCapacity) {
+      index = 0;
+    }
+  }
+
+  advanceHead(popCount);
+  return popCount;
+}
+
+template<typename ElementType, size_t kCapacity>
+void ArrayQueue<ElementType, kCapacity>::getReadableRegions(Region *first,
+                                                            Region *second) {
+  CHRE_ASSERT(first != nullptr && second != nullptr);
+  size_t firstSize = kCapacity - mHead;
+  if (firstSize > mSize) {
+    firstSize = mSize;
+  }
+
+  first->data = (firstSize > 0) ? data() + mHead : nullptr;
+  first->size = firstSize;
+  second->size = mSize - firstSize;
+  second->data = (second->size > 0) ? data() : nullptr;
+}
+
+template<typename ElementType, size_t kCapacity>
+void ArrayQueue<ElementType, kCapacity>::getWritableRegions(Region *first,
+                                                            Region *second) {
+  static_assert(std::is_trivial<ElementType>::value,
+                "Direct writes are only supported for trivial element types");
+  CHRE_ASSERT(first != nullptr && second != nullptr);
+  size_t freeCount = kCapacity - mSize;
+  size_t index = nextTailIndex();
+  size_t firstSize = kCapacity - index;
+  if (firstSize > freeCount) {
+    firstSize = freeCount;
+  }
+
+  first->data = (firstSize > 0) ? data() + index : nullptr;
+  first->size = firstSize;
+  second->size = freeCount - firstSize;
+  second->data = (second->size > 0) ? data() : nullptr;
+}
+
+template<typename ElementType, size_t kCapacity>
+size_t ArrayQueue<ElementType, kCapacity>::commitWrite(size_t count) {
+  static_assert(std::is_trivial<ElementType>::value,
+                "Direct writes are only supported for trivial element types");
+  size_t commitCount = (count < kCapacity - mSize) ? count : kCapacity - mSize;
+  advanceTail(commitCount);
+  return commitCount;
+}
+
 template<typename ElementType, size_t kCapacity>
 typename ArrayQueue<ElementType, kCapacity>::iterator
 ArrayQueue<ElementType, kCapacity>::begin() {
@@ -202,6 +323,31 @@ size_t ArrayQueue<ElementType, kCapacity>::relativeIndexToAbsolute(
   return absoluteIndex;
 }
 
+template<typename ElementType, size_t kCapacity>
+size_t ArrayQueue<ElementType, kCapacity>::nextTailIndex() const {
+  return (mTail + 1 == kCapacity) ? 0 : mTail + 1;
+}
+
+template<typename ElementType, size_t kCapacity>
+void ArrayQueue<ElementType, kCapacity>::advanceTail(size_t count) {
+  CHRE_ASSERT(count <= kCapacity - mSize);
+  mTail += count;
+  if (mTail >= kCapacity) {
+    mTail -= kCapacity;
+  }
+  mSize += count;
+}
+
+template<typename ElementType, size_t kCapacity>
+void ArrayQueue<ElementType, kCapacity>::advanceHead(size_t count) {
+  CHRE_ASSERT(count <= mSize);
+  mHead += count;
+  if (mHead >= kCapacity) {
+    mHead -= kCapacity;
+  }
+  mSize -= count;
+}
+
 template<typename ElementType, size_t kCapacity>
 void ArrayQueue<ElementType, kCapacity>::pullHead() {
   CHRE_ASSERT(mSize > 0);
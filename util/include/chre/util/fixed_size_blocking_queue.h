@@ -43,6 +43,18 @@ class FixedSizeBlockingQueue : public NonCopyable {
    */
   bool push(const ElementType& element);
 
+  /**
+   * Pushes all of the supplied elements into the queue under a single
+   * acquisition of the lock, or none of them if there isn't room for all, and
+   * notifies any waiting threads that elements are available.
+   *
+   * @param elements A pointer to the first element to push.
+   * @param count The number of elements to push.
+   *
+   * @return true if all of the elements were pushed.
+   */
+  bool pushAll(const ElementType *elements, size_t count);
+
   /**
    * Pops one element from the queue. If the queue is empty, the thread will
    * block until an element has been pushed.
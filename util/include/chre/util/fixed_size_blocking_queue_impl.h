@@ -36,6 +36,23 @@ bool FixedSizeBlockingQueue<ElementType, kSize>::push(
   return success;
 }
 
+template<typename ElementType, size_t kSize>
+bool FixedSizeBlockingQueue<ElementType, kSize>::pushAll(
+    const ElementType *elements, size_t count) {
+  bool success;
+  {
+    LockGuard<Mutex> lock(mMutex);
+    success = (kSize - mQueue.size() >= count);
+    if (success) {
+      mQueue.push(elements, count);
+    }
+  }
+  if (success && count > 0) {
+    mConditionVariable.notify_one();
+  }
+  return success;
+}
+
 template<typename ElementType, size_t kSize>
 ElementType FixedSizeBlockingQueue<ElementType, kSize>::pop() {
   LockGuard<Mutex> lock(mMutex);
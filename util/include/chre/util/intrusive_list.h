@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_INTRUSIVE_LIST_H_
+#define CHRE_UTIL_INTRUSIVE_LIST_H_
+
+#include <cstddef>
+
+#include "chre/util/non_copyable.h"
+
+namespace chre {
+
+/**
+ * The link storage that must be inherited by any type that is to be stored in
+ * an IntrusiveList. A node can be a member of at most one list at a time.
+ */
+class IntrusiveListNode : public NonCopyable {
+ public:
+  /**
+   * @return true if this node is currently a member of a list.
+   */
+  bool isLinked() const {
+    return (mNext != nullptr);
+  }
+
+ private:
+  template<typename ElementType>
+  friend class IntrusiveList;
+
+  //! The previous node in the list, or nullptr if not linked.
+  IntrusiveListNode *mPrev = nullptr;
+
+  //! The next node in the list, or nullptr if not linked.
+  IntrusiveListNode *mNext = nullptr;
+};
+
+/**
+ * A doubly-linked list that chains elements through an IntrusiveListNode
+ * embedded in the elements themselves, so no allocations are performed by the
+ * list. The list does not own its elements: they are never constructed or
+ * destroyed by the list, and must outlive their membership in it.
+ *
+ * ElementType must publicly inherit from IntrusiveListNode.
+ */
+template<typename ElementType>
+class IntrusiveList : public NonCopyable {
+ public:
+  /**
+   * Constructs an empty list.
+   */
+  IntrusiveList();
+
+  /**
+   * Unlinks all elements that remain in the list. The elements themselves are
+   * not destroyed.
+   */
+  ~IntrusiveList();
+
+  /**
+   * @return true if the list contains no elements.
+   */
+  bool empty() const;
+
+  /**
+   * @return The number of elements currently linked into the list.
+   */
+  size_t size() const;
+
+  /**
+   * Obtains the first element of the list. It is illegal to call this on an
+   * empty list.
+   *
+   * @return The first element.
+   */
+  ElementType& front();
+  const ElementType& front() const;
+
+  /**
+   * Obtains the last element of the list. It is illegal to call this on an
+   * empty list.
+   *
+   * @return The last element.
+   */
+  ElementType& back();
+  const ElementType& back() const;
+
+  /**
+   * Links an element at the front of the list. The element must not currently
+   * be linked into any list.
+   *
+   * @param element The element to link.
+   */
+  void push_front(ElementType& element);
+
+  /**
+   * Links an element at the back of the list. The element must not currently
+   * be linked into any list.
+   *
+   * @param element The element to link.
+   */
+  void push_back(ElementType& element);
+
+  /**
+   * Unlinks the first element of the list. It is illegal to call this on an
+   * empty list.
+   */
+  void pop_front();
+
+  /**
+   * Unlinks the last element of the list. It is illegal to call this on an
+   * empty list.
+   */
+  void pop_back();
+
+  /**
+   * Unlinks an element from this list in constant time. The element must be
+   * a member of this list. Iterators to other elements are unaffected.
+   *
+   * @param element The element to unlink.
+   */
+  void remove(ElementType& element);
+
+  /**
+   * Unlinks all elements from the list.
+   */
+  void clear();
+
+  /**
+   * A template class that implements a bidirectional iterator for the list.
+   */
+  template<typename ValueType, typename NodeType>
+  class IntrusiveListIterator {
+   public:
+    explicit IntrusiveListIterator(NodeType *node) : mNode(node) {}
+
+    bool operator==(const IntrusiveListIterator& right) const {
+      return (mNode == right.mNode);
+    }
+
+    bool operator!=(const IntrusiveListIterator& right) const {
+      return (mNode != right.mNode);
+    }
+
+    ValueType& operator*() const {
+      return *static_cast<ValueType *>(mNode);
+    }
+
+    ValueType *operator->() const {
+      return static_cast<ValueType *>(mNode);
+    }
+
+    IntrusiveListIterator& operator++() {
+      mNode = mNode->mNext;
+      return *this;
+    }
+
+    IntrusiveListIterator operator++(int) {
+      IntrusiveListIterator it(*this);
+      operator++();
+      return it;
+    }
+
+    IntrusiveListIterator& operator--() {
+      mNode = mNode->mPrev;
+      return *this;
+    }
+
+    IntrusiveListIterator operator--(int) {
+      IntrusiveListIterator it(*this);
+      operator--();
+      return it;
+    }
+
+   private:
+    //! The node the iterator currently refers to.
+    NodeType *mNode;
+  };
+
+  /**
+   * Bidirectional iterator that points to some element in the list. Unlinking
+   * the element an iterator refers to invalidates that iterator only.
+   */
+  typedef IntrusiveListIterator<ElementType, IntrusiveListNode> iterator;
+  typedef IntrusiveListIterator<const ElementType, const IntrusiveListNode>
+      const_iterator;
+
+  /**
+   * @return A bidirectional iterator to the beginning.
+   */
+  typename IntrusiveList<ElementType>::iterator begin();
+  typename IntrusiveList<ElementType>::const_iterator begin() const;
+  typename IntrusiveList<ElementType>::const_iterator cbegin() const;
+
+  /**
+   * @return A bidirectional iterator to the end.
+   */
+  typename IntrusiveList<ElementType>::iterator end();
+  typename IntrusiveList<ElementType>::const_iterator end() const;
+  typename IntrusiveList<ElementType>::const_iterator cend() const;
+
+ private:
+  /**
+   * The list is circular through this sentinel node, which removes the need
+   * for special cases when linking or unlinking at either end. An empty list
+   * has the sentinel pointing to itself.
+   */
+  IntrusiveListNode mSentinel;
+
+  //! The number of elements linked into the list.
+  size_t mSize = 0;
+
+  /**
+   * Links a node immediately before another node that is already part of this
+   * list (or the sentinel).
+   *
+   * @param node The node to link.
+   * @param next The node that will follow the newly linked node.
+   */
+  void linkBefore(IntrusiveListNode *node, IntrusiveListNode *next);
+
+  /**
+   * Unlinks a node that is part of this list.
+   *
+   * @param node The node to unlink.
+   */
+  void unlink(IntrusiveListNode *node);
+};
+
+}  // namespace chre
+
+#include "chre/util/intrusive_list_impl.h"
+
+#endif  // CHRE_UTIL_INTRUSIVE_LIST_H_
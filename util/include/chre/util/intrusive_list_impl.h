@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_INTRUSIVE_LIST_IMPL_H_
+#define CHRE_UTIL_INTRUSIVE_LIST_IMPL_H_
+
+#include <type_traits>
+
+#include "chre/platform/assert.h"
+#include "chre/util/intrusive_list.h"
+
+namespace chre {
+
+template<typename ElementType>
+IntrusiveList<ElementType>::IntrusiveList() {
+  static_assert(std::is_base_of<IntrusiveListNode, ElementType>::value,
+                "Elements of an IntrusiveList must inherit IntrusiveListNode");
+  mSentinel.mPrev = &mSentinel;
+  mSentinel.mNext = &mSentinel;
+}
+
+template<typename ElementType>
+IntrusiveList<ElementType>::~IntrusiveList() {
+  clear();
+}
+
+template<typename ElementType>
+bool IntrusiveList<ElementType>::empty() const {
+  return (mSize == 0);
+}
+
+template<typename ElementType>
+size_t IntrusiveList<ElementType>::size() const {
+  return mSize;
+}
+
+template<typename ElementType>
+ElementType& IntrusiveList<ElementType>::front() {
+  CHRE_ASSERT(mSize > 0);
+  return *static_cast<ElementType *>(mSentinel.mNext);
+}
+
+template<typename ElementType>
+const ElementType& IntrusiveList<ElementType>::front() const {
+  CHRE_ASSERT(mSize > 0);
+  return *static_cast<const ElementType *>(mSentinel.mNext);
+}
+
+template<typename ElementType>
+ElementType& IntrusiveList<ElementType>::back() {
+  CHRE_ASSERT(mSize > 0);
+  return *static_cast<ElementType *>(mSentinel.mPrev);
+}
+
+template<typename ElementType>
+const ElementType& IntrusiveList<ElementType>::back() const {
+  CHRE_ASSERT(mSize > 0);
+  return *static_cast<const ElementType *>(mSentinel.mPrev);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::push_front(ElementType& element) {
+  linkBefore(&element, mSentinel.mNext);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::push_back(ElementType& element) {
+  linkBefore(&element, &mSentinel);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::pop_front() {
+  CHRE_ASSERT(mSize > 0);
+  unlink(mSentinel.mNext);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::pop_back() {
+  CHRE_ASSERT(mSize > 0);
+  unlink(mSentinel.mPrev);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::remove(ElementType& element) {
+  unlink(&element);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::clear() {
+  while (!empty()) {
+    unlink(mSentinel.mNext);
+  }
+}
+
+template<typename ElementType>
+typename IntrusiveList<ElementType>::iterator
+IntrusiveList<ElementType>::begin() {
+  return iterator(mSentinel.mNext);
+}
+
+template<typename ElementType>
+typename IntrusiveList<ElementType>::iterator
+IntrusiveList<ElementType>::end() {
+  return iterator(&mSentinel);
+}
+
+template<typename ElementType>
+typename IntrusiveList<ElementType>::const_iterator
+IntrusiveList<ElementType>::begin() const {
+  return cbegin();
+}
+
+template<typename ElementType>
+typename IntrusiveList<ElementType>::const_iterator
+IntrusiveList<ElementType>::end() const {
+  return cend();
+}
+
+template<typename ElementType>
+typename IntrusiveList<ElementType>::const_iterator
+IntrusiveList<ElementType>::cbegin() const {
+  return const_iterator(mSentinel.mNext);
+}
+
+template<typename ElementType>
+typename IntrusiveList<ElementType>::const_iterator
+IntrusiveList<ElementType>::cend() const {
+  return const_iterator(&mSentinel);
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::linkBefore(IntrusiveListNode *node,
+                                            IntrusiveListNode *next) {
+  CHRE_ASSERT(!node->isLinked());
+  node->mNext = next;
+  node->mPrev = next->mPrev;
+  next->mPrev->mNext = node;
+  next->mPrev = node;
+  mSize++;
+}
+
+template<typename ElementType>
+void IntrusiveList<ElementType>::unlink(IntrusiveListNode *node) {
+  CHRE_ASSERT(node->isLinked() && node != &mSentinel);
+  node->mPrev->mNext = node->mNext;
+  node->mNext->mPrev = node->mPrev;
+  node->mPrev = nullptr;
+  node->mNext = nullptr;
+  mSize--;
+}
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_INTRUSIVE_LIST_IMPL_H_
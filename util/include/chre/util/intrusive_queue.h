@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_INTRUSIVE_QUEUE_H_
+#define CHRE_UTIL_INTRUSIVE_QUEUE_H_
+
+#include <cstddef>
+
+#include "chre/util/intrusive_list.h"
+#include "chre/util/non_copyable.h"
+
+namespace chre {
+
+/**
+ * An unbounded FIFO queue of elements that are chained through their embedded
+ * IntrusiveListNode. Unlike ArrayQueue, pushing never fails and never
+ * allocates, but the queue does not own its elements: the caller is
+ * responsible for their storage and lifetime.
+ *
+ * ElementType must publicly inherit from IntrusiveListNode.
+ */
+template<typename ElementType>
+class IntrusiveQueue : public NonCopyable {
+ public:
+  /**
+   * @return true if the queue contains no elements.
+   */
+  bool empty() const;
+
+  /**
+   * @return The number of elements currently in the queue.
+   */
+  size_t size() const;
+
+  /**
+   * Obtains the front (oldest) element of the queue. It is illegal to call
+   * this on an empty queue.
+   *
+   * @return The front element.
+   */
+  ElementType& front();
+  const ElementType& front() const;
+
+  /**
+   * Obtains the back (newest) element of the queue. It is illegal to call this
+   * on an empty queue.
+   *
+   * @return The back element.
+   */
+  ElementType& back();
+  const ElementType& back() const;
+
+  /**
+   * Links an element onto the back of the queue. The element must not
+   * currently be linked into any list or queue.
+   *
+   * @param element The element to enqueue.
+   */
+  void push(ElementType& element);
+
+  /**
+   * Unlinks the front element from the queue if the queue is not empty.
+   */
+  void pop();
+
+  /**
+   * Unlinks the front element from the queue and returns it.
+   *
+   * @return A pointer to the element that was at the front of the queue, or
+   *         nullptr if the queue was empty.
+   */
+  ElementType *takeFront();
+
+  /**
+   * Unlinks an element from anywhere in the queue in constant time. The
+   * element must be a member of this queue.
+   *
+   * @param element The element to unlink.
+   */
+  void remove(ElementType& element);
+
+  typedef typename IntrusiveList<ElementType>::iterator iterator;
+  typedef typename IntrusiveList<ElementType>::const_iterator const_iterator;
+
+  /**
+   * @return A bidirectional iterator to the front of the queue.
+   */
+  iterator begin();
+  const_iterator begin() const;
+
+  /**
+   * @return A bidirectional iterator past the back of the queue.
+   */
+  iterator end();
+  const_iterator end() const;
+
+ private:
+  //! The list that provides storage for the queue.
+  IntrusiveList<ElementType> mList;
+};
+
+}  // namespace chre
+
+#include "chre/util/intrusive_queue_impl.h"
+
+#endif  // CHRE_UTIL_INTRUSIVE_QUEUE_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_INTRUSIVE_QUEUE_IMPL_H_
+#define CHRE_UTIL_INTRUSIVE_QUEUE_IMPL_H_
+
+#include "chre/util/intrusive_queue.h"
+
+namespace chre {
+
+template<typename ElementType>
+bool IntrusiveQueue<ElementType>::empty() const {
+  return mList.empty();
+}
+
+template<typename ElementType>
+size_t IntrusiveQueue<ElementType>::size() const {
+  return mList.size();
+}
+
+template<typename ElementType>
+ElementType& IntrusiveQueue<ElementType>::front() {
+  return mList.front();
+}
+
+template<typename ElementType>
+const ElementType& IntrusiveQueue<ElementType>::front() const {
+  return mList.front();
+}
+
+template<typename ElementType>
+ElementType& IntrusiveQueue<ElementType>::back() {
+  return mList.back();
+}
+
+template<typename ElementType>
+const ElementType& IntrusiveQueue<ElementType>::back() const {
+  return mList.back();
+}
+
+template<typename ElementType>
+void IntrusiveQueue<ElementType>::push(ElementType& element) {
+  mList.push_back(element);
+}
+
+template<typename ElementType>
+void IntrusiveQueue<ElementType>::pop() {
+  if (!mList.empty()) {
+    mList.pop_front();
+  }
+}
+
+template<typename ElementType>
+ElementType *IntrusiveQueue<ElementType>::takeFront() {
+  ElementType *element = nullptr;
+  if (!mList.empty()) {
+    element = &mList.front();
+    mList.pop_front();
+  }
+  return element;
+}
+
+template<typename ElementType>
+void IntrusiveQueue<ElementType>::remove(ElementType& element) {
+  mList.remove(element);
+}
+
+template<typename ElementType>
+typename IntrusiveQueue<ElementType>::iterator
+IntrusiveQueue<ElementType>::begin() {
+  return mList.begin();
+}
+
+template<typename ElementType>
+typename IntrusiveQueue<ElementType>::const_iterator
+IntrusiveQueue<ElementType>::begin() const {
+  return mList.cbegin();
+}
+
+template<typename ElementType>
+typename IntrusiveQueue<ElementType>::iterator
+IntrusiveQueue<ElementType>::end() {
+  return mList.end();
+}
+
+template<typename ElementType>
+typename IntrusiveQueue<ElementType>::const_iterator
+IntrusiveQueue<ElementType>::end() const {
+  return mList.cend();
+}
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_INTRUSIVE_QUEUE_IMPL_H_
@@ -75,6 +75,12 @@ class MemoryPool : public NonCopyable {
    */
   void deallocate(ElementType *element);
 
+  /**
+   * @return The number of elements that can be allocated before the pool is
+   *         exhausted.
+   */
+  size_t getFreeBlockCount() const;
+
  private:
   /**
    * The unused storage for this MemoryPool maintains the list of free slots.
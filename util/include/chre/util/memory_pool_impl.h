@@ -60,6 +60,11 @@ void MemoryPool<ElementType, kSize>::deallocate(ElementType *element) {
   mFreeBlockCount++;
 }
 
+template<typename ElementType, size_t kSize>
+size_t MemoryPool<ElementType, kSize>::getFreeBlockCount() const {
+  return mFreeBlockCount;
+}
+
 template<typename ElementType, size_t kSize>
 typename MemoryPool<ElementType, kSize>::MemoryPoolBlock
     *MemoryPool<ElementType, kSize>::blocks() {
@@ -76,6 +76,9 @@ constexpr uint64_t kWwanWorldAppId    = makeExampleNanoappId(7);
 constexpr uint64_t kSpammerAppId      = makeExampleNanoappId(9);
 constexpr uint64_t kUnloadTesterAppId = makeExampleNanoappId(10);
 constexpr uint64_t kAshWorldAppId     = makeExampleNanoappId(11);
+constexpr uint64_t kLoadGenAppId      = makeExampleNanoappId(12);
+constexpr uint64_t kSensorLatencyAppId = makeExampleNanoappId(13);
+constexpr uint64_t kEchoAppId         = makeExampleNanoappId(14);
 
 constexpr uint64_t kImuCalAppId       = makeGoogleNanoappId(0x16);
 
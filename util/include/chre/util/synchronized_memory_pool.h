@@ -51,6 +51,32 @@ class SynchronizedMemoryPool : public NonCopyable {
    */
   void deallocate(ElementType *element);
 
+  /**
+   * Allocates count objects under a single acquisition of the lock, or none if
+   * fewer than count blocks are free. The object for each index is constructed
+   * by allocateElement(pool, index), which must call pool.allocate() exactly
+   * once and return the result.
+   *
+   * @param elements Populated with count pointers to the allocated objects on
+   *        success.
+   * @param count The number of objects to allocate.
+   * @param allocateElement Allocates and constructs one object from the
+   *        underlying (unsynchronized) MemoryPool, which is passed by reference.
+   * @return true if all count objects were allocated.
+   */
+  template<typename AllocateFunction>
+  bool allocateMultiple(ElementType **elements, size_t count,
+                        AllocateFunction allocateElement);
+
+  /**
+   * Releases count elements under a single acquisition of the lock. Each
+   * pointer must have been produced by a previous allocation from this pool.
+   *
+   * @param elements The elements to release.
+   * @param count The number of elements to release.
+   */
+  void deallocateMultiple(ElementType * const *elements, size_t count);
+
  private:
   //! The mutex used to guard access to this memory pool.
   Mutex mMutex;
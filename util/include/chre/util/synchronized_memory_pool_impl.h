@@ -37,6 +37,30 @@ void SynchronizedMemoryPool<ElementType, kSize>::deallocate(
   mMemoryPool.deallocate(element);
 }
 
+template<typename ElementType, size_t kSize>
+template<typename AllocateFunction>
+bool SynchronizedMemoryPool<ElementType, kSize>::allocateMultiple(
+    ElementType **elements, size_t count, AllocateFunction allocateElement) {
+  LockGuard<Mutex> lock(mMutex);
+  bool success = (mMemoryPool.getFreeBlockCount() >= count);
+  if (success) {
+    for (size_t i = 0; i < count; i++) {
+      elements[i] = allocateElement(mMemoryPool, i);
+    }
+  }
+
+  return success;
+}
+
+template<typename ElementType, size_t kSize>
+void SynchronizedMemoryPool<ElementType, kSize>::deallocateMultiple(
+    ElementType * const *elements, size_t count) {
+  LockGuard<Mutex> lock(mMutex);
+  for (size_t i = 0; i < count; i++) {
+    mMemoryPool.deallocate(elements[i]);
+  }
+}
+
 }  // namespace chre
 
 #endif  // CHRE_UTIL_SYNCHRONIZED_MEMORY_POOL_IMPL_H_
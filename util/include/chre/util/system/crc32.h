@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHRE_UTIL_SYSTEM_CRC32_H_
+#define CHRE_UTIL_SYSTEM_CRC32_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chre {
+
+/**
+ * Computes the CRC-32 of a buffer, using the reflected polynomial 0xEDB88320
+ * as used by IEEE 802.3 and zlib. The CRC of data that is delivered in pieces
+ * can be computed incrementally by passing the result of the previous call as
+ * the crc parameter.
+ *
+ * @param data Pointer to the data to checksum
+ * @param dataLen Size of data, in bytes
+ * @param crc The CRC of any data preceding this buffer, or 0 when starting a
+ *        new computation
+ *
+ * @return The CRC of all data processed so far
+ */
+uint32_t crc32(const void *data, size_t dataLen, uint32_t crc = 0);
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_SYSTEM_CRC32_H_
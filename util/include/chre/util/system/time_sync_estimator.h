@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_SYSTEM_TIME_SYNC_ESTIMATOR_H_
+#define CHRE_UTIL_SYSTEM_TIME_SYNC_ESTIMATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chre {
+
+/**
+ * Estimates the offset between a local and a remote clock from a series of
+ * round trip probes. Each probe records four timestamps: when it left the local
+ * side, when the remote side received it and replied (in the remote clock),
+ * and when the reply arrived. The remote clock is assumed to be read midway
+ * through the time the probe spent in transit, so each sample's error is at
+ * most half of its round trip time excluding the time spent on the remote
+ * side. The estimate uses the sample with the smallest round trip time, which
+ * discards samples delayed by scheduling or queueing on either side.
+ *
+ * The clocks are arbitrary nanosecond time bases; neither needs to be related
+ * to a particular hardware counter.
+ */
+class TimeSyncEstimator {
+ public:
+  /**
+   * Discards all samples, e.g. before starting a new exchange.
+   */
+  void reset();
+
+  /**
+   * Adds the timestamps from one probe. All times are in nanoseconds.
+   *
+   * @param localSendTime Local time the probe was sent
+   * @param remoteReceiveTime Remote time the probe was received
+   * @param remoteSendTime Remote time the reply was sent
+   * @param localReceiveTime Local time the reply was received
+   *
+   * @return false if the timestamps are inconsistent (either side's clock ran
+   *         backwards) and the sample was rejected
+   */
+  bool addSample(int64_t localSendTime, int64_t remoteReceiveTime,
+                 int64_t remoteSendTime, int64_t localReceiveTime);
+
+  /**
+   * @return The number of samples accepted since the last reset
+   */
+  size_t getSampleCount() const {
+    return mSampleCount;
+  }
+
+  /**
+   * Provides the current estimate of the offset between the clocks.
+   *
+   * @param offset Populated with the offset to add to a remote time to get the
+   *        corresponding local time, in nanoseconds
+   * @param uncertainty Populated with the maximum error of offset, in
+   *        nanoseconds
+   *
+   * @return false if no samples have been accepted
+   */
+  bool getEstimate(int64_t *offset, int64_t *uncertainty) const;
+
+ private:
+  size_t mSampleCount = 0;
+
+  //! The offset and round trip time of the sample with the smallest round
+  //! trip, only valid if mSampleCount > 0
+  int64_t mBestOffset = 0;
+  int64_t mBestRoundTrip = 0;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_SYSTEM_TIME_SYNC_ESTIMATOR_H_
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/system/time_sync_estimator.h"
+
+namespace chre {
+
+void TimeSyncEstimator::reset() {
+  mSampleCount = 0;
+  mBestOffset = 0;
+  mBestRoundTrip = 0;
+}
+
+bool TimeSyncEstimator::addSample(int64_t localSendTime,
+                                  int64_t remoteReceiveTime,
+                                  int64_t remoteSendTime,
+                                  int64_t localReceiveTime) {
+  bool accepted = (localReceiveTime >= localSendTime
+                   && remoteSendTime >= remoteReceiveTime);
+  if (accepted) {
+    int64_t roundTrip = (localReceiveTime - localSendTime)
+        - (remoteSendTime - remoteReceiveTime);
+    if (roundTrip < 0) {
+      // The remote side took longer than the whole exchange, which can only
+      // happen if its clock runs faster than ours; treat it as instantaneous
+      roundTrip = 0;
+    }
+
+    // Halve each difference separately to avoid overflowing with clocks that
+    // have unrelated epochs, then add back the halves lost to truncation
+    int64_t outboundDiff = localSendTime - remoteReceiveTime;
+    int64_t returnDiff = localReceiveTime - remoteSendTime;
+    int64_t offset = outboundDiff / 2 + returnDiff / 2
+        + (outboundDiff % 2 + returnDiff % 2) / 2;
+
+    if (mSampleCount == 0 || roundTrip < mBestRoundTrip) {
+      mBestOffset = offset;
+      mBestRoundTrip = roundTrip;
+    }
+    mSampleCount++;
+  }
+
+  return accepted;
+}
+
+bool TimeSyncEstimator::getEstimate(int64_t *offset,
+                                    int64_t *uncertainty) const {
+  bool valid = (mSampleCount > 0);
+  if (valid) {
+    *offset = mBestOffset;
+
+    // Round up to allow for truncation when computing the offset
+    *uncertainty = (mBestRoundTrip + 1) / 2;
+  }
+
+  return valid;
+}
+
+}  // namespace chre
@@ -329,3 +329,130 @@ TEST(ArrayQueueTest, Full) {
 
   EXPECT_TRUE(q.full());
 }
+
+TEST(ArrayQueueTest, BulkPushWraps) {
+  ArrayQueue<int, 5> q;
+  q.push(100);
+  q.push(101);
+  q.push(102);
+  q.pop();
+  q.pop();
+
+  int values[] = { 0, 1, 2, 3, 4, 5 };
+  EXPECT_EQ(4, q.push(values, 6));
+  EXPECT_TRUE(q.full());
+  EXPECT_EQ(102, q[0]);
+  for (size_t i = 1; i < q.size(); i++) {
+    EXPECT_EQ(i - 1, q[i]);
+  }
+
+  EXPECT_EQ(0, q.push(values, 1));
+}
+
+TEST(ArrayQueueTest, BulkPopDestroysElements) {
+  for (size_t i = 0; i < kMaxTestCapacity; ++i) {
+    destructor_count[i] = 0;
+  }
+
+  ArrayQueue<DummyElement, 4> q;
+  for (size_t i = 0; i < 4; ++i) {
+    q.emplace(i);
+  }
+  q.pop();
+  q.emplace(4);
+
+  EXPECT_EQ(3, q.pop(3));
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(1, destructor_count[i]);
+  }
+  EXPECT_EQ(0, destructor_count[4]);
+  EXPECT_EQ(1, q.size());
+
+  EXPECT_EQ(1, q.pop(10));
+  EXPECT_EQ(1, destructor_count[4]);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(ArrayQueueTest, BulkPopIntoArray) {
+  ArrayQueue<int, 4> q;
+  for (int i = 0; i < 4; i++) {
+    q.push(i);
+  }
+  q.pop();
+  q.push(4);
+
+  int values[6] = {};
+  EXPECT_EQ(4, q.pop(values, 6));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(i + 1, values[i]);
+  }
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(0, q.pop(values, 6));
+}
+
+TEST(ArrayQueueTest, EmplaceMultiple) {
+  constructor_count = 0;
+  ArrayQueue<DummyElement, 4> q;
+  q.emplace(1);
+  EXPECT_EQ(3, q.emplaceMultiple(5, 2));
+  EXPECT_EQ(4, constructor_count);
+  EXPECT_TRUE(q.full());
+}
+
+TEST(ArrayQueueTest, ReadableRegions) {
+  ArrayQueue<int, 4> q;
+  ArrayQueue<int, 4>::Region first, second;
+
+  q.getReadableRegions(&first, &second);
+  EXPECT_EQ(0, first.size);
+  EXPECT_EQ(0, second.size);
+
+  q.push(0);
+  q.push(1);
+  q.getReadableRegions(&first, &second);
+  ASSERT_EQ(2, first.size);
+  EXPECT_EQ(0, second.size);
+  EXPECT_EQ(0, first.data[0]);
+  EXPECT_EQ(1, first.data[1]);
+
+  q.push(2);
+  q.pop();
+  q.push(3);
+  q.push(4);
+  q.getReadableRegions(&first, &second);
+  ASSERT_EQ(3, first.size);
+  ASSERT_EQ(1, second.size);
+  EXPECT_EQ(1, first.data[0]);
+  EXPECT_EQ(3, first.data[2]);
+  EXPECT_EQ(4, second.data[0]);
+
+  EXPECT_EQ(4, q.pop(first.size + second.size));
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(ArrayQueueTest, WritableRegionsAndCommit) {
+  ArrayQueue<int, 4> q;
+  ArrayQueue<int, 4>::Region first, second;
+
+  q.push(0);
+  q.push(1);
+  q.push(2);
+  q.pop(2);
+  q.getWritableRegions(&first, &second);
+  ASSERT_EQ(1, first.size);
+  ASSERT_EQ(2, second.size);
+
+  first.data[0] = 10;
+  second.data[0] = 11;
+  EXPECT_EQ(2, q.commitWrite(2));
+  ASSERT_EQ(3, q.size());
+  EXPECT_EQ(2, q[0]);
+  EXPECT_EQ(10, q[1]);
+  EXPECT_EQ(11, q[2]);
+
+  q.getWritableRegions(&first, &second);
+  EXPECT_EQ(1, first.size);
+  EXPECT_EQ(0, second.size);
+  EXPECT_EQ(1, q.commitWrite(5));
+  EXPECT_TRUE(q.full());
+}
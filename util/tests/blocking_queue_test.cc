@@ -34,3 +34,38 @@ TEST(FixedSizeBlockingQueue, PushPopVerifyOrder) {
   ASSERT_EQ(blockingQueue.pop(), 0x1337);
   ASSERT_EQ(blockingQueue.pop(), 0xcafe);
 }
+
+TEST(FixedSizeBlockingQueue, PushAllVerifyOrder) {
+  FixedSizeBlockingQueue<int, 4> blockingQueue;
+  const int elements[] = {1, 2, 3};
+
+  ASSERT_TRUE(blockingQueue.push(0));
+  ASSERT_TRUE(blockingQueue.pushAll(elements, 3));
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(blockingQueue.pop(), i);
+  }
+  ASSERT_TRUE(blockingQueue.empty());
+}
+
+TEST(FixedSizeBlockingQueue, PushAllIsAllOrNothing) {
+  FixedSizeBlockingQueue<int, 4> blockingQueue;
+  const int elements[] = {1, 2, 3};
+
+  ASSERT_TRUE(blockingQueue.pushAll(elements, 2));
+  ASSERT_FALSE(blockingQueue.pushAll(elements, 3));
+
+  // Nothing from the failed push was added, but a batch that fits still is
+  ASSERT_TRUE(blockingQueue.pushAll(elements + 1, 2));
+  ASSERT_EQ(blockingQueue.pop(), 1);
+  ASSERT_EQ(blockingQueue.pop(), 2);
+  ASSERT_EQ(blockingQueue.pop(), 2);
+  ASSERT_EQ(blockingQueue.pop(), 3);
+  ASSERT_TRUE(blockingQueue.empty());
+}
+
+TEST(FixedSizeBlockingQueue, PushAllEmptyBatch) {
+  FixedSizeBlockingQueue<int, 4> blockingQueue;
+  ASSERT_TRUE(blockingQueue.pushAll(nullptr, 0));
+  ASSERT_TRUE(blockingQueue.empty());
+}
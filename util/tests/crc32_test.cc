@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "chre/util/system/crc32.h"
+
+using chre::crc32;
+
+TEST(Crc32, EmptyBuffer) {
+  EXPECT_EQ(crc32(nullptr, 0), 0u);
+}
+
+TEST(Crc32, KnownValues) {
+  const char kCheckString[] = "123456789";
+  EXPECT_EQ(crc32(kCheckString, strlen(kCheckString)), 0xcbf43926u);
+
+  const char kFox[] = "The quick brown fox jumps over the lazy dog";
+  EXPECT_EQ(crc32(kFox, strlen(kFox)), 0x414fa339u);
+}
+
+TEST(Crc32, IncrementalMatchesSingleShot) {
+  uint8_t data[257];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<uint8_t>(i * 31);
+  }
+
+  uint32_t expected = crc32(data, sizeof(data));
+  for (size_t split = 0; split <= sizeof(data); split += 16) {
+    uint32_t crc = crc32(data, split);
+    crc = crc32(data + split, sizeof(data) - split, crc);
+    EXPECT_EQ(crc, expected);
+  }
+}
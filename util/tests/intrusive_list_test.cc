@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "chre/util/intrusive_list.h"
+#include "chre/util/intrusive_queue.h"
+
+using chre::IntrusiveList;
+using chre::IntrusiveListNode;
+using chre::IntrusiveQueue;
+
+namespace {
+
+class Item : public IntrusiveListNode {
+ public:
+  Item(int value) : mValue(value) {}
+
+  int getValue() const {
+    return mValue;
+  }
+
+ private:
+  int mValue;
+};
+
+}  // anonymous namespace
+
+TEST(IntrusiveList, EmptyByDefault) {
+  IntrusiveList<Item> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(0, list.size());
+  EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(IntrusiveList, PushBackAndFront) {
+  Item a(1), b(2), c(3);
+  IntrusiveList<Item> list;
+  list.push_back(b);
+  list.push_back(c);
+  list.push_front(a);
+
+  ASSERT_EQ(3, list.size());
+  EXPECT_EQ(1, list.front().getValue());
+  EXPECT_EQ(3, list.back().getValue());
+  EXPECT_TRUE(a.isLinked());
+  EXPECT_TRUE(b.isLinked());
+  EXPECT_TRUE(c.isLinked());
+}
+
+TEST(IntrusiveList, PopFrontAndBack) {
+  Item a(1), b(2), c(3);
+  IntrusiveList<Item> list;
+  list.push_back(a);
+  list.push_back(b);
+  list.push_back(c);
+
+  list.pop_front();
+  EXPECT_FALSE(a.isLinked());
+  EXPECT_EQ(2, list.front().getValue());
+
+  list.pop_back();
+  EXPECT_FALSE(c.isLinked());
+  EXPECT_EQ(2, list.back().getValue());
+  EXPECT_EQ(1, list.size());
+
+  list.pop_back();
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(IntrusiveList, RemoveFromMiddle) {
+  Item a(1), b(2), c(3);
+  IntrusiveList<Item> list;
+  list.push_back(a);
+  list.push_back(b);
+  list.push_back(c);
+
+  list.remove(b);
+  EXPECT_FALSE(b.isLinked());
+  ASSERT_EQ(2, list.size());
+
+  auto it = list.begin();
+  EXPECT_EQ(1, it->getValue());
+  ++it;
+  EXPECT_EQ(3, it->getValue());
+  ++it;
+  EXPECT_TRUE(it == list.end());
+}
+
+TEST(IntrusiveList, ElementCanMoveBetweenLists) {
+  Item a(1);
+  IntrusiveList<Item> first;
+  IntrusiveList<Item> second;
+
+  first.push_back(a);
+  first.remove(a);
+  second.push_back(a);
+  EXPECT_TRUE(first.empty());
+  EXPECT_EQ(1, second.size());
+  EXPECT_EQ(&a, &second.front());
+}
+
+TEST(IntrusiveList, IterateForwardAndBackward) {
+  Item items[] = { {0}, {1}, {2}, {3} };
+  IntrusiveList<Item> list;
+  for (Item& item : items) {
+    list.push_back(item);
+  }
+
+  int expected = 0;
+  for (const Item& item : list) {
+    EXPECT_EQ(expected++, item.getValue());
+  }
+  EXPECT_EQ(4, expected);
+
+  auto it = list.end();
+  for (int i = 3; i >= 0; i--) {
+    --it;
+    EXPECT_EQ(i, it->getValue());
+  }
+  EXPECT_TRUE(it == list.begin());
+}
+
+TEST(IntrusiveList, ClearUnlinksAllElements) {
+  Item a(1), b(2);
+  {
+    IntrusiveList<Item> list;
+    list.push_back(a);
+    list.push_back(b);
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_FALSE(a.isLinked());
+    EXPECT_FALSE(b.isLinked());
+
+    list.push_back(a);
+  }
+
+  // The destructor must unlink any remaining elements.
+  EXPECT_FALSE(a.isLinked());
+}
+
+TEST(IntrusiveListDeathTest, DoublePush) {
+  Item a(1);
+  IntrusiveList<Item> list;
+  list.push_back(a);
+  EXPECT_DEATH(list.push_back(a), "");
+}
+
+TEST(IntrusiveListDeathTest, FrontWhenEmpty) {
+  IntrusiveList<Item> list;
+  EXPECT_DEATH(list.front(), "");
+}
+
+TEST(IntrusiveQueue, FifoOrder) {
+  Item items[] = { {0}, {1}, {2}, {3}, {4} };
+  IntrusiveQueue<Item> queue;
+  for (Item& item : items) {
+    queue.push(item);
+  }
+
+  ASSERT_EQ(5, queue.size());
+  EXPECT_EQ(4, queue.back().getValue());
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(i, queue.front().getValue());
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(IntrusiveQueue, PopWhenEmpty) {
+  IntrusiveQueue<Item> queue;
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(nullptr, queue.takeFront());
+}
+
+TEST(IntrusiveQueue, TakeFront) {
+  Item a(1), b(2);
+  IntrusiveQueue<Item> queue;
+  queue.push(a);
+  queue.push(b);
+
+  Item *item = queue.takeFront();
+  ASSERT_EQ(&a, item);
+  EXPECT_FALSE(a.isLinked());
+  EXPECT_EQ(1, queue.size());
+
+  // A taken element can be requeued immediately.
+  queue.push(*item);
+  EXPECT_EQ(&b, queue.takeFront());
+  EXPECT_EQ(&a, queue.takeFront());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(IntrusiveQueue, RemoveArbitraryElement) {
+  Item a(1), b(2), c(3);
+  IntrusiveQueue<Item> queue;
+  queue.push(a);
+  queue.push(b);
+  queue.push(c);
+
+  queue.remove(b);
+  EXPECT_EQ(2, queue.size());
+
+  int sum = 0;
+  for (const Item& item : queue) {
+    sum += item.getValue();
+  }
+  EXPECT_EQ(4, sum);
+}
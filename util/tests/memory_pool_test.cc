@@ -15,6 +15,17 @@ TEST(MemoryPool, ExhaustPool) {
   ASSERT_EQ(memoryPool.allocate(), nullptr);
 }
 
+TEST(MemoryPool, FreeBlockCountTracksAllocations) {
+  MemoryPool<int, 3> memoryPool;
+  ASSERT_EQ(memoryPool.getFreeBlockCount(), 3);
+
+  int *element = memoryPool.allocate();
+  ASSERT_EQ(memoryPool.getFreeBlockCount(), 2);
+
+  memoryPool.deallocate(element);
+  ASSERT_EQ(memoryPool.getFreeBlockCount(), 3);
+}
+
 TEST(MemoryPool, ExhaustPoolThenDeallocateOneAndAllocateOne) {
   MemoryPool<int, 3> memoryPool;
 
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "chre/util/synchronized_memory_pool.h"
+
+using chre::MemoryPool;
+using chre::SynchronizedMemoryPool;
+
+namespace {
+
+int *allocateIndex(MemoryPool<int, 4>& pool, size_t index) {
+  return pool.allocate(static_cast<int>(index));
+}
+
+}  // anonymous namespace
+
+TEST(SynchronizedMemoryPool, AllocateMultipleConstructsEachElement) {
+  SynchronizedMemoryPool<int, 4> memoryPool;
+  int *elements[3];
+
+  ASSERT_TRUE(memoryPool.allocateMultiple(elements, 3, allocateIndex));
+  for (int i = 0; i < 3; i++) {
+    ASSERT_NE(elements[i], nullptr);
+    EXPECT_EQ(*elements[i], i);
+  }
+
+  ASSERT_NE(memoryPool.allocate(), nullptr);
+  ASSERT_EQ(memoryPool.allocate(), nullptr);
+}
+
+TEST(SynchronizedMemoryPool, AllocateMultipleIsAllOrNothing) {
+  SynchronizedMemoryPool<int, 4> memoryPool;
+  int *first[2];
+  int *second[3] = {};
+
+  ASSERT_TRUE(memoryPool.allocateMultiple(first, 2, allocateIndex));
+  ASSERT_FALSE(memoryPool.allocateMultiple(second, 3, allocateIndex));
+  for (int *element : second) {
+    EXPECT_EQ(element, nullptr);
+  }
+
+  // The failed allocation must not have consumed any blocks
+  ASSERT_TRUE(memoryPool.allocateMultiple(second, 2, allocateIndex));
+}
+
+TEST(SynchronizedMemoryPool, DeallocateMultipleReleasesAll) {
+  SynchronizedMemoryPool<int, 4> memoryPool;
+  int *elements[4];
+
+  ASSERT_TRUE(memoryPool.allocateMultiple(elements, 4, allocateIndex));
+  ASSERT_EQ(memoryPool.allocate(), nullptr);
+
+  memoryPool.deallocateMultiple(elements, 4);
+  ASSERT_TRUE(memoryPool.allocateMultiple(elements, 4, allocateIndex));
+}
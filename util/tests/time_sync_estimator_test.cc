@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+#include "chre/util/system/time_sync_estimator.h"
+
+using chre::TimeSyncEstimator;
+
+namespace {
+
+/**
+ * Simulates a probe to a remote clock that lags the local clock by
+ * trueOffset, with the given one-way delays and time spent on the remote side.
+ */
+bool addSimulatedSample(TimeSyncEstimator& estimator, int64_t localSendTime,
+                        int64_t trueOffset, int64_t outboundDelay,
+                        int64_t remoteDelay, int64_t returnDelay) {
+  int64_t remoteReceiveTime = localSendTime + outboundDelay - trueOffset;
+  int64_t remoteSendTime = remoteReceiveTime + remoteDelay;
+  int64_t localReceiveTime = remoteSendTime + trueOffset + returnDelay;
+  return estimator.addSample(localSendTime, remoteReceiveTime, remoteSendTime,
+                             localReceiveTime);
+}
+
+}  // anonymous namespace
+
+TEST(TimeSyncEstimator, NoEstimateWithoutSamples) {
+  TimeSyncEstimator estimator;
+  int64_t offset, uncertainty;
+  EXPECT_FALSE(estimator.getEstimate(&offset, &uncertainty));
+  EXPECT_EQ(estimator.getSampleCount(), 0u);
+}
+
+TEST(TimeSyncEstimator, SymmetricDelayIsExact) {
+  TimeSyncEstimator estimator;
+  constexpr int64_t kTrueOffset = 123456789;
+  ASSERT_TRUE(addSimulatedSample(estimator, 1000000000, kTrueOffset, 50000,
+                                 20000, 50000));
+
+  int64_t offset, uncertainty;
+  ASSERT_TRUE(estimator.getEstimate(&offset, &uncertainty));
+  EXPECT_EQ(offset, kTrueOffset);
+  EXPECT_GE(uncertainty, 50000);
+  EXPECT_LE(uncertainty, 50002);
+}
+
+TEST(TimeSyncEstimator, UsesSampleWithMinimumRoundTrip) {
+  TimeSyncEstimator estimator;
+  constexpr int64_t kTrueOffset = -5000000;
+  ASSERT_TRUE(addSimulatedSample(estimator, 1000000, kTrueOffset, 900000, 0,
+                                 10000));
+  ASSERT_TRUE(addSimulatedSample(estimator, 2000000, kTrueOffset, 10000, 0,
+                                 11000));
+  ASSERT_TRUE(addSimulatedSample(estimator, 3000000, kTrueOffset, 10000, 0,
+                                 700000));
+  EXPECT_EQ(estimator.getSampleCount(), 3u);
+
+  int64_t offset, uncertainty;
+  ASSERT_TRUE(estimator.getEstimate(&offset, &uncertainty));
+  EXPECT_EQ(offset, kTrueOffset + 500);
+  EXPECT_LE(uncertainty, 10502);
+}
+
+TEST(TimeSyncEstimator, RejectsClocksRunningBackwards) {
+  TimeSyncEstimator estimator;
+  EXPECT_FALSE(estimator.addSample(1000, 500, 600, 900));
+  EXPECT_FALSE(estimator.addSample(1000, 600, 500, 1200));
+  EXPECT_EQ(estimator.getSampleCount(), 0u);
+}
+
+TEST(TimeSyncEstimator, ResetDiscardsSamples) {
+  TimeSyncEstimator estimator;
+  ASSERT_TRUE(addSimulatedSample(estimator, 1000, 100, 10, 0, 10));
+  estimator.reset();
+
+  int64_t offset, uncertainty;
+  EXPECT_FALSE(estimator.getEstimate(&offset, &uncertainty));
+  ASSERT_TRUE(addSimulatedSample(estimator, 1000, 200, 1000, 0, 1000));
+  ASSERT_TRUE(estimator.getEstimate(&offset, &uncertainty));
+  EXPECT_EQ(offset, 200);
+}
+
+TEST(TimeSyncEstimator, HandlesUnrelatedEpochs) {
+  TimeSyncEstimator estimator;
+  constexpr int64_t kLocalTime = INT64_MAX - 1000000000;
+  constexpr int64_t kTrueOffset = kLocalTime - 1000;
+  ASSERT_TRUE(addSimulatedSample(estimator, kLocalTime, kTrueOffset, 300, 100,
+                                 300));
+
+  int64_t offset, uncertainty;
+  ASSERT_TRUE(estimator.getEstimate(&offset, &uncertainty));
+  EXPECT_LE(std::llabs(offset - kTrueOffset), uncertainty);
+}
+
+TEST(TimeSyncEstimator, TrueOffsetWithinUncertainty) {
+  constexpr int64_t kTrueOffset = 987654321;
+  srand(0);
+  for (int trial = 0; trial < 100; trial++) {
+    TimeSyncEstimator estimator;
+    int64_t localTime = 1000000000;
+    for (int i = 0; i < 8; i++) {
+      int64_t outbound = 20000 + rand() % 2000000;
+      int64_t remote = rand() % 100000;
+      int64_t inbound = 20000 + rand() % 2000000;
+      ASSERT_TRUE(addSimulatedSample(estimator, localTime, kTrueOffset,
+                                     outbound, remote, inbound));
+      localTime += outbound + remote + inbound;
+    }
+
+    int64_t offset, uncertainty;
+    ASSERT_TRUE(estimator.getEstimate(&offset, &uncertainty));
+    EXPECT_LE(std::llabs(offset - kTrueOffset), uncertainty);
+  }
+}
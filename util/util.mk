@@ -12,19 +12,36 @@ COMMON_CFLAGS += -Iutil/include
 COMMON_SRCS += util/nanoapp/debug.cc
 COMMON_SRCS += util/nanoapp/sensor.cc
 COMMON_SRCS += util/nanoapp/wifi.cc
+COMMON_SRCS += util/system/crc32.cc
 COMMON_SRCS += util/system/debug_dump.cc
 
 # GoogleTest Source Files ######################################################
 
 GOOGLETEST_SRCS += util/tests/array_queue_test.cc
 GOOGLETEST_SRCS += util/tests/blocking_queue_test.cc
+GOOGLETEST_SRCS += util/tests/crc32_test.cc
 GOOGLETEST_SRCS += util/tests/dynamic_vector_test.cc
 GOOGLETEST_SRCS += util/tests/fixed_size_vector_test.cc
 GOOGLETEST_SRCS += util/tests/heap_test.cc
+GOOGLETEST_SRCS += util/tests/intrusive_list_test.cc
 GOOGLETEST_SRCS += util/tests/lock_guard_test.cc
 GOOGLETEST_SRCS += util/tests/memory_pool_test.cc
 GOOGLETEST_SRCS += util/tests/optional_test.cc
 GOOGLETEST_SRCS += util/tests/priority_queue_test.cc
 GOOGLETEST_SRCS += util/tests/singleton_test.cc
+GOOGLETEST_SRCS += util/tests/synchronized_memory_pool_test.cc
+GOOGLETEST_SRCS += util/system/time_sync_estimator.cc
+GOOGLETEST_SRCS += util/tests/time_sync_estimator_test.cc
 GOOGLETEST_SRCS += util/tests/time_test.cc
 GOOGLETEST_SRCS += util/tests/unique_ptr_test.cc
+
+# Benchmark Compiler Flags #####################################################
+
+BENCHMARK_CFLAGS += -Iutil/benchmarks/include
+
+# Benchmark Source Files #######################################################
+
+BENCHMARK_SRCS += util/benchmarks/benchmark_main.cc
+BENCHMARK_SRCS += util/benchmarks/memory_pool_benchmark.cc
+BENCHMARK_SRCS += util/benchmarks/queue_benchmark.cc
+BENCHMARK_SRCS += util/benchmarks/vector_benchmark.cc
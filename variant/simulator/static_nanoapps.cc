@@ -22,10 +22,13 @@ namespace chre {
 
 //! The default list of static nanoapps to load.
 const StaticNanoappInitFunction kStaticNanoappList[] = {
+  initializeStaticNanoappEcho,
   initializeStaticNanoappGnssWorld,
   initializeStaticNanoappHelloWorld,
   initializeStaticNanoappImuCal,
+  initializeStaticNanoappLoadGen,
   initializeStaticNanoappMessageWorld,
+  initializeStaticNanoappSensorLatency,
   initializeStaticNanoappSensorWorld,
   initializeStaticNanoappSpammer,
   initializeStaticNanoappTimerWorld,